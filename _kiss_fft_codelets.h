@@ -0,0 +1,1040 @@
+/*
+ *  Copyright (c) 2003-2010, Mark Borgerding. All rights reserved.
+ *  This file is part of KISS FFT - https://github.com/mborgerding/kissfft
+ *
+ *  SPDX-License-Identifier: BSD-3-Clause
+ *  See COPYING file for more information.
+ */
+
+/* _kiss_fft_codelets.h
+   GENERATED by gen_kiss_fft_codelets.py -- do not edit.
+
+   Straight-line forward DFTs of size 8, 16, 32, 64 with hardcoded twiddles
+   (radix-4 decimation in time).  This file is a template: kiss_fft_codelets.c
+   includes it once per instruction set after defining
+
+     KF_V              vector type holding KF_VLEN complex values (lanes)
+     KF_TARGET         function attribute enabling the instruction set
+     VLD(p) VST(p,v)   load/store KF_VLEN consecutive complex values
+     VLDS(p,s)         load p[0], p[s], p[2s], ...
+     VADD VSUB VMUL    lane-wise arithmetic
+     VCMUL(a,b)        complex multiply
+     VCMULK(a,c,s)     complex multiply by the constant c + i*s
+     VMULNI(a)         multiply by -i
+     VSET1(x)          broadcast a scalar
+
+   and the names pick up the KF_SFX suffix.  Each lane runs an independent
+   transform; for size n:
+
+     kf_cl_col<n>  lane l reads in[j*is + l], writes out[k*os + l]
+     kf_cl_row<n>  lane l reads in[j*is + l*ls] * tw[j*is + l*ls]
+                   (j > 0), writes out[k*os + l]
+ */
+
+#define KF_CL_SQRT1_2 0.70710678118654752440f
+
+/* DFT-8 in place on x[0..7] */
+static KF_CL_INLINE KF_TARGET void KF_NAME(kf_cl_dft8_)(KF_V * x)
+{
+    KF_V t0 = VADD(x[0],x[4]);
+    KF_V t1 = VSUB(x[0],x[4]);
+    KF_V t2 = VADD(x[1],x[5]);
+    KF_V t3 = VSUB(x[1],x[5]);
+    KF_V t4 = VADD(x[2],x[6]);
+    KF_V t5 = VSUB(x[2],x[6]);
+    KF_V t6 = VADD(x[3],x[7]);
+    KF_V t7 = VSUB(x[3],x[7]);
+    KF_V t8 = VADD(t0,t4);
+    KF_V t9 = VSUB(t0,t4);
+    KF_V t10 = VADD(t2,t6);
+    KF_V t11 = VMULNI(VSUB(t2,t6));
+    KF_V t12 = VADD(t8,t10);
+    KF_V t13 = VADD(t9,t11);
+    KF_V t14 = VSUB(t8,t10);
+    KF_V t15 = VSUB(t9,t11);
+    KF_V t16 = VMUL(VADD(t3,VMULNI(t3)),VSET1(KF_CL_SQRT1_2));
+    KF_V t17 = VMULNI(t5);
+    KF_V t18 = VMUL(VSUB(VMULNI(t7),t7),VSET1(KF_CL_SQRT1_2));
+    KF_V t19 = VADD(t1,t17);
+    KF_V t20 = VSUB(t1,t17);
+    KF_V t21 = VADD(t16,t18);
+    KF_V t22 = VMULNI(VSUB(t16,t18));
+    KF_V t23 = VADD(t19,t21);
+    KF_V t24 = VADD(t20,t22);
+    KF_V t25 = VSUB(t19,t21);
+    KF_V t26 = VSUB(t20,t22);
+    x[0] = t12;
+    x[1] = t23;
+    x[2] = t13;
+    x[3] = t24;
+    x[4] = t14;
+    x[5] = t25;
+    x[6] = t15;
+    x[7] = t26;
+}
+
+static KF_TARGET void KF_NAME(kf_cl_col8_)(
+        const kiss_fft_cpx * in,size_t is,kiss_fft_cpx * out,size_t os)
+{
+    KF_V x[8];
+    int j;
+    for (j=0;j<8;++j)
+        x[j] = VLD(in + j*is);
+    KF_NAME(kf_cl_dft8_)(x);
+    for (j=0;j<8;++j)
+        VST(out + j*os, x[j]);
+}
+
+static KF_TARGET void KF_NAME(kf_cl_row8_)(
+        const kiss_fft_cpx * in,const kiss_fft_cpx * tw,size_t is,size_t ls,
+        kiss_fft_cpx * out,size_t os)
+{
+    KF_V x[8];
+    int j;
+    (void)ls;  /* lane stride; unused by the scalar VLDS */
+    x[0] = VLDS(in, ls);
+    for (j=1;j<8;++j)
+        x[j] = VCMUL(VLDS(in + j*is, ls), VLDS(tw + j*is, ls));
+    KF_NAME(kf_cl_dft8_)(x);
+    for (j=0;j<8;++j)
+        VST(out + j*os, x[j]);
+}
+
+/* DFT-16 in place on x[0..15] */
+static KF_CL_INLINE KF_TARGET void KF_NAME(kf_cl_dft16_)(KF_V * x)
+{
+    KF_V t0 = VADD(x[0],x[8]);
+    KF_V t1 = VSUB(x[0],x[8]);
+    KF_V t2 = VADD(x[4],x[12]);
+    KF_V t3 = VMULNI(VSUB(x[4],x[12]));
+    KF_V t4 = VADD(t0,t2);
+    KF_V t5 = VADD(t1,t3);
+    KF_V t6 = VSUB(t0,t2);
+    KF_V t7 = VSUB(t1,t3);
+    KF_V t8 = VADD(x[1],x[9]);
+    KF_V t9 = VSUB(x[1],x[9]);
+    KF_V t10 = VADD(x[5],x[13]);
+    KF_V t11 = VMULNI(VSUB(x[5],x[13]));
+    KF_V t12 = VADD(t8,t10);
+    KF_V t13 = VADD(t9,t11);
+    KF_V t14 = VSUB(t8,t10);
+    KF_V t15 = VSUB(t9,t11);
+    KF_V t16 = VADD(x[2],x[10]);
+    KF_V t17 = VSUB(x[2],x[10]);
+    KF_V t18 = VADD(x[6],x[14]);
+    KF_V t19 = VMULNI(VSUB(x[6],x[14]));
+    KF_V t20 = VADD(t16,t18);
+    KF_V t21 = VADD(t17,t19);
+    KF_V t22 = VSUB(t16,t18);
+    KF_V t23 = VSUB(t17,t19);
+    KF_V t24 = VADD(x[3],x[11]);
+    KF_V t25 = VSUB(x[3],x[11]);
+    KF_V t26 = VADD(x[7],x[15]);
+    KF_V t27 = VMULNI(VSUB(x[7],x[15]));
+    KF_V t28 = VADD(t24,t26);
+    KF_V t29 = VADD(t25,t27);
+    KF_V t30 = VSUB(t24,t26);
+    KF_V t31 = VSUB(t25,t27);
+    KF_V t32 = VADD(t4,t20);
+    KF_V t33 = VSUB(t4,t20);
+    KF_V t34 = VADD(t12,t28);
+    KF_V t35 = VMULNI(VSUB(t12,t28));
+    KF_V t36 = VADD(t32,t34);
+    KF_V t37 = VADD(t33,t35);
+    KF_V t38 = VSUB(t32,t34);
+    KF_V t39 = VSUB(t33,t35);
+    KF_V t40 = VCMULK(t13,0.92387953251128674f,-0.38268343236508978f);
+    KF_V t41 = VMUL(VADD(t21,VMULNI(t21)),VSET1(KF_CL_SQRT1_2));
+    KF_V t42 = VCMULK(t29,0.38268343236508984f,-0.92387953251128674f);
+    KF_V t43 = VADD(t5,t41);
+    KF_V t44 = VSUB(t5,t41);
+    KF_V t45 = VADD(t40,t42);
+    KF_V t46 = VMULNI(VSUB(t40,t42));
+    KF_V t47 = VADD(t43,t45);
+    KF_V t48 = VADD(t44,t46);
+    KF_V t49 = VSUB(t43,t45);
+    KF_V t50 = VSUB(t44,t46);
+    KF_V t51 = VMUL(VADD(t14,VMULNI(t14)),VSET1(KF_CL_SQRT1_2));
+    KF_V t52 = VMULNI(t22);
+    KF_V t53 = VMUL(VSUB(VMULNI(t30),t30),VSET1(KF_CL_SQRT1_2));
+    KF_V t54 = VADD(t6,t52);
+    KF_V t55 = VSUB(t6,t52);
+    KF_V t56 = VADD(t51,t53);
+    KF_V t57 = VMULNI(VSUB(t51,t53));
+    KF_V t58 = VADD(t54,t56);
+    KF_V t59 = VADD(t55,t57);
+    KF_V t60 = VSUB(t54,t56);
+    KF_V t61 = VSUB(t55,t57);
+    KF_V t62 = VCMULK(t15,0.38268343236508984f,-0.92387953251128674f);
+    KF_V t63 = VMUL(VSUB(VMULNI(t23),t23),VSET1(KF_CL_SQRT1_2));
+    KF_V t64 = VCMULK(t31,-0.92387953251128685f,0.38268343236508967f);
+    KF_V t65 = VADD(t7,t63);
+    KF_V t66 = VSUB(t7,t63);
+    KF_V t67 = VADD(t62,t64);
+    KF_V t68 = VMULNI(VSUB(t62,t64));
+    KF_V t69 = VADD(t65,t67);
+    KF_V t70 = VADD(t66,t68);
+    KF_V t71 = VSUB(t65,t67);
+    KF_V t72 = VSUB(t66,t68);
+    x[0] = t36;
+    x[1] = t47;
+    x[2] = t58;
+    x[3] = t69;
+    x[4] = t37;
+    x[5] = t48;
+    x[6] = t59;
+    x[7] = t70;
+    x[8] = t38;
+    x[9] = t49;
+    x[10] = t60;
+    x[11] = t71;
+    x[12] = t39;
+    x[13] = t50;
+    x[14] = t61;
+    x[15] = t72;
+}
+
+static KF_TARGET void KF_NAME(kf_cl_col16_)(
+        const kiss_fft_cpx * in,size_t is,kiss_fft_cpx * out,size_t os)
+{
+    KF_V x[16];
+    int j;
+    for (j=0;j<16;++j)
+        x[j] = VLD(in + j*is);
+    KF_NAME(kf_cl_dft16_)(x);
+    for (j=0;j<16;++j)
+        VST(out + j*os, x[j]);
+}
+
+static KF_TARGET void KF_NAME(kf_cl_row16_)(
+        const kiss_fft_cpx * in,const kiss_fft_cpx * tw,size_t is,size_t ls,
+        kiss_fft_cpx * out,size_t os)
+{
+    KF_V x[16];
+    int j;
+    (void)ls;  /* lane stride; unused by the scalar VLDS */
+    x[0] = VLDS(in, ls);
+    for (j=1;j<16;++j)
+        x[j] = VCMUL(VLDS(in + j*is, ls), VLDS(tw + j*is, ls));
+    KF_NAME(kf_cl_dft16_)(x);
+    for (j=0;j<16;++j)
+        VST(out + j*os, x[j]);
+}
+
+/* DFT-32 in place on x[0..31] */
+static KF_CL_INLINE KF_TARGET void KF_NAME(kf_cl_dft32_)(KF_V * x)
+{
+    KF_V t0 = VADD(x[0],x[16]);
+    KF_V t1 = VSUB(x[0],x[16]);
+    KF_V t2 = VADD(x[4],x[20]);
+    KF_V t3 = VSUB(x[4],x[20]);
+    KF_V t4 = VADD(x[8],x[24]);
+    KF_V t5 = VSUB(x[8],x[24]);
+    KF_V t6 = VADD(x[12],x[28]);
+    KF_V t7 = VSUB(x[12],x[28]);
+    KF_V t8 = VADD(t0,t4);
+    KF_V t9 = VSUB(t0,t4);
+    KF_V t10 = VADD(t2,t6);
+    KF_V t11 = VMULNI(VSUB(t2,t6));
+    KF_V t12 = VADD(t8,t10);
+    KF_V t13 = VADD(t9,t11);
+    KF_V t14 = VSUB(t8,t10);
+    KF_V t15 = VSUB(t9,t11);
+    KF_V t16 = VMUL(VADD(t3,VMULNI(t3)),VSET1(KF_CL_SQRT1_2));
+    KF_V t17 = VMULNI(t5);
+    KF_V t18 = VMUL(VSUB(VMULNI(t7),t7),VSET1(KF_CL_SQRT1_2));
+    KF_V t19 = VADD(t1,t17);
+    KF_V t20 = VSUB(t1,t17);
+    KF_V t21 = VADD(t16,t18);
+    KF_V t22 = VMULNI(VSUB(t16,t18));
+    KF_V t23 = VADD(t19,t21);
+    KF_V t24 = VADD(t20,t22);
+    KF_V t25 = VSUB(t19,t21);
+    KF_V t26 = VSUB(t20,t22);
+    KF_V t27 = VADD(x[1],x[17]);
+    KF_V t28 = VSUB(x[1],x[17]);
+    KF_V t29 = VADD(x[5],x[21]);
+    KF_V t30 = VSUB(x[5],x[21]);
+    KF_V t31 = VADD(x[9],x[25]);
+    KF_V t32 = VSUB(x[9],x[25]);
+    KF_V t33 = VADD(x[13],x[29]);
+    KF_V t34 = VSUB(x[13],x[29]);
+    KF_V t35 = VADD(t27,t31);
+    KF_V t36 = VSUB(t27,t31);
+    KF_V t37 = VADD(t29,t33);
+    KF_V t38 = VMULNI(VSUB(t29,t33));
+    KF_V t39 = VADD(t35,t37);
+    KF_V t40 = VADD(t36,t38);
+    KF_V t41 = VSUB(t35,t37);
+    KF_V t42 = VSUB(t36,t38);
+    KF_V t43 = VMUL(VADD(t30,VMULNI(t30)),VSET1(KF_CL_SQRT1_2));
+    KF_V t44 = VMULNI(t32);
+    KF_V t45 = VMUL(VSUB(VMULNI(t34),t34),VSET1(KF_CL_SQRT1_2));
+    KF_V t46 = VADD(t28,t44);
+    KF_V t47 = VSUB(t28,t44);
+    KF_V t48 = VADD(t43,t45);
+    KF_V t49 = VMULNI(VSUB(t43,t45));
+    KF_V t50 = VADD(t46,t48);
+    KF_V t51 = VADD(t47,t49);
+    KF_V t52 = VSUB(t46,t48);
+    KF_V t53 = VSUB(t47,t49);
+    KF_V t54 = VADD(x[2],x[18]);
+    KF_V t55 = VSUB(x[2],x[18]);
+    KF_V t56 = VADD(x[6],x[22]);
+    KF_V t57 = VSUB(x[6],x[22]);
+    KF_V t58 = VADD(x[10],x[26]);
+    KF_V t59 = VSUB(x[10],x[26]);
+    KF_V t60 = VADD(x[14],x[30]);
+    KF_V t61 = VSUB(x[14],x[30]);
+    KF_V t62 = VADD(t54,t58);
+    KF_V t63 = VSUB(t54,t58);
+    KF_V t64 = VADD(t56,t60);
+    KF_V t65 = VMULNI(VSUB(t56,t60));
+    KF_V t66 = VADD(t62,t64);
+    KF_V t67 = VADD(t63,t65);
+    KF_V t68 = VSUB(t62,t64);
+    KF_V t69 = VSUB(t63,t65);
+    KF_V t70 = VMUL(VADD(t57,VMULNI(t57)),VSET1(KF_CL_SQRT1_2));
+    KF_V t71 = VMULNI(t59);
+    KF_V t72 = VMUL(VSUB(VMULNI(t61),t61),VSET1(KF_CL_SQRT1_2));
+    KF_V t73 = VADD(t55,t71);
+    KF_V t74 = VSUB(t55,t71);
+    KF_V t75 = VADD(t70,t72);
+    KF_V t76 = VMULNI(VSUB(t70,t72));
+    KF_V t77 = VADD(t73,t75);
+    KF_V t78 = VADD(t74,t76);
+    KF_V t79 = VSUB(t73,t75);
+    KF_V t80 = VSUB(t74,t76);
+    KF_V t81 = VADD(x[3],x[19]);
+    KF_V t82 = VSUB(x[3],x[19]);
+    KF_V t83 = VADD(x[7],x[23]);
+    KF_V t84 = VSUB(x[7],x[23]);
+    KF_V t85 = VADD(x[11],x[27]);
+    KF_V t86 = VSUB(x[11],x[27]);
+    KF_V t87 = VADD(x[15],x[31]);
+    KF_V t88 = VSUB(x[15],x[31]);
+    KF_V t89 = VADD(t81,t85);
+    KF_V t90 = VSUB(t81,t85);
+    KF_V t91 = VADD(t83,t87);
+    KF_V t92 = VMULNI(VSUB(t83,t87));
+    KF_V t93 = VADD(t89,t91);
+    KF_V t94 = VADD(t90,t92);
+    KF_V t95 = VSUB(t89,t91);
+    KF_V t96 = VSUB(t90,t92);
+    KF_V t97 = VMUL(VADD(t84,VMULNI(t84)),VSET1(KF_CL_SQRT1_2));
+    KF_V t98 = VMULNI(t86);
+    KF_V t99 = VMUL(VSUB(VMULNI(t88),t88),VSET1(KF_CL_SQRT1_2));
+    KF_V t100 = VADD(t82,t98);
+    KF_V t101 = VSUB(t82,t98);
+    KF_V t102 = VADD(t97,t99);
+    KF_V t103 = VMULNI(VSUB(t97,t99));
+    KF_V t104 = VADD(t100,t102);
+    KF_V t105 = VADD(t101,t103);
+    KF_V t106 = VSUB(t100,t102);
+    KF_V t107 = VSUB(t101,t103);
+    KF_V t108 = VADD(t12,t66);
+    KF_V t109 = VSUB(t12,t66);
+    KF_V t110 = VADD(t39,t93);
+    KF_V t111 = VMULNI(VSUB(t39,t93));
+    KF_V t112 = VADD(t108,t110);
+    KF_V t113 = VADD(t109,t111);
+    KF_V t114 = VSUB(t108,t110);
+    KF_V t115 = VSUB(t109,t111);
+    KF_V t116 = VCMULK(t50,0.98078528040323043f,-0.19509032201612825f);
+    KF_V t117 = VCMULK(t77,0.92387953251128674f,-0.38268343236508978f);
+    KF_V t118 = VCMULK(t104,0.83146961230254524f,-0.55557023301960218f);
+    KF_V t119 = VADD(t23,t117);
+    KF_V t120 = VSUB(t23,t117);
+    KF_V t121 = VADD(t116,t118);
+    KF_V t122 = VMULNI(VSUB(t116,t118));
+    KF_V t123 = VADD(t119,t121);
+    KF_V t124 = VADD(t120,t122);
+    KF_V t125 = VSUB(t119,t121);
+    KF_V t126 = VSUB(t120,t122);
+    KF_V t127 = VCMULK(t40,0.92387953251128674f,-0.38268343236508978f);
+    KF_V t128 = VMUL(VADD(t67,VMULNI(t67)),VSET1(KF_CL_SQRT1_2));
+    KF_V t129 = VCMULK(t94,0.38268343236508984f,-0.92387953251128674f);
+    KF_V t130 = VADD(t13,t128);
+    KF_V t131 = VSUB(t13,t128);
+    KF_V t132 = VADD(t127,t129);
+    KF_V t133 = VMULNI(VSUB(t127,t129));
+    KF_V t134 = VADD(t130,t132);
+    KF_V t135 = VADD(t131,t133);
+    KF_V t136 = VSUB(t130,t132);
+    KF_V t137 = VSUB(t131,t133);
+    KF_V t138 = VCMULK(t51,0.83146961230254524f,-0.55557023301960218f);
+    KF_V t139 = VCMULK(t78,0.38268343236508984f,-0.92387953251128674f);
+    KF_V t140 = VCMULK(t105,-0.19509032201612819f,-0.98078528040323043f);
+    KF_V t141 = VADD(t24,t139);
+    KF_V t142 = VSUB(t24,t139);
+    KF_V t143 = VADD(t138,t140);
+    KF_V t144 = VMULNI(VSUB(t138,t140));
+    KF_V t145 = VADD(t141,t143);
+    KF_V t146 = VADD(t142,t144);
+    KF_V t147 = VSUB(t141,t143);
+    KF_V t148 = VSUB(t142,t144);
+    KF_V t149 = VMUL(VADD(t41,VMULNI(t41)),VSET1(KF_CL_SQRT1_2));
+    KF_V t150 = VMULNI(t68);
+    KF_V t151 = VMUL(VSUB(VMULNI(t95),t95),VSET1(KF_CL_SQRT1_2));
+    KF_V t152 = VADD(t14,t150);
+    KF_V t153 = VSUB(t14,t150);
+    KF_V t154 = VADD(t149,t151);
+    KF_V t155 = VMULNI(VSUB(t149,t151));
+    KF_V t156 = VADD(t152,t154);
+    KF_V t157 = VADD(t153,t155);
+    KF_V t158 = VSUB(t152,t154);
+    KF_V t159 = VSUB(t153,t155);
+    KF_V t160 = VCMULK(t52,0.55557023301960229f,-0.83146961230254524f);
+    KF_V t161 = VCMULK(t79,-0.38268343236508973f,-0.92387953251128674f);
+    KF_V t162 = VCMULK(t106,-0.98078528040323043f,-0.19509032201612861f);
+    KF_V t163 = VADD(t25,t161);
+    KF_V t164 = VSUB(t25,t161);
+    KF_V t165 = VADD(t160,t162);
+    KF_V t166 = VMULNI(VSUB(t160,t162));
+    KF_V t167 = VADD(t163,t165);
+    KF_V t168 = VADD(t164,t166);
+    KF_V t169 = VSUB(t163,t165);
+    KF_V t170 = VSUB(t164,t166);
+    KF_V t171 = VCMULK(t42,0.38268343236508984f,-0.92387953251128674f);
+    KF_V t172 = VMUL(VSUB(VMULNI(t69),t69),VSET1(KF_CL_SQRT1_2));
+    KF_V t173 = VCMULK(t96,-0.92387953251128685f,0.38268343236508967f);
+    KF_V t174 = VADD(t15,t172);
+    KF_V t175 = VSUB(t15,t172);
+    KF_V t176 = VADD(t171,t173);
+    KF_V t177 = VMULNI(VSUB(t171,t173));
+    KF_V t178 = VADD(t174,t176);
+    KF_V t179 = VADD(t175,t177);
+    KF_V t180 = VSUB(t174,t176);
+    KF_V t181 = VSUB(t175,t177);
+    KF_V t182 = VCMULK(t53,0.19509032201612833f,-0.98078528040323043f);
+    KF_V t183 = VCMULK(t80,-0.92387953251128674f,-0.38268343236508989f);
+    KF_V t184 = VCMULK(t107,-0.55557023301960218f,0.83146961230254524f);
+    KF_V t185 = VADD(t26,t183);
+    KF_V t186 = VSUB(t26,t183);
+    KF_V t187 = VADD(t182,t184);
+    KF_V t188 = VMULNI(VSUB(t182,t184));
+    KF_V t189 = VADD(t185,t187);
+    KF_V t190 = VADD(t186,t188);
+    KF_V t191 = VSUB(t185,t187);
+    KF_V t192 = VSUB(t186,t188);
+    x[0] = t112;
+    x[1] = t123;
+    x[2] = t134;
+    x[3] = t145;
+    x[4] = t156;
+    x[5] = t167;
+    x[6] = t178;
+    x[7] = t189;
+    x[8] = t113;
+    x[9] = t124;
+    x[10] = t135;
+    x[11] = t146;
+    x[12] = t157;
+    x[13] = t168;
+    x[14] = t179;
+    x[15] = t190;
+    x[16] = t114;
+    x[17] = t125;
+    x[18] = t136;
+    x[19] = t147;
+    x[20] = t158;
+    x[21] = t169;
+    x[22] = t180;
+    x[23] = t191;
+    x[24] = t115;
+    x[25] = t126;
+    x[26] = t137;
+    x[27] = t148;
+    x[28] = t159;
+    x[29] = t170;
+    x[30] = t181;
+    x[31] = t192;
+}
+
+static KF_TARGET void KF_NAME(kf_cl_col32_)(
+        const kiss_fft_cpx * in,size_t is,kiss_fft_cpx * out,size_t os)
+{
+    KF_V x[32];
+    int j;
+    for (j=0;j<32;++j)
+        x[j] = VLD(in + j*is);
+    KF_NAME(kf_cl_dft32_)(x);
+    for (j=0;j<32;++j)
+        VST(out + j*os, x[j]);
+}
+
+static KF_TARGET void KF_NAME(kf_cl_row32_)(
+        const kiss_fft_cpx * in,const kiss_fft_cpx * tw,size_t is,size_t ls,
+        kiss_fft_cpx * out,size_t os)
+{
+    KF_V x[32];
+    int j;
+    (void)ls;  /* lane stride; unused by the scalar VLDS */
+    x[0] = VLDS(in, ls);
+    for (j=1;j<32;++j)
+        x[j] = VCMUL(VLDS(in + j*is, ls), VLDS(tw + j*is, ls));
+    KF_NAME(kf_cl_dft32_)(x);
+    for (j=0;j<32;++j)
+        VST(out + j*os, x[j]);
+}
+
+/* DFT-64 in place on x[0..63] */
+static KF_CL_INLINE KF_TARGET void KF_NAME(kf_cl_dft64_)(KF_V * x)
+{
+    KF_V t0 = VADD(x[0],x[32]);
+    KF_V t1 = VSUB(x[0],x[32]);
+    KF_V t2 = VADD(x[16],x[48]);
+    KF_V t3 = VMULNI(VSUB(x[16],x[48]));
+    KF_V t4 = VADD(t0,t2);
+    KF_V t5 = VADD(t1,t3);
+    KF_V t6 = VSUB(t0,t2);
+    KF_V t7 = VSUB(t1,t3);
+    KF_V t8 = VADD(x[4],x[36]);
+    KF_V t9 = VSUB(x[4],x[36]);
+    KF_V t10 = VADD(x[20],x[52]);
+    KF_V t11 = VMULNI(VSUB(x[20],x[52]));
+    KF_V t12 = VADD(t8,t10);
+    KF_V t13 = VADD(t9,t11);
+    KF_V t14 = VSUB(t8,t10);
+    KF_V t15 = VSUB(t9,t11);
+    KF_V t16 = VADD(x[8],x[40]);
+    KF_V t17 = VSUB(x[8],x[40]);
+    KF_V t18 = VADD(x[24],x[56]);
+    KF_V t19 = VMULNI(VSUB(x[24],x[56]));
+    KF_V t20 = VADD(t16,t18);
+    KF_V t21 = VADD(t17,t19);
+    KF_V t22 = VSUB(t16,t18);
+    KF_V t23 = VSUB(t17,t19);
+    KF_V t24 = VADD(x[12],x[44]);
+    KF_V t25 = VSUB(x[12],x[44]);
+    KF_V t26 = VADD(x[28],x[60]);
+    KF_V t27 = VMULNI(VSUB(x[28],x[60]));
+    KF_V t28 = VADD(t24,t26);
+    KF_V t29 = VADD(t25,t27);
+    KF_V t30 = VSUB(t24,t26);
+    KF_V t31 = VSUB(t25,t27);
+    KF_V t32 = VADD(t4,t20);
+    KF_V t33 = VSUB(t4,t20);
+    KF_V t34 = VADD(t12,t28);
+    KF_V t35 = VMULNI(VSUB(t12,t28));
+    KF_V t36 = VADD(t32,t34);
+    KF_V t37 = VADD(t33,t35);
+    KF_V t38 = VSUB(t32,t34);
+    KF_V t39 = VSUB(t33,t35);
+    KF_V t40 = VCMULK(t13,0.92387953251128674f,-0.38268343236508978f);
+    KF_V t41 = VMUL(VADD(t21,VMULNI(t21)),VSET1(KF_CL_SQRT1_2));
+    KF_V t42 = VCMULK(t29,0.38268343236508984f,-0.92387953251128674f);
+    KF_V t43 = VADD(t5,t41);
+    KF_V t44 = VSUB(t5,t41);
+    KF_V t45 = VADD(t40,t42);
+    KF_V t46 = VMULNI(VSUB(t40,t42));
+    KF_V t47 = VADD(t43,t45);
+    KF_V t48 = VADD(t44,t46);
+    KF_V t49 = VSUB(t43,t45);
+    KF_V t50 = VSUB(t44,t46);
+    KF_V t51 = VMUL(VADD(t14,VMULNI(t14)),VSET1(KF_CL_SQRT1_2));
+    KF_V t52 = VMULNI(t22);
+    KF_V t53 = VMUL(VSUB(VMULNI(t30),t30),VSET1(KF_CL_SQRT1_2));
+    KF_V t54 = VADD(t6,t52);
+    KF_V t55 = VSUB(t6,t52);
+    KF_V t56 = VADD(t51,t53);
+    KF_V t57 = VMULNI(VSUB(t51,t53));
+    KF_V t58 = VADD(t54,t56);
+    KF_V t59 = VADD(t55,t57);
+    KF_V t60 = VSUB(t54,t56);
+    KF_V t61 = VSUB(t55,t57);
+    KF_V t62 = VCMULK(t15,0.38268343236508984f,-0.92387953251128674f);
+    KF_V t63 = VMUL(VSUB(VMULNI(t23),t23),VSET1(KF_CL_SQRT1_2));
+    KF_V t64 = VCMULK(t31,-0.92387953251128685f,0.38268343236508967f);
+    KF_V t65 = VADD(t7,t63);
+    KF_V t66 = VSUB(t7,t63);
+    KF_V t67 = VADD(t62,t64);
+    KF_V t68 = VMULNI(VSUB(t62,t64));
+    KF_V t69 = VADD(t65,t67);
+    KF_V t70 = VADD(t66,t68);
+    KF_V t71 = VSUB(t65,t67);
+    KF_V t72 = VSUB(t66,t68);
+    KF_V t73 = VADD(x[1],x[33]);
+    KF_V t74 = VSUB(x[1],x[33]);
+    KF_V t75 = VADD(x[17],x[49]);
+    KF_V t76 = VMULNI(VSUB(x[17],x[49]));
+    KF_V t77 = VADD(t73,t75);
+    KF_V t78 = VADD(t74,t76);
+    KF_V t79 = VSUB(t73,t75);
+    KF_V t80 = VSUB(t74,t76);
+    KF_V t81 = VADD(x[5],x[37]);
+    KF_V t82 = VSUB(x[5],x[37]);
+    KF_V t83 = VADD(x[21],x[53]);
+    KF_V t84 = VMULNI(VSUB(x[21],x[53]));
+    KF_V t85 = VADD(t81,t83);
+    KF_V t86 = VADD(t82,t84);
+    KF_V t87 = VSUB(t81,t83);
+    KF_V t88 = VSUB(t82,t84);
+    KF_V t89 = VADD(x[9],x[41]);
+    KF_V t90 = VSUB(x[9],x[41]);
+    KF_V t91 = VADD(x[25],x[57]);
+    KF_V t92 = VMULNI(VSUB(x[25],x[57]));
+    KF_V t93 = VADD(t89,t91);
+    KF_V t94 = VADD(t90,t92);
+    KF_V t95 = VSUB(t89,t91);
+    KF_V t96 = VSUB(t90,t92);
+    KF_V t97 = VADD(x[13],x[45]);
+    KF_V t98 = VSUB(x[13],x[45]);
+    KF_V t99 = VADD(x[29],x[61]);
+    KF_V t100 = VMULNI(VSUB(x[29],x[61]));
+    KF_V t101 = VADD(t97,t99);
+    KF_V t102 = VADD(t98,t100);
+    KF_V t103 = VSUB(t97,t99);
+    KF_V t104 = VSUB(t98,t100);
+    KF_V t105 = VADD(t77,t93);
+    KF_V t106 = VSUB(t77,t93);
+    KF_V t107 = VADD(t85,t101);
+    KF_V t108 = VMULNI(VSUB(t85,t101));
+    KF_V t109 = VADD(t105,t107);
+    KF_V t110 = VADD(t106,t108);
+    KF_V t111 = VSUB(t105,t107);
+    KF_V t112 = VSUB(t106,t108);
+    KF_V t113 = VCMULK(t86,0.92387953251128674f,-0.38268343236508978f);
+    KF_V t114 = VMUL(VADD(t94,VMULNI(t94)),VSET1(KF_CL_SQRT1_2));
+    KF_V t115 = VCMULK(t102,0.38268343236508984f,-0.92387953251128674f);
+    KF_V t116 = VADD(t78,t114);
+    KF_V t117 = VSUB(t78,t114);
+    KF_V t118 = VADD(t113,t115);
+    KF_V t119 = VMULNI(VSUB(t113,t115));
+    KF_V t120 = VADD(t116,t118);
+    KF_V t121 = VADD(t117,t119);
+    KF_V t122 = VSUB(t116,t118);
+    KF_V t123 = VSUB(t117,t119);
+    KF_V t124 = VMUL(VADD(t87,VMULNI(t87)),VSET1(KF_CL_SQRT1_2));
+    KF_V t125 = VMULNI(t95);
+    KF_V t126 = VMUL(VSUB(VMULNI(t103),t103),VSET1(KF_CL_SQRT1_2));
+    KF_V t127 = VADD(t79,t125);
+    KF_V t128 = VSUB(t79,t125);
+    KF_V t129 = VADD(t124,t126);
+    KF_V t130 = VMULNI(VSUB(t124,t126));
+    KF_V t131 = VADD(t127,t129);
+    KF_V t132 = VADD(t128,t130);
+    KF_V t133 = VSUB(t127,t129);
+    KF_V t134 = VSUB(t128,t130);
+    KF_V t135 = VCMULK(t88,0.38268343236508984f,-0.92387953251128674f);
+    KF_V t136 = VMUL(VSUB(VMULNI(t96),t96),VSET1(KF_CL_SQRT1_2));
+    KF_V t137 = VCMULK(t104,-0.92387953251128685f,0.38268343236508967f);
+    KF_V t138 = VADD(t80,t136);
+    KF_V t139 = VSUB(t80,t136);
+    KF_V t140 = VADD(t135,t137);
+    KF_V t141 = VMULNI(VSUB(t135,t137));
+    KF_V t142 = VADD(t138,t140);
+    KF_V t143 = VADD(t139,t141);
+    KF_V t144 = VSUB(t138,t140);
+    KF_V t145 = VSUB(t139,t141);
+    KF_V t146 = VADD(x[2],x[34]);
+    KF_V t147 = VSUB(x[2],x[34]);
+    KF_V t148 = VADD(x[18],x[50]);
+    KF_V t149 = VMULNI(VSUB(x[18],x[50]));
+    KF_V t150 = VADD(t146,t148);
+    KF_V t151 = VADD(t147,t149);
+    KF_V t152 = VSUB(t146,t148);
+    KF_V t153 = VSUB(t147,t149);
+    KF_V t154 = VADD(x[6],x[38]);
+    KF_V t155 = VSUB(x[6],x[38]);
+    KF_V t156 = VADD(x[22],x[54]);
+    KF_V t157 = VMULNI(VSUB(x[22],x[54]));
+    KF_V t158 = VADD(t154,t156);
+    KF_V t159 = VADD(t155,t157);
+    KF_V t160 = VSUB(t154,t156);
+    KF_V t161 = VSUB(t155,t157);
+    KF_V t162 = VADD(x[10],x[42]);
+    KF_V t163 = VSUB(x[10],x[42]);
+    KF_V t164 = VADD(x[26],x[58]);
+    KF_V t165 = VMULNI(VSUB(x[26],x[58]));
+    KF_V t166 = VADD(t162,t164);
+    KF_V t167 = VADD(t163,t165);
+    KF_V t168 = VSUB(t162,t164);
+    KF_V t169 = VSUB(t163,t165);
+    KF_V t170 = VADD(x[14],x[46]);
+    KF_V t171 = VSUB(x[14],x[46]);
+    KF_V t172 = VADD(x[30],x[62]);
+    KF_V t173 = VMULNI(VSUB(x[30],x[62]));
+    KF_V t174 = VADD(t170,t172);
+    KF_V t175 = VADD(t171,t173);
+    KF_V t176 = VSUB(t170,t172);
+    KF_V t177 = VSUB(t171,t173);
+    KF_V t178 = VADD(t150,t166);
+    KF_V t179 = VSUB(t150,t166);
+    KF_V t180 = VADD(t158,t174);
+    KF_V t181 = VMULNI(VSUB(t158,t174));
+    KF_V t182 = VADD(t178,t180);
+    KF_V t183 = VADD(t179,t181);
+    KF_V t184 = VSUB(t178,t180);
+    KF_V t185 = VSUB(t179,t181);
+    KF_V t186 = VCMULK(t159,0.92387953251128674f,-0.38268343236508978f);
+    KF_V t187 = VMUL(VADD(t167,VMULNI(t167)),VSET1(KF_CL_SQRT1_2));
+    KF_V t188 = VCMULK(t175,0.38268343236508984f,-0.92387953251128674f);
+    KF_V t189 = VADD(t151,t187);
+    KF_V t190 = VSUB(t151,t187);
+    KF_V t191 = VADD(t186,t188);
+    KF_V t192 = VMULNI(VSUB(t186,t188));
+    KF_V t193 = VADD(t189,t191);
+    KF_V t194 = VADD(t190,t192);
+    KF_V t195 = VSUB(t189,t191);
+    KF_V t196 = VSUB(t190,t192);
+    KF_V t197 = VMUL(VADD(t160,VMULNI(t160)),VSET1(KF_CL_SQRT1_2));
+    KF_V t198 = VMULNI(t168);
+    KF_V t199 = VMUL(VSUB(VMULNI(t176),t176),VSET1(KF_CL_SQRT1_2));
+    KF_V t200 = VADD(t152,t198);
+    KF_V t201 = VSUB(t152,t198);
+    KF_V t202 = VADD(t197,t199);
+    KF_V t203 = VMULNI(VSUB(t197,t199));
+    KF_V t204 = VADD(t200,t202);
+    KF_V t205 = VADD(t201,t203);
+    KF_V t206 = VSUB(t200,t202);
+    KF_V t207 = VSUB(t201,t203);
+    KF_V t208 = VCMULK(t161,0.38268343236508984f,-0.92387953251128674f);
+    KF_V t209 = VMUL(VSUB(VMULNI(t169),t169),VSET1(KF_CL_SQRT1_2));
+    KF_V t210 = VCMULK(t177,-0.92387953251128685f,0.38268343236508967f);
+    KF_V t211 = VADD(t153,t209);
+    KF_V t212 = VSUB(t153,t209);
+    KF_V t213 = VADD(t208,t210);
+    KF_V t214 = VMULNI(VSUB(t208,t210));
+    KF_V t215 = VADD(t211,t213);
+    KF_V t216 = VADD(t212,t214);
+    KF_V t217 = VSUB(t211,t213);
+    KF_V t218 = VSUB(t212,t214);
+    KF_V t219 = VADD(x[3],x[35]);
+    KF_V t220 = VSUB(x[3],x[35]);
+    KF_V t221 = VADD(x[19],x[51]);
+    KF_V t222 = VMULNI(VSUB(x[19],x[51]));
+    KF_V t223 = VADD(t219,t221);
+    KF_V t224 = VADD(t220,t222);
+    KF_V t225 = VSUB(t219,t221);
+    KF_V t226 = VSUB(t220,t222);
+    KF_V t227 = VADD(x[7],x[39]);
+    KF_V t228 = VSUB(x[7],x[39]);
+    KF_V t229 = VADD(x[23],x[55]);
+    KF_V t230 = VMULNI(VSUB(x[23],x[55]));
+    KF_V t231 = VADD(t227,t229);
+    KF_V t232 = VADD(t228,t230);
+    KF_V t233 = VSUB(t227,t229);
+    KF_V t234 = VSUB(t228,t230);
+    KF_V t235 = VADD(x[11],x[43]);
+    KF_V t236 = VSUB(x[11],x[43]);
+    KF_V t237 = VADD(x[27],x[59]);
+    KF_V t238 = VMULNI(VSUB(x[27],x[59]));
+    KF_V t239 = VADD(t235,t237);
+    KF_V t240 = VADD(t236,t238);
+    KF_V t241 = VSUB(t235,t237);
+    KF_V t242 = VSUB(t236,t238);
+    KF_V t243 = VADD(x[15],x[47]);
+    KF_V t244 = VSUB(x[15],x[47]);
+    KF_V t245 = VADD(x[31],x[63]);
+    KF_V t246 = VMULNI(VSUB(x[31],x[63]));
+    KF_V t247 = VADD(t243,t245);
+    KF_V t248 = VADD(t244,t246);
+    KF_V t249 = VSUB(t243,t245);
+    KF_V t250 = VSUB(t244,t246);
+    KF_V t251 = VADD(t223,t239);
+    KF_V t252 = VSUB(t223,t239);
+    KF_V t253 = VADD(t231,t247);
+    KF_V t254 = VMULNI(VSUB(t231,t247));
+    KF_V t255 = VADD(t251,t253);
+    KF_V t256 = VADD(t252,t254);
+    KF_V t257 = VSUB(t251,t253);
+    KF_V t258 = VSUB(t252,t254);
+    KF_V t259 = VCMULK(t232,0.92387953251128674f,-0.38268343236508978f);
+    KF_V t260 = VMUL(VADD(t240,VMULNI(t240)),VSET1(KF_CL_SQRT1_2));
+    KF_V t261 = VCMULK(t248,0.38268343236508984f,-0.92387953251128674f);
+    KF_V t262 = VADD(t224,t260);
+    KF_V t263 = VSUB(t224,t260);
+    KF_V t264 = VADD(t259,t261);
+    KF_V t265 = VMULNI(VSUB(t259,t261));
+    KF_V t266 = VADD(t262,t264);
+    KF_V t267 = VADD(t263,t265);
+    KF_V t268 = VSUB(t262,t264);
+    KF_V t269 = VSUB(t263,t265);
+    KF_V t270 = VMUL(VADD(t233,VMULNI(t233)),VSET1(KF_CL_SQRT1_2));
+    KF_V t271 = VMULNI(t241);
+    KF_V t272 = VMUL(VSUB(VMULNI(t249),t249),VSET1(KF_CL_SQRT1_2));
+    KF_V t273 = VADD(t225,t271);
+    KF_V t274 = VSUB(t225,t271);
+    KF_V t275 = VADD(t270,t272);
+    KF_V t276 = VMULNI(VSUB(t270,t272));
+    KF_V t277 = VADD(t273,t275);
+    KF_V t278 = VADD(t274,t276);
+    KF_V t279 = VSUB(t273,t275);
+    KF_V t280 = VSUB(t274,t276);
+    KF_V t281 = VCMULK(t234,0.38268343236508984f,-0.92387953251128674f);
+    KF_V t282 = VMUL(VSUB(VMULNI(t242),t242),VSET1(KF_CL_SQRT1_2));
+    KF_V t283 = VCMULK(t250,-0.92387953251128685f,0.38268343236508967f);
+    KF_V t284 = VADD(t226,t282);
+    KF_V t285 = VSUB(t226,t282);
+    KF_V t286 = VADD(t281,t283);
+    KF_V t287 = VMULNI(VSUB(t281,t283));
+    KF_V t288 = VADD(t284,t286);
+    KF_V t289 = VADD(t285,t287);
+    KF_V t290 = VSUB(t284,t286);
+    KF_V t291 = VSUB(t285,t287);
+    KF_V t292 = VADD(t36,t182);
+    KF_V t293 = VSUB(t36,t182);
+    KF_V t294 = VADD(t109,t255);
+    KF_V t295 = VMULNI(VSUB(t109,t255));
+    KF_V t296 = VADD(t292,t294);
+    KF_V t297 = VADD(t293,t295);
+    KF_V t298 = VSUB(t292,t294);
+    KF_V t299 = VSUB(t293,t295);
+    KF_V t300 = VCMULK(t120,0.99518472667219693f,-0.098017140329560604f);
+    KF_V t301 = VCMULK(t193,0.98078528040323043f,-0.19509032201612825f);
+    KF_V t302 = VCMULK(t266,0.95694033573220882f,-0.29028467725446233f);
+    KF_V t303 = VADD(t47,t301);
+    KF_V t304 = VSUB(t47,t301);
+    KF_V t305 = VADD(t300,t302);
+    KF_V t306 = VMULNI(VSUB(t300,t302));
+    KF_V t307 = VADD(t303,t305);
+    KF_V t308 = VADD(t304,t306);
+    KF_V t309 = VSUB(t303,t305);
+    KF_V t310 = VSUB(t304,t306);
+    KF_V t311 = VCMULK(t131,0.98078528040323043f,-0.19509032201612825f);
+    KF_V t312 = VCMULK(t204,0.92387953251128674f,-0.38268343236508978f);
+    KF_V t313 = VCMULK(t277,0.83146961230254524f,-0.55557023301960218f);
+    KF_V t314 = VADD(t58,t312);
+    KF_V t315 = VSUB(t58,t312);
+    KF_V t316 = VADD(t311,t313);
+    KF_V t317 = VMULNI(VSUB(t311,t313));
+    KF_V t318 = VADD(t314,t316);
+    KF_V t319 = VADD(t315,t317);
+    KF_V t320 = VSUB(t314,t316);
+    KF_V t321 = VSUB(t315,t317);
+    KF_V t322 = VCMULK(t142,0.95694033573220882f,-0.29028467725446233f);
+    KF_V t323 = VCMULK(t215,0.83146961230254524f,-0.55557023301960218f);
+    KF_V t324 = VCMULK(t288,0.63439328416364549f,-0.77301045336273699f);
+    KF_V t325 = VADD(t69,t323);
+    KF_V t326 = VSUB(t69,t323);
+    KF_V t327 = VADD(t322,t324);
+    KF_V t328 = VMULNI(VSUB(t322,t324));
+    KF_V t329 = VADD(t325,t327);
+    KF_V t330 = VADD(t326,t328);
+    KF_V t331 = VSUB(t325,t327);
+    KF_V t332 = VSUB(t326,t328);
+    KF_V t333 = VCMULK(t110,0.92387953251128674f,-0.38268343236508978f);
+    KF_V t334 = VMUL(VADD(t183,VMULNI(t183)),VSET1(KF_CL_SQRT1_2));
+    KF_V t335 = VCMULK(t256,0.38268343236508984f,-0.92387953251128674f);
+    KF_V t336 = VADD(t37,t334);
+    KF_V t337 = VSUB(t37,t334);
+    KF_V t338 = VADD(t333,t335);
+    KF_V t339 = VMULNI(VSUB(t333,t335));
+    KF_V t340 = VADD(t336,t338);
+    KF_V t341 = VADD(t337,t339);
+    KF_V t342 = VSUB(t336,t338);
+    KF_V t343 = VSUB(t337,t339);
+    KF_V t344 = VCMULK(t121,0.88192126434835505f,-0.47139673682599764f);
+    KF_V t345 = VCMULK(t194,0.55557023301960229f,-0.83146961230254524f);
+    KF_V t346 = VCMULK(t267,0.09801714032956077f,-0.99518472667219682f);
+    KF_V t347 = VADD(t48,t345);
+    KF_V t348 = VSUB(t48,t345);
+    KF_V t349 = VADD(t344,t346);
+    KF_V t350 = VMULNI(VSUB(t344,t346));
+    KF_V t351 = VADD(t347,t349);
+    KF_V t352 = VADD(t348,t350);
+    KF_V t353 = VSUB(t347,t349);
+    KF_V t354 = VSUB(t348,t350);
+    KF_V t355 = VCMULK(t132,0.83146961230254524f,-0.55557023301960218f);
+    KF_V t356 = VCMULK(t205,0.38268343236508984f,-0.92387953251128674f);
+    KF_V t357 = VCMULK(t278,-0.19509032201612819f,-0.98078528040323043f);
+    KF_V t358 = VADD(t59,t356);
+    KF_V t359 = VSUB(t59,t356);
+    KF_V t360 = VADD(t355,t357);
+    KF_V t361 = VMULNI(VSUB(t355,t357));
+    KF_V t362 = VADD(t358,t360);
+    KF_V t363 = VADD(t359,t361);
+    KF_V t364 = VSUB(t358,t360);
+    KF_V t365 = VSUB(t359,t361);
+    KF_V t366 = VCMULK(t143,0.77301045336273699f,-0.63439328416364549f);
+    KF_V t367 = VCMULK(t216,0.19509032201612833f,-0.98078528040323043f);
+    KF_V t368 = VCMULK(t289,-0.4713967368259977f,-0.88192126434835505f);
+    KF_V t369 = VADD(t70,t367);
+    KF_V t370 = VSUB(t70,t367);
+    KF_V t371 = VADD(t366,t368);
+    KF_V t372 = VMULNI(VSUB(t366,t368));
+    KF_V t373 = VADD(t369,t371);
+    KF_V t374 = VADD(t370,t372);
+    KF_V t375 = VSUB(t369,t371);
+    KF_V t376 = VSUB(t370,t372);
+    KF_V t377 = VMUL(VADD(t111,VMULNI(t111)),VSET1(KF_CL_SQRT1_2));
+    KF_V t378 = VMULNI(t184);
+    KF_V t379 = VMUL(VSUB(VMULNI(t257),t257),VSET1(KF_CL_SQRT1_2));
+    KF_V t380 = VADD(t38,t378);
+    KF_V t381 = VSUB(t38,t378);
+    KF_V t382 = VADD(t377,t379);
+    KF_V t383 = VMULNI(VSUB(t377,t379));
+    KF_V t384 = VADD(t380,t382);
+    KF_V t385 = VADD(t381,t383);
+    KF_V t386 = VSUB(t380,t382);
+    KF_V t387 = VSUB(t381,t383);
+    KF_V t388 = VCMULK(t122,0.63439328416364549f,-0.77301045336273699f);
+    KF_V t389 = VCMULK(t195,-0.19509032201612819f,-0.98078528040323043f);
+    KF_V t390 = VCMULK(t268,-0.88192126434835494f,-0.47139673682599786f);
+    KF_V t391 = VADD(t49,t389);
+    KF_V t392 = VSUB(t49,t389);
+    KF_V t393 = VADD(t388,t390);
+    KF_V t394 = VMULNI(VSUB(t388,t390));
+    KF_V t395 = VADD(t391,t393);
+    KF_V t396 = VADD(t392,t394);
+    KF_V t397 = VSUB(t391,t393);
+    KF_V t398 = VSUB(t392,t394);
+    KF_V t399 = VCMULK(t133,0.55557023301960229f,-0.83146961230254524f);
+    KF_V t400 = VCMULK(t206,-0.38268343236508973f,-0.92387953251128674f);
+    KF_V t401 = VCMULK(t279,-0.98078528040323043f,-0.19509032201612861f);
+    KF_V t402 = VADD(t60,t400);
+    KF_V t403 = VSUB(t60,t400);
+    KF_V t404 = VADD(t399,t401);
+    KF_V t405 = VMULNI(VSUB(t399,t401));
+    KF_V t406 = VADD(t402,t404);
+    KF_V t407 = VADD(t403,t405);
+    KF_V t408 = VSUB(t402,t404);
+    KF_V t409 = VSUB(t403,t405);
+    KF_V t410 = VCMULK(t144,0.47139673682599781f,-0.88192126434835494f);
+    KF_V t411 = VCMULK(t217,-0.55557023301960196f,-0.83146961230254546f);
+    KF_V t412 = VCMULK(t290,-0.99518472667219693f,0.09801714032956059f);
+    KF_V t413 = VADD(t71,t411);
+    KF_V t414 = VSUB(t71,t411);
+    KF_V t415 = VADD(t410,t412);
+    KF_V t416 = VMULNI(VSUB(t410,t412));
+    KF_V t417 = VADD(t413,t415);
+    KF_V t418 = VADD(t414,t416);
+    KF_V t419 = VSUB(t413,t415);
+    KF_V t420 = VSUB(t414,t416);
+    KF_V t421 = VCMULK(t112,0.38268343236508984f,-0.92387953251128674f);
+    KF_V t422 = VMUL(VSUB(VMULNI(t185),t185),VSET1(KF_CL_SQRT1_2));
+    KF_V t423 = VCMULK(t258,-0.92387953251128685f,0.38268343236508967f);
+    KF_V t424 = VADD(t39,t422);
+    KF_V t425 = VSUB(t39,t422);
+    KF_V t426 = VADD(t421,t423);
+    KF_V t427 = VMULNI(VSUB(t421,t423));
+    KF_V t428 = VADD(t424,t426);
+    KF_V t429 = VADD(t425,t427);
+    KF_V t430 = VSUB(t424,t426);
+    KF_V t431 = VSUB(t425,t427);
+    KF_V t432 = VCMULK(t123,0.29028467725446233f,-0.95694033573220894f);
+    KF_V t433 = VCMULK(t196,-0.83146961230254535f,-0.55557023301960218f);
+    KF_V t434 = VCMULK(t269,-0.7730104533627371f,0.63439328416364527f);
+    KF_V t435 = VADD(t50,t433);
+    KF_V t436 = VSUB(t50,t433);
+    KF_V t437 = VADD(t432,t434);
+    KF_V t438 = VMULNI(VSUB(t432,t434));
+    KF_V t439 = VADD(t435,t437);
+    KF_V t440 = VADD(t436,t438);
+    KF_V t441 = VSUB(t435,t437);
+    KF_V t442 = VSUB(t436,t438);
+    KF_V t443 = VCMULK(t134,0.19509032201612833f,-0.98078528040323043f);
+    KF_V t444 = VCMULK(t207,-0.92387953251128674f,-0.38268343236508989f);
+    KF_V t445 = VCMULK(t280,-0.55557023301960218f,0.83146961230254524f);
+    KF_V t446 = VADD(t61,t444);
+    KF_V t447 = VSUB(t61,t444);
+    KF_V t448 = VADD(t443,t445);
+    KF_V t449 = VMULNI(VSUB(t443,t445));
+    KF_V t450 = VADD(t446,t448);
+    KF_V t451 = VADD(t447,t449);
+    KF_V t452 = VSUB(t446,t448);
+    KF_V t453 = VSUB(t447,t449);
+    KF_V t454 = VCMULK(t145,0.09801714032956077f,-0.99518472667219682f);
+    KF_V t455 = VCMULK(t218,-0.98078528040323043f,-0.19509032201612861f);
+    KF_V t456 = VCMULK(t291,-0.29028467725446244f,0.95694033573220882f);
+    KF_V t457 = VADD(t72,t455);
+    KF_V t458 = VSUB(t72,t455);
+    KF_V t459 = VADD(t454,t456);
+    KF_V t460 = VMULNI(VSUB(t454,t456));
+    KF_V t461 = VADD(t457,t459);
+    KF_V t462 = VADD(t458,t460);
+    KF_V t463 = VSUB(t457,t459);
+    KF_V t464 = VSUB(t458,t460);
+    x[0] = t296;
+    x[1] = t307;
+    x[2] = t318;
+    x[3] = t329;
+    x[4] = t340;
+    x[5] = t351;
+    x[6] = t362;
+    x[7] = t373;
+    x[8] = t384;
+    x[9] = t395;
+    x[10] = t406;
+    x[11] = t417;
+    x[12] = t428;
+    x[13] = t439;
+    x[14] = t450;
+    x[15] = t461;
+    x[16] = t297;
+    x[17] = t308;
+    x[18] = t319;
+    x[19] = t330;
+    x[20] = t341;
+    x[21] = t352;
+    x[22] = t363;
+    x[23] = t374;
+    x[24] = t385;
+    x[25] = t396;
+    x[26] = t407;
+    x[27] = t418;
+    x[28] = t429;
+    x[29] = t440;
+    x[30] = t451;
+    x[31] = t462;
+    x[32] = t298;
+    x[33] = t309;
+    x[34] = t320;
+    x[35] = t331;
+    x[36] = t342;
+    x[37] = t353;
+    x[38] = t364;
+    x[39] = t375;
+    x[40] = t386;
+    x[41] = t397;
+    x[42] = t408;
+    x[43] = t419;
+    x[44] = t430;
+    x[45] = t441;
+    x[46] = t452;
+    x[47] = t463;
+    x[48] = t299;
+    x[49] = t310;
+    x[50] = t321;
+    x[51] = t332;
+    x[52] = t343;
+    x[53] = t354;
+    x[54] = t365;
+    x[55] = t376;
+    x[56] = t387;
+    x[57] = t398;
+    x[58] = t409;
+    x[59] = t420;
+    x[60] = t431;
+    x[61] = t442;
+    x[62] = t453;
+    x[63] = t464;
+}
+
+static KF_TARGET void KF_NAME(kf_cl_col64_)(
+        const kiss_fft_cpx * in,size_t is,kiss_fft_cpx * out,size_t os)
+{
+    KF_V x[64];
+    int j;
+    for (j=0;j<64;++j)
+        x[j] = VLD(in + j*is);
+    KF_NAME(kf_cl_dft64_)(x);
+    for (j=0;j<64;++j)
+        VST(out + j*os, x[j]);
+}
+
+static KF_TARGET void KF_NAME(kf_cl_row64_)(
+        const kiss_fft_cpx * in,const kiss_fft_cpx * tw,size_t is,size_t ls,
+        kiss_fft_cpx * out,size_t os)
+{
+    KF_V x[64];
+    int j;
+    (void)ls;  /* lane stride; unused by the scalar VLDS */
+    x[0] = VLDS(in, ls);
+    for (j=1;j<64;++j)
+        x[j] = VCMUL(VLDS(in + j*is, ls), VLDS(tw + j*is, ls));
+    KF_NAME(kf_cl_dft64_)(x);
+    for (j=0;j<64;++j)
+        VST(out + j*os, x[j]);
+}
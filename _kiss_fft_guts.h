@@ -18,16 +18,77 @@
 #include "kiss_fft_log.h"
 #include <limits.h>
 
+/* The SIMD levels (butterflies, codelets and the kernels built on them) are
+   bit-identical to the scalar code only if no level fuses a multiply and an
+   add into one FMA.  GCC contracts by default outside -std=c99/c11, and with
+   -march=native even the scalar code would, so contraction is turned off
+   here for every library translation unit, whatever the build flags. */
+#if defined(__clang__)
+# pragma STDC FP_CONTRACT OFF
+#elif defined(__GNUC__)
+# pragma GCC optimize("fp-contract=off")
+#elif defined(_MSC_VER)
+# pragma fp_contract(off)
+#endif
+
+/* target(isa) for the runtime-dispatched SIMD kernels.  GCC rebuilds the
+   options of a target() function from the command line, so the pragma
+   above does not reach it and contraction is turned off again here. */
+#if defined(__GNUC__) && !defined(__clang__)
+# define KF_ATTR_TARGET(isa) __attribute__((target(isa), optimize("fp-contract=off")))
+#elif defined(__clang__)
+# define KF_ATTR_TARGET(isa) __attribute__((target(isa)))
+#else
+# define KF_ATTR_TARGET(isa)
+#endif
+
 #define MAXFACTORS 32
 /* e.g. an fft of length 128 has 4 factors
  as far as kissfft is concerned
  4*4*4*2
  */
 
+/* Float builds transform sizes whose largest prime factor exceeds
+   KISS_FFT_BLUESTEIN_MIN_FACTOR with Bluestein's algorithm (a chirp-z
+   convolution over a 2,3,5-smooth size, a power of two where a codelet
+   covers it) instead of kf_bfly_generic,
+   whose cost grows with N*p. */
+#if !defined(FIXED_POINT) && !defined(USE_SIMD)
+# define KISS_FFT_BLUESTEIN
+# ifndef KISS_FFT_BLUESTEIN_MIN_FACTOR
+#  define KISS_FFT_BLUESTEIN_MIN_FACTOR 31
+# endif
+/* the sub-FFT uses radices 2 to 5, which must never recurse into Bluestein */
+# if KISS_FFT_BLUESTEIN_MIN_FACTOR < 5
+#  error "KISS_FFT_BLUESTEIN_MIN_FACTOR must be at least 5"
+# endif
+#endif
+
+/* Float builds run power-of-two sizes from KF_CODELET_MIN to KF_CODELET_MAX
+   with the generated fixed-size codelets in kiss_fft_codelets.c instead of
+   kf_work.  Define KISS_FFT_NO_CODELETS to always use kf_work. */
+#if !defined(FIXED_POINT) && !defined(USE_SIMD) && !defined(KISS_FFT_NO_CODELETS)
+# define KISS_FFT_CODELETS
+#endif
+#define KF_CODELET_MIN 64
+#define KF_CODELET_MAX 4096
+
 struct kiss_fft_state{
     int nfft;
     int inverse;
     int factors[2*MAXFACTORS];
+    /* Bluestein plans only (NULL otherwise), all inside the cfg block:
+       forward sub-FFT of size M >= 2*nfft-1, the chirp w[n] (nfft values),
+       and the spectrum of the conjugate chirp filter scaled by 1/M (M
+       values); the scratch is taken per transform */
+    struct kiss_fft_state * bluestein;
+    kiss_fft_cpx * chirp;
+    kiss_fft_cpx * chirp_fft;
+    /* codelet plans only (NULL / 0 otherwise): nfft = codelet_n1 * n2,
+       and codelet_tw[k1*n2 + j] = exp(-2*pi*i*k1*j/nfft), inside the
+       cfg block */
+    kiss_fft_cpx * codelet_tw;
+    int codelet_n1;
     kiss_fft_cpx twiddles[1];
 };
 
@@ -163,5 +224,58 @@ struct kiss_fft_state{
 #define  KISS_FFT_TMP_FREE(ptr) KISS_FFT_FREE(ptr)
 #endif
 
+/* Largest number of transforms kiss_fft_batch/kiss_fftr_batch interleave
+   at once, and the work buffer size (in complex values) they keep on the
+   stack before falling back to KISS_FFT_TMP_ALLOC. */
+#ifndef KISS_FFT_BATCH_MAX
+#define KISS_FFT_BATCH_MAX 8
+#endif
+#ifndef KISS_FFT_BATCH_STACK
+#define KISS_FFT_BATCH_STACK 1024
+#endif
+
+/* Row length used for an element-interleaved batch of howmany transforms
+   (howmany rounded up to fill whole SIMD vectors). */
+int kf_batch_stride(int howmany);
+
+/* Runs howmany transforms of fin (transform b at fin+b*in_dist) and leaves
+   the result element-interleaved in work: bin k of transform b at
+   work[k*stride+b], where stride = kf_batch_stride(howmany) is returned.
+   work holds nfft*stride values. */
+int kf_batch_interleaved(kiss_fft_cfg st,int howmany,
+        const kiss_fft_cpx *fin,int in_dist,kiss_fft_cpx *work);
+
+/* How kiss_fft_alloc computes one size: the kf_work radices in the
+   factors[] layout of struct kiss_fft_state (p1,m1,p2,m2,... in stage
+   order), or the codelet split N1 when codelet_n1 is nonzero (factors
+   then still serve kiss_fft_stride with in_stride != 1). */
+typedef struct {
+    int factors[2*MAXFACTORS];
+    int codelet_n1;
+} kf_plan;
+
+/* default radix order: 4s first, then 2, then the odd primes ascending */
+void kf_factor(int n,int * facbuf);
+/* the plan kiss_fft_alloc uses when there is no wisdom for nfft */
+void kf_default_plan(int nfft,kf_plan * plan);
+/* kiss_fft_alloc with the plan given instead of looked up */
+kiss_fft_cfg kf_alloc_plan(int nfft,int inverse_fft,const kf_plan * plan,
+        void * mem,size_t * lenmem);
+/* copies the tuned plan for nfft (kiss_fft_wisdom.c) into *plan;
+   returns 0 if there is none */
+int kf_wisdom_lookup(int nfft,kf_plan * plan);
+
+#ifdef KISS_FFT_CODELETS
+/* codelet split of nfft (N1 of N = N1*N2), or 0 if nfft has no codelet plan */
+int kf_codelet_n1(int nfft);
+/* nonzero if N1 = n1 is also a valid codelet split of nfft (both passes
+   within the generated DFT-8..64) */
+int kf_codelet_split_ok(int nfft,int n1);
+/* fills st->codelet_tw; codelet_n1 and codelet_tw are already set */
+void kf_codelet_init(kiss_fft_cfg st);
+/* forward or inverse transform with the codelets; fin may equal fout */
+void kf_codelet(kiss_fft_cfg st,const kiss_fft_cpx *fin,kiss_fft_cpx *fout);
+#endif
+
 #endif /* _kiss_fft_guts_h */
 
@@ -0,0 +1,360 @@
+/*
+ *  Copyright (c) 2003-2010, Mark Borgerding. All rights reserved.
+ *  This file is part of KISS FFT - https://github.com/mborgerding/kissfft
+ *
+ *  SPDX-License-Identifier: BSD-3-Clause
+ *  See COPYING file for more information.
+ */
+
+/* _kiss_fft_simd.h
+   Vectorized radix-2/3/4/5 butterflies for the float kiss_fft_cpx layout.
+
+   This file is a template: kiss_fft.c includes it once per instruction set
+   after defining the vector primitives below, and the kernel names pick up
+   the KF_SFX suffix (kf_bfly4_sse2, kf_bfly4_avx2, ...).
+
+     KF_V              vector type holding KF_VLEN interleaved complex values
+     KF_TARGET         function attribute enabling the instruction set
+     VLD(p) VST(p,v)   unaligned load/store of KF_VLEN complex values
+     VTW(p,s)          load p[0], p[s], p[2s], ... (strided twiddles)
+     VADD VSUB VMUL    lane-wise arithmetic
+     VSET1(x)          broadcast a scalar
+     VSWAP(v)          swap real/imag in every complex value
+     VDUPRE VDUPIM     broadcast real (imag) part across each complex value
+     VNEGRE VNEGIM     flip the sign of the real (imag) lanes
+
+   Every kernel performs exactly the same IEEE operations, in the same
+   order, as its scalar twin in kiss_fft.c, so results are bit-identical
+   to the scalar path.  _kiss_fft_guts.h turns FMA contraction off for the
+   whole translation unit, so this holds under any -std or -march; the
+   scalar path must still use SSE rather than x87 math.
+   Callers guarantee m is a multiple of KF_VLEN.
+
+   The *_batch_ kernels run one stage for a batch of transforms stored
+   element-interleaved (element k of transform b at Fout[k*B+b]).  The
+   vector lanes run across transforms, so each twiddle is broadcast once
+   per row; they handle columns [b0,b1), with b1-b0 a multiple of KF_VLEN.
+ */
+
+#define KF_CAT_(a,b) a##b
+#define KF_CAT(a,b) KF_CAT_(a,b)
+#define KF_NAME(base) KF_CAT(base,KF_SFX)
+
+/* m = a*b with a.r*b.r - a.i*b.i and a.r*b.i + a.i*b.r, like C_MUL */
+#define VCMUL(a,b) \
+    VADD( VMUL((a),VDUPRE(b)), VNEGRE( VMUL(VSWAP(a),VDUPIM(b)) ) )
+
+static KF_TARGET void KF_NAME(kf_bfly2_)(
+        kiss_fft_cpx * Fout,
+        const size_t fstride,
+        const kiss_fft_cfg st,
+        int m
+        )
+{
+    const kiss_fft_cpx * tw1 = st->twiddles;
+    int k;
+
+    for (k=0; k<m; k+=KF_VLEN) {
+        KF_V f0 = VLD(Fout+k);
+        KF_V t = VCMUL( VLD(Fout+m+k), VTW(tw1+k*fstride,fstride) );
+        VST(Fout+m+k, VSUB(f0,t));
+        VST(Fout+k,   VADD(f0,t));
+    }
+}
+
+static KF_TARGET void KF_NAME(kf_bfly4_)(
+        kiss_fft_cpx * Fout,
+        const size_t fstride,
+        const kiss_fft_cfg st,
+        int m
+        )
+{
+    const kiss_fft_cpx * tw = st->twiddles;
+    const size_t m2=2*m;
+    const size_t m3=3*m;
+    int k;
+
+    for (k=0; k<m; k+=KF_VLEN) {
+        KF_V f0,s0,s1,s2,s3,s4,s5,rot;
+
+        s0 = VCMUL( VLD(Fout+k+m),  VTW(tw+k*fstride,  fstride) );
+        s1 = VCMUL( VLD(Fout+k+m2), VTW(tw+k*fstride*2,fstride*2) );
+        s2 = VCMUL( VLD(Fout+k+m3), VTW(tw+k*fstride*3,fstride*3) );
+
+        f0 = VLD(Fout+k);
+        s5 = VSUB(f0,s1);
+        f0 = VADD(f0,s1);
+        s3 = VADD(s0,s2);
+        s4 = VSUB(s0,s2);
+        VST(Fout+k+m2, VSUB(f0,s3));
+        VST(Fout+k,    VADD(f0,s3));
+
+        /* rot = (s4.i, -s4.r) */
+        rot = VNEGIM( VSWAP(s4) );
+        if(st->inverse) {
+            VST(Fout+k+m,  VSUB(s5,rot));
+            VST(Fout+k+m3, VADD(s5,rot));
+        }else{
+            VST(Fout+k+m,  VADD(s5,rot));
+            VST(Fout+k+m3, VSUB(s5,rot));
+        }
+    }
+}
+
+static KF_TARGET void KF_NAME(kf_bfly3_)(
+        kiss_fft_cpx * Fout,
+        const size_t fstride,
+        const kiss_fft_cfg st,
+        int m
+        )
+{
+    const kiss_fft_cpx * tw = st->twiddles;
+    const size_t m2 = 2*m;
+    const KF_V epi3i = VSET1(st->twiddles[fstride*m].i);
+    const KF_V half = VSET1(.5f);
+    int k;
+
+    for (k=0; k<m; k+=KF_VLEN) {
+        KF_V f0,fm,s0,s1,s2,s3,rot;
+
+        s1 = VCMUL( VLD(Fout+k+m),  VTW(tw+k*fstride,  fstride) );
+        s2 = VCMUL( VLD(Fout+k+m2), VTW(tw+k*fstride*2,fstride*2) );
+
+        s3 = VADD(s1,s2);
+        s0 = VSUB(s1,s2);
+
+        f0 = VLD(Fout+k);
+        fm = VSUB( f0, VMUL(s3,half) );
+
+        s0 = VMUL(s0,epi3i);
+
+        VST(Fout+k, VADD(f0,s3));
+
+        /* rot = (s0.i, -s0.r) */
+        rot = VNEGIM( VSWAP(s0) );
+        VST(Fout+k+m2, VADD(fm,rot));
+        VST(Fout+k+m,  VSUB(fm,rot));
+    }
+}
+
+static KF_TARGET void KF_NAME(kf_bfly5_)(
+        kiss_fft_cpx * Fout,
+        const size_t fstride,
+        const kiss_fft_cfg st,
+        int m
+        )
+{
+    const kiss_fft_cpx * tw = st->twiddles;
+    const kiss_fft_cpx ya = st->twiddles[fstride*m];
+    const kiss_fft_cpx yb = st->twiddles[fstride*2*m];
+    const KF_V yar = VSET1(ya.r), yai = VSET1(ya.i);
+    const KF_V ybr = VSET1(yb.r), ybi = VSET1(yb.i);
+    int u;
+
+    for (u=0; u<m; u+=KF_VLEN) {
+        KF_V s0,s1,s2,s3,s4,s5,s6,s7,s8,s9,s10,s11,s12;
+
+        s0 = VLD(Fout+u);
+        s1 = VCMUL( VLD(Fout+u+m),   VTW(tw+u*fstride,  fstride) );
+        s2 = VCMUL( VLD(Fout+u+2*m), VTW(tw+2*u*fstride,2*fstride) );
+        s3 = VCMUL( VLD(Fout+u+3*m), VTW(tw+3*u*fstride,3*fstride) );
+        s4 = VCMUL( VLD(Fout+u+4*m), VTW(tw+4*u*fstride,4*fstride) );
+
+        s7  = VADD(s1,s4);
+        s10 = VSUB(s1,s4);
+        s8  = VADD(s2,s3);
+        s9  = VSUB(s2,s3);
+
+        VST(Fout+u, VADD( s0, VADD(s7,s8) ));
+
+        s5 = VADD( VADD( s0, VMUL(s7,yar) ), VMUL(s8,ybr) );
+        /* (s10.i*ya.i + s9.i*yb.i, -s10.r*ya.i - s9.r*yb.i) */
+        s6 = VNEGIM( VADD( VMUL(VSWAP(s10),yai), VMUL(VSWAP(s9),ybi) ) );
+
+        VST(Fout+u+m,   VSUB(s5,s6));
+        VST(Fout+u+4*m, VADD(s5,s6));
+
+        s11 = VADD( VADD( s0, VMUL(s7,ybr) ), VMUL(s8,yar) );
+        /* (-s10.i*yb.i + s9.i*ya.i, s10.r*yb.i - s9.r*ya.i) */
+        s12 = VNEGRE( VSUB( VMUL(VSWAP(s10),ybi), VMUL(VSWAP(s9),yai) ) );
+
+        VST(Fout+u+2*m, VADD(s11,s12));
+        VST(Fout+u+3*m, VSUB(s11,s12));
+    }
+}
+
+/* ---- batched kernels: lanes across transforms ---- */
+
+static KF_TARGET void KF_NAME(kf_bfly2_batch_)(
+        kiss_fft_cpx * Fout,
+        const size_t fstride,
+        const kiss_fft_cfg st,
+        int m,
+        int B,
+        int b0,
+        int b1
+        )
+{
+    int k,b;
+
+    for (k=0; k<m; ++k) {
+        const KF_V w = VTW(st->twiddles+k*fstride,0);
+        kiss_fft_cpx * F0 = Fout + (size_t)k*B;
+        kiss_fft_cpx * F1 = F0 + (size_t)m*B;
+        for (b=b0; b<b1; b+=KF_VLEN) {
+            KF_V f0 = VLD(F0+b);
+            KF_V t = VCMUL( VLD(F1+b), w );
+            VST(F1+b, VSUB(f0,t));
+            VST(F0+b, VADD(f0,t));
+        }
+    }
+}
+
+static KF_TARGET void KF_NAME(kf_bfly4_batch_)(
+        kiss_fft_cpx * Fout,
+        const size_t fstride,
+        const kiss_fft_cfg st,
+        int m,
+        int B,
+        int b0,
+        int b1
+        )
+{
+    const size_t row = (size_t)m*B;
+    int k,b;
+
+    for (k=0; k<m; ++k) {
+        const KF_V w1 = VTW(st->twiddles+k*fstride,0);
+        const KF_V w2 = VTW(st->twiddles+k*fstride*2,0);
+        const KF_V w3 = VTW(st->twiddles+k*fstride*3,0);
+        kiss_fft_cpx * F0 = Fout + (size_t)k*B;
+
+        for (b=b0; b<b1; b+=KF_VLEN) {
+            KF_V f0,s0,s1,s2,s3,s4,s5,rot;
+
+            s0 = VCMUL( VLD(F0+b+row),   w1 );
+            s1 = VCMUL( VLD(F0+b+2*row), w2 );
+            s2 = VCMUL( VLD(F0+b+3*row), w3 );
+
+            f0 = VLD(F0+b);
+            s5 = VSUB(f0,s1);
+            f0 = VADD(f0,s1);
+            s3 = VADD(s0,s2);
+            s4 = VSUB(s0,s2);
+            VST(F0+b+2*row, VSUB(f0,s3));
+            VST(F0+b,       VADD(f0,s3));
+
+            rot = VNEGIM( VSWAP(s4) );
+            if(st->inverse) {
+                VST(F0+b+row,   VSUB(s5,rot));
+                VST(F0+b+3*row, VADD(s5,rot));
+            }else{
+                VST(F0+b+row,   VADD(s5,rot));
+                VST(F0+b+3*row, VSUB(s5,rot));
+            }
+        }
+    }
+}
+
+static KF_TARGET void KF_NAME(kf_bfly3_batch_)(
+        kiss_fft_cpx * Fout,
+        const size_t fstride,
+        const kiss_fft_cfg st,
+        int m,
+        int B,
+        int b0,
+        int b1
+        )
+{
+    const size_t row = (size_t)m*B;
+    const KF_V epi3i = VSET1(st->twiddles[fstride*m].i);
+    const KF_V half = VSET1(.5f);
+    int k,b;
+
+    for (k=0; k<m; ++k) {
+        const KF_V w1 = VTW(st->twiddles+k*fstride,0);
+        const KF_V w2 = VTW(st->twiddles+k*fstride*2,0);
+        kiss_fft_cpx * F0 = Fout + (size_t)k*B;
+
+        for (b=b0; b<b1; b+=KF_VLEN) {
+            KF_V f0,fm,s0,s1,s2,s3,rot;
+
+            s1 = VCMUL( VLD(F0+b+row),   w1 );
+            s2 = VCMUL( VLD(F0+b+2*row), w2 );
+
+            s3 = VADD(s1,s2);
+            s0 = VSUB(s1,s2);
+
+            f0 = VLD(F0+b);
+            fm = VSUB( f0, VMUL(s3,half) );
+
+            s0 = VMUL(s0,epi3i);
+
+            VST(F0+b, VADD(f0,s3));
+
+            rot = VNEGIM( VSWAP(s0) );
+            VST(F0+b+2*row, VADD(fm,rot));
+            VST(F0+b+row,   VSUB(fm,rot));
+        }
+    }
+}
+
+static KF_TARGET void KF_NAME(kf_bfly5_batch_)(
+        kiss_fft_cpx * Fout,
+        const size_t fstride,
+        const kiss_fft_cfg st,
+        int m,
+        int B,
+        int b0,
+        int b1
+        )
+{
+    const size_t row = (size_t)m*B;
+    const kiss_fft_cpx ya = st->twiddles[fstride*m];
+    const kiss_fft_cpx yb = st->twiddles[fstride*2*m];
+    const KF_V yar = VSET1(ya.r), yai = VSET1(ya.i);
+    const KF_V ybr = VSET1(yb.r), ybi = VSET1(yb.i);
+    int u,b;
+
+    for (u=0; u<m; ++u) {
+        const KF_V w1 = VTW(st->twiddles+u*fstride,0);
+        const KF_V w2 = VTW(st->twiddles+2*u*fstride,0);
+        const KF_V w3 = VTW(st->twiddles+3*u*fstride,0);
+        const KF_V w4 = VTW(st->twiddles+4*u*fstride,0);
+        kiss_fft_cpx * F0 = Fout + (size_t)u*B;
+
+        for (b=b0; b<b1; b+=KF_VLEN) {
+            KF_V s0,s1,s2,s3,s4,s5,s6,s7,s8,s9,s10,s11,s12;
+
+            s0 = VLD(F0+b);
+            s1 = VCMUL( VLD(F0+b+row),   w1 );
+            s2 = VCMUL( VLD(F0+b+2*row), w2 );
+            s3 = VCMUL( VLD(F0+b+3*row), w3 );
+            s4 = VCMUL( VLD(F0+b+4*row), w4 );
+
+            s7  = VADD(s1,s4);
+            s10 = VSUB(s1,s4);
+            s8  = VADD(s2,s3);
+            s9  = VSUB(s2,s3);
+
+            VST(F0+b, VADD( s0, VADD(s7,s8) ));
+
+            s5 = VADD( VADD( s0, VMUL(s7,yar) ), VMUL(s8,ybr) );
+            s6 = VNEGIM( VADD( VMUL(VSWAP(s10),yai), VMUL(VSWAP(s9),ybi) ) );
+
+            VST(F0+b+row,   VSUB(s5,s6));
+            VST(F0+b+4*row, VADD(s5,s6));
+
+            s11 = VADD( VADD( s0, VMUL(s7,ybr) ), VMUL(s8,yar) );
+            s12 = VNEGRE( VSUB( VMUL(VSWAP(s10),ybi), VMUL(VSWAP(s9),yai) ) );
+
+            VST(F0+b+2*row, VADD(s11,s12));
+            VST(F0+b+3*row, VSUB(s11,s12));
+        }
+    }
+}
+
+#undef VCMUL
+#undef KF_NAME
+#undef KF_CAT
+#undef KF_CAT_
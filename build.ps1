@@ -13,7 +13,28 @@ $EXE = "fft_analyzer_network.exe"
 $SOURCES = @(
     "fft_analyzer_network.c",
     "web_server.c",
-    "kiss_fft.c"
+    "kiss_fft.c",
+    "kiss_fft_codelets.c",
+    "kiss_fft_wisdom.c",
+    "kiss_fftr.c",
+    "kiss_fftmt.c",
+    "kiss_czt.c",
+    "kiss_fastfir.c",
+    "kiss_pfb.c",
+    "kiss_welch.c",
+    "kiss_window.c",
+    "kiss_spectrum.c",
+    "kiss_bands.c",
+    "kiss_peaks.c",
+    "kiss_cfar.c",
+    "kiss_noise.c",
+    "kiss_ddc.c",
+    "kiss_sdft.c",
+    "kiss_goertzel.c",
+    "kfc.c",
+    "data_logger.c",
+    "frame_features.c",
+    "spectrogram.c"
 )
 
 # Clean old build
@@ -48,6 +48,8 @@ void data_logger_init(data_logger_t* logger) {
     logger->auto_record_enabled = false;
     logger->snr_threshold_db = 10.0f;  // Default 10 dB threshold
     logger->format = LOG_FORMAT_BINARY;
+    logger->channels = 1;
+    logger->psd_bins = 128;
     strcpy(logger->log_directory, ".");  // Default to current directory
 #ifdef USE_HDF5
     logger->hdf5_file = -1;
@@ -57,6 +59,19 @@ void data_logger_init(data_logger_t* logger) {
 #endif
 }
 
+void data_logger_set_spectrum(data_logger_t* logger, uint32_t channels, uint32_t spectrum_bins,
+                              uint32_t psd_bins, float first_bin_hz) {
+    logger->channels = channels;
+    logger->spectrum_bins = spectrum_bins;
+    logger->psd_bins = psd_bins;
+    logger->first_bin_hz = first_bin_hz;
+}
+
+// Magnitude values per frame for an FFT of fft_size
+static uint32_t spectrum_bins(const data_logger_t* logger, uint32_t fft_size) {
+    return logger->spectrum_bins ? logger->spectrum_bins : fft_size / 2;
+}
+
 static void get_timestamp_filename(char* buffer, size_t size, const char* prefix, const char* ext) {
     time_t now = time(NULL);
     struct tm tm_buf;
@@ -113,6 +128,10 @@ bool data_logger_start_binary(data_logger_t* logger, const char* filename,
     header.fft_size = fft_size;
     header.sample_rate = sample_rate;
     header.start_time = (uint64_t)time(NULL);
+    header.channels = logger->channels;
+    header.spectrum_bins = spectrum_bins(logger, fft_size);
+    header.psd_bins = logger->psd_bins;
+    header.first_bin_hz = logger->first_bin_hz;
 
     if (fwrite(&header, sizeof(header), 1, logger->file) != 1) {
         fprintf(stderr, "[LOGGER] Failed to write header\n");
@@ -128,7 +147,8 @@ bool data_logger_start_binary(data_logger_t* logger, const char* filename,
     logger->start_time = header.start_time;
 
     printf("[LOGGER] Started binary logging to: %s\n", logger->filepath);
-    printf("[LOGGER] FFT Size: %u, Sample Rate: %u Hz\n", fft_size, sample_rate);
+    printf("[LOGGER] FFT Size: %u, Sample Rate: %u Hz%s\n", fft_size, sample_rate,
+           logger->channels == 2 ? ", I/Q" : "");
 
     return true;
 }
@@ -137,6 +157,7 @@ bool data_logger_write_frame(data_logger_t* logger,
                              const float* signal,
                              const float* magnitude,
                              const float* psd,
+                             const frame_features_t* features,
                              uint64_t timestamp_ms) {
     if (!logger->is_logging) {
         return false;
@@ -157,43 +178,20 @@ bool data_logger_write_frame(data_logger_t* logger,
     }
 
     if (logger->format == LOG_FORMAT_CSV) {
-        // CSV format: calculate summary statistics
-        float signal_avg = 0.0f;
-        float magnitude_peak = 0.0f;
-        float psd_avg = 0.0f;
-
-        if (signal) {
-            for (int i = 0; i < (int)logger->fft_size; i++) {
-                signal_avg += fabsf(signal[i]);
-            }
-            signal_avg /= logger->fft_size;
-        }
-
-        if (magnitude) {
-            for (int i = 0; i < (int)(logger->fft_size / 2); i++) {
-                if (magnitude[i] > magnitude_peak) {
-                    magnitude_peak = magnitude[i];
-                }
-            }
-        }
-
-        if (psd) {
-            for (int i = 0; i < 128; i++) {
-                psd_avg += psd[i];
-            }
-            psd_avg /= 128.0f;
+        // CSV format: the frame's summary, already computed by the analyzer
+        if (!features) {
+            return false;
         }
-
-        // Calculate SNR
-        float snr_db = magnitude ? data_logger_calculate_snr(magnitude, logger->fft_size, logger->sample_rate) : 0.0f;
-
-        // Write CSV line
-        fprintf(logger->file, "%llu,%.6f,%.6f,%.3f,%.2f\n",
+        fprintf(logger->file, "%llu,%.6f,%.6f,%.3f,%.2f,%.1f,%.6f,%.6f,%.1f\n",
                 (unsigned long long)timestamp_ms,
-                signal_avg,
-                magnitude_peak,
-                psd_avg,
-                snr_db);
+                features->mean_abs,
+                features->peak_value,
+                features->psd_mean,
+                features->snr_db,
+                features->peak_freq,
+                features->noise_floor,
+                features->rms,
+                features->centroid);
 
     } else {
         // Binary format
@@ -205,21 +203,22 @@ bool data_logger_write_frame(data_logger_t* logger,
             return false;
         }
 
-        // Write signal data (time domain)
-        if (signal && fwrite(signal, sizeof(float), logger->fft_size, logger->file) != logger->fft_size) {
+        // Write signal data (time domain; interleaved I/Q pairs for 2 channels)
+        size_t signal_size = (size_t)logger->fft_size * logger->channels;
+        if (signal && fwrite(signal, sizeof(float), signal_size, logger->file) != signal_size) {
             fprintf(stderr, "[LOGGER] Failed to write signal data\n");
             return false;
         }
 
         // Write magnitude data (FFT)
-        size_t mag_size = logger->fft_size / 2;
+        size_t mag_size = spectrum_bins(logger, logger->fft_size);
         if (magnitude && fwrite(magnitude, sizeof(float), mag_size, logger->file) != mag_size) {
             fprintf(stderr, "[LOGGER] Failed to write magnitude data\n");
             return false;
         }
 
-        // Write PSD data (128 bins)
-        if (psd && fwrite(psd, sizeof(float), 128, logger->file) != 128) {
+        // Write PSD data
+        if (psd && fwrite(psd, sizeof(float), logger->psd_bins, logger->file) != logger->psd_bins) {
             fprintf(stderr, "[LOGGER] Failed to write PSD data\n");
             return false;
         }
@@ -317,8 +316,10 @@ bool data_logger_start_csv(data_logger_t* logger, const char* filename,
     fprintf(logger->file, "# FFT Size: %u\n", fft_size);
     fprintf(logger->file, "# Sample Rate: %u Hz\n", sample_rate);
     fprintf(logger->file, "# Start Time: %llu\n", (unsigned long long)time(NULL));
-    fprintf(logger->file, "# Format: Timestamp(ms), Signal_Avg, Magnitude_Peak, PSD_Avg, SNR(dB)\n");
-    fprintf(logger->file, "Timestamp_ms,Signal_Avg,Magnitude_Peak,PSD_Avg,SNR_dB\n");
+    fprintf(logger->file, "# Format: Timestamp(ms), Signal_Avg, Magnitude_Peak, PSD_Avg, SNR(dB), "
+                          "Peak(Hz), Noise_Floor, Signal_RMS, Centroid(Hz)\n");
+    fprintf(logger->file, "Timestamp_ms,Signal_Avg,Magnitude_Peak,PSD_Avg,SNR_dB,"
+                          "Peak_Hz,Noise_Floor,Signal_RMS,Centroid_Hz\n");
 
     logger->fft_size = fft_size;
     logger->sample_rate = sample_rate;
@@ -331,40 +332,6 @@ bool data_logger_start_csv(data_logger_t* logger, const char* filename,
     return true;
 }
 
-float data_logger_calculate_snr(const float* magnitude, int size, int sample_rate) {
-    if (!magnitude || size < 2) return 0.0f;
-
-    // Find peak signal (max magnitude)
-    float peak_signal = 0.0f;
-    int peak_bin = 0;
-    for (int i = 1; i < size / 2; i++) {  // Skip DC bin
-        if (magnitude[i] > peak_signal) {
-            peak_signal = magnitude[i];
-            peak_bin = i;
-        }
-    }
-
-    // Estimate noise floor (average of bins away from peak)
-    float noise_sum = 0.0f;
-    int noise_count = 0;
-    int exclusion_bins = 5;  // Exclude bins near peak
-
-    for (int i = 1; i < size / 2; i++) {
-        if (abs(i - peak_bin) > exclusion_bins) {
-            noise_sum += magnitude[i];
-            noise_count++;
-        }
-    }
-
-    float noise_floor = (noise_count > 0) ? (noise_sum / noise_count) : 1e-10f;
-
-    // Calculate SNR in dB
-    float snr_linear = peak_signal / (noise_floor + 1e-10f);
-    float snr_db = 20.0f * log10f(snr_linear + 1e-10f);
-
-    return snr_db;
-}
-
 void data_logger_set_auto_record(data_logger_t* logger, bool enabled, float snr_threshold_db) {
     logger->auto_record_enabled = enabled;
     logger->snr_threshold_db = snr_threshold_db;
@@ -463,6 +430,18 @@ bool data_logger_start_hdf5(data_logger_t* logger, const char* filename,
         H5Awrite(attr, H5T_NATIVE_UINT32, &sample_rate);
         H5Aclose(attr);
 
+        // Frame layout (as in the binary header)
+        uint32_t bins = spectrum_bins(logger, fft_size);
+        attr = H5Acreate2(metadata_group, "channels", H5T_NATIVE_UINT32, dataspace, H5P_DEFAULT, H5P_DEFAULT);
+        H5Awrite(attr, H5T_NATIVE_UINT32, &logger->channels);
+        H5Aclose(attr);
+        attr = H5Acreate2(metadata_group, "spectrum_bins", H5T_NATIVE_UINT32, dataspace, H5P_DEFAULT, H5P_DEFAULT);
+        H5Awrite(attr, H5T_NATIVE_UINT32, &bins);
+        H5Aclose(attr);
+        attr = H5Acreate2(metadata_group, "first_bin_hz", H5T_NATIVE_FLOAT, dataspace, H5P_DEFAULT, H5P_DEFAULT);
+        H5Awrite(attr, H5T_NATIVE_FLOAT, &logger->first_bin_hz);
+        H5Aclose(attr);
+
         // Start time
         uint64_t start_time = (uint64_t)time(NULL);
         attr = H5Acreate2(metadata_group, "start_time", H5T_NATIVE_UINT64, dataspace, H5P_DEFAULT, H5P_DEFAULT);
@@ -478,10 +457,10 @@ bool data_logger_start_hdf5(data_logger_t* logger, const char* filename,
     hsize_t max_dims[2] = {H5S_UNLIMITED, 0};
     hsize_t chunk_dims[2] = {10, 0};  // 10 frames per chunk
 
-    // Signal dataset (time domain)
-    init_dims[1] = fft_size;
-    max_dims[1] = fft_size;
-    chunk_dims[1] = fft_size;
+    // Signal dataset (time domain; interleaved I/Q pairs for 2 channels)
+    init_dims[1] = fft_size * logger->channels;
+    max_dims[1] = fft_size * logger->channels;
+    chunk_dims[1] = fft_size * logger->channels;
     hid_t signal_space = H5Screate_simple(2, init_dims, max_dims);
     hid_t signal_prop = H5Pcreate(H5P_DATASET_CREATE);
     H5Pset_chunk(signal_prop, 2, chunk_dims);
@@ -492,9 +471,9 @@ bool data_logger_start_hdf5(data_logger_t* logger, const char* filename,
     H5Sclose(signal_space);
 
     // Magnitude dataset (FFT)
-    init_dims[1] = fft_size / 2;
-    max_dims[1] = fft_size / 2;
-    chunk_dims[1] = fft_size / 2;
+    init_dims[1] = spectrum_bins(logger, fft_size);
+    max_dims[1] = spectrum_bins(logger, fft_size);
+    chunk_dims[1] = spectrum_bins(logger, fft_size);
     hid_t mag_space = H5Screate_simple(2, init_dims, max_dims);
     hid_t mag_prop = H5Pcreate(H5P_DATASET_CREATE);
     H5Pset_chunk(mag_prop, 2, chunk_dims);
@@ -505,9 +484,9 @@ bool data_logger_start_hdf5(data_logger_t* logger, const char* filename,
     H5Sclose(mag_space);
 
     // PSD dataset
-    init_dims[1] = 128;
-    max_dims[1] = 128;
-    chunk_dims[1] = 128;
+    init_dims[1] = logger->psd_bins;
+    max_dims[1] = logger->psd_bins;
+    chunk_dims[1] = logger->psd_bins;
     hid_t psd_space = H5Screate_simple(2, init_dims, max_dims);
     hid_t psd_prop = H5Pcreate(H5P_DATASET_CREATE);
     H5Pset_chunk(psd_prop, 2, chunk_dims);
@@ -542,12 +521,12 @@ static bool hdf5_write_frame(data_logger_t* logger, const float* signal,
 
     // Write signal
     if (signal) {
-        new_dims[1] = logger->fft_size;
+        new_dims[1] = logger->fft_size * logger->channels;
         H5Dset_extent(logger->hdf5_signal_dset, new_dims);
         hid_t filespace = H5Dget_space(logger->hdf5_signal_dset);
         offset[0] = logger->frame_count;
         offset[1] = 0;
-        count[1] = logger->fft_size;
+        count[1] = logger->fft_size * logger->channels;
         H5Sselect_hyperslab(filespace, H5S_SELECT_SET, offset, NULL, count, NULL);
         hid_t memspace = H5Screate_simple(2, count, NULL);
         H5Dwrite(logger->hdf5_signal_dset, H5T_NATIVE_FLOAT, memspace, filespace, H5P_DEFAULT, signal);
@@ -557,12 +536,12 @@ static bool hdf5_write_frame(data_logger_t* logger, const float* signal,
 
     // Write magnitude
     if (magnitude) {
-        new_dims[1] = logger->fft_size / 2;
+        new_dims[1] = spectrum_bins(logger, logger->fft_size);
         H5Dset_extent(logger->hdf5_magnitude_dset, new_dims);
         hid_t filespace = H5Dget_space(logger->hdf5_magnitude_dset);
         offset[0] = logger->frame_count;
         offset[1] = 0;
-        count[1] = logger->fft_size / 2;
+        count[1] = spectrum_bins(logger, logger->fft_size);
         H5Sselect_hyperslab(filespace, H5S_SELECT_SET, offset, NULL, count, NULL);
         hid_t memspace = H5Screate_simple(2, count, NULL);
         H5Dwrite(logger->hdf5_magnitude_dset, H5T_NATIVE_FLOAT, memspace, filespace, H5P_DEFAULT, magnitude);
@@ -572,12 +551,12 @@ static bool hdf5_write_frame(data_logger_t* logger, const float* signal,
 
     // Write PSD
     if (psd) {
-        new_dims[1] = 128;
+        new_dims[1] = logger->psd_bins;
         H5Dset_extent(logger->hdf5_psd_dset, new_dims);
         hid_t filespace = H5Dget_space(logger->hdf5_psd_dset);
         offset[0] = logger->frame_count;
         offset[1] = 0;
-        count[1] = 128;
+        count[1] = logger->psd_bins;
         H5Sselect_hyperslab(filespace, H5S_SELECT_SET, offset, NULL, count, NULL);
         hid_t memspace = H5Screate_simple(2, count, NULL);
         H5Dwrite(logger->hdf5_psd_dset, H5T_NATIVE_FLOAT, memspace, filespace, H5P_DEFAULT, psd);
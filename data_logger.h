@@ -13,6 +13,8 @@
 #include <stdbool.h>
 #include <time.h>
 
+#include "frame_features.h"
+
 /*===========================================================================
  * Binary Format Specification
  *===========================================================================
@@ -23,17 +25,25 @@
  *   - FFT Size: uint32_t (4 bytes)
  *   - Sample Rate: uint32_t (4 bytes)
  *   - Start Time (Unix): uint64_t (8 bytes)
- *   - Reserved: (36 bytes)
+ *   - Channels: uint32_t (4 bytes, 1 real, 2 interleaved I/Q)
+ *   - Spectrum Bins: uint32_t (4 bytes)
+ *   - PSD Bins: uint32_t (4 bytes)
+ *   - First Bin: float (4 bytes, Hz of magnitude[0])
+ *   - Reserved: (20 bytes)
+ *
+ * Version 1 files have the four fields after the start time zeroed; read
+ * them as 1 channel, fft_size/2 spectrum bins, 128 PSD bins from 0 Hz.
  *
  * Data Frame (variable size):
  *   - Timestamp: uint64_t (8 bytes, milliseconds since epoch)
- *   - Signal: float[fft_size] (time domain data)
- *   - Magnitude: float[fft_size/2] (FFT magnitude)
- *   - PSD: float[128] (power spectral density in dB)
+ *   - Signal: float[fft_size * channels] (time domain data)
+ *   - Magnitude: float[spectrum_bins] (FFT magnitude; two-sided and
+ *     fftshifted for I/Q, bin k at first_bin + k * sample_rate / fft_size)
+ *   - PSD: float[psd_bins] (power spectral density in dB, same span)
  */
 
 #define DATA_LOGGER_MAGIC "FFTLOG01"
-#define DATA_LOGGER_VERSION 1
+#define DATA_LOGGER_VERSION 2
 
 typedef struct {
     char magic[8];
@@ -41,15 +51,19 @@ typedef struct {
     uint32_t fft_size;
     uint32_t sample_rate;
     uint64_t start_time;
-    uint8_t reserved[36];
+    uint32_t channels;
+    uint32_t spectrum_bins;
+    uint32_t psd_bins;
+    float first_bin_hz;
+    uint8_t reserved[20];
 } __attribute__((packed)) data_logger_header_t;
 
 typedef struct {
     uint64_t timestamp_ms;
     // Followed by variable-length data:
-    // float signal[fft_size]
-    // float magnitude[fft_size/2]
-    // float psd[128]
+    // float signal[fft_size * channels]
+    // float magnitude[spectrum_bins]
+    // float psd[psd_bins]
 } __attribute__((packed)) data_frame_header_t;
 
 typedef enum {
@@ -67,6 +81,10 @@ typedef struct {
     char log_directory[256];
     uint32_t fft_size;
     uint32_t sample_rate;
+    uint32_t channels;          // Signal values per sample (2 for I/Q)
+    uint32_t spectrum_bins;     // Magnitude values per frame (0: fft_size/2)
+    uint32_t psd_bins;
+    float first_bin_hz;         // Hz of magnitude[0]
     uint64_t frame_count;
     uint64_t start_time;
     log_format_t format;
@@ -83,6 +101,13 @@ typedef struct {
  */
 void data_logger_init(data_logger_t* logger);
 
+/**
+ * Frame layout of later logs (the default is real input: 1 channel,
+ * fft_size/2 bins from 0 Hz and 128 PSD bins); set it while not logging
+ */
+void data_logger_set_spectrum(data_logger_t* logger, uint32_t channels, uint32_t spectrum_bins,
+                              uint32_t psd_bins, float first_bin_hz);
+
 /**
  * Start logging to binary file
  * Returns: true on success, false on error
@@ -92,11 +117,14 @@ bool data_logger_start_binary(data_logger_t* logger, const char* filename,
 
 /**
  * Log a single frame of data
+ * CSV rows are written from features (required for CSV); binary and HDF5
+ * frames store the arrays
  */
 bool data_logger_write_frame(data_logger_t* logger,
                              const float* signal,
                              const float* magnitude,
                              const float* psd,
+                             const frame_features_t* features,
                              uint64_t timestamp_ms);
 
 /**
@@ -134,12 +162,6 @@ void data_logger_set_auto_record(data_logger_t* logger, bool enabled, float snr_
 bool data_logger_check_auto_trigger(data_logger_t* logger, float current_snr_db,
                                     uint32_t fft_size, uint32_t sample_rate);
 
-/**
- * Calculate SNR from magnitude data
- * Returns: SNR in dB
- */
-float data_logger_calculate_snr(const float* magnitude, int size, int sample_rate);
-
 /**
  * Set log directory for saving files
  * If NULL or empty, uses current directory
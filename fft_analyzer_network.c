@@ -35,8 +35,25 @@
 #endif
 
 #include "kiss_fft.h"
+#include "kiss_fft_wisdom.h"
+#include "kiss_fftr.h"
+#include "kiss_czt.h"
+#include "kiss_sdft.h"
+#include "kiss_goertzel.h"
+#include "kiss_fastfir.h"
+#include "kiss_pfb.h"
+#include "kiss_welch.h"
+#include "kiss_window.h"
+#include "kiss_spectrum.h"
+#include "kiss_bands.h"
+#include "kiss_peaks.h"
+#include "kiss_cfar.h"
+#include "kiss_ddc.h"
+#include "kfc.h"
 #include "web_server.h"
 #include "data_logger.h"
+#include "frame_features.h"
+#include "spectrogram.h"
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
@@ -57,16 +74,44 @@
 
 #define FFT_SIZE            512
 #define SAMPLE_RATE         8000
-#define NUM_BANDS           8
 #define UPDATE_RATE_MS      50
 #define DEFAULT_LOG_DIR     "logs"
+#define DEFAULT_WISDOM_FILE "fft_wisdom.txt"
 
-static const float BAND_EDGES[NUM_BANDS + 1] = {
+// Band set used unless --bands or /api/bands picks another
+#define DEFAULT_NUM_BANDS   8
+static const float DEFAULT_BAND_EDGES[DEFAULT_NUM_BANDS + 1] = {
     0, 200, 400, 600, 800, 1200, 1600, 2400, 4000
 };
 
+#define MAX_BANDS           4096
+#define OCTAVE_BANDS_LOW_HZ 20.0    // lowest mid-band frequency of octave:N sets
+
 #define LED_THRESHOLD_LOW   0.01f
 
+// Alarm bands are read from the network in chunks of this many samples
+#define ALARM_CHUNK_SAMPLES 32
+
+#define MAX_GOERTZEL_TONES  16
+#define FIR_DEFAULT_TAPS    511
+#define FIR_MAX_TAPS        65536
+#define MAX_CHANNELS        256
+#define PSD_DEFAULT_AVERAGE 8       // frames in the exponential Welch average
+#define PSD_FLOOR_DB        -100.0f
+#define PEAK_MAX_PEAKS      32      // strongest peaks kept per frame
+#define PEAK_MAX_TRACKS     64
+#define PEAK_THRESHOLD_DB   20.0f   // above the frame's noise floor
+#define PEAK_MAX_JUMP_BINS  2.0f    // furthest a track moves between frames
+#define PEAK_MAX_MISSED     3       // frames a track coasts without a peak
+#define CFAR_GUARD_BINS     2       // each side of the bin under test
+#define CFAR_TRAIN_BINS     12      // noise cells each side, past the guard bins
+#define CFAR_DEFAULT_PFA    1e-4    // false alarms per bin on noise
+#define MAX_DETECTIONS      32
+#define SPECTROGRAM_FRAMES  600     // 30 s of history at UPDATE_RATE_MS
+#define SPECTROGRAM_MAX_FRAMES 12000 // 10 min; --history is capped here
+#define DDC_MAX_DECIM       4096    // network input up to SAMPLE_RATE * this
+#define DDC_DEFAULT_ORDER   4
+
 /*===========================================================================
  * Network Configuration
  *===========================================================================*/
@@ -112,6 +157,7 @@ static data_logger_t g_data_logger = {0};
 
 // Mode control
 static volatile int g_requested_mode = 0;  // Default to network input
+static volatile int g_requested_window = -1;  // Window type from the web API, -1 if none pending
 
 /*===========================================================================
  * Signal Handler
@@ -370,76 +416,1226 @@ void generate_signal_noise(float* buffer, int size) {
  * DSP Functions (from your existing code)
  *===========================================================================*/
 
-void compute_fft(const float* input, float* magnitude, int size) {
-    kiss_fft_cfg cfg = kiss_fft_alloc(size, 0, NULL, NULL);
-    kiss_fft_cpx* fft_in = (kiss_fft_cpx*)malloc(size * sizeof(kiss_fft_cpx));
-    kiss_fft_cpx* fft_out = (kiss_fft_cpx*)malloc(size * sizeof(kiss_fft_cpx));
+// FFT plans come from the kfc cache and the spectrum work buffer persists
+// across frames, so the steady-state loop does no plan builds or heap traffic.
+// Real input goes through the real-input transform (kiss_fftr): it runs an
+// N/2 complex FFT and reads the samples in place without packing.  IQ input
+// takes the full complex transform (compute_fft_iq).
+static kiss_fft_cpx* g_fft_out = NULL;
+static int g_fft_work_size = 0;
+
+// Grow the shared spectrum buffer to hold at least 'bins' complex values.
+// The buffer and g_fft_work_size change together, so a failed grow leaves
+// the old buffer and its size valid.
+static bool fft_work_reserve(int bins) {
+    if (bins <= g_fft_work_size) {
+        return true;
+    }
 
-    for (int i = 0; i < size; i++) {
-        fft_in[i].r = input[i];
-        fft_in[i].i = 0.0f;
+    kiss_fft_cpx* fft_out = (kiss_fft_cpx*)realloc(g_fft_out, bins * sizeof(kiss_fft_cpx));
+    if (!fft_out) {
+        return false;
+    }
+    g_fft_out = fft_out;
+    g_fft_work_size = bins;
+    return true;
+}
+
+// Band set: the g_num_bands bands between g_band_edges (Hz).  Every band
+// comes out of one running sum over the frame's power spectrum, so the
+// cost per frame hardly depends on how many bands there are.
+static kiss_bands_cfg g_bands_cfg = NULL;
+static int g_num_bands = 0;
+static float g_band_edges[MAX_BANDS + 1];
+static float g_requested_edges[MAX_BANDS + 1];  // band set from the web API
+static volatile int g_requested_num_bands = 0;  // 0 if none pending
+
+// Chirp-z plan for the zoom view; rebuilt only when the requested band changes
+static kiss_czt_cfg g_zoom_cfg = NULL;
+static int g_zoom_size = 0;
+static int g_zoom_bins = 0;
+static float g_zoom_f_low = 0.0f;
+static float g_zoom_f_high = 0.0f;
+
+// Alarm bands: a sliding DFT over the last FFT_SIZE samples tracks every bin
+// of the selected bands one sample at a time, so their energies and the
+// auto-record trigger follow the input instead of waiting for a whole frame.
+// The sliding bins are unwindowed; the analysis window is applied to them
+// as its kernel over neighbouring bins, so the sdft also tracks the bins
+// within KISS_WINDOW_MAX_TAPS - 1 of each band bin.
+static kiss_sdft_cfg g_alarm_sdft = NULL;
+static bool g_alarm_band[MAX_BANDS] = {false};
+static int g_alarm_bin_list[FFT_SIZE / 2 + 1];  // spectrum bin of each sdft bin
+static int g_alarm_slot[FFT_SIZE / 2 + 1];      // sdft bin of each spectrum bin, or -1
+static int g_alarm_band_bins[FFT_SIZE / 2];     // spectrum bins of the alarm bands
+static float g_alarm_power[FFT_SIZE / 2];       // windowed power at those bins, 0 elsewhere
+static float g_alarm_band_power[MAX_BANDS];
+static int g_alarm_bins = 0;
+static int g_alarm_num_band_bins = 0;
+static float g_alarm_noise_floor = 0.0f;
+
+// Goertzel bank mode: only the bins of the selected bands and the listed
+// tones are evaluated, and the frame FFT and Welch PSD are skipped.  Tones
+// land on their exact frequency.
+// g_goertzel_mags holds a 0 in slot 0 (where a DC bin would be) and then
+// every evaluated magnitude, so it can stand in for a spectrum (at the
+// frequencies in g_goertzel_freqs) in the frame features.
+static kiss_goertzel_cfg g_goertzel_cfg = NULL;
+static int g_goertzel_bins[FFT_SIZE / 2];   // spectrum bin of each band entry
+static int g_goertzel_num_bins = 0;
+static int g_goertzel_num_tones = 0;
+static float g_goertzel_tone_freqs[MAX_GOERTZEL_TONES];
+static float g_goertzel_power[FFT_SIZE / 2 + MAX_GOERTZEL_TONES];
+static float g_goertzel_mags[1 + FFT_SIZE / 2 + MAX_GOERTZEL_TONES];
+static float g_goertzel_freqs[1 + FFT_SIZE / 2 + MAX_GOERTZEL_TONES];  // Hz of each slot
+
+// Optional FIR stage (overlap-save) between the sample source and the
+// analysis.  The filter spectrum is computed once; the block size covers a
+// whole frame plus the filter length, so each frame costs one real FFT and
+// one inverse FFT however many taps there are.
+static kiss_fastfir_cfg g_fir_cfg = NULL;
+static int g_fir_taps = 0;
+
+// Streaming Welch PSD: segments run on across frame boundaries, each is
+// transformed once, and the estimate is averaged over many frames.  NULL
+// means the per-frame estimate (only the segments inside this frame).
+static kiss_welch_cfg g_welch_cfg = NULL;
+
+// Analysis window of the frame spectrum and the Welch segments.  Tables
+// come from the kiss_window cache, so a frame only looks one up.
+static kiss_window_type g_window_type = KISS_WINDOW_HANN;
+
+// Optional polyphase channelizer after the FIR stage: K channels of
+// SAMPLE_RATE/K Hz each, one output (one K-point real FFT) per D input
+// samples.  g_channel_power is each channel's mean power over the last
+// frame; the raw channel samples can be streamed to a file.
+static kiss_pfb_cfg g_pfb_cfg = NULL;
+static int g_pfb_channels = 0;
+static int g_pfb_decim = 0;
+static kiss_fft_cpx* g_pfb_out = NULL;      // FFT_SIZE/D + 1 hops of K/2+1 channels
+static float g_channel_freqs[MAX_CHANNELS / 2 + 1];
+static float g_channel_power[MAX_CHANNELS / 2 + 1];
+static FILE* g_channel_log = NULL;
+
+// Spectral peak tracker on the FFT spectrum: the strongest local maxima
+// PEAK_THRESHOLD_DB above the noise floor, placed between bins and followed
+// from frame to frame.  The tracks can be streamed to a file.
+static kiss_peaks_cfg g_peaks_cfg = NULL;
+static kiss_peak g_peaks[PEAK_MAX_PEAKS];
+static peak_track_t g_peak_tracks[PEAK_MAX_TRACKS];
+static int g_num_peak_tracks = 0;
+static FILE* g_peak_log = NULL;
+
+// CFAR detector on the FFT spectrum: every bin against the noise around it,
+// for the auto-record trigger and the web UI.  Adjacent detected bins make
+// one detection, reported at its strongest bin.
+static kiss_cfar_cfg g_cfar_cfg = NULL;
+static float g_cfar_power[FFT_SIZE];
+static float g_cfar_noise[FFT_SIZE];
+static int g_cfar_hits[FFT_SIZE];
+static cfar_detection_t g_detections[MAX_DETECTIONS];
+static int g_num_detections = 0;
+
+// With --cfar global, one threshold for every bin over the frame's noise
+// floor instead (for comparison; g_cfar_cfg stays NULL)
+static bool g_cfar_global = false;
+static double g_cfar_global_scale = 0.0;
+
+// The last frames' magnitude and PSD spectra in dB, for /api/waterfall
+// (FFT mode only; preallocated, nothing is allocated per frame)
+static spectrogram_t g_spectrogram;
+static spectrogram_t g_psd_history;
+
+// Noise floor estimator behind the frame SNR, the peak threshold and the
+// alarm bands' noise reference
+static frame_noise_method_t g_noise_method = FRAME_NOISE_MEAN;
+
+// Optional digital downconverter on the network input: the stream arrives
+// at SAMPLE_RATE * g_ddc_decim, and the slice around g_ddc_center_hz is
+// brought down to SAMPLE_RATE with its centre at SAMPLE_RATE/4, so the rest
+// of the pipeline runs unchanged.  A frame reads FFT_SIZE * g_ddc_decim
+// samples into g_ddc_in; one output left over from a read is carried over.
+static kiss_ddc_cfg g_ddc_cfg = NULL;
+static int g_ddc_decim = 0;
+static double g_ddc_center_hz = 0.0;
+static float* g_ddc_in = NULL;
+static float g_ddc_out[FFT_SIZE + 1];
+static int g_ddc_carry = 0;
+
+// IQ input (--iq): the network delivers interleaved float32 I/Q pairs,
+// read straight into g_iq_buffer (kiss_fft_cpx is the same two floats), and
+// the spectrum is two-sided: FFT_SIZE bins from -SAMPLE_RATE/2 up, in
+// fftshift order.  Everything past the FFT reads g_spectrum_bins bins, the
+// first at g_spectrum_f0 Hz, instead of assuming 0 to Nyquist.
+static bool g_iq = false;
+static kiss_fft_cpx g_iq_buffer[FFT_SIZE];
+static int g_spectrum_bins = FFT_SIZE / 2;
+static float g_spectrum_f0 = 0.0f;
+static float g_spectrum_freqs[FFT_SIZE];    // Hz of each bin (IQ input only)
+static int g_psd_bins = 128;                // Welch bins: half a segment, all of it for IQ
+static bool g_welch_per_frame = false;      // IQ: the streaming cfg restarts every frame
+
+void peaks_cleanup(void) {
+    kiss_peaks_free(g_peaks_cfg);
+    g_peaks_cfg = NULL;
+    g_num_peak_tracks = 0;
+    if (g_peak_log) {
+        fclose(g_peak_log);
+        g_peak_log = NULL;
+    }
+}
+
+void channelizer_cleanup(void) {
+    kiss_pfb_free(g_pfb_cfg);
+    g_pfb_cfg = NULL;
+    free(g_pfb_out);
+    g_pfb_out = NULL;
+    g_pfb_channels = 0;
+    if (g_channel_log) {
+        fclose(g_channel_log);
+        g_channel_log = NULL;
+    }
+}
+
+void ddc_cleanup(void) {
+    kiss_ddc_free(g_ddc_cfg);
+    g_ddc_cfg = NULL;
+    free(g_ddc_in);
+    g_ddc_in = NULL;
+    g_ddc_decim = 0;
+    g_ddc_carry = 0;
+}
+
+void dsp_cleanup(void) {
+    free(g_fft_out);
+    g_fft_out = NULL;
+    g_fft_work_size = 0;
+    kiss_czt_free(g_zoom_cfg);
+    g_zoom_cfg = NULL;
+    g_zoom_bins = 0;
+    kiss_sdft_free(g_alarm_sdft);
+    g_alarm_sdft = NULL;
+    kiss_goertzel_free(g_goertzel_cfg);
+    g_goertzel_cfg = NULL;
+    kiss_fastfir_free(g_fir_cfg);
+    g_fir_cfg = NULL;
+    kiss_welch_free(g_welch_cfg);
+    g_welch_cfg = NULL;
+    kiss_bands_free(g_bands_cfg);
+    g_bands_cfg = NULL;
+    g_num_bands = 0;
+    channelizer_cleanup();
+    ddc_cleanup();
+    peaks_cleanup();
+    kiss_cfar_free(g_cfar_cfg);
+    g_cfar_cfg = NULL;
+    g_num_detections = 0;
+    spectrogram_cleanup(&g_spectrogram);
+    spectrogram_cleanup(&g_psd_history);
+    kiss_window_cleanup();
+    kfc_cleanup();
+    kiss_fft_wisdom_forget();
+}
+
+// magnitude_db (optional) gets 20*log10(magnitude + 1e-6), the web reference
+void compute_fft(const float* input, float* magnitude, float* magnitude_db, int size) {
+    kiss_fftr_cfg cfg = kfc_getcfgr(size, 0);
+    const kiss_window* window = kiss_window_get(g_window_type, size);
+    if (!cfg || !window || !fft_work_reserve(size / 2 + 1)) {
+        fprintf(stderr, "[ERROR] FFT setup failed (size %d)\n", size);
+        memset(magnitude, 0, (size / 2) * sizeof(float));
+        if (magnitude_db) {
+            memset(magnitude_db, 0, (size / 2) * sizeof(float));
+        }
+        return;
+    }
+
+    // The window is applied as the input is packed for the transform
+    kiss_fftr_windowed(cfg, input, window->w, g_fft_out);
+
+    // Divide out the coherent gain so a tone reads the same under every
+    // window; magnitudes and their dB come out of one vectorized pass
+    const float scale = (float)(1.0 / window->coherent_gain);
+    kiss_spectrum_mag_db(g_fft_out, size / 2, scale, 1e-6f, magnitude, magnitude_db);
+}
+
+// Zoomed spectrum: 'bins' magnitudes evenly spaced over [freq_low, freq_high] Hz.
+// The chirp-z transform evaluates the same sum as a full-band FFT at any bin
+// spacing for the cost of two FFTs of size ~(size + bins).
+bool compute_zoom(const float* input, int size, float freq_low, float freq_high,
+                  int bins, float* magnitude) {
+    if (bins < 2 || freq_high <= freq_low) {
+        return false;
+    }
+
+    if (!g_zoom_cfg || g_zoom_size != size || g_zoom_bins != bins ||
+        g_zoom_f_low != freq_low || g_zoom_f_high != freq_high) {
+        double f0 = (double)freq_low / SAMPLE_RATE;
+        double df = ((double)freq_high - freq_low) / (bins - 1) / SAMPLE_RATE;
+
+        kiss_czt_free(g_zoom_cfg);
+        g_zoom_cfg = kiss_czt_alloc(size, bins, f0, df, NULL, NULL);
+        if (!g_zoom_cfg) {
+            g_zoom_bins = 0;
+            return false;
+        }
+        g_zoom_size = size;
+        g_zoom_bins = bins;
+        g_zoom_f_low = freq_low;
+        g_zoom_f_high = freq_high;
+    }
+
+    if (!fft_work_reserve(bins)) {
+        return false;
+    }
+
+    if (g_iq) {
+        // size interleaved I/Q pairs
+        kiss_czt(g_zoom_cfg, (const kiss_fft_cpx*)input, g_fft_out);
+    } else {
+        kiss_czt_real(g_zoom_cfg, input, g_fft_out);
+    }
+
+    for (int i = 0; i < bins; i++) {
+        magnitude[i] = sqrtf(g_fft_out[i].r * g_fft_out[i].r +
+                            g_fft_out[i].i * g_fft_out[i].i);
+    }
+    return true;
+}
+
+#define WELCH_SEGMENT_SIZE  256
+#define WELCH_NUM_BINS      (WELCH_SEGMENT_SIZE / 2)
+
+// average_frames < 0: per-frame estimate; 0: mean of every segment since
+// the last reset; N > 0: exponential average over about N frames.  IQ
+// input always runs the complex streaming cfg, restarted every frame for
+// the per-frame estimate.
+bool welch_init(int average_frames) {
+    const int hop = WELCH_SEGMENT_SIZE / 2;
+    const int tau = average_frames > 0 ? average_frames * (FFT_SIZE / hop) : 0;
+
+    kiss_welch_free(g_welch_cfg);
+    g_welch_cfg = NULL;
+    g_welch_per_frame = g_iq && average_frames < 0;
+    if (average_frames < 0 && !g_iq) {
+        return true;
+    }
+    g_welch_cfg = g_iq ? kiss_welch_alloc_cpx(WELCH_SEGMENT_SIZE, hop, tau, NULL, NULL) :
+                         kiss_welch_alloc(WELCH_SEGMENT_SIZE, hop, tau, NULL, NULL);
+    if (!g_welch_cfg) {
+        return false;
+    }
+    const kiss_window* window = kiss_window_get(g_window_type, WELCH_SEGMENT_SIZE);
+    if (!window) {
+        return false;
+    }
+    kiss_welch_set_window(g_welch_cfg, window->w);
+    return true;
+}
+
+// Start the average over, e.g. when the input switches to another signal
+void welch_reset(void) {
+    if (g_welch_cfg) {
+        kiss_welch_reset(g_welch_cfg);
+    }
+}
+
+// Switch the analysis window of the spectrum and PSD.  The streaming Welch
+// average restarts, since segments under different windows must not mix.
+bool window_select(kiss_window_type type) {
+    const kiss_window* window = kiss_window_get(type, WELCH_SEGMENT_SIZE);
+    if (!window || !kiss_window_get(type, FFT_SIZE)) {
+        return false;
     }
+    g_window_type = type;
+    if (g_welch_cfg) {
+        kiss_welch_set_window(g_welch_cfg, window->w);
+    }
+    return true;
+}
 
-    kiss_fft(cfg, fft_in, fft_out);
+// |X|^2 of a Welch segment divided by this is the mean square per bin.
+// segment^2 without a window; segment * sum(w^2) with one keeps the noise
+// floor in place (a tone's peak drops by the window's ENBW instead).
+static float welch_power_scale(void) {
+    const kiss_window* window = kiss_window_get(g_window_type, WELCH_SEGMENT_SIZE);
+    double gain = window ? window->coherent_gain * window->coherent_gain * window->enbw : 1.0;
+    return (float)((double)WELCH_SEGMENT_SIZE * WELCH_SEGMENT_SIZE * gain);
+}
+
+// Streaming estimate: feed the frame, read back the running average
+static void compute_psd_welch_stream(const float* signal, float* psd, int fft_size) {
+    float power[WELCH_NUM_BINS + 1];
 
-    for (int i = 0; i < size / 2; i++) {
-        magnitude[i] = sqrtf(fft_out[i].r * fft_out[i].r +
-                            fft_out[i].i * fft_out[i].i);
+    kiss_welch(g_welch_cfg, signal, fft_size);
+    if (kiss_welch_psd(g_welch_cfg, power) == 0) {
+        for (int i = 0; i < WELCH_NUM_BINS; i++) {
+            psd[i] = PSD_FLOOR_DB;
+        }
+        return;
     }
 
-    free(fft_in);
-    free(fft_out);
-    kiss_fft_free(cfg);
+    // Same normalization and dB reference as the per-frame estimate
+    kiss_spectrum_db(power, WELCH_NUM_BINS, 1.0f / welch_power_scale(), 1e-10f, 10.0f, psd);
 }
 
-void compute_psd_welch(const float* signal, float* psd, int fft_size, int sample_rate) {
-    const int segment_size = 256;
+void compute_psd_welch(const float* signal, float* psd, int fft_size) {
+    const int segment_size = WELCH_SEGMENT_SIZE;
     const int overlap = segment_size / 2;
-    const int num_bins = segment_size / 2;
+    const int num_bins = WELCH_NUM_BINS;
+    const int segment_bins = segment_size / 2 + 1;
+    const int num_segments = (fft_size - segment_size) / overlap + 1;
 
-    float* segment = (float*)malloc(segment_size * sizeof(float));
-    float* segment_psd = (float*)malloc(num_bins * sizeof(float));
-    float* accumulated_psd = (float*)calloc(num_bins, sizeof(float));
+    float accumulated_psd[WELCH_NUM_BINS] = {0};
 
-    int num_segments = 0;
+    if (g_welch_cfg) {
+        compute_psd_welch_stream(signal, psd, fft_size);
+        return;
+    }
+
+    // The segments go after the frame spectrum, which the peak tracker reads
+    const int spectrum_bins = fft_size / 2 + 1;
+    kiss_fftr_cfg cfg = kfc_getcfgr(segment_size, 0);
+    const kiss_window* window = kiss_window_get(g_window_type, segment_size);
+    if (!cfg || !window || num_segments <= 0 ||
+        !fft_work_reserve(spectrum_bins + num_segments * segment_bins)) {
+        fprintf(stderr, "[ERROR] Welch PSD setup failed (size %d)\n", fft_size);
+        memset(psd, 0, num_bins * sizeof(float));
+        return;
+    }
 
-    for (int start = 0; start <= fft_size - segment_size; start += overlap) {
-        memcpy(segment, signal + start, segment_size * sizeof(float));
-        compute_fft(segment, segment_psd, segment_size);
+    // All overlapping segments go through one kiss_fftr_batch call, windowed
+    // as they are packed
+    kiss_fftr_batch_windowed(cfg, num_segments, signal, overlap, window->w,
+                             g_fft_out + spectrum_bins, segment_bins);
 
+    for (int seg = 0; seg < num_segments; seg++) {
+        const kiss_fft_cpx* spectrum = g_fft_out + spectrum_bins + seg * segment_bins;
         for (int i = 0; i < num_bins; i++) {
-            accumulated_psd[i] += segment_psd[i] * segment_psd[i];
+            accumulated_psd[i] += spectrum[i].r * spectrum[i].r +
+                                  spectrum[i].i * spectrum[i].i;
+        }
+    }
+
+    // Average, normalize by segment size (and window power) to get proper
+    // PSD, and convert to dB relative to reference (1.0)
+    kiss_spectrum_db(accumulated_psd, num_bins, 1.0f / (num_segments * welch_power_scale()),
+                     1e-10f, 10.0f, psd);
+}
+
+// Load the FFT plans tuned on an earlier run, or tune the sizes the frame
+// path uses and save them.  Must run before the first plan is cached.
+void dsp_load_wisdom(const char* path, bool retune) {
+    // kiss_fftr of size n runs a complex transform of size n/2; IQ input
+    // runs the full size
+    const int sizes[] = { g_iq ? FFT_SIZE : FFT_SIZE / 2,
+                          g_iq ? WELCH_SEGMENT_SIZE : WELCH_SEGMENT_SIZE / 2 };
+    const int num_sizes = (int)(sizeof(sizes) / sizeof(sizes[0]));
+    int missing = 0;
+
+    if (!retune && kiss_fft_wisdom_load(path) >= 0) {
+        for (int i = 0; i < num_sizes; i++) {
+            if (!kiss_fft_wisdom_has(sizes[i])) {
+                missing++;
+            }
+        }
+        if (missing == 0) {
+            printf("[OK] FFT plans loaded from %s\n", path);
+            return;
+        }
+    }
+
+    printf("[*] Tuning FFT plans for this CPU...\n");
+    for (int i = 0; i < num_sizes; i++) {
+        char plan[64];
+        if (!retune && kiss_fft_wisdom_has(sizes[i])) {
+            continue;
+        }
+        if (kiss_fft_tune(sizes[i]) == 0 && kiss_fft_wisdom_describe(sizes[i], plan, sizeof(plan))) {
+            printf("    %d-pt: %s\n", sizes[i], plan);
+        }
+    }
+    if (kiss_fft_wisdom_save(path) < 0) {
+        fprintf(stderr, "[WARNING] Could not save FFT plans to %s\n", path);
+    } else {
+        printf("[OK] FFT plans saved to %s\n", path);
+    }
+}
+
+/*===========================================================================
+ * Band Energies
+ *===========================================================================*/
+
+// Analyze the num_bands bands between edges (Hz) from the next frame on
+bool bands_init(const float* edges, int num_bands) {
+    static double bin_edges[MAX_BANDS + 1];
+    if (num_bands < 1 || num_bands > MAX_BANDS) {
+        return false;
+    }
+
+    for (int b = 0; b <= num_bands; b++) {
+        bin_edges[b] = ((double)edges[b] - g_spectrum_f0) * FFT_SIZE / SAMPLE_RATE;
+    }
+    kiss_bands_cfg cfg = kiss_bands_alloc(num_bands, bin_edges, g_spectrum_bins, NULL, NULL);
+    if (!cfg) {
+        return false;
+    }
+
+    kiss_bands_free(g_bands_cfg);
+    g_bands_cfg = cfg;
+    memcpy(g_band_edges, edges, (num_bands + 1) * sizeof(float));
+    g_num_bands = num_bands;
+    return true;
+}
+
+// Band edges (Hz) from a --bands / /api/bands spec: "default", "octave:N"
+// (1/N octave from OCTAVE_BANDS_LOW_HZ to Nyquist), "linear:N" (N equal bands
+// from 0 to Nyquist), a comma-separated list of edges or, where files are
+// allowed, "file:PATH" with the edges whitespace or comma separated.  With
+// IQ input, edges may be negative, linear:N spans -Nyquist to Nyquist and
+// so does "default" (as linear:DEFAULT_NUM_BANDS).
+// Returns the number of bands, 0 if the spec is invalid.
+int bands_parse(const char* spec, float* edges, bool allow_file) {
+    static double octave_edges[MAX_BANDS + 1];
+    const float nyquist = SAMPLE_RATE / 2.0f;
+    char iq_default[32];
+    int num_edges = 0;
+    int n = 0;
+    int len = 0;
+
+    if (g_iq && strcmp(spec, "default") == 0) {
+        snprintf(iq_default, sizeof(iq_default), "linear:%d", DEFAULT_NUM_BANDS);
+        spec = iq_default;
+    }
+
+    if (strcmp(spec, "default") == 0) {
+        memcpy(edges, DEFAULT_BAND_EDGES, sizeof(DEFAULT_BAND_EDGES));
+        return DEFAULT_NUM_BANDS;
+    } else if (sscanf(spec, "octave:%d%n", &n, &len) == 1 && spec[len] == '\0') {
+        int num_bands = kiss_bands_octave(n, OCTAVE_BANDS_LOW_HZ, nyquist, octave_edges, MAX_BANDS);
+        for (int b = 0; b <= num_bands; b++) {
+            edges[b] = (float)octave_edges[b];
+        }
+        return num_bands;
+    } else if (sscanf(spec, "linear:%d%n", &n, &len) == 1 && spec[len] == '\0') {
+        if (n < 1 || n > MAX_BANDS) {
+            return 0;
+        }
+        for (int b = 0; b <= n; b++) {
+            edges[b] = g_spectrum_f0 + (nyquist - g_spectrum_f0) * b / n;
+        }
+        return n;
+    } else if (strncmp(spec, "file:", 5) == 0) {
+        FILE* f = allow_file ? fopen(spec + 5, "r") : NULL;
+        if (!f) {
+            return 0;
+        }
+        while (num_edges <= MAX_BANDS && fscanf(f, " %f ,", &edges[num_edges]) == 1) {
+            num_edges++;
+        }
+        fclose(f);
+    } else {
+        const char* p = spec;
+        char* end;
+        while (num_edges <= MAX_BANDS && *p) {
+            edges[num_edges] = strtof(p, &end);
+            if (end == p || (*end && *end != ',')) {
+                return 0;
+            }
+            num_edges++;
+            p = *end ? end + 1 : end;
+        }
+    }
+
+    for (int b = 1; b < num_edges; b++) {
+        if (!(edges[b] > edges[b - 1])) {
+            return 0;
+        }
+    }
+    return num_edges >= 2 && edges[0] >= g_spectrum_f0 ? num_edges - 1 : 0;
+}
+
+/*===========================================================================
+ * FIR Filter Stage (overlap-save)
+ *===========================================================================*/
+
+bool fir_init(const float* taps, int num_taps) {
+    kiss_fastfir_free(g_fir_cfg);
+    g_fir_cfg = NULL;
+    g_fir_taps = 0;
+    if (num_taps <= 0 || num_taps > FIR_MAX_TAPS) {
+        return false;
+    }
+
+    int nfft = kiss_fftr_next_fast_size_real(num_taps - 1 + FFT_SIZE);
+    g_fir_cfg = kiss_fastfir_alloc(taps, num_taps, nfft, NULL, NULL);
+    if (!g_fir_cfg) {
+        return false;
+    }
+    g_fir_taps = num_taps;
+    return true;
+}
+
+// Linear-phase bandpass by the window method (Blackman window).  A low edge
+// of 0 gives a lowpass, a high edge at Nyquist a highpass.
+bool fir_init_bandpass(float freq_low, float freq_high, int num_taps) {
+    if (num_taps <= 0 || num_taps > FIR_MAX_TAPS || freq_high <= freq_low) {
+        return false;
+    }
+
+    float* taps = (float*)malloc(num_taps * sizeof(float));
+    if (!taps) {
+        return false;
+    }
+
+    double f1 = freq_low / SAMPLE_RATE;
+    double f2 = freq_high / SAMPLE_RATE;
+    if (f2 > 0.5) f2 = 0.5;
+    double center = (num_taps - 1) / 2.0;
+    for (int i = 0; i < num_taps; i++) {
+        double t = i - center;
+        double ideal = t == 0.0 ? 2.0 * (f2 - f1) :
+            (sin(2.0 * M_PI * f2 * t) - sin(2.0 * M_PI * f1 * t)) / (M_PI * t);
+        double w = num_taps == 1 ? 1.0 :
+            0.42 - 0.5 * cos(2.0 * M_PI * i / (num_taps - 1)) +
+            0.08 * cos(4.0 * M_PI * i / (num_taps - 1));
+        taps[i] = (float)(ideal * w);
+    }
+
+    bool ok = fir_init(taps, num_taps);
+    free(taps);
+    return ok;
+}
+
+// Taps from a text file, whitespace or comma separated (e.g. a matched filter)
+bool fir_init_file(const char* path) {
+    FILE* f = fopen(path, "r");
+    if (!f) {
+        return false;
+    }
+
+    float* taps = (float*)malloc(FIR_MAX_TAPS * sizeof(float));
+    int num_taps = 0;
+    if (taps) {
+        while (num_taps < FIR_MAX_TAPS && fscanf(f, " %f ,", &taps[num_taps]) == 1) {
+            num_taps++;
+        }
+    }
+    fclose(f);
+
+    bool ok = taps && fir_init(taps, num_taps);
+    free(taps);
+    return ok;
+}
+
+// Filter a block of samples in place (continuing from the previous block)
+void fir_process(float* samples, int count) {
+    if (g_fir_cfg) {
+        kiss_fastfir(g_fir_cfg, samples, samples, count);
+    }
+}
+
+/*===========================================================================
+ * Polyphase Channelizer
+ *===========================================================================*/
+
+// K channels (even, at most MAX_CHANNELS) decimated by D (1..K); the default
+// prototype is a Blackman windowed sinc, 8 taps per branch.  log_path, if
+// given, receives every hop as K/2+1 interleaved float32 I/Q pairs.
+bool channelizer_init(int channels, int decim, const char* log_path) {
+    channelizer_cleanup();
+    if (channels < 2 || channels > MAX_CHANNELS || (channels & 1) ||
+        decim < 1 || decim > channels) {
+        return false;
+    }
+
+    g_pfb_cfg = kiss_pfb_alloc(channels, decim, NULL, 0, NULL, NULL);
+    g_pfb_out = (kiss_fft_cpx*)malloc((FFT_SIZE / decim + 1) * (channels / 2 + 1) *
+                                      sizeof(kiss_fft_cpx));
+    if (log_path) {
+        g_channel_log = fopen(log_path, "wb");
+    }
+    if (!g_pfb_cfg || !g_pfb_out || (log_path && !g_channel_log)) {
+        channelizer_cleanup();
+        return false;
+    }
+
+    g_pfb_channels = channels;
+    g_pfb_decim = decim;
+    for (int k = 0; k <= channels / 2; k++) {
+        g_channel_freqs[k] = (float)k * SAMPLE_RATE / channels;
+        g_channel_power[k] = 0.0f;
+    }
+    return true;
+}
+
+// Channelize a block of samples (continuing from the previous block)
+void channelizer_process(const float* samples, int count) {
+    if (!g_pfb_cfg) {
+        return;
+    }
+
+    const int nout = g_pfb_channels / 2 + 1;
+    int hops = kiss_pfb(g_pfb_cfg, samples, count, g_pfb_out);
+    if (hops == 0) {
+        return;
+    }
+
+    for (int k = 0; k < nout; k++) {
+        float power = 0.0f;
+        for (int h = 0; h < hops; h++) {
+            const kiss_fft_cpx* y = &g_pfb_out[h * nout + k];
+            power += y->r * y->r + y->i * y->i;
+        }
+        g_channel_power[k] = power / hops;
+    }
+
+    if (g_channel_log) {
+        fwrite(g_pfb_out, sizeof(kiss_fft_cpx), (size_t)hops * nout, g_channel_log);
+    }
+}
+
+/*===========================================================================
+ * Peak Tracker
+ *===========================================================================*/
+
+// log_path, if given, receives one record per frame: uint64 timestamp (ms)
+// and uint32 count, then count x (uint32 id, float32 Hz, float32 dB) for the
+// tracks that matched a peak in the frame
+bool peaks_init(const char* log_path) {
+    peaks_cleanup();
+    g_peaks_cfg = kiss_peaks_alloc(g_spectrum_bins, PEAK_MAX_PEAKS, PEAK_MAX_TRACKS,
+                                   PEAK_MAX_JUMP_BINS, PEAK_MAX_MISSED, NULL, NULL);
+    if (log_path) {
+        g_peak_log = fopen(log_path, "wb");
+    }
+    if (!g_peaks_cfg || (log_path && !g_peak_log)) {
+        peaks_cleanup();
+        return false;
+    }
+    return true;
+}
+
+// Drop every track; after a mode or window change they no longer apply
+void peaks_reset(void) {
+    if (g_peaks_cfg) {
+        kiss_peaks_reset(g_peaks_cfg);
+    }
+    g_num_peak_tracks = 0;
+}
+
+// Pick the frame's peaks and extend the tracks with them.  Only the bins
+// above the threshold cost more than a compare.  Without a window Quinn's
+// estimator places each peak from the complex bins (g_fft_out, as
+// compute_fft left it); under a window a parabola through the log
+// magnitudes does.
+void peaks_update(const float* magnitude, const frame_features_t* features, uint64_t timestamp) {
+    if (!g_peaks_cfg) {
+        return;
+    }
+
+    const float bin_hz = (float)SAMPLE_RATE / FFT_SIZE;
+    float threshold = features->noise_floor * powf(10.0f, PEAK_THRESHOLD_DB / 20.0f);
+    if (threshold < 1e-6f) {
+        threshold = 1e-6f;      // the dB floor of the spectrum
+    }
+    kiss_peaks_method method = g_window_type == KISS_WINDOW_RECT ?
+        KISS_PEAKS_QUINN : KISS_PEAKS_PARABOLIC;
+
+    int npeaks = kiss_peaks_find(g_peaks_cfg, magnitude, g_fft_out, threshold, method, g_peaks);
+    kiss_peaks_track(g_peaks_cfg, g_peaks, npeaks);
+
+    int ntracks = 0;
+    uint32_t matched = 0;
+    const kiss_peak_track* tracks = kiss_peaks_tracks(g_peaks_cfg, &ntracks);
+    for (int i = 0; i < ntracks; i++) {
+        g_peak_tracks[i].id = tracks[i].id;
+        g_peak_tracks[i].freq = g_spectrum_f0 + tracks[i].pos * bin_hz;
+        g_peak_tracks[i].magnitude = tracks[i].mag;
+        g_peak_tracks[i].age = tracks[i].age;
+        g_peak_tracks[i].coasting = tracks[i].missed > 0;
+        if (!g_peak_tracks[i].coasting) {
+            matched++;
+        }
+    }
+    g_num_peak_tracks = ntracks;
+
+    if (g_peak_log) {
+        fwrite(&timestamp, sizeof(timestamp), 1, g_peak_log);
+        fwrite(&matched, sizeof(matched), 1, g_peak_log);
+        for (int i = 0; i < ntracks; i++) {
+            if (g_peak_tracks[i].coasting) {
+                continue;
+            }
+            uint32_t id = (uint32_t)g_peak_tracks[i].id;
+            float db = 20.0f * log10f(g_peak_tracks[i].magnitude + 1e-6f);
+            fwrite(&id, sizeof(id), 1, g_peak_log);
+            fwrite(&g_peak_tracks[i].freq, sizeof(float), 1, g_peak_log);
+            fwrite(&db, sizeof(db), 1, g_peak_log);
+        }
+    }
+}
+
+/*===========================================================================
+ * CFAR Detector
+ *===========================================================================*/
+
+// Cell-averaging (ca) or ordered-statistic (os) CFAR over bins 1..N/2-1
+// (all N bins of a two-sided spectrum, where DC sits among the signal
+// bins), with a false alarm rate of pfa per bin on noise
+bool cfar_init(kiss_cfar_method method, double pfa) {
+    kiss_cfar_free(g_cfar_cfg);
+    g_num_detections = 0;
+    g_cfar_cfg = kiss_cfar_alloc(g_spectrum_bins - (g_iq ? 0 : 1), CFAR_GUARD_BINS, CFAR_TRAIN_BINS,
+                                 method, 0, pfa, NULL, NULL);
+    return g_cfar_cfg != NULL;
+}
+
+// One threshold over the frame's noise floor: on noise the bin power is
+// exponential, so -ln(pfa) times its mean is crossed with probability pfa
+void cfar_init_global(double pfa) {
+    kiss_cfar_free(g_cfar_cfg);
+    g_cfar_cfg = NULL;
+    g_num_detections = 0;
+    g_cfar_global = true;
+    g_cfar_global_scale = -log(pfa);
+}
+
+// Detect on the frame's magnitudes and return the SNR of the strongest
+// detection over its local noise (dB), or PSD_FLOOR_DB if nothing was found.
+// noise_floor (a mean magnitude) is only read by the global threshold.
+float cfar_update(const float* magnitude, float noise_floor) {
+    const int first = g_iq ? 0 : 1;
+    const int num_cells = g_spectrum_bins - first;
+    float best_snr_db = PSD_FLOOR_DB;
+    int nhits = 0;
+
+    g_num_detections = 0;
+    if (!g_cfar_cfg && !g_cfar_global) {
+        return best_snr_db;
+    }
+
+    // DC is left out of a one-sided spectrum: g_cfar_power[k] is bin k + first
+    for (int k = 0; k < num_cells; k++) {
+        g_cfar_power[k] = magnitude[k + first] * magnitude[k + first];
+    }
+    // A two-sided spectrum has DC mid-way, where a front end's LO leaks
+    // through; its cell reads as its neighbours, so the leak is neither
+    // detected nor counted as noise
+    if (g_iq) {
+        const int dc = g_spectrum_bins / 2;
+        g_cfar_power[dc] = 0.5f * (g_cfar_power[dc - 1] + g_cfar_power[dc + 1]);
+    }
+    if (g_cfar_cfg) {
+        nhits = kiss_cfar_detect(g_cfar_cfg, g_cfar_power, g_cfar_noise, g_cfar_hits);
+    } else {
+        // Rayleigh magnitudes: mean power = mean magnitude^2 * 4/pi
+        float noise_power = noise_floor * noise_floor * (float)(4.0 / M_PI);
+        float threshold = (float)g_cfar_global_scale * noise_power;
+        for (int k = 0; k < num_cells; k++) {
+            g_cfar_noise[k] = noise_power;
+            if (g_cfar_power[k] > threshold) {
+                g_cfar_hits[nhits++] = k;
+            }
+        }
+    }
+
+    for (int i = 0; i < nhits && g_num_detections < MAX_DETECTIONS; ) {
+        int best = g_cfar_hits[i];
+        int run = 1;
+        while (i + run < nhits && g_cfar_hits[i + run] == g_cfar_hits[i] + run) {
+            if (g_cfar_power[g_cfar_hits[i + run]] > g_cfar_power[best]) {
+                best = g_cfar_hits[i + run];
+            }
+            run++;
+        }
+
+        cfar_detection_t* d = &g_detections[g_num_detections++];
+        d->freq = g_spectrum_f0 + (best + first) * (float)SAMPLE_RATE / FFT_SIZE;
+        d->magnitude = magnitude[best + first];
+        d->snr_db = 10.0f * log10f(g_cfar_power[best] / (g_cfar_noise[best] + 1e-20f) + 1e-10f);
+        d->bins = run;
+        if (d->snr_db > best_snr_db) {
+            best_snr_db = d->snr_db;
+        }
+        i += run;
+    }
+    return best_snr_db;
+}
+
+/*===========================================================================
+ * Goertzel Bank
+ *===========================================================================*/
+
+// Mark the spectrum bins that the selected bands of the current set take
+// power from; returns how many bins are marked
+static int band_bins_select(const bool* bands, bool* selected) {
+    int count = 0;
+    memset(selected, 0, (FFT_SIZE / 2) * sizeof(bool));
+    for (int band = 0; band < g_num_bands; band++) {
+        int first, last;
+        if (!bands[band] || kiss_bands_bins(g_bands_cfg, band, &first, &last) == 0) {
+            continue;
+        }
+        for (int k = first; k <= last; k++) {
+            count += !selected[k];
+            selected[k] = true;
+        }
+    }
+    return count;
+}
+
+// Build the bank over every bin of the selected bands plus the listed tones (Hz)
+bool goertzel_init(const bool* bands, const float* tones, int num_tones) {
+    double freqs[FFT_SIZE / 2 + MAX_GOERTZEL_TONES];
+    bool selected[FFT_SIZE / 2];
+    int nfreqs = 0;
+
+    g_goertzel_num_bins = 0;
+    band_bins_select(bands, selected);
+    for (int k = 0; k < FFT_SIZE / 2; k++) {
+        if (selected[k]) {
+            g_goertzel_bins[g_goertzel_num_bins++] = k;
+            g_goertzel_freqs[1 + nfreqs] = (float)k * SAMPLE_RATE / FFT_SIZE;
+            freqs[nfreqs++] = (double)k / FFT_SIZE;
+        }
+    }
+
+    g_goertzel_num_tones = num_tones < MAX_GOERTZEL_TONES ? num_tones : MAX_GOERTZEL_TONES;
+    for (int t = 0; t < g_goertzel_num_tones; t++) {
+        g_goertzel_tone_freqs[t] = tones[t];
+        g_goertzel_freqs[1 + nfreqs] = tones[t];
+        freqs[nfreqs++] = (double)tones[t] / SAMPLE_RATE;
+    }
+
+    kiss_goertzel_free(g_goertzel_cfg);
+    g_goertzel_cfg = NULL;
+    if (nfreqs == 0) {
+        return false;
+    }
+
+    g_goertzel_cfg = kiss_goertzel_alloc(nfreqs, freqs, NULL, NULL);
+    return g_goertzel_cfg != NULL;
+}
+
+// Frame analysis without an FFT: the selected band bins are written into the
+// magnitude spectrum (everything else stays zero, so the selected bands read
+// as from a full spectrum) and the tone magnitudes into tone_magnitudes.
+void compute_goertzel(const float* input, float* magnitude, float* tone_magnitudes, int size) {
+    const int nfreqs = g_goertzel_num_bins + g_goertzel_num_tones;
+
+    kiss_goertzel_power(g_goertzel_cfg, input, size, g_goertzel_power);
+
+    memset(magnitude, 0, (size / 2) * sizeof(float));
+    for (int i = 0; i < nfreqs; i++) {
+        g_goertzel_mags[1 + i] = sqrtf(g_goertzel_power[i]);
+    }
+    for (int i = 0; i < g_goertzel_num_bins; i++) {
+        magnitude[g_goertzel_bins[i]] = g_goertzel_mags[1 + i];
+    }
+    memcpy(tone_magnitudes, g_goertzel_mags + 1 + g_goertzel_num_bins,
+           g_goertzel_num_tones * sizeof(float));
+}
+
+// Number of slots in g_goertzel_mags, the DC placeholder included
+int goertzel_num_slots(void) {
+    return 1 + g_goertzel_num_bins + g_goertzel_num_tones;
+}
+
+/*===========================================================================
+ * Alarm Bands (sliding DFT)
+ *===========================================================================*/
+
+// Bin j of a real input's spectrum folded into 0..FFT_SIZE/2 (X[-j] and
+// X[FFT_SIZE - j] are the conjugate of X[j]); sets *conj when it folds
+static int alarm_fold(int j, bool* conj) {
+    *conj = j < 0 || j > FFT_SIZE / 2;
+    return j < 0 ? -j : (j > FFT_SIZE / 2 ? FFT_SIZE - j : j);
+}
+
+// Build the sliding DFT over every bin of the selected bands of the band set,
+// and the neighbours the window kernel reads
+bool alarm_init(const bool* bands) {
+    bool selected[FFT_SIZE / 2];
+    bool tracked[FFT_SIZE / 2 + 1] = {false};
+    int nbins = 0;
+    int nband = 0;
+
+    memcpy(g_alarm_band, bands, MAX_BANDS * sizeof(bool));
+    band_bins_select(bands, selected);
+    memset(g_alarm_power, 0, sizeof(g_alarm_power));
+    for (int k = 0; k < FFT_SIZE / 2; k++) {
+        if (!selected[k]) {
+            continue;
+        }
+        g_alarm_band_bins[nband++] = k;
+        for (int m = 1 - KISS_WINDOW_MAX_TAPS; m < KISS_WINDOW_MAX_TAPS; m++) {
+            bool conj;
+            tracked[alarm_fold(k + m, &conj)] = true;
+        }
+    }
+    for (int k = 0; k <= FFT_SIZE / 2; k++) {
+        g_alarm_slot[k] = tracked[k] ? nbins : -1;
+        if (tracked[k]) {
+            g_alarm_bin_list[nbins++] = k;
+        }
+    }
+
+    kiss_sdft_free(g_alarm_sdft);
+    g_alarm_sdft = NULL;
+    g_alarm_bins = nbins;
+    g_alarm_num_band_bins = nband;
+    if (nband == 0) {
+        return false;
+    }
+
+    g_alarm_sdft = kiss_sdft_alloc(FFT_SIZE, nbins, g_alarm_bin_list, NULL, NULL);
+    return g_alarm_sdft != NULL;
+}
+
+// Power of spectrum bin k on the scale of the frame spectrum: the current
+// window applied to the sliding bins as its kernel, and its coherent gain
+// (kernel[0]) divided out, as compute_fft() does
+static float alarm_bin_power(const kiss_fft_cpx* bins, int k, const double* kernel, int taps) {
+    const kiss_fft_cpx* x = &bins[g_alarm_slot[k]];
+    double re = kernel[0] * x->r;
+    double im = kernel[0] * x->i;
+    for (int m = 1; m < taps; m++) {
+        bool conj_lo, conj_hi;
+        const kiss_fft_cpx* lo = &bins[g_alarm_slot[alarm_fold(k - m, &conj_lo)]];
+        const kiss_fft_cpx* hi = &bins[g_alarm_slot[alarm_fold(k + m, &conj_hi)]];
+        re += kernel[m] * (lo->r + hi->r);
+        im += kernel[m] * ((conj_lo ? -lo->i : lo->i) + (conj_hi ? -hi->i : hi->i));
+    }
+    return (float)((re * re + im * im) / (kernel[0] * kernel[0]));
+}
+
+// Noise reference for the per-sample trigger: mean magnitude of the last
+// frame, or its noise floor when a tone-proof estimator was chosen
+void alarm_set_noise_floor(const frame_features_t* features) {
+    g_alarm_noise_floor = g_noise_method == FRAME_NOISE_MEAN ?
+        features->magnitude_mean : features->noise_floor;
+}
+
+// Slide the alarm bins over new samples.  While auto-record is armed, the
+// strongest alarm bin is compared against the noise floor after every sample,
+// so recording starts on the sample that crosses the threshold.
+void alarm_process(const float* samples, int count) {
+    if (!g_alarm_sdft) {
+        return;
+    }
+
+    double kernel[KISS_WINDOW_MAX_TAPS];
+    const int taps = kiss_window_kernel(g_window_type, kernel);
+    const kiss_fft_cpx* bins = kiss_sdft_bins(g_alarm_sdft);
+    for (int i = 0; i < count; i++) {
+        kiss_sdft_push(g_alarm_sdft, samples[i]);
+
+        if (!g_data_logger.auto_record_enabled || data_logger_is_active(&g_data_logger) ||
+            g_alarm_noise_floor <= 0.0f) {
+            continue;
+        }
+
+        float peak = 0.0f;
+        for (int b = 0; b < g_alarm_num_band_bins; b++) {
+            float power = alarm_bin_power(bins, g_alarm_band_bins[b], kernel, taps);
+            if (power > peak) {
+                peak = power;
+            }
         }
-        num_segments++;
+        float snr_db = 20.0f * log10f(sqrtf(peak) / g_alarm_noise_floor + 1e-10f);
+        data_logger_check_auto_trigger(&g_data_logger, snr_db, FFT_SIZE, SAMPLE_RATE);
     }
+}
+
+// Replace the frame energies of the alarm bands with their sliding values
+// (the band set read over the latest FFT_SIZE samples instead of the frame,
+// under the same window and gain, so the two kinds of band compare directly)
+void alarm_band_energies(float* band_energies) {
+    if (!g_alarm_sdft) {
+        return;
+    }
+
+    double kernel[KISS_WINDOW_MAX_TAPS];
+    const int taps = kiss_window_kernel(g_window_type, kernel);
+    const kiss_fft_cpx* bins = kiss_sdft_bins(g_alarm_sdft);
+    for (int i = 0; i < g_alarm_num_band_bins; i++) {
+        int k = g_alarm_band_bins[i];
+        g_alarm_power[k] = alarm_bin_power(bins, k, kernel, taps);
+    }
+    kiss_bands_mean(g_bands_cfg, g_alarm_power, g_alarm_band_power);
+    for (int band = 0; band < g_num_bands; band++) {
+        if (g_alarm_band[band]) {
+            band_energies[band] = sqrtf(g_alarm_band_power[band]);
+        }
+    }
+}
+
+// Read one frame from the network, feeding the alarm bands as data arrives.
+// TCP is read in ALARM_CHUNK_SAMPLES pieces; a UDP datagram is one read.
+int network_read_frame_alarm(network_config_t* config, float* buffer, int num_samples) {
+    if (config->protocol != NET_PROTOCOL_TCP) {
+        int samples_read = network_read_samples(config, buffer, num_samples);
+        if (samples_read > 0) {
+            alarm_process(buffer, samples_read);
+        }
+        return samples_read;
+    }
+
+    int filled = 0;
+    while (filled < num_samples) {
+        int chunk = num_samples - filled;
+        if (chunk > ALARM_CHUNK_SAMPLES) {
+            chunk = ALARM_CHUNK_SAMPLES;
+        }
+        if (network_read_samples(config, buffer + filled, chunk) < 0) {
+            return -1;
+        }
+        alarm_process(buffer + filled, chunk);
+        filled += chunk;
+    }
+    return filled;
+}
+
+/*===========================================================================
+ * IQ Input
+ *===========================================================================*/
+
+// Switch the analyzer to IQ input before anything is set up for the
+// spectrum: FFT_SIZE bins from -SAMPLE_RATE/2, and a PSD over the whole
+// Welch segment
+void iq_init(void) {
+    g_iq = true;
+    g_spectrum_bins = FFT_SIZE;
+    g_spectrum_f0 = -SAMPLE_RATE / 2.0f;
+    g_psd_bins = WELCH_SEGMENT_SIZE;
+    for (int k = 0; k < FFT_SIZE; k++) {
+        g_spectrum_freqs[k] = g_spectrum_f0 + k * (float)SAMPLE_RATE / FFT_SIZE;
+    }
+}
+
+// Read num_samples interleaved float32 I/Q pairs straight into buffer;
+// returns the pairs read, -1 on error
+int network_read_iq(network_config_t* config, kiss_fft_cpx* buffer, int num_samples) {
+    int values_read = network_read_samples(config, (float*)buffer, 2 * num_samples);
+    return values_read < 0 ? -1 : values_read / 2;
+}
+
+// A real test waveform as IQ input (Q = 0: a spectrum mirrored about DC)
+void iq_from_real(const float* input, kiss_fft_cpx* output, int size) {
+    for (int i = 0; i < size; i++) {
+        output[i].r = input[i];
+        output[i].i = 0.0f;
+    }
+}
+
+// Two-sided spectrum of size (even) I/Q samples in fftshift order: bin k
+// is (k - size/2) * SAMPLE_RATE / size Hz.  Alternate samples are negated
+// as the window is applied, which moves bin size/2 to bin 0, so the one
+// transform writes the bins in display order and g_fft_out holds the
+// complex bins behind the magnitudes, as the peak tracker expects.
+void compute_fft_iq(const kiss_fft_cpx* input, float* magnitude, float* magnitude_db, int size) {
+    kiss_fft_cfg cfg = kfc_getcfg(size, 0);
+    const kiss_window* window = kiss_window_get(g_window_type, size);
+    if (!cfg || !window || !fft_work_reserve(2 * size)) {
+        fprintf(stderr, "[ERROR] FFT setup failed (size %d)\n", size);
+        memset(magnitude, 0, size * sizeof(float));
+        if (magnitude_db) {
+            memset(magnitude_db, 0, size * sizeof(float));
+        }
+        return;
+    }
+
+    // The windowed frame goes after the spectrum
+    kiss_fft_cpx* windowed = g_fft_out + size;
+    for (int i = 0; i < size; i++) {
+        float w = (i & 1) ? -window->w[i] : window->w[i];
+        windowed[i].r = input[i].r * w;
+        windowed[i].i = input[i].i * w;
+    }
+    kiss_fft(cfg, windowed, g_fft_out);
+
+    const float scale = (float)(1.0 / window->coherent_gain);
+    kiss_spectrum_mag_db(g_fft_out, size, scale, 1e-6f, magnitude, magnitude_db);
+}
+
+// Complex Welch estimate: WELCH_SEGMENT_SIZE bins from -SAMPLE_RATE/2, in
+// the order and dB reference of the one-sided estimate
+void compute_psd_welch_iq(const kiss_fft_cpx* signal, float* psd, int size) {
+    const int half = WELCH_SEGMENT_SIZE / 2;
+    float power[WELCH_SEGMENT_SIZE];
 
-    // Average, normalize, and convert to dB
-    for (int i = 0; i < num_bins; i++) {
-        float power = accumulated_psd[i] / num_segments;
-        // Normalize by segment size to get proper PSD
-        power = power / (segment_size * segment_size);
-        // Convert to dB relative to reference (1.0)
-        psd[i] = 10.0f * log10f(power + 1e-10f);
+    if (g_welch_per_frame) {
+        kiss_welch_reset(g_welch_cfg);
+    }
+    kiss_welch_cpx(g_welch_cfg, signal, size);
+    if (kiss_welch_psd(g_welch_cfg, power) == 0) {
+        for (int i = 0; i < WELCH_SEGMENT_SIZE; i++) {
+            psd[i] = PSD_FLOOR_DB;
+        }
+        return;
     }
 
-    free(segment);
-    free(segment_psd);
-    free(accumulated_psd);
+    // The negative frequencies (the top half of the FFT order) come first
+    const float scale = 1.0f / welch_power_scale();
+    kiss_spectrum_db(power + half, half, scale, 1e-10f, 10.0f, psd);
+    kiss_spectrum_db(power, half, scale, 1e-10f, 10.0f, psd + half);
 }
 
-float get_band_energy(const float* magnitude, int size, float freq_low, float freq_high) {
-    int bin_low = (int)((freq_low * size) / SAMPLE_RATE);
-    int bin_high = (int)((freq_high * size) / SAMPLE_RATE);
+/*===========================================================================
+ * Digital Downconverter
+ *===========================================================================*/
 
-    if (bin_high >= size / 2) bin_high = size / 2 - 1;
-    if (bin_low < 0) bin_low = 0;
+// Input at SAMPLE_RATE * decim (even, 2..DDC_MAX_DECIM), center_hz at that
+// rate; CIC order 1..6.  The band within SAMPLE_RATE/2 * 0.2 of the centre
+// is flat, and nothing from beyond 0.3 of it aliases in.
+bool ddc_init(double center_hz, int decim, int order) {
+    ddc_cleanup();
+    if (decim < 2 || decim > DDC_MAX_DECIM || (decim & 1) ||
+        !(center_hz >= 0.0 && center_hz <= (double)SAMPLE_RATE * decim / 2)) {
+        return false;
+    }
+
+    g_ddc_cfg = kiss_ddc_alloc(center_hz / ((double)SAMPLE_RATE * decim), decim, order,
+                               0.2, 0.3, NULL, NULL);
+    g_ddc_in = (float*)malloc((size_t)FFT_SIZE * decim * sizeof(float));
+    if (!g_ddc_cfg || !g_ddc_in) {
+        ddc_cleanup();
+        return false;
+    }
+    g_ddc_decim = decim;
+    g_ddc_center_hz = center_hz;
+    return true;
+}
 
-    float energy = 0.0f;
-    for (int i = bin_low; i <= bin_high; i++) {
-        energy += magnitude[i] * magnitude[i];
+// Read one frame of FFT_SIZE downconverted samples from the network
+int ddc_read_frame(network_config_t* config, float* buffer) {
+    int filled = 0;
+    if (g_ddc_carry) {
+        buffer[filled++] = g_ddc_out[FFT_SIZE];
+        g_ddc_carry = 0;
     }
 
-    return sqrtf(energy / (bin_high - bin_low + 1));
+    while (filled < FFT_SIZE) {
+        int samples_read = network_read_samples(config, g_ddc_in, (FFT_SIZE - filled) * g_ddc_decim);
+        if (samples_read < 0) {
+            return -1;
+        }
+        // At most one output more than asked for, kept for the next frame
+        int out = kiss_ddc_real(g_ddc_cfg, g_ddc_in, samples_read, g_ddc_out);
+        int take = out < FFT_SIZE - filled ? out : FFT_SIZE - filled;
+        memcpy(buffer + filled, g_ddc_out, take * sizeof(float));
+        filled += take;
+        if (out > take) {
+            g_ddc_out[FFT_SIZE] = g_ddc_out[take];
+            g_ddc_carry = 1;
+        }
+    }
+
+    if (g_alarm_sdft) {
+        alarm_process(buffer, FFT_SIZE);
+    }
+    return FFT_SIZE;
 }
 
 /*===========================================================================
@@ -451,6 +1647,31 @@ void web_mode_change_callback(int mode) {
     printf("[WEB] Mode change requested: %d (%s)\n", mode, MODE_NAMES[mode]);
 }
 
+bool web_window_change_callback(const char* name) {
+    int type = kiss_window_parse(name);
+    if (type < 0) {
+        return false;
+    }
+    g_requested_window = type;
+    printf("[WEB] Window change requested: %s\n", kiss_window_name((kiss_window_type)type));
+    return true;
+}
+
+// Band sets from the web are applied by the main loop.  Alarm and Goertzel
+// bands are chosen by index at startup, so the set is fixed while they run.
+int web_bands_change_callback(const char* spec) {
+    if (g_alarm_sdft || g_goertzel_cfg) {
+        return 0;
+    }
+    int num_bands = bands_parse(spec, g_requested_edges, false);
+    if (num_bands == 0) {
+        return 0;
+    }
+    g_requested_num_bands = num_bands;
+    printf("[WEB] Band set change requested: %s (%d bands)\n", spec, num_bands);
+    return num_bands;
+}
+
 void web_pause_toggle_callback(void) {
     g_paused = !g_paused;
     printf("[WEB] Pause toggled: %s\n", g_paused ? "PAUSED" : "RESUMED");
@@ -547,6 +1768,19 @@ const char* web_get_log_directory_callback(void) {
  * Main Application
  *===========================================================================*/
 
+// Parse a comma-separated list of band indices into bands[]; returns how many were valid
+static int parse_band_list(char* list, bool* bands) {
+    int count = 0;
+    for (char* tok = strtok(list, ","); tok; tok = strtok(NULL, ",")) {
+        int band = atoi(tok);
+        if (band >= 0 && band < MAX_BANDS) {
+            bands[band] = true;
+            count++;
+        }
+    }
+    return count;
+}
+
 void print_usage(const char* prog_name) {
     printf("Usage: %s [OPTIONS]\n\n", prog_name);
     printf("Options:\n");
@@ -555,6 +1789,29 @@ void print_usage(const char* prog_name) {
     printf("  --test              Use test waveforms instead of network\n");
     printf("  --port PORT         Web server port (default: 8080)\n");
     printf("  --no-browser        Don't auto-open web browser\n");
+    printf("  --bands SET         Band set: default, octave:N, linear:N, F0,F1,... (Hz) or file:PATH\n");
+    printf("  --alarm-bands LIST  Track bands (e.g. 0,3) per sample with a sliding DFT\n");
+    printf("  --goertzel-bands LIST  Skip the FFT; evaluate only these bands' bins\n");
+    printf("  --goertzel-tones LIST  Skip the FFT; evaluate only these tones (Hz)\n");
+    printf("                      (exact tone frequencies; cheaper than the FFT and PSD below ~50)\n");
+    printf("  --fir-bandpass LOW:HIGH[:TAPS]  Bandpass (Hz) the input before analysis\n");
+    printf("  --fir-file FILE     Filter the input with the FIR taps in FILE\n");
+    printf("  --channels K[:D]    Split the input into K channels, decimated by D (default K)\n");
+    printf("  --channel-log FILE  Write the raw channel samples (float32 I/Q) to FILE\n");
+    printf("  --ddc CENTER:DECIM[:ORDER]  Network input at %d Hz * DECIM; downconvert CENTER (Hz)\n",
+           SAMPLE_RATE);
+    printf("  --iq                Network input is interleaved float32 I/Q; two-sided spectrum\n");
+    printf("  --peak-log FILE     Write the peak tracks of every frame (binary) to FILE\n");
+    printf("  --cfar MODE         Detector for auto-record and the web UI: ca, os, global or off (default ca)\n");
+    printf("  --cfar-pfa P        CFAR false alarm probability per bin (default %g)\n", CFAR_DEFAULT_PFA);
+    printf("  --noise-floor MODE  Noise floor estimator: mean, median or hist (default mean)\n");
+    printf("  --history FRAMES    Spectra kept for /api/waterfall, 1..%d (default %d)\n",
+           SPECTROGRAM_MAX_FRAMES, SPECTROGRAM_FRAMES);
+    printf("  --psd-average MODE  Welch PSD average: frame, linear or exp[:FRAMES] (default exp:%d)\n",
+           PSD_DEFAULT_AVERAGE);
+    printf("  --window NAME       Analysis window: rect, hann, blackman-harris or flattop (default hann)\n");
+    printf("  --wisdom FILE       Tuned FFT plans file (default: %s)\n", DEFAULT_WISDOM_FILE);
+    printf("  --tune              Retune the FFT plans and rewrite the wisdom file\n");
     printf("  --help              Show this help\n\n");
     printf("Examples:\n");
     printf("  %s --source 192.168.1.100:5000 --protocol tcp\n", prog_name);
@@ -566,6 +1823,33 @@ int main(int argc, char* argv[]) {
     bool use_network = false;
     int web_port = 8080;
     bool auto_open_browser = true;  // Auto-open browser by default
+    static bool alarm_bands[MAX_BANDS];
+    bool use_alarm = false;
+    static bool goertzel_bands[MAX_BANDS];
+    const char* band_spec = "default";
+    float goertzel_tones[MAX_GOERTZEL_TONES];
+    int num_goertzel_tones = 0;
+    bool use_goertzel = false;
+    const char* wisdom_file = DEFAULT_WISDOM_FILE;
+    const char* fir_file = NULL;
+    float fir_low = 0.0f, fir_high = 0.0f;
+    int fir_taps = 0;
+    int pfb_channels = 0, pfb_decim = 0;
+    const char* channel_log = NULL;
+    const char* peak_log = NULL;
+    double ddc_center = 0.0;
+    int ddc_decim = 0, ddc_order = DDC_DEFAULT_ORDER;
+    int cfar_method = KISS_CFAR_CA;    // -1 for off, -2 for global
+    double cfar_pfa = CFAR_DEFAULT_PFA;
+    int history_frames = SPECTROGRAM_FRAMES;
+    int psd_average = PSD_DEFAULT_AVERAGE;
+    bool iq_input = false;
+    bool retune = false;
+    float* signal_buffer = NULL;
+    float* magnitude_buffer = NULL;
+    float* magnitude_db = NULL;
+    float* psd_buffer = NULL;
+    float* band_energies = NULL;
 
     // Parse command line arguments
     for (int i = 1; i < argc; i++) {
@@ -590,12 +1874,128 @@ int main(int argc, char* argv[]) {
             web_port = atoi(argv[++i]);
         } else if (strcmp(argv[i], "--no-browser") == 0) {
             auto_open_browser = false;
+        } else if (strcmp(argv[i], "--bands") == 0 && i + 1 < argc) {
+            band_spec = argv[++i];
+        } else if (strcmp(argv[i], "--alarm-bands") == 0 && i + 1 < argc) {
+            use_alarm = parse_band_list(argv[++i], alarm_bands) > 0;
+        } else if (strcmp(argv[i], "--goertzel-bands") == 0 && i + 1 < argc) {
+            if (parse_band_list(argv[++i], goertzel_bands) > 0) {
+                use_goertzel = true;
+            }
+        } else if (strcmp(argv[i], "--goertzel-tones") == 0 && i + 1 < argc) {
+            for (char* tok = strtok(argv[++i], ","); tok; tok = strtok(NULL, ",")) {
+                float freq = (float)atof(tok);
+                if (freq > 0.0f && freq < SAMPLE_RATE / 2 && num_goertzel_tones < MAX_GOERTZEL_TONES) {
+                    goertzel_tones[num_goertzel_tones++] = freq;
+                    use_goertzel = true;
+                }
+            }
+        } else if (strcmp(argv[i], "--fir-bandpass") == 0 && i + 1 < argc) {
+            fir_taps = FIR_DEFAULT_TAPS;
+            if (sscanf(argv[++i], "%f:%f:%d", &fir_low, &fir_high, &fir_taps) < 2) {
+                fir_taps = 0;
+            }
+        } else if (strcmp(argv[i], "--fir-file") == 0 && i + 1 < argc) {
+            fir_file = argv[++i];
+        } else if (strcmp(argv[i], "--channels") == 0 && i + 1 < argc) {
+            pfb_decim = 0;
+            if (sscanf(argv[++i], "%d:%d", &pfb_channels, &pfb_decim) < 1) {
+                pfb_channels = 0;
+            }
+            if (pfb_decim <= 0) {
+                pfb_decim = pfb_channels;
+            }
+        } else if (strcmp(argv[i], "--channel-log") == 0 && i + 1 < argc) {
+            channel_log = argv[++i];
+        } else if (strcmp(argv[i], "--ddc") == 0 && i + 1 < argc) {
+            ddc_order = DDC_DEFAULT_ORDER;
+            if (sscanf(argv[++i], "%lf:%d:%d", &ddc_center, &ddc_decim, &ddc_order) < 2) {
+                fprintf(stderr, "[ERROR] --ddc needs CENTER:DECIM[:ORDER]\n");
+                print_usage(argv[0]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--iq") == 0) {
+            iq_input = true;
+        } else if (strcmp(argv[i], "--peak-log") == 0 && i + 1 < argc) {
+            peak_log = argv[++i];
+        } else if (strcmp(argv[i], "--cfar") == 0 && i + 1 < argc) {
+            const char* method = argv[++i];
+            if (strcmp(method, "ca") == 0) {
+                cfar_method = KISS_CFAR_CA;
+            } else if (strcmp(method, "os") == 0) {
+                cfar_method = KISS_CFAR_OS;
+            } else if (strcmp(method, "global") == 0) {
+                cfar_method = -2;
+            } else if (strcmp(method, "off") == 0) {
+                cfar_method = -1;
+            } else {
+                fprintf(stderr, "[ERROR] Unknown CFAR method '%s'\n", method);
+                print_usage(argv[0]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--cfar-pfa") == 0 && i + 1 < argc) {
+            cfar_pfa = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--history") == 0 && i + 1 < argc) {
+            history_frames = atoi(argv[++i]);
+            if (history_frames <= 0 || history_frames > SPECTROGRAM_MAX_FRAMES) {
+                fprintf(stderr, "[ERROR] --history must be 1..%d frames\n", SPECTROGRAM_MAX_FRAMES);
+                print_usage(argv[0]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--noise-floor") == 0 && i + 1 < argc) {
+            int method = frame_noise_parse(argv[++i]);
+            if (method < 0) {
+                fprintf(stderr, "[ERROR] Unknown noise floor estimator '%s'\n", argv[i]);
+                print_usage(argv[0]);
+                return 1;
+            }
+            g_noise_method = (frame_noise_method_t)method;
+        } else if (strcmp(argv[i], "--psd-average") == 0 && i + 1 < argc) {
+            const char* mode = argv[++i];
+            if (strcmp(mode, "frame") == 0) {
+                psd_average = -1;
+            } else if (strcmp(mode, "linear") == 0) {
+                psd_average = 0;
+            } else if (strncmp(mode, "exp", 3) == 0) {
+                psd_average = mode[3] == ':' ? atoi(mode + 4) : PSD_DEFAULT_AVERAGE;
+                if (psd_average <= 0) {
+                    psd_average = PSD_DEFAULT_AVERAGE;
+                }
+            }
+        } else if (strcmp(argv[i], "--window") == 0 && i + 1 < argc) {
+            int type = kiss_window_parse(argv[++i]);
+            if (type < 0) {
+                fprintf(stderr, "[ERROR] Unknown window '%s'\n", argv[i]);
+                print_usage(argv[0]);
+                return 1;
+            }
+            g_window_type = (kiss_window_type)type;
+        } else if (strcmp(argv[i], "--wisdom") == 0 && i + 1 < argc) {
+            wisdom_file = argv[++i];
+        } else if (strcmp(argv[i], "--tune") == 0) {
+            retune = true;
         } else if (strcmp(argv[i], "--help") == 0) {
             print_usage(argv[0]);
             return 0;
         }
     }
 
+    // The per-sample stages all take real samples
+    if (iq_input && (use_alarm || use_goertzel || fir_file || fir_taps > 0 ||
+                     pfb_channels > 0 || ddc_decim != 0)) {
+        fprintf(stderr, "[ERROR] --iq does not combine with --alarm-bands, --goertzel-*, "
+                "--fir-*, --channels or --ddc\n");
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    // The sliding DFT is fed as samples arrive, ahead of the block-based FIR
+    if (use_alarm && (fir_file || fir_taps > 0)) {
+        fprintf(stderr, "[ERROR] --alarm-bands does not combine with --fir-*\n");
+        print_usage(argv[0]);
+        return 1;
+    }
+
     printf("===========================================\n");
     printf("  FFT Analyzer v%s\n", VERSION_STRING);
     printf("  Real-Time Spectrum Analysis\n");
@@ -642,6 +2042,9 @@ int main(int argc, char* argv[]) {
     web_server_set_auto_record_callback(web_auto_record_callback);
     web_server_set_log_directory_callback(web_set_log_directory_callback);
     web_server_set_get_log_directory_callback(web_get_log_directory_callback);
+    web_server_set_zoom_callback(compute_zoom);
+    web_server_set_window_callback(web_window_change_callback);
+    web_server_set_bands_callback(web_bands_change_callback);
     printf("[OK] Web callbacks registered\n");
 
     // Initialize data logger
@@ -656,20 +2059,170 @@ int main(int argc, char* argv[]) {
     data_logger_set_directory(&g_data_logger, DEFAULT_LOG_DIR);
     printf("[*] Log directory set to: %s\n", DEFAULT_LOG_DIR);
 
-    // Allocate buffers
-    printf("[*] Allocating FFT buffers (%d samples)...\n", FFT_SIZE);
-    float* signal_buffer = (float*)malloc(FFT_SIZE * sizeof(float));
-    float* magnitude_buffer = (float*)malloc((FFT_SIZE / 2) * sizeof(float));
-    float* psd_buffer = (float*)malloc(128 * sizeof(float));
-    float* band_energies = (float*)malloc(NUM_BANDS * sizeof(float));
+    // IQ input changes the spectrum layout everything below is set up for
+    if (iq_input) {
+        iq_init();
+        printf("[OK] IQ input: %d bins from %.1f to %.1f Hz, PSD in %d bins\n",
+               g_spectrum_bins, g_spectrum_f0, -g_spectrum_f0, g_psd_bins);
+    }
+    data_logger_set_spectrum(&g_data_logger, g_iq ? 2 : 1, g_spectrum_bins, g_psd_bins,
+                             g_spectrum_f0);
+
+    // Tuned plans must be in place before compute_fft() caches any
+    dsp_load_wisdom(wisdom_file, retune);
 
-    if (!signal_buffer || !magnitude_buffer || !psd_buffer || !band_energies) {
+    // Allocate buffers
+    printf("[*] Allocating FFT buffers (%d samples, %s kernels)...\n", FFT_SIZE,
+           kiss_fft_simd_name(kiss_fft_simd_level()));
+    signal_buffer = (float*)malloc(FFT_SIZE * sizeof(float));
+    magnitude_buffer = (float*)malloc(g_spectrum_bins * sizeof(float));
+    magnitude_db = (float*)malloc(g_spectrum_bins * sizeof(float));
+    psd_buffer = (float*)malloc(g_psd_bins * sizeof(float));
+    band_energies = (float*)malloc(MAX_BANDS * sizeof(float));
+    float tone_magnitudes[MAX_GOERTZEL_TONES] = {0};
+
+    if (!signal_buffer || !magnitude_buffer || !magnitude_db || !psd_buffer || !band_energies) {
         fprintf(stderr, "[ERROR] Failed to allocate buffers\n");
         ret = 1;
         goto cleanup;
     }
     printf("[OK] Buffers allocated\n\n");
 
+    // The frame as received: interleaved I/Q pairs for IQ input
+    float* frame_signal = g_iq ? (float*)g_iq_buffer : signal_buffer;
+    const int frame_values = g_iq ? 2 * FFT_SIZE : FFT_SIZE;
+
+    // The band set comes first: alarm and Goertzel bands are indices into it
+    int num_bands = bands_parse(band_spec, g_requested_edges, true);
+    if (num_bands == 0 || !bands_init(g_requested_edges, num_bands)) {
+        fprintf(stderr, "[ERROR] Invalid band set '%s'\n", band_spec);
+        ret = 1;
+        goto cleanup;
+    }
+    printf("[OK] Band set %s: %d bands, %.1f-%.1f Hz\n\n", band_spec, g_num_bands,
+           g_band_edges[0], g_band_edges[g_num_bands]);
+
+    if (use_alarm) {
+        if (!alarm_init(alarm_bands)) {
+            fprintf(stderr, "[ERROR] Failed to set up alarm bands\n");
+            ret = 1;
+            goto cleanup;
+        }
+        printf("[OK] Sliding DFT on %d bins for alarm bands\n\n", g_alarm_bins);
+    }
+
+    if (fir_file || fir_taps > 0) {
+        if (fir_file ? !fir_init_file(fir_file) : !fir_init_bandpass(fir_low, fir_high, fir_taps)) {
+            fprintf(stderr, "[ERROR] Failed to set up FIR filter\n");
+            ret = 1;
+            goto cleanup;
+        }
+        printf("[OK] FIR filter: %d taps, %d-pt overlap-save blocks\n\n",
+               g_fir_taps, kiss_fastfir_nfft(g_fir_cfg));
+    }
+
+    if (ddc_decim != 0) {
+        if (!ddc_init(ddc_center, ddc_decim, ddc_order)) {
+            fprintf(stderr, "[ERROR] Failed to set up downconverter (DECIM even, 2..%d; "
+                    "0 <= CENTER <= input rate / 2; ORDER 1..6)\n", DDC_MAX_DECIM);
+            ret = 1;
+            goto cleanup;
+        }
+        int cic_decim, halves, taps;
+        kiss_ddc_info(g_ddc_cfg, &cic_decim, &halves, &taps);
+        printf("[OK] Downconverter: %.0f Hz input, %.1f-%.1f Hz shown as 0-%d Hz\n",
+               (double)SAMPLE_RATE * g_ddc_decim, g_ddc_center_hz - SAMPLE_RATE / 4,
+               g_ddc_center_hz + SAMPLE_RATE / 4, SAMPLE_RATE / 2);
+        printf("     CIC /%d, %d stages /2, %d taps%s\n\n", cic_decim, halves, taps,
+               use_network ? "" : " (network input only)");
+    }
+
+    if (pfb_channels > 0) {
+        if (!channelizer_init(pfb_channels, pfb_decim, channel_log)) {
+            fprintf(stderr, "[ERROR] Failed to set up channelizer (K even, 2..%d; D 1..K)\n",
+                    MAX_CHANNELS);
+            ret = 1;
+            goto cleanup;
+        }
+        printf("[OK] Channelizer: %d channels of %.1f Hz, one output per %d samples\n",
+               g_pfb_channels, (float)SAMPLE_RATE / g_pfb_channels, g_pfb_decim);
+        if (channel_log) {
+            printf("     Logging %d channels (float32 I/Q) to %s\n",
+                   g_pfb_channels / 2 + 1, channel_log);
+        }
+        printf("\n");
+    }
+
+    if (use_goertzel) {
+        if (!goertzel_init(goertzel_bands, goertzel_tones, num_goertzel_tones)) {
+            fprintf(stderr, "[ERROR] Failed to set up Goertzel bank\n");
+            ret = 1;
+            goto cleanup;
+        }
+        // No Welch PSD in this mode
+        for (int i = 0; i < g_psd_bins; i++) {
+            psd_buffer[i] = PSD_FLOOR_DB;
+        }
+        printf("[OK] Goertzel bank on %d bins + %d tones (FFT disabled)\n\n",
+               g_goertzel_num_bins, g_goertzel_num_tones);
+    } else {
+        const kiss_window* window = kiss_window_get(g_window_type, FFT_SIZE);
+        if (!window || !welch_init(psd_average)) {
+            fprintf(stderr, "[ERROR] Failed to set up streaming Welch PSD\n");
+            ret = 1;
+            goto cleanup;
+        }
+        if (!peaks_init(peak_log)) {
+            fprintf(stderr, "[ERROR] Failed to set up peak tracker\n");
+            ret = 1;
+            goto cleanup;
+        }
+        printf("[OK] Peak tracker: up to %d peaks %.0f dB over the noise floor\n",
+               PEAK_MAX_PEAKS, PEAK_THRESHOLD_DB);
+        if (peak_log) {
+            printf("     Logging peak tracks to %s\n", peak_log);
+        }
+        if (!spectrogram_init(&g_spectrogram, history_frames, g_spectrum_bins) ||
+            !spectrogram_init(&g_psd_history, history_frames, g_psd_bins)) {
+            fprintf(stderr, "[ERROR] Failed to set up spectrogram history\n");
+            ret = 1;
+            goto cleanup;
+        }
+        printf("[OK] Spectrogram history: %d frames (%.1f MB)\n", history_frames,
+               history_frames * (g_spectrogram.stride + g_psd_history.stride) * sizeof(float) / 1e6);
+        if (cfar_method >= 0) {
+            if (!cfar_init((kiss_cfar_method)cfar_method, cfar_pfa)) {
+                fprintf(stderr, "[ERROR] Failed to set up CFAR detector (0 < pfa < 1)\n");
+                ret = 1;
+                goto cleanup;
+            }
+            printf("[OK] %s-CFAR: %d guard + %d training bins each side, Pfa %g per bin "
+                   "(threshold %.1f dB over the local noise)\n",
+                   cfar_method == KISS_CFAR_OS ? "OS" : "CA", CFAR_GUARD_BINS, CFAR_TRAIN_BINS,
+                   cfar_pfa, 10.0 * log10(kiss_cfar_scale(g_cfar_cfg)));
+        } else if (cfar_method == -2) {
+            if (!(cfar_pfa > 0 && cfar_pfa < 1)) {
+                fprintf(stderr, "[ERROR] Failed to set up CFAR detector (0 < pfa < 1)\n");
+                ret = 1;
+                goto cleanup;
+            }
+            cfar_init_global(cfar_pfa);
+            printf("[OK] Global threshold: Pfa %g per bin (%.1f dB over the %s noise floor)\n",
+                   cfar_pfa, 10.0 * log10(g_cfar_global_scale), frame_noise_name(g_noise_method));
+        }
+        printf("[OK] Noise floor: %s\n", frame_noise_name(g_noise_method));
+        printf("[OK] Window: %s (coherent gain %.3f, ENBW %.2f bins)\n",
+               kiss_window_name(g_window_type), window->coherent_gain, window->enbw);
+        if (psd_average < 0) {
+            printf("[OK] Welch PSD: per frame\n\n");
+        } else if (psd_average == 0) {
+            printf("[OK] Welch PSD: streaming, mean of all segments since the last mode change\n\n");
+        } else {
+            printf("[OK] Welch PSD: streaming, exponential average over ~%d frames\n\n",
+                   psd_average);
+        }
+    }
+
     printf("Controls:\n");
     printf("  Web GUI  - http://localhost:%d\n", web_port);
     printf("  Ctrl+C   - Exit\n\n");
@@ -700,6 +2253,8 @@ int main(int argc, char* argv[]) {
     // Main processing loop
     waveform_mode_t current_mode = MODE_NETWORK_INPUT;
     uint8_t led_pattern = 0;
+    frame_features_t features = {0};
+    float trigger_snr_db = PSD_FLOOR_DB;
 
     while (g_running) {
         // Handle mode change requests
@@ -707,19 +2262,50 @@ int main(int argc, char* argv[]) {
             waveform_mode_t new_mode = (waveform_mode_t)g_requested_mode;
             if (new_mode != current_mode) {
                 current_mode = new_mode;
+                welch_reset();
+                peaks_reset();
                 printf("[*] Mode changed to: %s\n", MODE_NAMES[current_mode]);
             }
         }
+        if (g_requested_num_bands > 0) {
+            if (bands_init(g_requested_edges, g_requested_num_bands)) {
+                // Read on the next frame; nothing stale is served meanwhile
+                memset(band_energies, 0, g_num_bands * sizeof(float));
+                printf("[*] Band set changed: %d bands\n", g_num_bands);
+            } else {
+                fprintf(stderr, "[ERROR] Failed to set up %d bands\n", g_requested_num_bands);
+            }
+            g_requested_num_bands = 0;
+        }
+        if (g_requested_window >= 0) {
+            kiss_window_type type = (kiss_window_type)g_requested_window;
+            g_requested_window = -1;
+            if (type != g_window_type) {
+                if (window_select(type)) {
+                    peaks_reset();
+                    printf("[*] Window changed to: %s\n", kiss_window_name(type));
+                } else {
+                    fprintf(stderr, "[ERROR] Failed to set up %s window\n", kiss_window_name(type));
+                }
+            }
+        }
 
         if (!g_paused) {
             // Get signal data
             if (current_mode == MODE_NETWORK_INPUT && use_network) {
                 // Read from network
-                int samples_read = network_read_samples(&g_network_config,
-                                                       signal_buffer, FFT_SIZE);
+                int samples_read = g_iq ?
+                    network_read_iq(&g_network_config, g_iq_buffer, FFT_SIZE) :
+                    g_ddc_cfg ?
+                    ddc_read_frame(&g_network_config, signal_buffer) :
+                    g_alarm_sdft ?
+                    network_read_frame_alarm(&g_network_config, signal_buffer, FFT_SIZE) :
+                    network_read_samples(&g_network_config, signal_buffer, FFT_SIZE);
                 if (samples_read < 0) {
                     fprintf(stderr, "[ERROR] Network read failed, switching to test mode\n");
                     current_mode = MODE_440HZ;
+                    welch_reset();
+                    peaks_reset();
                 }
             } else {
                 // Generate test waveform when network not available
@@ -765,35 +2351,101 @@ int main(int argc, char* argv[]) {
                         generate_sine_wave(signal_buffer, FFT_SIZE, 440.0f, 0.8f);
                         break;
                 }
+                alarm_process(signal_buffer, FFT_SIZE);
+                if (g_iq) {
+                    iq_from_real(signal_buffer, g_iq_buffer, FFT_SIZE);
+                }
             }
 
-            // Compute FFT
-            compute_fft(signal_buffer, magnitude_buffer, FFT_SIZE);
+            // Optional FIR stage: everything below sees the filtered frame
+            // (alarm bands, fed above, are not combined with it)
+            fir_process(signal_buffer, FFT_SIZE);
+            channelizer_process(signal_buffer, FFT_SIZE);
+
+            if (g_goertzel_cfg) {
+                // Only the requested bins and tones
+                compute_goertzel(signal_buffer, magnitude_buffer, tone_magnitudes, FFT_SIZE);
+            } else if (g_iq) {
+                // Two-sided spectrum and PSD, straight from the I/Q pairs
+                compute_fft_iq(g_iq_buffer, magnitude_buffer, magnitude_db, FFT_SIZE);
+                compute_psd_welch_iq(g_iq_buffer, psd_buffer, FFT_SIZE);
+            } else {
+                // Compute FFT
+                compute_fft(signal_buffer, magnitude_buffer, magnitude_db, FFT_SIZE);
 
-            // Compute PSD
-            compute_psd_welch(signal_buffer, psd_buffer, FFT_SIZE, SAMPLE_RATE);
+                // Compute PSD
+                compute_psd_welch(signal_buffer, psd_buffer, FFT_SIZE);
+            }
+            if (!g_goertzel_cfg) {
+                uint64_t frame_time = (uint64_t)time(NULL) * 1000;
+                spectrogram_push(&g_spectrogram, magnitude_db, frame_time);
+                spectrogram_push(&g_psd_history, psd_buffer, frame_time);
+            }
 
-            // Calculate band energies
-            for (int band = 0; band < NUM_BANDS; band++) {
-                band_energies[band] = get_band_energy(magnitude_buffer, FFT_SIZE,
-                                                     BAND_EDGES[band],
-                                                     BAND_EDGES[band + 1]);
+            // Calculate band energies (RMS magnitude of each band)
+            kiss_bands_rms(g_bands_cfg, magnitude_buffer, band_energies);
+            alarm_band_energies(band_energies);
+
+            // Frame summary, computed once for the trigger, web server and loggers
+            // (in Goertzel mode, over the evaluated bins and tones only)
+            if (g_goertzel_cfg) {
+                frame_features_compute(&features, signal_buffer, FFT_SIZE,
+                                       g_goertzel_mags, goertzel_num_slots(), 0, 0.0f, g_goertzel_freqs,
+                                       psd_buffer, g_psd_bins, band_energies, g_num_bands,
+                                       g_noise_method);
+            } else {
+                // (for IQ input, the time-domain statistics run over I and Q alike,
+                // and DC, where a front end's LO leaks through, is mid-spectrum)
+                frame_features_compute(&features, frame_signal, frame_values,
+                                       magnitude_buffer, g_spectrum_bins, g_iq ? g_spectrum_bins / 2 : 0,
+                                       (float)SAMPLE_RATE / FFT_SIZE,
+                                       g_iq ? g_spectrum_freqs : NULL,
+                                       psd_buffer, g_psd_bins, band_energies, g_num_bands,
+                                       g_noise_method);
             }
+            alarm_set_noise_floor(&features);
+            peaks_update(magnitude_buffer, &features, (uint64_t)time(NULL) * 1000);
+
+            // Auto-record fires on the strongest CFAR detection's SNR over
+            // its local noise; without the detector (or the FFT), on the
+            // frame's peak over the global noise floor
+            trigger_snr_db = (g_cfar_cfg || g_cfar_global) && !g_goertzel_cfg ?
+                cfar_update(magnitude_buffer, features.noise_floor) : features.snr_db;
         }
 
         // Update web interface (ALWAYS, even when paused)
         if (g_web_server_fd >= 0) {
+            const kiss_window* frame_window = kiss_window_get(g_window_type, FFT_SIZE);
             fft_data_t web_data = {
                 .fft_size = FFT_SIZE,
                 .sample_rate = SAMPLE_RATE,
-                .num_bands = NUM_BANDS,
-                .psd_size = 128,
-                .time_domain = signal_buffer,
+                .num_bands = g_num_bands,
+                .psd_size = g_psd_bins,
+                .iq = g_iq,
+                .time_domain = frame_signal,
                 .magnitude = magnitude_buffer,
+                .magnitude_db = g_goertzel_cfg ? NULL : magnitude_db,
                 .psd = psd_buffer,
                 .band_energies = band_energies,
+                .band_edges = g_band_edges,
+                .features = &features,
+                .num_tones = g_goertzel_cfg ? g_goertzel_num_tones : 0,
+                .tone_freqs = g_goertzel_tone_freqs,
+                .tone_magnitudes = tone_magnitudes,
+                .num_channels = g_pfb_cfg ? g_pfb_channels / 2 + 1 : 0,
+                .channel_freqs = g_channel_freqs,
+                .channel_power = g_channel_power,
+                .num_peaks = g_num_peak_tracks,
+                .peaks = g_peak_tracks,
+                .num_detections = g_goertzel_cfg ? 0 : g_num_detections,
+                .detections = g_detections,
+                .spectrogram = g_goertzel_cfg ? NULL : &g_spectrogram,
+                .psd_history = g_goertzel_cfg ? NULL : &g_psd_history,
                 .led_pattern = led_pattern,
                 .mode_name = MODE_NAMES[current_mode],
+                .window_name = kiss_window_name(g_window_type),
+                .window_coherent_gain = frame_window ? (float)frame_window->coherent_gain : 1.0f,
+                .window_enbw = frame_window ? (float)frame_window->enbw : 1.0f,
                 .paused = g_paused,
                 .web_control_active = true,  // Always true (no hardware switches)
                 .timestamp = (uint64_t)time(NULL) * 1000
@@ -802,23 +2454,25 @@ int main(int argc, char* argv[]) {
             web_server_update_data(&web_data);
             web_server_handle_requests(g_web_server_fd);
 
-            // Calculate SNR for auto-record triggering
-            float current_snr = data_logger_calculate_snr(magnitude_buffer, FFT_SIZE, SAMPLE_RATE);
-
             // Check auto-record trigger
-            data_logger_check_auto_trigger(&g_data_logger, current_snr, FFT_SIZE, SAMPLE_RATE);
+            data_logger_check_auto_trigger(&g_data_logger, trigger_snr_db, FFT_SIZE, SAMPLE_RATE);
 
             // Log data if logging is active
             if (data_logger_is_active(&g_data_logger)) {
                 data_logger_write_frame(&g_data_logger,
-                                       signal_buffer,
+                                       frame_signal,
                                        magnitude_buffer,
                                        psd_buffer,
+                                       &features,
                                        web_data.timestamp);
             }
         }
 
-        usleep(UPDATE_RATE_MS * 1000);
+        // With alarm bands on a network source, the blocking reads pace the
+        // loop; sleeping would only let input queue up behind the trigger
+        if (!(g_alarm_sdft && current_mode == MODE_NETWORK_INPUT && use_network)) {
+            usleep(UPDATE_RATE_MS * 1000);
+        }
     }
 
 cleanup:
@@ -839,8 +2493,10 @@ cleanup:
 
     free(signal_buffer);
     free(magnitude_buffer);
+    free(magnitude_db);
     free(psd_buffer);
     free(band_energies);
+    dsp_cleanup();
 
     cleanup_winsock();
 
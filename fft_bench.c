@@ -0,0 +1,2338 @@
+/*
+ * fft_bench.c
+ *
+ * Microbenchmarks for the analyzer's FFT hot path, in output order:
+ *   - Frame: a FFT_SIZE spectrum plus the Welch segments, with each of the
+ *     ways compute_fft() has run it
+ *   - Butterfly kernels: SIMD levels bit-for-bit against scalar, and timed
+ *   - Batched transforms: kiss_fft_batch on codelet and generic sizes
+ *   - Codelets: fixed-size codelets against the generic kf_work path
+ *   - Autotuned plans: the autotuner and its wisdom file
+ *   - Large transforms: multithreaded million-point kiss_fftmt
+ *   - Awkward sizes: Bluestein, checked in double and against the next
+ *     fast size
+ *   - Welch PSD: streaming real and complex (I/Q) segments
+ *   - Windows: window tables and kiss_fftr_windowed
+ *   - Spectrum kernels: magnitude and dB
+ *   - Band energies, peak picking, CFAR detector and noise floor estimators
+ *   - Frame features of an I/Q spectrum with a DC offset
+ *   - FIR stage: overlap-save kiss_fastfir
+ *   - Downconverter and channelizer
+ *   - Zoom: the chirp-z transform
+ *   - Sliding DFT used for alarm bands, unwindowed and windowed
+ *   - Goertzel bank against the frame FFT and Welch PSD it skips
+ *
+ * Usage:
+ *   ./fft_bench [iterations]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <time.h>
+#endif
+
+#include "kiss_fft.h"
+#include "kiss_fft_wisdom.h"
+#include "kiss_fftr.h"
+#include "kiss_fftmt.h"
+#include "kiss_czt.h"
+#include "kiss_fastfir.h"
+#include "kiss_pfb.h"
+#include "kiss_welch.h"
+#include "kiss_window.h"
+#include "kiss_spectrum.h"
+#include "kiss_bands.h"
+#include "kiss_peaks.h"
+#include "kiss_cfar.h"
+#include "kiss_noise.h"
+#include "kiss_ddc.h"
+#include "kiss_sdft.h"
+#include "kiss_goertzel.h"
+#include "kfc.h"
+#include "frame_features.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+// Some float references below are compared bit-for-bit with the library,
+// which never contracts a*b+c into an FMA; neither may they.
+#if defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#elif defined(__GNUC__)
+#pragma GCC optimize("fp-contract=off")
+#endif
+
+/*===========================================================================
+ * Configuration (mirrors fft_analyzer_network.c)
+ *===========================================================================*/
+
+#define FFT_SIZE            512
+#define SAMPLE_RATE         8000
+#define WELCH_SEGMENT_SIZE  256
+#define DEFAULT_ITERATIONS  20000
+#define MAX_CHECK_SIZE      4096
+
+/*===========================================================================
+ * Timing Helpers
+ *===========================================================================*/
+
+static double now_seconds(void) {
+#ifdef _WIN32
+    LARGE_INTEGER freq, count;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&count);
+    return (double)count.QuadPart / (double)freq.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+#endif
+}
+
+// Keeps the optimizer from discarding results
+static volatile float g_sink = 0.0f;
+
+/*===========================================================================
+ * Frame Workloads
+ *===========================================================================*/
+
+// Original compute_fft(): plan build and buffer allocation on every call
+static void fft_uncached(const float* input, float* magnitude, int size) {
+    kiss_fft_cfg cfg = kiss_fft_alloc(size, 0, NULL, NULL);
+    kiss_fft_cpx* fft_in = (kiss_fft_cpx*)malloc(size * sizeof(kiss_fft_cpx));
+    kiss_fft_cpx* fft_out = (kiss_fft_cpx*)malloc(size * sizeof(kiss_fft_cpx));
+
+    for (int i = 0; i < size; i++) {
+        fft_in[i].r = input[i];
+        fft_in[i].i = 0.0f;
+    }
+
+    kiss_fft(cfg, fft_in, fft_out);
+
+    for (int i = 0; i < size / 2; i++) {
+        magnitude[i] = sqrtf(fft_out[i].r * fft_out[i].r +
+                            fft_out[i].i * fft_out[i].i);
+    }
+
+    free(fft_in);
+    free(fft_out);
+    kiss_fft_free(cfg);
+}
+
+// Cached complex plan, persistent work buffers
+static kiss_fft_cpx g_fft_in[FFT_SIZE];
+static kiss_fft_cpx g_fft_out[FFT_SIZE];
+
+static void fft_cached(const float* input, float* magnitude, int size) {
+    kiss_fft_cfg cfg = kfc_getcfg(size, 0);
+
+    for (int i = 0; i < size; i++) {
+        g_fft_in[i].r = input[i];
+        g_fft_in[i].i = 0.0f;
+    }
+
+    kiss_fft(cfg, g_fft_in, g_fft_out);
+
+    for (int i = 0; i < size / 2; i++) {
+        magnitude[i] = sqrtf(g_fft_out[i].r * g_fft_out[i].r +
+                            g_fft_out[i].i * g_fft_out[i].i);
+    }
+}
+
+// Current compute_fft(): cached real-input plan, no input packing
+static void fft_cached_real(const float* input, float* magnitude, int size) {
+    kiss_fftr_cfg cfg = kfc_getcfgr(size, 0);
+
+    kiss_fftr(cfg, input, g_fft_out);
+
+    for (int i = 0; i < size / 2; i++) {
+        magnitude[i] = sqrtf(g_fft_out[i].r * g_fft_out[i].r +
+                            g_fft_out[i].i * g_fft_out[i].i);
+    }
+}
+
+typedef void (*fft_fn)(const float* input, float* magnitude, int size);
+
+// One analyzer frame: full spectrum plus 50%-overlap Welch segments
+static void run_frame(fft_fn fft, const float* signal, float* magnitude, float* segment_mag) {
+    fft(signal, magnitude, FFT_SIZE);
+    for (int start = 0; start <= FFT_SIZE - WELCH_SEGMENT_SIZE; start += WELCH_SEGMENT_SIZE / 2) {
+        fft(signal + start, segment_mag, WELCH_SEGMENT_SIZE);
+    }
+    g_sink += magnitude[FFT_SIZE / 8] + segment_mag[WELCH_SEGMENT_SIZE / 8];
+}
+
+// Current frame: real spectrum plus the Welch segments in one kiss_fftr_batch
+// call (a loop over the 128-pt codelet in float builds)
+static kiss_fft_cpx g_batch_out[4 * (WELCH_SEGMENT_SIZE / 2 + 1)];
+
+static void run_frame_batched(const float* signal, float* magnitude, float* segment_mag) {
+    const int segment_bins = WELCH_SEGMENT_SIZE / 2 + 1;
+    const int num_segments = (FFT_SIZE - WELCH_SEGMENT_SIZE) / (WELCH_SEGMENT_SIZE / 2) + 1;
+
+    fft_cached_real(signal, magnitude, FFT_SIZE);
+    kiss_fftr_batch(kfc_getcfgr(WELCH_SEGMENT_SIZE, 0), num_segments, signal,
+                    WELCH_SEGMENT_SIZE / 2, g_batch_out, segment_bins);
+    for (int seg = 0; seg < num_segments; seg++) {
+        for (int i = 0; i < WELCH_SEGMENT_SIZE / 2; i++) {
+            const kiss_fft_cpx* x = &g_batch_out[seg * segment_bins + i];
+            segment_mag[i] = sqrtf(x->r * x->r + x->i * x->i);
+        }
+    }
+    g_sink += magnitude[FFT_SIZE / 8] + segment_mag[WELCH_SEGMENT_SIZE / 8];
+}
+
+static double time_frames_batched(const float* signal, int iterations) {
+    float magnitude[FFT_SIZE / 2];
+    float segment_mag[WELCH_SEGMENT_SIZE / 2];
+
+    for (int i = 0; i < iterations / 10 + 1; i++) {
+        run_frame_batched(signal, magnitude, segment_mag);
+    }
+
+    double start = now_seconds();
+    for (int i = 0; i < iterations; i++) {
+        run_frame_batched(signal, magnitude, segment_mag);
+    }
+    return (now_seconds() - start) / iterations;
+}
+
+static double time_frames(fft_fn fft, const float* signal, int iterations) {
+    float magnitude[FFT_SIZE / 2];
+    float segment_mag[WELCH_SEGMENT_SIZE / 2];
+
+    // Warm up caches (and the plan cache for the cached path)
+    for (int i = 0; i < iterations / 10 + 1; i++) {
+        run_frame(fft, signal, magnitude, segment_mag);
+    }
+
+    double start = now_seconds();
+    for (int i = 0; i < iterations; i++) {
+        run_frame(fft, signal, magnitude, segment_mag);
+    }
+    return (now_seconds() - start) / iterations;
+}
+
+/*===========================================================================
+ * SIMD Butterfly Kernels
+ *===========================================================================*/
+
+static void fill_test_vector(kiss_fft_cpx* x, int n) {
+    srand(1234);
+    for (int i = 0; i < n; i++) {
+        x[i].r = (float)rand() / RAND_MAX * 2.0f - 1.0f;
+        x[i].i = (float)rand() / RAND_MAX * 2.0f - 1.0f;
+    }
+}
+
+// Returns the number of (size, direction, level) combinations that differ
+static int check_simd_bit_exact(int best_level) {
+    static const int sizes[] = { 2, 8, 60, 64, 120, 256, 360, 512, 1000, 1024, 2048, 4096, 1536, 3000 };
+    static kiss_fft_cpx in[MAX_CHECK_SIZE];
+    static kiss_fft_cpx ref[MAX_CHECK_SIZE];
+    static kiss_fft_cpx out[MAX_CHECK_SIZE];
+    int failures = 0;
+
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        int n = sizes[s];
+        fill_test_vector(in, n);
+
+        // direction x (generic plan, codelet plan where the size has one)
+        for (int variant = 0; variant < 4; variant++) {
+            int inverse = variant & 1;
+            kiss_fft_set_codelets(variant >> 1);
+            kiss_fft_cfg cfg = kiss_fft_alloc(n, inverse, NULL, NULL);
+
+            kiss_fft_set_simd_level(KISS_FFT_SIMD_SCALAR);
+            kiss_fft(cfg, in, ref);
+
+            for (int level = KISS_FFT_SIMD_SSE2; level <= best_level; level++) {
+                kiss_fft_set_simd_level(level);
+                kiss_fft(cfg, in, out);
+                if (memcmp(ref, out, n * sizeof(kiss_fft_cpx)) != 0) {
+                    printf("  MISMATCH: n=%d %s %s%s\n", n, inverse ? "inverse" : "forward",
+                           kiss_fft_simd_name(level), variant >> 1 ? "" : " (generic)");
+                    failures++;
+                }
+            }
+            kiss_fft_free(cfg);
+        }
+    }
+
+    kiss_fft_set_simd_level(best_level);
+    return failures;
+}
+
+static double time_complex_fft(int n, int iterations) {
+    static kiss_fft_cpx in[MAX_CHECK_SIZE];
+    static kiss_fft_cpx out[MAX_CHECK_SIZE];
+    kiss_fft_cfg cfg = kfc_getcfg(n, 0);
+
+    fill_test_vector(in, n);
+    for (int i = 0; i < iterations / 10 + 1; i++) {
+        kiss_fft(cfg, in, out);
+    }
+
+    double start = now_seconds();
+    for (int i = 0; i < iterations; i++) {
+        kiss_fft(cfg, in, out);
+    }
+    double elapsed = (now_seconds() - start) / iterations;
+    g_sink += out[1].r;
+    return elapsed;
+}
+
+// Many same-size transforms: one kiss_fft per vector vs one kiss_fft_batch.
+// A power-of-two size with a codelet is batched as a loop over the codelet;
+// other sizes run interleaved through the kf_work stages.  The batch at every
+// SIMD level must match the scalar loop bit-for-bit.
+static int bench_batch(int iterations) {
+    enum { BATCH_MAX_N = 256, BATCH_COUNT = 16 };
+    static const int sizes[2] = { 256, 240 };
+    static kiss_fft_cpx in[BATCH_MAX_N * BATCH_COUNT];
+    static kiss_fft_cpx out[BATCH_MAX_N * BATCH_COUNT];
+    static kiss_fft_cpx ref[BATCH_MAX_N * BATCH_COUNT];
+    int best_level = kiss_fft_simd_level();
+    int n_iter = iterations / 4 + 1;
+    int failures = 0;
+
+    fill_test_vector(in, BATCH_MAX_N * BATCH_COUNT);
+
+    printf("\nBatched transforms (%d transforms, complex)\n", BATCH_COUNT);
+    printf("  %-8s %-18s %10s %10s %8s   %s\n", "size", "batch runs as", "loop", "batch", "speedup",
+           "vs loop");
+    for (int s = 0; s < 2; s++) {
+        const int n = sizes[s];
+        kiss_fft_cfg cfg = kfc_getcfg(n, 0);
+
+        double start = now_seconds();
+        for (int it = 0; it < n_iter; it++) {
+            for (int b = 0; b < BATCH_COUNT; b++) {
+                kiss_fft(cfg, in + b * n, ref + b * n);
+            }
+        }
+        double t_loop = (now_seconds() - start) / n_iter;
+
+        start = now_seconds();
+        for (int it = 0; it < n_iter; it++) {
+            kiss_fft_batch(cfg, BATCH_COUNT, in, n, out, n);
+        }
+        double t_batch = (now_seconds() - start) / n_iter;
+
+        kiss_fft_set_simd_level(KISS_FFT_SIMD_SCALAR);
+        for (int b = 0; b < BATCH_COUNT; b++) {
+            kiss_fft(cfg, in + b * n, ref + b * n);
+        }
+        int bad_level = -1;
+        for (int level = KISS_FFT_SIMD_SCALAR; level <= best_level; level++) {
+            kiss_fft_set_simd_level(level);
+            kiss_fft_batch(cfg, BATCH_COUNT, in, n, out, n);
+            if (bad_level < 0 && memcmp(ref, out, sizeof(kiss_fft_cpx) * n * BATCH_COUNT) != 0) {
+                bad_level = level;
+            }
+        }
+        kiss_fft_set_simd_level(best_level);
+
+        printf("  %-8d %-18s %7.2f us %7.2f us %7.2fx   ", n,
+               (n & (n - 1)) == 0 ? "codelet loop" : "interleaved stages",
+               t_loop * 1e6, t_batch * 1e6, t_loop / t_batch);
+        if (bad_level < 0) {
+            printf("bit-exact PASS\n");
+        } else {
+            printf("%s FAIL\n", kiss_fft_simd_name(bad_level));
+            failures++;
+        }
+    }
+    return failures;
+}
+
+// Power-of-two sizes: generated codelets vs the generic kf_work plan, both
+// directions, at the host's best SIMD level
+static int bench_codelets(int iterations) {
+    static const int sizes[] = { 64, 128, 256, 512, 1024, 2048, 4096 };
+    static kiss_fft_cpx in[MAX_CHECK_SIZE];
+    static kiss_fft_cpx ref[MAX_CHECK_SIZE];
+    static kiss_fft_cpx out[MAX_CHECK_SIZE];
+    int failures = 0;
+
+    printf("\nFixed-size codelets vs generic plan (%s)\n",
+           kiss_fft_simd_name(kiss_fft_simd_level()));
+    printf("  %-8s %12s %12s %9s %12s\n", "size", "generic", "codelet", "speedup", "rel. error");
+
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        int n = sizes[s];
+        int n_iter = (int)((long long)iterations * 512 / n) + 1;
+        double worst = 0.0;
+        double t[2];
+
+        fill_test_vector(in, n);
+        for (int inverse = 0; inverse <= 1; inverse++) {
+            kiss_fft_set_codelets(0);
+            kiss_fft_cfg generic = kiss_fft_alloc(n, inverse, NULL, NULL);
+            kiss_fft_set_codelets(1);
+            kiss_fft_cfg codelet = kiss_fft_alloc(n, inverse, NULL, NULL);
+
+            kiss_fft(generic, in, ref);
+            kiss_fft(codelet, in, out);
+            double err = 0.0, norm = 0.0;
+            for (int k = 0; k < n; k++) {
+                err += (out[k].r - ref[k].r) * (out[k].r - ref[k].r) +
+                       (out[k].i - ref[k].i) * (out[k].i - ref[k].i);
+                norm += ref[k].r * ref[k].r + ref[k].i * ref[k].i;
+            }
+            err = sqrt(err / norm);
+            if (err > worst) {
+                worst = err;
+            }
+
+            if (!inverse) {
+                kiss_fft_cfg cfgs[2] = { generic, codelet };
+                for (int c = 0; c < 2; c++) {
+                    for (int i = 0; i < n_iter / 10 + 1; i++) {
+                        kiss_fft(cfgs[c], in, out);
+                    }
+                    double start = now_seconds();
+                    for (int i = 0; i < n_iter; i++) {
+                        kiss_fft(cfgs[c], in, out);
+                    }
+                    t[c] = (now_seconds() - start) / n_iter;
+                }
+                g_sink += out[1].r;
+            }
+            kiss_fft_free(generic);
+            kiss_fft_free(codelet);
+        }
+
+        printf("  %-8d %9.2f us %9.2f us %8.2fx %12.1e%s\n", n, t[0] * 1e6, t[1] * 1e6,
+               t[0] / t[1], worst, worst > 1e-5 ? "  FAIL" : "");
+        if (worst > 1e-5) {
+            failures++;
+        }
+    }
+    return failures;
+}
+
+static double time_plan(kiss_fft_cfg cfg, const kiss_fft_cpx* in, kiss_fft_cpx* out, int iterations) {
+    for (int i = 0; i < iterations / 10 + 1; i++) {
+        kiss_fft(cfg, in, out);
+    }
+    double start = now_seconds();
+    for (int i = 0; i < iterations; i++) {
+        kiss_fft(cfg, in, out);
+    }
+    double elapsed = (now_seconds() - start) / iterations;
+    g_sink += out[1].r;
+    return elapsed;
+}
+
+// Autotuner: default plan vs the tuned one, then a save/forget/load round
+// trip through a wisdom file
+static int bench_autotune(int iterations) {
+    static const int sizes[] = { 256, 512, 1000, 1536, 2048, 4096 };
+    static kiss_fft_cpx in[MAX_CHECK_SIZE];
+    static kiss_fft_cpx ref[MAX_CHECK_SIZE];
+    static kiss_fft_cpx out[MAX_CHECK_SIZE];
+    const int num_sizes = (int)(sizeof(sizes) / sizeof(sizes[0]));
+    const char* path = "fft_bench_wisdom.tmp";
+    char plans[sizeof(sizes) / sizeof(sizes[0])][64];
+    int failures = 0;
+
+    kiss_fft_wisdom_forget();
+    printf("\nAutotuned plans (%s)\n", kiss_fft_simd_name(kiss_fft_simd_level()));
+    printf("  %-8s %12s %12s %9s %10s  %s\n", "size", "default", "tuned", "speedup", "tune time", "plan");
+
+    for (int s = 0; s < num_sizes; s++) {
+        int n = sizes[s];
+        int n_iter = (int)((long long)iterations * 512 / n) + 1;
+
+        fill_test_vector(in, n);
+        kiss_fft_cfg def = kiss_fft_alloc(n, 0, NULL, NULL);
+        double start = now_seconds();
+        int tuned_ok = kiss_fft_tune(n) == 0;
+        double t_tune = now_seconds() - start;
+        kiss_fft_cfg tuned = kiss_fft_alloc(n, 0, NULL, NULL);
+
+        kiss_fft(def, in, ref);
+        kiss_fft(tuned, in, out);
+        double err = 0.0, norm = 0.0;
+        for (int k = 0; k < n; k++) {
+            err += (out[k].r - ref[k].r) * (out[k].r - ref[k].r) +
+                   (out[k].i - ref[k].i) * (out[k].i - ref[k].i);
+            norm += ref[k].r * ref[k].r + ref[k].i * ref[k].i;
+        }
+        err = sqrt(err / norm);
+
+        double t_def = time_plan(def, in, out, n_iter);
+        double t_tuned = time_plan(tuned, in, out, n_iter);
+        if (!kiss_fft_wisdom_describe(n, plans[s], sizeof(plans[s]))) {
+            plans[s][0] = '\0';
+        }
+        printf("  %-8d %9.2f us %9.2f us %8.2fx %7.1f ms  %s%s\n", n, t_def * 1e6,
+               t_tuned * 1e6, t_def / t_tuned, t_tune * 1e3, plans[s],
+               !tuned_ok || err > 1e-5 ? "  FAIL" : "");
+        if (!tuned_ok || err > 1e-5) {
+            failures++;
+        }
+        kiss_fft_free(def);
+        kiss_fft_free(tuned);
+    }
+
+    int saved = kiss_fft_wisdom_save(path);
+    kiss_fft_wisdom_forget();
+    int loaded = kiss_fft_wisdom_load(path);
+    int same = saved == num_sizes && loaded == num_sizes;
+    for (int s = 0; s < num_sizes && same; s++) {
+        char plan[64];
+        same = kiss_fft_wisdom_describe(sizes[s], plan, sizeof(plan)) && strcmp(plan, plans[s]) == 0;
+    }
+    remove(path);
+    printf("  %-32s %s (%d sizes)\n", "wisdom file save/load", same ? "PASS" : "FAIL", loaded);
+    if (!same) {
+        failures++;
+    }
+
+    // A Bluestein size tunes exactly the sub-FFT its plans are built on
+    static const int awkward[] = { 127, 998, 1009 };
+    for (size_t s = 0; s < sizeof(awkward) / sizeof(awkward[0]); s++) {
+        int n = awkward[s];
+        int m = kiss_fft_bluestein_size(n);
+        kiss_fft_wisdom_forget();
+        int ok = m > 0 && kiss_fft_tune(n) == 0 && kiss_fft_wisdom_has(m) &&
+                 kiss_fft_wisdom_save(path) == 1;
+        remove(path);
+        char label[40];
+        snprintf(label, sizeof(label), "Bluestein %d tunes sub-FFT", n);
+        printf("  %-32s %s (%d points)\n", label, ok ? "PASS" : "FAIL", m);
+        if (!ok) {
+            failures++;
+        }
+    }
+
+    kiss_fft_wisdom_forget();
+    return failures;
+}
+
+// 2^20 and 2^22 points: one kiss_fft plan vs the four-step kiss_fftmt at
+// 1, 2, 4, ... threads up to the CPU count
+static int bench_large_fft(int iterations) {
+    static const int sizes[] = { 1 << 20, 1 << 22 };
+    const int cpus = kiss_fftmt_cpu_count();
+    int failures = 0;
+
+    printf("\nLarge transforms (four-step kiss_fftmt, %d CPU%s)\n", cpus, cpus == 1 ? "" : "s");
+    printf("  %-8s %-12s %12s %9s %12s\n", "size", "plan", "time", "speedup", "rel. error");
+
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        int n = sizes[s];
+        int n_iter = (int)((long long)iterations * 512 / n / 8) + 2;
+        kiss_fft_cpx* in = (kiss_fft_cpx*)malloc(sizeof(kiss_fft_cpx) * n);
+        kiss_fft_cpx* ref = (kiss_fft_cpx*)malloc(sizeof(kiss_fft_cpx) * n);
+        kiss_fft_cpx* out = (kiss_fft_cpx*)malloc(sizeof(kiss_fft_cpx) * n);
+        kiss_fft_cfg single = kiss_fft_alloc(n, 0, NULL, NULL);
+        if (!in || !ref || !out || !single) {
+            printf("  %-8d allocation failed\n", n);
+            free(in); free(ref); free(out); kiss_fft_free(single);
+            failures++;
+            continue;
+        }
+        for (int k = 0; k < n; k++) {
+            in[k].r = (float)((k * 37 % 101) / 50.0 - 1.0);
+            in[k].i = (float)((k * 61 % 103) / 51.0 - 1.0);
+        }
+
+        kiss_fft(single, in, ref);
+        double start = now_seconds();
+        for (int i = 0; i < n_iter; i++) {
+            kiss_fft(single, in, ref);
+        }
+        double t_single = (now_seconds() - start) / n_iter;
+        printf("  %-8d %-12s %9.2f ms\n", n, "kiss_fft", t_single * 1e3);
+
+        for (int threads = 1; threads <= cpus; threads *= 2) {
+            kiss_fftmt_cfg cfg = kiss_fftmt_alloc(n, 0, threads, NULL, NULL);
+            char label[32];
+            if (!cfg) {
+                failures++;
+                break;
+            }
+            kiss_fftmt(cfg, in, out);
+            start = now_seconds();
+            for (int i = 0; i < n_iter; i++) {
+                kiss_fftmt(cfg, in, out);
+            }
+            double t = (now_seconds() - start) / n_iter;
+
+            double err = 0.0, norm = 0.0;
+            for (int k = 0; k < n; k++) {
+                err += (out[k].r - ref[k].r) * (out[k].r - ref[k].r) +
+                       (out[k].i - ref[k].i) * (out[k].i - ref[k].i);
+                norm += ref[k].r * ref[k].r + ref[k].i * ref[k].i;
+            }
+            err = sqrt(err / norm);
+            snprintf(label, sizeof(label), "%d thread%s", threads, threads == 1 ? "" : "s");
+            printf("  %-8s %-12s %9.2f ms %8.2fx %12.1e%s\n", "", label, t * 1e3,
+                   t_single / t, err, err > 1e-5 ? "  FAIL" : "");
+            if (err > 1e-5) {
+                failures++;
+            }
+            kiss_fftmt_free(cfg);
+            if (threads < cpus && threads * 2 > cpus) {
+                threads = cpus / 2;  // finish with all CPUs
+            }
+        }
+
+        kiss_fft_free(single);
+        free(in);
+        free(ref);
+        free(out);
+    }
+
+    kiss_fftmt_cleanup();
+    return failures;
+}
+
+// Prime and awkward sizes go through Bluestein; compare against a double DFT
+// and against the nearest 2,3,5-smooth size
+static int bench_awkward_sizes(int iterations) {
+    static const int sizes[] = { 127, 998, 1009, 1005, 2048 + 1, 4093 };
+    static kiss_fft_cpx in[MAX_CHECK_SIZE];
+    static kiss_fft_cpx out[MAX_CHECK_SIZE];
+    static double tw_r[MAX_CHECK_SIZE];
+    static double tw_i[MAX_CHECK_SIZE];
+    int failures = 0;
+
+    printf("\nAwkward sizes (Bluestein above prime factor 31)\n");
+    printf("  %-8s %12s %6s %12s %12s\n", "size", "time", "fast", "time", "rel. error");
+
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        int n = sizes[s];
+        int fast = kiss_fft_next_fast_size(n);
+        int n_iter = (int)((long long)iterations * 512 / n) / 4 + 1;
+        kiss_fft_cfg cfg = kfc_getcfg(n, 0);
+
+        fill_test_vector(in, n);
+        kiss_fft(cfg, in, out);
+
+        for (int k = 0; k < n; k++) {
+            tw_r[k] = cos(-2.0 * M_PI * k / n);
+            tw_i[k] = sin(-2.0 * M_PI * k / n);
+        }
+        double err = 0.0, ref = 0.0;
+        for (int k = 0; k < n; k++) {
+            double sr = 0.0, si = 0.0;
+            for (int j = 0, idx = 0; j < n; j++, idx = (idx + k) % n) {
+                sr += in[j].r * tw_r[idx] - in[j].i * tw_i[idx];
+                si += in[j].r * tw_i[idx] + in[j].i * tw_r[idx];
+            }
+            err += (sr - out[k].r) * (sr - out[k].r) + (si - out[k].i) * (si - out[k].i);
+            ref += sr * sr + si * si;
+        }
+        err = sqrt(err / ref);
+        if (err > 1e-5) {
+            failures++;
+        }
+
+        double t = time_complex_fft(n, n_iter);
+        double t_fast = time_complex_fft(fast, n_iter);
+        printf("  %-8d %9.2f us %6d %9.2f us %12.1e%s\n", n, t * 1e6, fast, t_fast * 1e6, err,
+               err > 1e-5 ? "  FAIL" : "");
+    }
+    return failures;
+}
+
+// FIR stage: overlap-save over 512-sample frames vs direct convolution
+static int bench_fastfir(int iterations) {
+    static const int tap_counts[] = { 63, 255, 1023, 4095 };
+    enum { FRAMES = 10 };  // the direct form reads 4094 samples back from the last frame
+    static float in[FRAMES * FFT_SIZE];
+    static float out[FRAMES * FFT_SIZE];
+    static float taps[4095];
+    int failures = 0;
+
+    printf("\nFIR stage (overlap-save, %d-sample frames)\n", FFT_SIZE);
+    printf("  %-8s %8s %12s %12s %9s %12s\n", "taps", "block", "direct", "fast", "speedup", "rel. error");
+
+    for (int i = 0; i < FRAMES * FFT_SIZE; i++) {
+        in[i] = (float)((i * 37 % 101) / 50.0 - 1.0);
+    }
+
+    for (size_t c = 0; c < sizeof(tap_counts) / sizeof(tap_counts[0]); c++) {
+        int ntaps = tap_counts[c];
+        for (int j = 0; j < ntaps; j++) {
+            taps[j] = (float)(sin(0.05 * j + 0.3) * exp(-3.0 * j / ntaps));
+        }
+        int nfft = kiss_fftr_next_fast_size_real(ntaps - 1 + FFT_SIZE);
+        kiss_fastfir_cfg cfg = kiss_fastfir_alloc(taps, ntaps, nfft, NULL, NULL);
+        if (!cfg) {
+            failures++;
+            continue;
+        }
+
+        // Accuracy over several frames, so the history carries across calls
+        for (int f = 0; f < FRAMES; f++) {
+            kiss_fastfir(cfg, in + f * FFT_SIZE, out + f * FFT_SIZE, FFT_SIZE);
+        }
+        double err = 0.0, norm = 0.0;
+        for (int t = 0; t < FRAMES * FFT_SIZE; t++) {
+            double y = 0.0;
+            for (int j = 0; j < ntaps && j <= t; j++) {
+                y += (double)taps[j] * in[t - j];
+            }
+            err += (out[t] - y) * (out[t] - y);
+            norm += y * y;
+        }
+        err = sqrt(err / norm);
+
+        // Time per frame; the direct form is the same loop in float
+        int n_iter = iterations / 20 + 1;
+        int d_iter = (int)((long long)n_iter * 63 / ntaps) + 1;
+        double start = now_seconds();
+        for (int it = 0; it < d_iter; it++) {
+            const float* x = in + FFT_SIZE * (FRAMES - 1);
+            for (int t = 0; t < FFT_SIZE; t++) {
+                float y = 0.0f;
+                for (int j = 0; j < ntaps; j++) {
+                    y += taps[j] * x[t - j];
+                }
+                out[t] = y;
+            }
+        }
+        double t_direct = (now_seconds() - start) / d_iter;
+        g_sink += out[1];
+
+        start = now_seconds();
+        for (int it = 0; it < n_iter; it++) {
+            kiss_fastfir(cfg, in, out, FFT_SIZE);
+        }
+        double t_fast = (now_seconds() - start) / n_iter;
+        g_sink += out[1];
+
+        printf("  %-8d %8d %9.2f us %9.2f us %8.2fx %12.1e%s\n", ntaps, nfft, t_direct * 1e6,
+               t_fast * 1e6, t_direct / t_fast, err, err > 1e-5 ? "  FAIL" : "");
+        if (err > 1e-5) {
+            failures++;
+        }
+        kiss_fastfir_free(cfg);
+    }
+    return failures;
+}
+
+// Standard deviation in dB of a PSD estimate over its interior bins; the
+// true PSD of white noise is flat, so this is the estimate's own noise
+static double psd_spread_db(const float* power, int bins) {
+    double s1 = 0.0, s2 = 0.0;
+    for (int k = 1; k < bins - 1; k++) {
+        double d = 10.0 * log10(power[k]);
+        s1 += d;
+        s2 += d * d;
+    }
+    s1 /= bins - 2;
+    return sqrt(s2 / (bins - 2) - s1 * s1);
+}
+
+// Welch PSD: the per-frame estimate (3 segments) vs the streaming one
+// averaged across frames, on white noise
+static int bench_welch_stream(int iterations) {
+    enum { FRAMES = 64, HOP = WELCH_SEGMENT_SIZE / 2, BINS = WELCH_SEGMENT_SIZE / 2 + 1 };
+    const int frame_segments = (FFT_SIZE - WELCH_SEGMENT_SIZE) / HOP + 1;
+    static float stream[FRAMES * FFT_SIZE];
+    static float power[BINS];
+    static double ref[BINS];
+    static kiss_fft_cpx spec[4 * BINS];
+    int failures = 0;
+
+    srand(99);
+    for (int i = 0; i < FRAMES * FFT_SIZE; i++) {
+        stream[i] = (float)rand() / RAND_MAX * 2.0f - 1.0f;
+    }
+    kiss_fftr_cfg seg_cfg = kfc_getcfgr(WELCH_SEGMENT_SIZE, 0);
+
+    printf("\nWelch PSD (%d-pt segments, hop %d, %d-sample frames of white noise)\n",
+           WELCH_SEGMENT_SIZE, HOP, FFT_SIZE);
+    printf("  %-30s %10s %12s %14s\n", "estimate", "segments", "us/frame", "spread");
+
+    // Per frame, as compute_psd_welch() did: the last frame's 3 segments only
+    kiss_fftr_batch(seg_cfg, frame_segments, stream + (FRAMES - 1) * FFT_SIZE, HOP, spec, BINS);
+    for (int k = 0; k < BINS; k++) {
+        double p = 0.0;
+        for (int s = 0; s < frame_segments; s++) {
+            p += (double)spec[s * BINS + k].r * spec[s * BINS + k].r +
+                 (double)spec[s * BINS + k].i * spec[s * BINS + k].i;
+        }
+        power[k] = (float)(p / frame_segments);
+    }
+    int n_iter = iterations / 4 + 1;
+    double start = now_seconds();
+    for (int it = 0; it < n_iter; it++) {
+        kiss_fftr_batch(seg_cfg, frame_segments, stream + (it % FRAMES) * FFT_SIZE, HOP, spec, BINS);
+    }
+    double t_frame = (now_seconds() - start) / n_iter;
+    g_sink += spec[1].r;
+    printf("  %-30s %10d %9.2f us %11.2f dB\n", "one frame", frame_segments, t_frame * 1e6,
+           psd_spread_db(power, BINS));
+
+    // Streaming mean over all frames, fed in uneven blocks, against the
+    // same segments transformed one by one over the whole stream
+    kiss_welch_cfg mean = kiss_welch_alloc(WELCH_SEGMENT_SIZE, HOP, 0, NULL, NULL);
+    kiss_welch_cfg expo = kiss_welch_alloc(WELCH_SEGMENT_SIZE, HOP, 32, NULL, NULL);
+    if (!mean || !expo) {
+        kiss_welch_free(mean);
+        kiss_welch_free(expo);
+        return 1;
+    }
+    int added = 0;
+    for (int pos = 0; pos < FRAMES * FFT_SIZE;) {
+        int n = pos % 3 == 0 ? 300 : 77;
+        if (n > FRAMES * FFT_SIZE - pos) {
+            n = FRAMES * FFT_SIZE - pos;
+        }
+        added += kiss_welch(mean, stream + pos, n);
+        pos += n;
+    }
+    int total_segments = (FRAMES * FFT_SIZE - WELCH_SEGMENT_SIZE) / HOP + 1;
+    memset(ref, 0, sizeof(ref));
+    for (int s = 0; s < total_segments; s++) {
+        kiss_fftr(seg_cfg, stream + s * HOP, spec);
+        for (int k = 0; k < BINS; k++) {
+            ref[k] += ((double)spec[k].r * spec[k].r + (double)spec[k].i * spec[k].i) / total_segments;
+        }
+    }
+    int count = kiss_welch_psd(mean, power);
+    double err = 0.0, norm = 0.0;
+    for (int k = 0; k < BINS; k++) {
+        err += (power[k] - ref[k]) * (power[k] - ref[k]);
+        norm += ref[k] * ref[k];
+    }
+    err = sqrt(err / norm);
+
+    // Time per frame in steady state (one frame = FFT_SIZE/HOP new segments)
+    kiss_welch_reset(expo);
+    start = now_seconds();
+    for (int it = 0; it < n_iter; it++) {
+        kiss_welch(expo, stream + (it % FRAMES) * FFT_SIZE, FFT_SIZE);
+    }
+    double t_stream = (now_seconds() - start) / n_iter;
+    kiss_welch_psd(expo, power);
+    double spread_exp = psd_spread_db(power, BINS);
+    kiss_welch_psd(mean, power);
+    double spread_mean = psd_spread_db(power, BINS);
+
+    char label[64];
+    snprintf(label, sizeof(label), "streaming mean, %d frames", FRAMES);
+    int bad = err > 1e-5 || added != total_segments || count != total_segments;
+    printf("  %-30s %10d %9.2f us %11.2f dB  (rel. error %.1e)%s\n", label, count,
+           t_stream * 1e6, spread_mean, err, bad ? "  FAIL" : "");
+    printf("  %-30s %10s %9.2f us %11.2f dB\n", "streaming exponential, tau 32", "-",
+           t_stream * 1e6, spread_exp);
+    if (bad) {
+        failures++;
+    }
+    kiss_welch_free(mean);
+    kiss_welch_free(expo);
+    return failures;
+}
+
+// Complex Welch PSD (the analyzer's IQ input): a Hann windowed streaming
+// mean of I/Q noise plus a tone at -1000 Hz, fed in uneven blocks, against
+// per-segment kiss_fft over the whole stream; the tone must come out in
+// the negative half of the FFT order
+static int bench_welch_iq(int iterations) {
+    enum { FRAMES = 32, HOP = WELCH_SEGMENT_SIZE / 2, BINS = WELCH_SEGMENT_SIZE };
+    const int total = FRAMES * FFT_SIZE;
+    const int tone_bin = BINS - 1000 * BINS / SAMPLE_RATE;
+    static kiss_fft_cpx stream[FRAMES * FFT_SIZE];
+    static kiss_fft_cpx seg[BINS], spec[BINS];
+    static float power[BINS];
+    static double ref[BINS];
+    int failures = 0;
+
+    srand(7);
+    for (int i = 0; i < total; i++) {
+        double ph = -2.0 * M_PI * 1000.0 * i / SAMPLE_RATE;
+        stream[i].r = (float)(0.5 * cos(ph) + 0.1 * ((float)rand() / RAND_MAX * 2.0f - 1.0f));
+        stream[i].i = (float)(0.5 * sin(ph) + 0.1 * ((float)rand() / RAND_MAX * 2.0f - 1.0f));
+    }
+    const kiss_window* hann = kiss_window_get(KISS_WINDOW_HANN, WELCH_SEGMENT_SIZE);
+    kiss_fft_cfg seg_cfg = kfc_getcfg(WELCH_SEGMENT_SIZE, 0);
+    kiss_welch_cfg mean = kiss_welch_alloc_cpx(WELCH_SEGMENT_SIZE, HOP, 0, NULL, NULL);
+    if (!hann || !seg_cfg || !mean) {
+        kiss_welch_free(mean);
+        return 1;
+    }
+    kiss_welch_set_window(mean, hann->w);
+
+    printf("\nComplex Welch PSD (%d-pt I/Q segments, hop %d, tone at -1000 Hz)\n",
+           WELCH_SEGMENT_SIZE, HOP);
+
+    int added = 0;
+    for (int pos = 0; pos < total;) {
+        int n = pos % 3 == 0 ? 300 : 77;
+        if (n > total - pos) {
+            n = total - pos;
+        }
+        added += kiss_welch_cpx(mean, stream + pos, n);
+        pos += n;
+    }
+    int total_segments = (total - WELCH_SEGMENT_SIZE) / HOP + 1;
+    memset(ref, 0, sizeof(ref));
+    for (int sg = 0; sg < total_segments; sg++) {
+        for (int n = 0; n < BINS; n++) {
+            seg[n].r = stream[sg * HOP + n].r * hann->w[n];
+            seg[n].i = stream[sg * HOP + n].i * hann->w[n];
+        }
+        kiss_fft(seg_cfg, seg, spec);
+        for (int k = 0; k < BINS; k++) {
+            ref[k] += ((double)spec[k].r * spec[k].r + (double)spec[k].i * spec[k].i) / total_segments;
+        }
+    }
+    int count = kiss_welch_psd(mean, power);
+    double err = 0.0, norm = 0.0;
+    int peak = 0;
+    for (int k = 0; k < BINS; k++) {
+        err += (power[k] - ref[k]) * (power[k] - ref[k]);
+        norm += ref[k] * ref[k];
+        if (power[k] > power[peak]) {
+            peak = k;
+        }
+    }
+    err = sqrt(err / norm);
+
+    int n_iter = iterations / 4 + 1;
+    kiss_welch_reset(mean);
+    double start = now_seconds();
+    for (int it = 0; it < n_iter; it++) {
+        kiss_welch_cpx(mean, stream + (it % FRAMES) * FFT_SIZE, FFT_SIZE);
+    }
+    double t_stream = (now_seconds() - start) / n_iter;
+
+    int bad = err > 1e-5 || added != total_segments || count != total_segments || peak != tone_bin;
+    printf("  %d segments, %.2f us/frame, peak in bin %d (expected %d), rel. error %.1e%s\n",
+           count, t_stream * 1e6, peak, tone_bin, err, bad ? "  FAIL" : "");
+    if (bad) {
+        failures++;
+    }
+    kiss_welch_free(mean);
+    return failures;
+}
+
+// Windowed frame spectrum: a cosf per sample, a separate pass over a cached
+// table, and the table applied while kiss_fftr packs its input.  Also
+// checks the batched path against per-segment transforms and how close the
+// coherent-gain corrected peak of an off-bin tone comes to its amplitude.
+static int bench_windows(int iterations) {
+    enum { BINS = FFT_SIZE / 2 + 1, SEG_BINS = WELCH_SEGMENT_SIZE / 2 + 1, HOP = WELCH_SEGMENT_SIZE / 2 };
+    static const double expected_enbw[KISS_WINDOW_COUNT] = { 1.0, 1.5, 2.004, 3.770 };
+    const int num_segments = (FFT_SIZE - WELCH_SEGMENT_SIZE) / HOP + 1;
+    static float tone[FFT_SIZE];
+    static float windowed[FFT_SIZE];
+    static kiss_fft_cpx ref[BINS];
+    static kiss_fft_cpx out[BINS];
+    static kiss_fft_cpx seg_ref[SEG_BINS];
+    static kiss_fft_cpx seg_out[3 * SEG_BINS];
+    kiss_fftr_cfg cfg = kfc_getcfgr(FFT_SIZE, 0);
+    kiss_fftr_cfg seg_cfg = kfc_getcfgr(WELCH_SEGMENT_SIZE, 0);
+    int n_iter = iterations / 2 + 1;
+    int failures = 0;
+
+    // Unit tone half-way between two bins: the worst case for scalloping
+    const double f_tone = 84.5 * SAMPLE_RATE / FFT_SIZE;
+    for (int i = 0; i < FFT_SIZE; i++) {
+        tone[i] = (float)cos(2.0 * M_PI * f_tone * i / SAMPLE_RATE);
+    }
+
+    double start = now_seconds();
+    for (int it = 0; it < n_iter; it++) {
+        kiss_fftr(cfg, tone, out);
+        g_sink += out[84].r;
+    }
+    double t_none = (now_seconds() - start) / n_iter;
+
+    printf("\nWindows (%d-pt frame, unwindowed kiss_fftr %.2f us)\n", FFT_SIZE, t_none * 1e6);
+    printf("  %-16s %6s %6s %12s %11s %10s %10s\n", "window", "CG", "ENBW", "cosf/sample",
+           "table pass", "fused", "peak err");
+
+    for (int type = KISS_WINDOW_HANN; type < KISS_WINDOW_COUNT; type++) {
+        const kiss_window* win = kiss_window_get((kiss_window_type)type, FFT_SIZE);
+        const kiss_window* seg_win = kiss_window_get((kiss_window_type)type, WELCH_SEGMENT_SIZE);
+        if (!win || !seg_win) {
+            return failures + 1;
+        }
+
+        // Naive: the window formula evaluated per sample every frame
+        start = now_seconds();
+        for (int it = 0; it < n_iter; it++) {
+            for (int i = 0; i < FFT_SIZE; i++) {
+                float x = 2.0f * (float)M_PI * i / FFT_SIZE;
+                float w = type == KISS_WINDOW_HANN ? 0.5f - 0.5f * cosf(x) :
+                          type == KISS_WINDOW_BLACKMAN_HARRIS ?
+                              0.35875f - 0.48829f * cosf(x) + 0.14128f * cosf(2 * x)
+                                  - 0.01168f * cosf(3 * x) :
+                              0.21557895f - 0.41663158f * cosf(x) + 0.277263158f * cosf(2 * x)
+                                  - 0.083578947f * cosf(3 * x) + 0.006947368f * cosf(4 * x);
+                windowed[i] = tone[i] * w;
+            }
+            kiss_fftr(cfg, windowed, out);
+            g_sink += out[84].r;
+        }
+        double t_cos = (now_seconds() - start) / n_iter;
+
+        // Cached table, multiplied in a pass of its own
+        start = now_seconds();
+        for (int it = 0; it < n_iter; it++) {
+            for (int i = 0; i < FFT_SIZE; i++) {
+                windowed[i] = tone[i] * win->w[i];
+            }
+            kiss_fftr(cfg, windowed, ref);
+            g_sink += ref[84].r;
+        }
+        double t_table = (now_seconds() - start) / n_iter;
+
+        start = now_seconds();
+        for (int it = 0; it < n_iter; it++) {
+            kiss_fftr_windowed(cfg, tone, win->w, out);
+            g_sink += out[84].r;
+        }
+        double t_fused = (now_seconds() - start) / n_iter;
+
+        // Fused and separate products are the same floats, so the spectra
+        // must match exactly; the batched segments up to rounding
+        int bad = memcmp(ref, out, sizeof(ref)) != 0;
+        kiss_fftr_batch_windowed(seg_cfg, num_segments, tone, HOP, seg_win->w, seg_out, SEG_BINS);
+        for (int seg = 0; seg < num_segments; seg++) {
+            for (int i = 0; i < WELCH_SEGMENT_SIZE; i++) {
+                windowed[i] = tone[seg * HOP + i] * seg_win->w[i];
+            }
+            kiss_fftr(seg_cfg, windowed, seg_ref);
+            for (int k = 0; k < SEG_BINS; k++) {
+                kiss_fft_cpx d = seg_out[seg * SEG_BINS + k];
+                if (fabsf(d.r - seg_ref[k].r) > 1e-4f || fabsf(d.i - seg_ref[k].i) > 1e-4f) {
+                    bad = 1;
+                }
+            }
+        }
+        if (fabs(win->enbw - expected_enbw[type]) > 0.01) {
+            bad = 1;
+        }
+
+        // Amplitude read from the highest bin, corrected by the coherent gain
+        double peak = 0.0;
+        for (int k = 0; k < BINS; k++) {
+            double m = sqrt((double)out[k].r * out[k].r + (double)out[k].i * out[k].i);
+            if (m > peak) peak = m;
+        }
+        double peak_db = 20.0 * log10(2.0 * peak / (FFT_SIZE * win->coherent_gain));
+
+        printf("  %-16s %6.3f %6.3f %9.2f us %8.2f us %7.2f us %7.2f dB%s\n",
+               kiss_window_name((kiss_window_type)type), win->coherent_gain, win->enbw,
+               t_cos * 1e6, t_table * 1e6, t_fused * 1e6, peak_db, bad ? "  FAIL" : "");
+        if (bad) {
+            failures++;
+        }
+    }
+    kiss_window_cleanup();
+    return failures;
+}
+
+// Per-bin post-processing of a frame spectrum: sqrtf and log10f per bin
+// vs the kiss_spectrum kernels at each SIMD level, which fill the linear
+// and dB arrays in one pass.  The dB values are checked against log10 in
+// double over the whole float range.
+static int bench_spectrum_kernels(int iterations) {
+    enum { BINS = FFT_SIZE / 2 + 1, SWEEP = 4096 };
+    static kiss_fft_cpx spectrum[BINS];
+    static float mag[BINS], db[BINS], ref_mag[BINS], ref_db[BINS];
+    static float sweep[SWEEP], sweep_db[SWEEP];
+    int best_level = kiss_fft_simd_level();
+    int n_iter = iterations + 1;
+    int failures = 0;
+
+    // Bins spread over 120 dB, as a real spectrum with a noise floor
+    srand(7);
+    for (int k = 0; k < BINS; k++) {
+        double level = pow(10.0, -6.0 * rand() / RAND_MAX);
+        spectrum[k].r = (float)(level * ((double)rand() / RAND_MAX - 0.5) * FFT_SIZE);
+        spectrum[k].i = (float)(level * ((double)rand() / RAND_MAX - 0.5) * FFT_SIZE);
+    }
+    for (int i = 0; i < SWEEP; i++) {
+        sweep[i] = (float)pow(10.0, -37.0 + 74.0 * i / (SWEEP - 1));
+    }
+
+    double start = now_seconds();
+    for (int it = 0; it < n_iter; it++) {
+        for (int k = 0; k < BINS; k++) {
+            ref_mag[k] = sqrtf(spectrum[k].r * spectrum[k].r + spectrum[k].i * spectrum[k].i);
+            ref_db[k] = 20.0f * log10f(ref_mag[k] + 1e-6f);
+        }
+        g_sink += ref_db[BINS / 2];
+    }
+    double t_libm = (now_seconds() - start) / n_iter;
+
+    printf("\nSpectrum kernels (%d bins, magnitude + dB, sqrtf/log10f loop %.2f us)\n",
+           BINS, t_libm * 1e6);
+    printf("  %-8s %12s %12s %14s\n", "level", "mag+dB", "power+dB", "max dB error");
+
+    float first_db[BINS], first_sweep[SWEEP];
+    int exact = 1;
+    for (int level = KISS_FFT_SIMD_SCALAR; level <= best_level; level++) {
+        kiss_fft_set_simd_level(level);
+
+        start = now_seconds();
+        for (int it = 0; it < n_iter; it++) {
+            kiss_spectrum_mag_db(spectrum, BINS, 1.0f, 1e-6f, mag, db);
+            g_sink += db[BINS / 2];
+        }
+        double t_mag = (now_seconds() - start) / n_iter;
+
+        start = now_seconds();
+        for (int it = 0; it < n_iter; it++) {
+            kiss_spectrum_power_db(spectrum, BINS, 1.0f, 1e-10f, mag, db);
+            g_sink += db[BINS / 2];
+        }
+        double t_power = (now_seconds() - start) / n_iter;
+
+        // Error against the exact value of what the kernel was given
+        double err = 0.0;
+        kiss_spectrum_db(sweep, SWEEP, 1.0f, 0.0f, 10.0f, sweep_db);
+        for (int i = 0; i < SWEEP; i++) {
+            double d = fabs(sweep_db[i] - 10.0 * log10((double)sweep[i]));
+            if (d > err) err = d;
+        }
+        kiss_spectrum_mag_db(spectrum, BINS, 1.0f, 1e-6f, mag, db);
+        for (int k = 0; k < BINS; k++) {
+            double d = fabs(db[k] - 20.0 * log10((double)mag[k] + 1e-6f));
+            if (d > err) err = d;
+            if (mag[k] != ref_mag[k]) exact = 0;
+        }
+
+        if (level == KISS_FFT_SIMD_SCALAR) {
+            memcpy(first_db, db, sizeof(first_db));
+            memcpy(first_sweep, sweep_db, sizeof(first_sweep));
+        } else if (memcmp(first_db, db, sizeof(first_db)) != 0 ||
+                   memcmp(first_sweep, sweep_db, sizeof(first_sweep)) != 0) {
+            exact = 0;
+        }
+
+        printf("  %-8s %9.2f us %9.2f us %11.1e dB%s\n", kiss_fft_simd_name(level), t_mag * 1e6,
+               t_power * 1e6, err, err > 1e-4 ? "  FAIL" : "");
+        if (err > 1e-4) {
+            failures++;
+        }
+    }
+    kiss_fft_set_simd_level(best_level);
+    printf("  SIMD levels %s\n", exact ? "bit-exact" : "MISMATCH  FAIL");
+    if (!exact) {
+        failures++;
+    }
+    return failures;
+}
+
+// RMS band energies with fractional edges: each band walking its own bins
+// vs kiss_bands (one running sum per frame, then two lookups per band), for
+// the default 8 bands up to thousands of bands narrower than a bin, on the
+// analyzer's spectrum and on a 64k-pt one.
+static double bands_walk(const float* mag, int nbins, const double* edges, int nbands,
+                         float* rms) {
+    for (int b = 0; b < nbands; b++) {
+        double lo = edges[b] + 0.5, hi = edges[b + 1] + 0.5, energy = 0.0;
+        if (lo < 0) lo = 0;
+        if (hi > nbins) hi = nbins;
+        for (int k = (int)floor(lo); k < nbins && k < hi; k++) {
+            double w = (hi < k + 1 ? hi : k + 1) - (lo > k ? lo : k);
+            energy += w * mag[k] * mag[k];
+        }
+        rms[b] = hi > lo ? (float)sqrt(energy / (hi - lo)) : 0.0f;
+    }
+    return rms[nbands / 2];
+}
+
+static int bench_bands(int iterations) {
+    enum { MAX_BINS = 32768, MAX_SET = 4096 };
+    static const struct { const char* name; int nbins; int fraction; int linear; } sets[] = {
+        { "default 8", FFT_SIZE / 2, 0, 0 },
+        { "1/3 octave", FFT_SIZE / 2, 3, 0 },
+        { "1/12 octave", FFT_SIZE / 2, 12, 0 },
+        { "linear 4096", FFT_SIZE / 2, 0, 4096 },
+        { "1/12 octave", MAX_BINS, 12, 0 },
+        { "linear 4096", MAX_BINS, 0, 4096 },
+    };
+    static const double default_edges[9] = { 0, 200, 400, 600, 800, 1200, 1600, 2400, 4000 };
+    static float mag[MAX_BINS];
+    static double edges[MAX_SET + 1];
+    static float ref[MAX_SET], rms[MAX_SET];
+    int failures = 0;
+
+    srand(11);
+    for (int k = 0; k < MAX_BINS; k++) {
+        mag[k] = (float)(pow(10.0, -4.0 * rand() / RAND_MAX) * FFT_SIZE);
+    }
+
+    printf("\nBand energies (RMS magnitude per band, fractional edges)\n");
+    printf("  %-12s %6s %6s %12s %12s %12s\n", "set", "bins", "bands", "per-band walk",
+           "running sum", "max rel err");
+
+    for (size_t s = 0; s < sizeof(sets) / sizeof(sets[0]); s++) {
+        const int nbins = sets[s].nbins;
+        const double hz_to_bin = 2.0 * nbins / SAMPLE_RATE;
+        int nbands;
+        if (sets[s].fraction > 0) {
+            nbands = kiss_bands_octave(sets[s].fraction, 20.0, SAMPLE_RATE / 2.0, edges, MAX_SET);
+        } else if (sets[s].linear > 0) {
+            nbands = sets[s].linear;
+            for (int b = 0; b <= nbands; b++) {
+                edges[b] = SAMPLE_RATE / 2.0 * b / nbands;
+            }
+        } else {
+            nbands = 8;
+            memcpy(edges, default_edges, sizeof(default_edges));
+        }
+        for (int b = 0; b <= nbands; b++) {
+            edges[b] *= hz_to_bin;
+        }
+
+        kiss_bands_cfg cfg = kiss_bands_alloc(nbands, edges, nbins, NULL, NULL);
+        if (!cfg) {
+            return failures + 1;
+        }
+        int n_iter = (int)((double)iterations * 256 / (nbins + nbands)) + 1;
+
+        double start = now_seconds();
+        for (int it = 0; it < n_iter; it++) {
+            g_sink += bands_walk(mag, nbins, edges, nbands, ref);
+        }
+        double t_walk = (now_seconds() - start) / n_iter;
+
+        start = now_seconds();
+        for (int it = 0; it < n_iter; it++) {
+            kiss_bands_rms(cfg, mag, rms);
+            g_sink += rms[nbands / 2];
+        }
+        double t_sum = (now_seconds() - start) / n_iter;
+
+        double err = 0.0;
+        for (int b = 0; b < nbands; b++) {
+            double d = fabs(rms[b] - ref[b]) / (ref[b] > 0.0f ? ref[b] : 1.0f);
+            if (d > err) err = d;
+        }
+
+        printf("  %-12s %6d %6d %9.2f us %9.2f us %12.1e%s\n", sets[s].name, nbins, nbands,
+               t_walk * 1e6, t_sum * 1e6, err, err > 1e-4 ? "  FAIL" : "");
+        if (err > 1e-4) {
+            failures++;
+        }
+        kiss_bands_free(cfg);
+    }
+    return failures;
+}
+
+// Peak picking: frequency error of the strongest bin, the log-parabola fit
+// (Hann) and Quinn's estimator (no window) over off-bin tones, then the cost
+// of find + track per frame with a few drifting tones, which must keep
+// their track ids
+static int bench_peaks(int iterations) {
+    enum { BINS = FFT_SIZE / 2, TONES = 4, FRAMES = 64 };
+    static float x[FFT_SIZE];
+    static float mag[BINS + 1];
+    static kiss_fft_cpx out[BINS + 1];
+    kiss_fftr_cfg cfg = kfc_getcfgr(FFT_SIZE, 0);
+    const kiss_window* hann = kiss_window_get(KISS_WINDOW_HANN, FFT_SIZE);
+    kiss_peaks_cfg peaks_cfg = kiss_peaks_alloc(BINS, 8, 16, 2.0f, 3, NULL, NULL);
+    kiss_peak peaks[8];
+    double err_argmax = 0.0, err_parabolic = 0.0, err_quinn = 0.0;
+    int failures = 0;
+
+    if (!cfg || !hann || !peaks_cfg) {
+        return 1;
+    }
+
+    // One tone at a time, from on-bin to half a bin either side
+    for (int step = -10; step <= 10; step++) {
+        const double pos = 40.0 + 0.05 * step + 0.0123;
+        for (int i = 0; i < FFT_SIZE; i++) {
+            x[i] = (float)cos(2.0 * M_PI * pos * i / FFT_SIZE);
+        }
+        for (int method = 0; method < 2; method++) {
+            kiss_fftr_windowed(cfg, x, method == 0 ? hann->w : NULL, out);
+            for (int k = 0; k < BINS; k++) {
+                mag[k] = sqrtf(out[k].r * out[k].r + out[k].i * out[k].i);
+            }
+            kiss_peaks_reset(peaks_cfg);
+            if (kiss_peaks_find(peaks_cfg, mag, out, 1e-3f,
+                                method == 0 ? KISS_PEAKS_PARABOLIC : KISS_PEAKS_QUINN, peaks) != 1) {
+                return failures + 1;
+            }
+            double e = fabs(peaks[0].pos - pos);
+            if (method == 0) {
+                if (fabs(peaks[0].bin - pos) > err_argmax) err_argmax = fabs(peaks[0].bin - pos);
+                if (e > err_parabolic) err_parabolic = e;
+            } else if (e > err_quinn) {
+                err_quinn = e;
+            }
+        }
+    }
+
+    printf("\nPeak picking (%d-pt frame, max error over off-bin tones)\n", FFT_SIZE);
+    printf("  %-32s %8.4f bins\n", "strongest bin", err_argmax);
+    printf("  %-32s %8.4f bins%s\n", "log parabola (Hann)", err_parabolic,
+           err_parabolic > 0.1 ? "  FAIL" : "");
+    printf("  %-32s %8.4f bins%s\n", "Quinn (no window)", err_quinn,
+           err_quinn > 0.02 ? "  FAIL" : "");
+    if (err_parabolic > 0.1) failures++;
+    if (err_quinn > 0.02) failures++;
+
+    // Drifting tones, a third of a bin per frame, well apart
+    kiss_peaks_reset(peaks_cfg);
+    int ntracks = 0, n = 0;
+    double t_find = 0.0, t_track = 0.0;
+    int n_iter = iterations / 16 + 1;
+    for (int frame = 0; frame < FRAMES; frame++) {
+        memset(x, 0, sizeof(x));
+        for (int t = 0; t < TONES; t++) {
+            const double pos = 20.0 + 50.0 * t + frame / 3.0;
+            for (int i = 0; i < FFT_SIZE; i++) {
+                x[i] += (float)(0.5 * cos(2.0 * M_PI * pos * i / FFT_SIZE + t));
+            }
+        }
+        kiss_fftr_windowed(cfg, x, hann->w, out);
+        for (int k = 0; k < BINS; k++) {
+            mag[k] = sqrtf(out[k].r * out[k].r + out[k].i * out[k].i);
+        }
+
+        double start = now_seconds();
+        for (int it = 0; it < n_iter; it++) {
+            n = kiss_peaks_find(peaks_cfg, mag, NULL, 1.0f, KISS_PEAKS_PARABOLIC, peaks);
+        }
+        t_find += (now_seconds() - start) / n_iter;
+
+        start = now_seconds();
+        kiss_peaks_track(peaks_cfg, peaks, n);
+        t_track += now_seconds() - start;
+    }
+
+    const kiss_peak_track* tracks = kiss_peaks_tracks(peaks_cfg, &ntracks);
+    int steady = ntracks == TONES;
+    for (int t = 0; steady && t < TONES; t++) {
+        steady = tracks[t].id == t && tracks[t].age == FRAMES - 1;
+    }
+    printf("  %-32s %8.2f us/frame (find) + %.2f us (track), %d tracks over %d frames%s\n",
+           "Hann, 4 drifting tones", t_find / FRAMES * 1e6, t_track / FRAMES * 1e6,
+           ntracks, FRAMES, steady ? "" : "  FAIL");
+    if (!steady) {
+        failures++;
+    }
+
+    kiss_peaks_free(peaks_cfg);
+    return failures;
+}
+
+// CFAR: the false alarm rate on exponential noise against the requested
+// Pfa; a weak tone in a quiet band next to a band of loud noise, against a
+// global threshold over the mean power; and the cost per frame of each
+// method against summing every bin's training window afresh
+static double cfar_exp_noise(void) {
+    return -log((rand() + 1.0) / (RAND_MAX + 2.0));
+}
+
+static int cfar_naive(const float* power, int nbins, int guard, int train, double scale, int* hits) {
+    int nhits = 0;
+    for (int k = 0; k < nbins; k++) {
+        double sum = 0.0;
+        int n = 0;
+        for (int j = k - guard - train; j <= k + guard + train; j++) {
+            if (j >= 0 && j < nbins && (j < k - guard || j > k + guard)) {
+                sum += power[j];
+                n++;
+            }
+        }
+        if (n > 0 && power[k] > scale * sum / n) {
+            hits[nhits++] = k;
+        }
+    }
+    return nhits;
+}
+
+static int bench_cfar(int iterations) {
+    enum { BINS = FFT_SIZE / 2, MAX_BINS = 32768, GUARD = 2, TRAIN = 12, TRIALS = 400 };
+    static const char* names[2] = { "CA", "OS" };
+    static float power[MAX_BINS];
+    static int hits[MAX_BINS];
+    const double pfa = 1e-2;
+    const int tone_bin = 60;
+    int failures = 0;
+
+    printf("\nCFAR detector (%d guard + %d training bins each side)\n", GUARD, TRAIN);
+    printf("  %-8s %12s %12s %14s %14s\n", "method", "Pfa 1e-2", "tone found", "false alarms",
+           "Pfa 1e-4 thr");
+
+    srand(5);
+    for (int method = KISS_CFAR_CA; method <= KISS_CFAR_OS; method++) {
+        kiss_cfar_cfg cfg = kiss_cfar_alloc(BINS, GUARD, TRAIN, (kiss_cfar_method)method, 0, pfa,
+                                            NULL, NULL);
+        if (!cfg) {
+            return failures + 1;
+        }
+
+        long alarms = 0;
+        for (int trial = 0; trial < TRIALS; trial++) {
+            for (int k = 0; k < BINS; k++) {
+                power[k] = (float)cfar_exp_noise();
+            }
+            alarms += kiss_cfar_detect(cfg, power, NULL, hits);
+        }
+        double rate = (double)alarms / ((double)TRIALS * BINS);
+
+        // Unit noise, a +15 dB tone at bin 60, and 30 dB more noise over
+        // bins 150-255: count the trials that find the tone, and the hits
+        // more than a guard band from it
+        int found = 0;
+        long clutter = 0;
+        kiss_cfar_free(cfg);
+        cfg = kiss_cfar_alloc(BINS, GUARD, TRAIN, (kiss_cfar_method)method, 0, 1e-4, NULL, NULL);
+        for (int trial = 0; trial < TRIALS; trial++) {
+            for (int k = 0; k < BINS; k++) {
+                power[k] = (float)(cfar_exp_noise() * (k >= 150 ? 1000.0 : 1.0));
+            }
+            power[tone_bin] = 31.6f;
+            int n = kiss_cfar_detect(cfg, power, NULL, hits);
+            for (int i = 0; i < n; i++) {
+                if (hits[i] == tone_bin) {
+                    found++;
+                } else if (abs(hits[i] - tone_bin) > GUARD) {
+                    clutter++;
+                }
+            }
+        }
+
+        int ok = rate > 0.7 * pfa && rate < 1.4 * pfa && found > TRIALS * 9 / 10;
+        printf("  %-8s %12.2e %11d%% %14.2f %11.1f dB%s\n", names[method], rate,
+               100 * found / TRIALS, (double)clutter / TRIALS, 10.0 * log10(kiss_cfar_scale(cfg)),
+               ok ? "" : "  FAIL");
+        if (!ok) {
+            failures++;
+        }
+        kiss_cfar_free(cfg);
+    }
+
+    // One non-finite sample off the wire makes NaN and Inf bins: the detector
+    // must stay in bounds, and OS still finds a +30 dB tone well clear of them
+    for (int method = KISS_CFAR_CA; method <= KISS_CFAR_OS; method++) {
+        kiss_cfar_cfg cfg = kiss_cfar_alloc(BINS, GUARD, TRAIN, (kiss_cfar_method)method, 0, 1e-4,
+                                            NULL, NULL);
+        if (!cfg) {
+            return failures + 1;
+        }
+        for (int k = 0; k < BINS; k++) {
+            power[k] = (float)cfar_exp_noise();
+        }
+        power[40] = INFINITY;
+        power[100] = NAN;
+        power[200] = 1000.0f;
+        int n = kiss_cfar_detect(cfg, power, NULL, hits);
+        int ok = n >= 0 && n <= BINS;
+        int found = 0;
+        for (int i = 0; ok && i < n; i++) {
+            ok = hits[i] >= 0 && hits[i] < BINS;
+            found |= hits[i] == 200;
+        }
+        for (int k = 0; k < BINS; k++) {
+            power[k] = NAN;
+        }
+        int n_nan = kiss_cfar_detect(cfg, power, NULL, hits);
+        ok = ok && n_nan >= 0 && n_nan <= BINS && (method == KISS_CFAR_CA || found);
+        printf("  %-8s NaN/Inf bins: %d hits, tone clear of them %s, all-NaN frame %d hits%s\n",
+               names[method], n, found ? "found" : "missed", n_nan, ok ? "" : "  FAIL");
+        if (!ok) {
+            failures++;
+        }
+        kiss_cfar_free(cfg);
+    }
+
+    // The same scene against one threshold for the whole spectrum: 20 dB
+    // over the mean power, as a peak-over-mean SNR trigger would see it
+    {
+        int found = 0;
+        long clutter = 0;
+        for (int trial = 0; trial < TRIALS; trial++) {
+            double mean = 0.0;
+            for (int k = 0; k < BINS; k++) {
+                power[k] = (float)(cfar_exp_noise() * (k >= 150 ? 1000.0 : 1.0));
+            }
+            power[tone_bin] = 31.6f;
+            for (int k = 0; k < BINS; k++) {
+                mean += power[k] / BINS;
+            }
+            for (int k = 0; k < BINS; k++) {
+                if (power[k] > 100.0 * mean) {
+                    if (k == tone_bin) found++;
+                    else clutter++;
+                }
+            }
+        }
+        printf("  %-8s %12s %11d%% %14.2f %11.1f dB\n", "global", "-", 100 * found / TRIALS,
+               (double)clutter / TRIALS, 20.0);
+    }
+
+    printf("  %-8s %8s %14s %12s %12s\n", "cost", "bins", "CA win sums", "CA run sum", "OS sliding");
+    for (int nbins = BINS; nbins <= MAX_BINS; nbins *= 128) {
+        kiss_cfar_cfg ca = kiss_cfar_alloc(nbins, GUARD, TRAIN, KISS_CFAR_CA, 0, 1e-4, NULL, NULL);
+        kiss_cfar_cfg os = kiss_cfar_alloc(nbins, GUARD, TRAIN, KISS_CFAR_OS, 0, 1e-4, NULL, NULL);
+        if (!ca || !os) {
+            return failures + 1;
+        }
+        for (int k = 0; k < nbins; k++) {
+            power[k] = (float)cfar_exp_noise();
+        }
+        int n_iter = (int)((double)iterations * BINS / nbins) + 1;
+
+        double start = now_seconds();
+        for (int it = 0; it < n_iter; it++) {
+            g_sink += cfar_naive(power, nbins, GUARD, TRAIN, kiss_cfar_scale(ca), hits);
+        }
+        double t_naive = (now_seconds() - start) / n_iter;
+        int n_naive = cfar_naive(power, nbins, GUARD, TRAIN, kiss_cfar_scale(ca), hits);
+
+        start = now_seconds();
+        for (int it = 0; it < n_iter; it++) {
+            g_sink += kiss_cfar_detect(ca, power, NULL, hits);
+        }
+        double t_ca = (now_seconds() - start) / n_iter;
+        int n_ca = kiss_cfar_detect(ca, power, NULL, hits);
+
+        start = now_seconds();
+        for (int it = 0; it < n_iter; it++) {
+            g_sink += kiss_cfar_detect(os, power, NULL, hits);
+        }
+        double t_os = (now_seconds() - start) / n_iter;
+
+        // Running sums and window sums differ only in rounding at the edges
+        int ok = abs(n_ca - n_naive) <= 1;
+        printf("  %-8s %8d %11.2f us %9.2f us %9.2f us%s\n", "", nbins, t_naive * 1e6,
+               t_ca * 1e6, t_os * 1e6, ok ? "" : "  FAIL");
+        if (!ok) {
+            failures++;
+        }
+        kiss_cfar_free(ca);
+        kiss_cfar_free(os);
+    }
+    return failures;
+}
+
+// Noise floor: Rayleigh magnitudes (mean sqrt(pi/2)) with a tone every 64
+// bins, each 5 bins wide.  The mean away from the strongest peak is pulled
+// up by the rest; the median (sorted, selected or from the histogram,
+// scaled by mean/median of a Rayleigh) is not.  Selection must match the
+// sort exactly, also on sorted and V-shaped input, and the histogram
+// must land within a slot of it.
+static int noise_cmp(const void* a, const void* b) {
+    float x = *(const float*)a, y = *(const float*)b;
+    return x < y ? -1 : x > y;
+}
+
+static int bench_noise(int iterations) {
+    enum { MAX_BINS = 32768 };
+    static float mag[MAX_BINS];
+    static float work[MAX_BINS];
+    static const char* shapes[3] = { "sorted", "reversed", "V-shaped" };
+    const double scale = 1.0645;     // Rayleigh mean / median
+    const double truth = sqrt(M_PI / 2.0);
+    int failures = 0;
+
+    printf("\nNoise floor estimators (unit Rayleigh noise, a tone every 64 bins)\n");
+    printf("  %-8s %10s %10s %10s %10s   %s\n", "bins", "mean", "sort", "select", "histogram",
+           "bias dB: mean / median / hist");
+
+    srand(11);
+    for (int nbins = FFT_SIZE / 2; nbins <= MAX_BINS; nbins *= 8) {
+        for (int k = 0; k < nbins; k++) {
+            mag[k] = (float)sqrt(2.0 * cfar_exp_noise());
+        }
+        for (int k = 32; k + 2 < nbins; k += 64) {
+            for (int j = -2; j <= 2; j++) {
+                mag[k + j] += 100.0f / (1 + j * j);
+            }
+        }
+        int n_iter = (int)((double)iterations * 256 / nbins) + 1;
+
+        // the analyzer's mean: everything more than 5 bins from the peak
+        double start = now_seconds();
+        double mean = 0.0;
+        for (int it = 0; it < n_iter; it++) {
+            int peak = 0;
+            double sum = 0.0;
+            for (int k = 0; k < nbins; k++) {
+                sum += mag[k];
+                if (mag[k] > mag[peak]) peak = k;
+            }
+            for (int k = peak - 5; k <= peak + 5; k++) {
+                if (k >= 0 && k < nbins) sum -= mag[k];
+            }
+            mean = sum / (nbins - 11);
+        }
+        double t_mean = (now_seconds() - start) / n_iter;
+        g_sink += (float)mean;
+
+        start = now_seconds();
+        for (int it = 0; it < n_iter; it++) {
+            memcpy(work, mag, sizeof(float) * nbins);
+            qsort(work, nbins, sizeof(float), noise_cmp);
+        }
+        double t_sort = (now_seconds() - start) / n_iter;
+        float sorted_median = work[(int)floor(0.5 * (nbins - 1) + 0.5)];
+
+        start = now_seconds();
+        float selected = 0.0f;
+        for (int it = 0; it < n_iter; it++) {
+            selected = kiss_noise_percentile(mag, nbins, 0.5, work);
+        }
+        double t_select = (now_seconds() - start) / n_iter;
+
+        start = now_seconds();
+        float hist = 0.0f;
+        for (int it = 0; it < n_iter; it++) {
+            hist = kiss_noise_hist(mag, nbins, 0.5);
+        }
+        double t_hist = (now_seconds() - start) / n_iter;
+
+        int ok = selected == sorted_median && fabs(20.0 * log10(hist / sorted_median)) < 0.6;
+        printf("  %-8d %7.2f us %7.2f us %7.2f us %7.2f us   %+6.2f / %+5.2f / %+5.2f%s\n", nbins,
+               t_mean * 1e6, t_sort * 1e6, t_select * 1e6, t_hist * 1e6,
+               20.0 * log10(mean / truth), 20.0 * log10(scale * selected / truth),
+               20.0 * log10(scale * hist / truth), ok ? "" : "  FAIL");
+        if (!ok) {
+            failures++;
+        }
+    }
+
+    // Inputs that drive plain quickselect with end pivots to n^2
+    for (int shape = 0; shape < 3; shape++) {
+        const int nbins = MAX_BINS;
+        for (int k = 0; k < nbins; k++) {
+            int v = shape == 0 ? k : shape == 1 ? nbins - k : (k < nbins / 2 ? k : nbins - k);
+            mag[k] = (float)v;
+        }
+        int ok = 1;
+        for (int q = 1; q < 8; q++) {
+            memcpy(work, mag, sizeof(float) * nbins);
+            qsort(work, nbins, sizeof(float), noise_cmp);
+            int rank = (int)floor(q / 8.0 * (nbins - 1) + 0.5);
+            float expect = work[rank];
+            if (kiss_noise_percentile(mag, nbins, q / 8.0, work) != expect) {
+                ok = 0;
+            }
+        }
+        double start = now_seconds();
+        for (int it = 0; it < 20; it++) {
+            g_sink += kiss_noise_percentile(mag, nbins, 0.5, work);
+        }
+        printf("  %-8s %10s %10s %7.2f us %10s   %s%s\n", shapes[shape], "", "",
+               (now_seconds() - start) / 20 * 1e6, "", "select == sort at 7 percentiles",
+               ok ? "" : "  FAIL");
+        if (!ok) {
+            failures++;
+        }
+    }
+    return failures;
+}
+
+// Frame features of a two-sided (IQ) spectrum: complex noise, a tone at
+// -1000 Hz and a DC offset far above it, as an SDR's LO leakage gives.
+// With DC skipped at mid-spectrum the peak is the tone and every noise
+// floor estimate reads as it does without the offset; skipping bin 0, as
+// for a one-sided spectrum, lets the offset through as the peak.
+static int bench_features_iq(void) {
+    enum { N = FFT_SIZE };
+    static kiss_fft_cpx in[N], out[N];
+    static float mag[2][N], freqs[N];
+    static const char* methods[3] = { "mean", "median", "hist" };
+    const float bin_hz = (float)SAMPLE_RATE / N;
+    int failures = 0;
+
+    kiss_fft_cfg cfg = kiss_fft_alloc(N, 0, NULL, NULL);
+    if (!cfg) {
+        printf("\n  frame features: allocation failed  FAIL\n");
+        return 1;
+    }
+
+    printf("\nFrame features, IQ spectrum (complex noise, -1000 Hz tone, DC offset 30 dB above it)\n");
+    srand(5);
+    for (int n = 0; n < N; n++) {
+        double r = 0.01 * sqrt(cfar_exp_noise());
+        double phase = 2.0 * M_PI * rand() / ((double)RAND_MAX + 1.0);
+        double tone = -2.0 * M_PI * 1000.0 * n / SAMPLE_RATE;
+        in[n].r = (float)(r * cos(phase) + 0.05 * cos(tone));
+        in[n].i = (float)(r * sin(phase) + 0.05 * sin(tone));
+    }
+    for (int k = 0; k < N; k++) {
+        freqs[k] = (k - N / 2) * bin_hz;
+    }
+    // mag[0] without the offset, mag[1] with it; fftshifted by (-1)^n
+    for (int pass = 0; pass < 2; pass++) {
+        static kiss_fft_cpx shifted[N];
+        for (int n = 0; n < N; n++) {
+            float sign = (n & 1) ? -1.0f : 1.0f;
+            shifted[n].r = sign * (in[n].r + (pass ? 1.5f : 0.0f));
+            shifted[n].i = sign * in[n].i;
+        }
+        kiss_fft(cfg, shifted, out);
+        for (int k = 0; k < N; k++) {
+            mag[pass][k] = sqrtf(out[k].r * out[k].r + out[k].i * out[k].i) / N;
+        }
+    }
+
+    for (int method = 0; method < 3; method++) {
+        frame_features_t clean, skip_mid, skip_first;
+        frame_features_compute(&clean, NULL, 0, mag[0], N, N / 2, 0.0f, freqs,
+                               NULL, 0, NULL, 0, (frame_noise_method_t)method);
+        frame_features_compute(&skip_mid, NULL, 0, mag[1], N, N / 2, 0.0f, freqs,
+                               NULL, 0, NULL, 0, (frame_noise_method_t)method);
+        frame_features_compute(&skip_first, NULL, 0, mag[1], N, 0, 0.0f, freqs,
+                               NULL, 0, NULL, 0, (frame_noise_method_t)method);
+        double floor_err = 20.0 * log10(skip_mid.noise_floor / clean.noise_floor);
+        int ok = skip_mid.peak_freq == -1000.0f && fabs(floor_err) < 0.01 &&
+                 fabs(skip_mid.snr_db - clean.snr_db) < 0.01 && skip_first.peak_freq == 0.0f;
+        printf("  %-7s DC skipped: peak %7.1f Hz, SNR %5.1f dB, floor %+5.3f dB"
+               "   bin 0 skipped: peak %6.1f Hz%s\n", methods[method], skip_mid.peak_freq,
+               skip_mid.snr_db, floor_err, skip_first.peak_freq, ok ? "" : "  FAIL");
+        if (!ok) {
+            failures++;
+        }
+    }
+    kiss_fft_free(cfg);
+    return failures;
+}
+
+// Downconverter: gain of a unit tone (0.5 out) at output frequency offset fo
+// (in output sample rates) from the centre, over the last half of 512 outputs
+static double ddc_tone_db(kiss_ddc_cfg cfg, double center, int decim, double fo,
+                          float* in, kiss_fft_cpx* out) {
+    enum { OUTPUTS = 512 };
+    const int n = OUTPUTS * decim;
+    const double w = 2.0 * M_PI * (center + fo / decim);
+    for (int i = 0; i < n; i++) {
+        in[i] = (float)cos(w * i);
+    }
+    kiss_ddc_reset(cfg);
+    int m = kiss_ddc(cfg, in, n, out);
+    double power = 0.0;
+    for (int i = m / 2; i < m; i++) {
+        power += out[i].r * out[i].r + out[i].i * out[i].i;
+    }
+    return 10.0 * log10(power / (m - m / 2) / 0.25 + 1e-30);
+}
+
+// Passband ripple, worst alias and throughput for a few decimations, then
+// the SIMD levels against each other
+static int bench_ddc(int iterations) {
+    static const int decims[] = { 8, 24, 256, 1000 };
+    static const double stop[] = { -1.1, -0.6, 0.6, 1.1, 2.1, 3.9, 4.1, 7.9, 8.1, 15.9, 16.1,
+                                   31.9, 32.1, 100.1, 255.9 };
+    enum { MAX_DECIM = 1000, CHUNK = 1 << 16 };
+    static float in[512 * MAX_DECIM];
+    static kiss_fft_cpx out[512 + 1];
+    static kiss_fft_cpx first[CHUNK / 24 + 1];
+    const double center = 0.1;
+    int best_level = kiss_fft_simd_level();
+    int failures = 0;
+
+    printf("\nDownconverter (centre %.2f fs, passband 0.4 fs_out, alias-free from 0.6 fs_out, %s)\n",
+           center, kiss_fft_simd_name(best_level));
+    printf("  %-6s %-10s %6s %12s %10s %11s\n", "decim", "chain", "taps", "ripple", "alias",
+           "input");
+
+    for (size_t c = 0; c < sizeof(decims) / sizeof(decims[0]); c++) {
+        const int decim = decims[c];
+        kiss_ddc_cfg cfg = kiss_ddc_alloc(center, decim, 0, 0.0, 0.0, NULL, NULL);
+        if (!cfg) {
+            failures++;
+            continue;
+        }
+        int cic, halves, taps;
+        kiss_ddc_info(cfg, &cic, &halves, &taps);
+
+        double lo = 1e9, hi = -1e9, alias = -1e9;
+        for (int k = -4; k <= 4; k++) {
+            double g = ddc_tone_db(cfg, center, decim, 0.1 * k, in, out);
+            if (g < lo) lo = g;
+            if (g > hi) hi = g;
+        }
+        for (size_t k = 0; k < sizeof(stop) / sizeof(stop[0]); k++) {
+            double f = center + stop[k] / decim;
+            if (f > 0.001 && f < 0.499) {
+                double g = ddc_tone_db(cfg, center, decim, stop[k], in, out);
+                if (g > alias) alias = g;
+            }
+        }
+
+        // Throughput on noise, 512 outputs per call
+        for (int i = 0; i < 512 * decim; i++) {
+            in[i] = (float)rand() / RAND_MAX - 0.5f;
+        }
+        int n_iter = (int)((double)iterations * 8 / decim) + 1;
+        double start = now_seconds();
+        for (int it = 0; it < n_iter; it++) {
+            kiss_ddc(cfg, in, 512 * decim, out);
+            g_sink += out[0].r;
+        }
+        double rate = (double)n_iter * 512 * decim / (now_seconds() - start);
+
+        char chain[32];
+        snprintf(chain, sizeof(chain), "%d x 2^%d", cic, halves);
+        int bad = hi - lo > 0.05 || fabs(hi) > 0.05 || alias > -70.0;
+        printf("  %-6d %-10s %6d %9.3f dB %7.1f dB %6.1f MS/s%s\n", decim, chain, taps, hi - lo,
+               alias, rate / 1e6, bad ? "  FAIL" : "");
+        if (bad) {
+            failures++;
+        }
+        kiss_ddc_free(cfg);
+    }
+
+    // Every level on the same noise, fed in uneven pieces
+    for (int i = 0; i < CHUNK; i++) {
+        in[i] = (float)rand() / RAND_MAX - 0.5f;
+    }
+    static kiss_fft_cpx level_out[CHUNK / 24 + 1];
+    int exact = 1, count = 0;
+    for (int level = KISS_FFT_SIMD_SCALAR; level <= best_level; level++) {
+        kiss_fft_set_simd_level(level);
+        kiss_ddc_cfg cfg = kiss_ddc_alloc(0.13, 24, 0, 0.0, 0.0, NULL, NULL);
+        if (!cfg) {
+            failures++;
+            break;
+        }
+        int m = 0;
+        for (int i = 0; i < CHUNK; i += 777) {
+            m += kiss_ddc(cfg, in + i, CHUNK - i < 777 ? CHUNK - i : 777,
+                          level == KISS_FFT_SIMD_SCALAR ? first + m : level_out + m);
+        }
+        if (level == KISS_FFT_SIMD_SCALAR) {
+            count = m;
+        } else if (m != count || memcmp(first, level_out, sizeof(kiss_fft_cpx) * m) != 0) {
+            exact = 0;
+        }
+        kiss_ddc_free(cfg);
+    }
+    kiss_fft_set_simd_level(best_level);
+
+    // The real output: a tone at centre + fs_out/10 at its own amplitude
+    kiss_ddc_cfg cfg = kiss_ddc_alloc(center, 24, 0, 0.2, 0.3, NULL, NULL);
+    double real_db = 0.0;
+    if (cfg) {
+        const int n = 512 * 24;
+        static float real_out[512 + 1];
+        for (int i = 0; i < n; i++) {
+            in[i] = (float)cos(2.0 * M_PI * (center + 0.1 / 24) * i);
+        }
+        int m = kiss_ddc_real(cfg, in, n, real_out);
+        double power = 0.0;
+        for (int i = m / 2; i < m; i++) {
+            power += real_out[i] * real_out[i];
+        }
+        real_db = 10.0 * log10(power / (m - m / 2) / 0.5);
+        kiss_ddc_free(cfg);
+    }
+    int bad = !cfg || fabs(real_db) > 0.05;
+    printf("  SIMD levels %s (%d outputs); real output gain %+.3f dB%s\n",
+           exact ? "bit-exact" : "MISMATCH  FAIL", count, real_db, bad ? "  FAIL" : "");
+    if (!exact) {
+        failures++;
+    }
+    if (bad) {
+        failures++;
+    }
+    return failures;
+}
+
+// Channelizer: polyphase filter bank vs a bank of per-channel complex FIRs
+static int bench_channelizer(int iterations) {
+    static const int configs[][2] = { { 16, 16 }, { 32, 16 }, { 64, 64 }, { 128, 64 } };
+    enum { FRAMES = 4, TAPS_PER_BRANCH = 8 };
+    static float in[FRAMES * FFT_SIZE];
+    static float taps[128 * TAPS_PER_BRANCH];
+    static float coef_r[65 * 128 * TAPS_PER_BRANCH];
+    static float coef_i[65 * 128 * TAPS_PER_BRANCH];
+    static kiss_fft_cpx out[(FRAMES * FFT_SIZE / 16 + 1) * 65];
+    static float bank[65 * 2];
+    int failures = 0;
+
+    printf("\nChannelizer (polyphase FFT, %d-sample frames, %d taps per branch)\n",
+           FFT_SIZE, TAPS_PER_BRANCH);
+    printf("  %-10s %12s %12s %9s %12s %10s\n", "K:D", "FIR bank", "polyphase", "speedup",
+           "rel. error", "leakage");
+
+    for (int i = 0; i < FRAMES * FFT_SIZE; i++) {
+        in[i] = (float)((i * 37 % 101) / 50.0 - 1.0);
+    }
+
+    for (size_t c = 0; c < sizeof(configs) / sizeof(configs[0]); c++) {
+        const int nchan = configs[c][0], decim = configs[c][1];
+        const int nout = nchan / 2 + 1, ntaps = nchan * TAPS_PER_BRANCH;
+        for (int j = 0; j < ntaps; j++) {
+            taps[j] = (float)(sin(0.07 * j + 0.2) * exp(-2.0 * j / ntaps));
+        }
+        kiss_pfb_cfg cfg = kiss_pfb_alloc(nchan, decim, taps, ntaps, NULL, NULL);
+        kiss_pfb_cfg tone = kiss_pfb_alloc(nchan, decim, NULL, 0, NULL, NULL);
+        if (!cfg || !tone) {
+            failures++;
+            free(cfg);
+            free(tone);
+            continue;
+        }
+
+        // Accuracy against the defining sum, in two uneven calls
+        int hops = kiss_pfb(cfg, in, FFT_SIZE + 7, out);
+        hops += kiss_pfb(cfg, in + FFT_SIZE + 7, FRAMES * FFT_SIZE - FFT_SIZE - 7,
+                         out + (size_t)hops * nout);
+        double err = 0.0, norm = 0.0;
+        for (int h = 0; h < hops; h++) {
+            int n = h * decim + decim - 1;
+            for (int k = 0; k < nout; k++) {
+                double yr = 0.0, yi = 0.0;
+                for (int l = 0; l < ntaps && l <= n; l++) {
+                    double ph = -2.0 * M_PI * (double)k * ((n - l) % nchan) / nchan;
+                    yr += taps[l] * in[n - l] * cos(ph);
+                    yi += taps[l] * in[n - l] * sin(ph);
+                }
+                double dr = out[h * nout + k].r - yr, di = out[h * nout + k].i - yi;
+                err += dr * dr + di * di;
+                norm += yr * yr + yi * yi;
+            }
+        }
+        err = sqrt(err / norm);
+
+        // A unit tone at the centre of channel nchan/4 should come out at 0.5
+        // there, with the default prototype keeping the other channels quiet
+        static float tone_in[FRAMES * FFT_SIZE];
+        int k0 = nchan / 4;
+        for (int i = 0; i < FRAMES * FFT_SIZE; i++) {
+            tone_in[i] = (float)cos(2.0 * M_PI * k0 * i / nchan);
+        }
+        hops = kiss_pfb(tone, tone_in, FRAMES * FFT_SIZE, out);
+        const kiss_fft_cpx* last = out + (size_t)(hops - 1) * nout;
+        double leak = 0.0;
+        for (int k = 0; k < nout; k++) {
+            double m = sqrt(last[k].r * last[k].r + last[k].i * last[k].i);
+            if (k != k0 && m > leak) {
+                leak = m;
+            }
+        }
+        double gain = sqrt(last[k0].r * last[k0].r + last[k0].i * last[k0].i);
+        double leak_db = 20.0 * log10(leak / gain + 1e-12);
+
+        // Time per frame; the FIR bank mixes each channel's taps in once and
+        // evaluates every channel at the hop times only
+        for (int k = 0; k < nout; k++) {
+            for (int l = 0; l < ntaps; l++) {
+                double ph = -2.0 * M_PI * (double)k * l / nchan;
+                coef_r[k * ntaps + l] = (float)(taps[l] * cos(ph));
+                coef_i[k * ntaps + l] = (float)(taps[l] * sin(ph));
+            }
+        }
+        int n_iter = iterations / 20 + 1;
+        int d_iter = n_iter / 8 + 1;
+        double start = now_seconds();
+        for (int it = 0; it < d_iter; it++) {
+            const float* x = in + FFT_SIZE * (FRAMES - 1);
+            for (int t = decim - 1; t < FFT_SIZE; t += decim) {
+                for (int k = 0; k < nout; k++) {
+                    const float* cr = coef_r + k * ntaps;
+                    const float* ci = coef_i + k * ntaps;
+                    float yr = 0.0f, yi = 0.0f;
+                    for (int l = 0; l < ntaps; l++) {
+                        yr += cr[l] * x[t - l];
+                        yi += ci[l] * x[t - l];
+                    }
+                    bank[2 * k] = yr;
+                    bank[2 * k + 1] = yi;
+                }
+            }
+        }
+        double t_bank = (now_seconds() - start) / d_iter;
+        g_sink += bank[2];
+
+        start = now_seconds();
+        for (int it = 0; it < n_iter; it++) {
+            kiss_pfb(cfg, in, FFT_SIZE, out);
+        }
+        double t_pfb = (now_seconds() - start) / n_iter;
+        g_sink += out[1].r;
+
+        int bad = err > 1e-5 || fabs(gain - 0.5) > 1e-3 || leak_db > -60.0;
+        printf("  %4d:%-5d %9.2f us %9.2f us %8.2fx %12.1e %7.1f dB%s\n", nchan, decim,
+               t_bank * 1e6, t_pfb * 1e6, t_bank / t_pfb, err, leak_db, bad ? "  FAIL" : "");
+        if (bad) {
+            failures++;
+        }
+        kiss_pfb_free(cfg);
+        kiss_pfb_free(tone);
+    }
+    return failures;
+}
+
+// Zoomed band of one frame: chirp-z vs a zero-padded real FFT with the same
+// bin spacing
+static int bench_zoom(const float* signal, int iterations) {
+    enum { ZOOM_BINS = 256 };
+    const float f_low = 1000.0f, f_high = 1100.0f;
+    const double df = (f_high - f_low) / (ZOOM_BINS - 1) / SAMPLE_RATE;
+    const int big = kiss_fftr_next_fast_size_real((int)ceil(1.0 / df));
+    const int first = (int)lround(f_low / SAMPLE_RATE * big);
+    static kiss_fft_cpx zoom[ZOOM_BINS];
+    int n_iter = iterations / 4 + 1;
+
+    kiss_czt_cfg czt = kiss_czt_alloc(FFT_SIZE, ZOOM_BINS, f_low / SAMPLE_RATE, df, NULL, NULL);
+    kiss_fftr_cfg full = kfc_getcfgr(big, 0);
+    float* padded = (float*)calloc(big, sizeof(float));
+    kiss_fft_cpx* spectrum = (kiss_fft_cpx*)malloc((big / 2 + 1) * sizeof(kiss_fft_cpx));
+    if (!czt || !full || !padded || !spectrum) {
+        printf("\nZoom: allocation failed\n");
+        kiss_czt_free(czt);
+        free(padded);
+        free(spectrum);
+        return 1;
+    }
+    memcpy(padded, signal, FFT_SIZE * sizeof(float));
+
+    double start = now_seconds();
+    for (int it = 0; it < n_iter; it++) {
+        kiss_czt_real(czt, signal, zoom);
+    }
+    double t_czt = (now_seconds() - start) / n_iter;
+
+    int n_full = n_iter / 20 + 1;
+    start = now_seconds();
+    for (int it = 0; it < n_full; it++) {
+        kiss_fftr(full, padded, spectrum);
+    }
+    double t_full = (now_seconds() - start) / n_full;
+
+    // bin spacing of the padded FFT differs slightly, so compare at the start
+    // of the band, where both evaluate the same frequency
+    double err = hypot(zoom[0].r - spectrum[first].r, zoom[0].i - spectrum[first].i) /
+                 (hypot(spectrum[first].r, spectrum[first].i) + 1e-9);
+
+    printf("\nZoom (%d bins over %.0f-%.0f Hz of a %d-pt frame)\n",
+           ZOOM_BINS, f_low, f_high, FFT_SIZE);
+    printf("  %-32s %10.2f us\n", "kiss_czt_real", t_czt * 1e6);
+    printf("  %-32s %10.2f us  (%.1fx slower)\n", "zero-padded kiss_fftr", t_full * 1e6,
+           t_full / t_czt);
+    printf("  %-32s %d-pt, first-bin rel. error %.1e\n", "equivalent full FFT", big, err);
+    g_sink += zoom[1].r + spectrum[1].r;
+
+    kiss_czt_free(czt);
+    free(padded);
+    free(spectrum);
+    return err > 1e-4 ? 1 : 0;
+}
+
+// Per-sample spectrum of a few bins: sliding DFT vs a real FFT of the window
+// after every sample.  Checked against kiss_fftr of the final window after
+// enough samples for drift to show, at a point between resyncs, and under
+// each analysis window (its kernel over the sliding bins, as the alarm bands
+// apply it) against kiss_fftr_windowed.
+static int bench_sliding_dft(int iterations) {
+    enum { SDFT_BINS = 13 };    // 0-200 Hz band of a FFT_SIZE frame
+    const int n_samples = 100 * FFT_SIZE + FFT_SIZE / 2 + 7;
+    static float stream[101 * FFT_SIZE];
+    static kiss_fft_cpx spectrum[FFT_SIZE / 2 + 1];
+    int bins[SDFT_BINS];
+    int n_iter = iterations / 100 + 1;
+
+    for (int k = 0; k < SDFT_BINS; k++) {
+        bins[k] = k;
+    }
+    srand(99);
+    for (int i = 0; i < n_samples; i++) {
+        stream[i] = 0.5f * sinf(2.0f * M_PI * 125.0f * i / SAMPLE_RATE) +
+                    0.1f * ((float)rand() / RAND_MAX * 2.0f - 1.0f);
+    }
+
+    kiss_sdft_cfg sdft = kiss_sdft_alloc(FFT_SIZE, SDFT_BINS, bins, NULL, NULL);
+    kiss_fftr_cfg full = kfc_getcfgr(FFT_SIZE, 0);
+    if (!sdft || !full) {
+        printf("\nSliding DFT: allocation failed\n");
+        kiss_sdft_free(sdft);
+        return 1;
+    }
+
+    kiss_sdft_update(sdft, stream, n_samples);
+    kiss_fftr(full, stream + n_samples - FFT_SIZE, spectrum);
+    const kiss_fft_cpx* value = kiss_sdft_bins(sdft);
+    double err = 0.0, ref = 0.0;
+    for (int k = 0; k < SDFT_BINS; k++) {
+        double dr = value[k].r - spectrum[bins[k]].r;
+        double di = value[k].i - spectrum[bins[k]].i;
+        err += dr * dr + di * di;
+        ref += spectrum[bins[k]].r * spectrum[bins[k]].r +
+               spectrum[bins[k]].i * spectrum[bins[k]].i;
+    }
+    err = sqrt(err / ref);
+
+    // Windowed bins 0..SDFT_BINS-KISS_WINDOW_MAX_TAPS from the unwindowed ones
+    // (bins below 0 are the conjugates of bins above it)
+    double win_err = 0.0;
+    for (int type = 0; type < KISS_WINDOW_COUNT; type++) {
+        double kernel[KISS_WINDOW_MAX_TAPS];
+        int taps = kiss_window_kernel((kiss_window_type)type, kernel);
+        const kiss_window* win = kiss_window_get((kiss_window_type)type, FFT_SIZE);
+        kiss_fftr_windowed(full, stream + n_samples - FFT_SIZE, win->w, spectrum);
+        double type_err = 0.0, type_ref = 0.0;
+        for (int k = 0; k + KISS_WINDOW_MAX_TAPS <= SDFT_BINS; k++) {
+            double re = kernel[0] * value[k].r, im = kernel[0] * value[k].i;
+            for (int m = 1; m < taps; m++) {
+                const kiss_fft_cpx* lo = &value[abs(k - m)];
+                re += kernel[m] * (lo->r + value[k + m].r);
+                im += kernel[m] * ((k - m < 0 ? -lo->i : lo->i) + value[k + m].i);
+            }
+            type_err += (re - spectrum[k].r) * (re - spectrum[k].r) +
+                        (im - spectrum[k].i) * (im - spectrum[k].i);
+            type_ref += spectrum[k].r * spectrum[k].r + spectrum[k].i * spectrum[k].i;
+        }
+        type_err = sqrt(type_err / type_ref);
+        if (type_err > win_err) {
+            win_err = type_err;
+        }
+    }
+
+    double start = now_seconds();
+    for (int it = 0; it < n_iter; it++) {
+        kiss_sdft_update(sdft, stream, FFT_SIZE);
+    }
+    double t_sdft = (now_seconds() - start) / ((double)n_iter * FFT_SIZE);
+
+    int n_full = n_iter / 10 + 1;
+    start = now_seconds();
+    for (int it = 0; it < n_full; it++) {
+        for (int i = 0; i < FFT_SIZE; i++) {
+            kiss_fftr(full, stream + i, spectrum);
+        }
+    }
+    double t_full = (now_seconds() - start) / ((double)n_full * FFT_SIZE);
+
+    printf("\nSliding DFT (%d bins of a %d-pt window, per input sample)\n", SDFT_BINS, FFT_SIZE);
+    printf("  %-32s %10.3f us\n", "kiss_sdft_push", t_sdft * 1e6);
+    printf("  %-32s %10.3f us  (%.1fx slower)\n", "kiss_fftr per sample", t_full * 1e6,
+           t_full / t_sdft);
+    printf("  %-32s %.1e after %d samples%s\n", "rel. error vs kiss_fftr", err, n_samples,
+           err > 1e-5 ? "  FAIL" : "");
+    printf("  %-32s %.1e (worst of %d windows)%s\n", "windowed, vs kiss_fftr_windowed", win_err,
+           KISS_WINDOW_COUNT, win_err > 1e-5 ? "  FAIL" : "");
+    g_sink += value[1].r + spectrum[1].r;
+
+    kiss_sdft_free(sdft);
+    return err > 1e-5 || win_err > 1e-5 ? 1 : 0;
+}
+
+// The work Goertzel mode skips: compute_fft() (windowed 512-pt kiss_fftr,
+// magnitudes and dB) and compute_psd_welch() (three windowed 256-pt segments
+// in one batch, averaged and converted to dB)
+static kiss_fft_cpx g_skip_spectrum[FFT_SIZE / 2 + 1];
+static kiss_fft_cpx g_skip_segments[3 * (WELCH_SEGMENT_SIZE / 2 + 1)];
+
+static void run_frame_path(const float* signal, float* magnitude, float* magnitude_db, float* psd) {
+    const int segment_bins = WELCH_SEGMENT_SIZE / 2 + 1;
+    const kiss_window* window = kiss_window_get(KISS_WINDOW_HANN, FFT_SIZE);
+    const kiss_window* seg_window = kiss_window_get(KISS_WINDOW_HANN, WELCH_SEGMENT_SIZE);
+    float accumulated[WELCH_SEGMENT_SIZE / 2] = {0};
+
+    kiss_fftr_windowed(kfc_getcfgr(FFT_SIZE, 0), signal, window->w, g_skip_spectrum);
+    kiss_spectrum_mag_db(g_skip_spectrum, FFT_SIZE / 2, (float)(1.0 / window->coherent_gain),
+                         1e-6f, magnitude, magnitude_db);
+
+    kiss_fftr_batch_windowed(kfc_getcfgr(WELCH_SEGMENT_SIZE, 0), 3, signal, WELCH_SEGMENT_SIZE / 2,
+                             seg_window->w, g_skip_segments, segment_bins);
+    for (int seg = 0; seg < 3; seg++) {
+        const kiss_fft_cpx* x = g_skip_segments + seg * segment_bins;
+        for (int i = 0; i < WELCH_SEGMENT_SIZE / 2; i++) {
+            accumulated[i] += x[i].r * x[i].r + x[i].i * x[i].i;
+        }
+    }
+    kiss_spectrum_db(accumulated, WELCH_SEGMENT_SIZE / 2, 1.0f / (3 * WELCH_SEGMENT_SIZE),
+                     1e-10f, 10.0f, psd);
+    g_sink += magnitude_db[FFT_SIZE / 8] + psd[WELCH_SEGMENT_SIZE / 8];
+}
+
+// A few tones or one band per frame: Goertzel bank vs the FFT frame path it
+// replaces (and vs a bare kiss_fftr).  Bins are checked against kiss_fftr and
+// every SIMD level against scalar.
+static int bench_goertzel(const float* signal, int iterations) {
+    static const int counts[] = { 4, 13, 32 };
+    static kiss_fft_cpx spectrum[FFT_SIZE / 2 + 1];
+    float magnitude[FFT_SIZE / 2], magnitude_db[FFT_SIZE / 2], psd[WELCH_SEGMENT_SIZE / 2];
+    float ref[32], power[32];
+    double freqs[32];
+    int best_level = kiss_fft_simd_level();
+    int n_iter = iterations / 4 + 1;
+    int failures = 0;
+
+    kiss_fftr_cfg full = kfc_getcfgr(FFT_SIZE, 0);
+    double start = now_seconds();
+    for (int it = 0; it < n_iter; it++) {
+        kiss_fftr(full, signal, spectrum);
+    }
+    double t_full = (now_seconds() - start) / n_iter;
+
+    run_frame_path(signal, magnitude, magnitude_db, psd);
+    start = now_seconds();
+    for (int it = 0; it < n_iter; it++) {
+        run_frame_path(signal, magnitude, magnitude_db, psd);
+    }
+    double t_frame = (now_seconds() - start) / n_iter;
+
+    printf("\nGoertzel bank (%d-pt frame, bins 20..; skipped frame path %.2f us, kiss_fftr %.2f us)\n",
+           FFT_SIZE, t_frame * 1e6, t_full * 1e6);
+    printf("  %-8s %12s %10s %10s %12s %12s\n", "freqs", "time", "vs frame", "vs fftr", "rel. error",
+           "SIMD levels");
+
+    for (size_t c = 0; c < sizeof(counts) / sizeof(counts[0]); c++) {
+        int nfreqs = counts[c];
+        for (int b = 0; b < nfreqs; b++) {
+            freqs[b] = (double)(20 + b) / FFT_SIZE;
+        }
+        kiss_goertzel_cfg bank = kiss_goertzel_alloc(nfreqs, freqs, NULL, NULL);
+        if (!bank) {
+            printf("  %-8d allocation failed\n", nfreqs);
+            failures++;
+            continue;
+        }
+
+        kiss_fft_set_simd_level(KISS_FFT_SIMD_SCALAR);
+        kiss_goertzel_power(bank, signal, FFT_SIZE, ref);
+        int exact = 1;
+        for (int level = KISS_FFT_SIMD_SSE2; level <= best_level; level++) {
+            kiss_fft_set_simd_level(level);
+            kiss_goertzel_power(bank, signal, FFT_SIZE, power);
+            if (memcmp(ref, power, nfreqs * sizeof(float)) != 0) {
+                exact = 0;
+            }
+        }
+        kiss_fft_set_simd_level(best_level);
+
+        double err = 0.0, norm = 0.0;
+        for (int b = 0; b < nfreqs; b++) {
+            const kiss_fft_cpx* x = &spectrum[20 + b];
+            double mag = sqrt(x->r * x->r + x->i * x->i);
+            err += (sqrt(ref[b]) - mag) * (sqrt(ref[b]) - mag);
+            norm += mag * mag;
+        }
+        err = sqrt(err / norm);
+
+        start = now_seconds();
+        for (int it = 0; it < n_iter; it++) {
+            kiss_goertzel_power(bank, signal, FFT_SIZE, power);
+        }
+        double t = (now_seconds() - start) / n_iter;
+
+        printf("  %-8d %9.2f us %9.2fx %9.2fx %12.1e %12s\n", nfreqs, t * 1e6, t / t_frame,
+               t / t_full, err, exact ? "bit-exact" : "MISMATCH");
+        if (!exact || err > 1e-4) {
+            failures++;
+        }
+        g_sink += power[0];
+        kiss_goertzel_free(bank);
+    }
+    return failures;
+}
+
+static int bench_simd_kernels(int iterations) {
+    static const int sizes[] = { 256, 512, 1000, 4096 };
+    int best_level = kiss_fft_set_simd_level(-1);
+
+    printf("\nButterfly kernels (host supports %s)\n", kiss_fft_simd_name(best_level));
+
+    int failures = check_simd_bit_exact(best_level);
+    printf("  bit-exact vs scalar: %s\n\n", failures == 0 ? "PASS" : "FAIL");
+
+    printf("  %-8s", "size");
+    for (int level = KISS_FFT_SIMD_SCALAR; level <= best_level; level++) {
+        printf(" %12s", kiss_fft_simd_name(level));
+    }
+    printf("\n");
+
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        int n = sizes[s];
+        int n_iter = (int)((long long)iterations * 512 / n) + 1;
+        printf("  %-8d", n);
+        for (int level = KISS_FFT_SIMD_SCALAR; level <= best_level; level++) {
+            kiss_fft_set_simd_level(level);
+            printf(" %9.2f us", time_complex_fft(n, n_iter) * 1e6);
+        }
+        printf("\n");
+    }
+
+    kiss_fft_set_simd_level(best_level);
+    failures += bench_batch(iterations);
+    return failures;
+}
+
+/*===========================================================================
+ * Main
+ *===========================================================================*/
+
+int main(int argc, char* argv[]) {
+    int iterations = DEFAULT_ITERATIONS;
+    if (argc > 1) {
+        iterations = atoi(argv[1]);
+        if (iterations <= 0) {
+            fprintf(stderr, "Usage: %s [iterations]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    float signal[FFT_SIZE];
+    for (int i = 0; i < FFT_SIZE; i++) {
+        float t = (float)i / SAMPLE_RATE;
+        signal[i] = 0.3f * sinf(2.0f * M_PI * 440.0f * t) +
+                    0.2f * sinf(2.0f * M_PI * 1320.0f * t);
+    }
+
+    printf("===========================================\n");
+    printf("  FFT Analyzer - Frame Benchmark\n");
+    printf("===========================================\n");
+    printf("Frame: 1 x %d-pt + %d x %d-pt FFTs, %d iterations\n\n",
+           FFT_SIZE, (FFT_SIZE - WELCH_SEGMENT_SIZE) / (WELCH_SEGMENT_SIZE / 2) + 1,
+           WELCH_SEGMENT_SIZE, iterations);
+
+    double t_uncached = time_frames(fft_uncached, signal, iterations);
+    double t_cached = time_frames(fft_cached, signal, iterations);
+    double t_real = time_frames(fft_cached_real, signal, iterations);
+    double t_batched = time_frames_batched(signal, iterations);
+
+    printf("  %-32s %10.2f us/frame\n", "alloc/free per FFT", t_uncached * 1e6);
+    printf("  %-32s %10.2f us/frame  (%.2fx)\n", "cached complex plan",
+           t_cached * 1e6, t_uncached / t_cached);
+    printf("  %-32s %10.2f us/frame  (%.2fx)\n", "cached real-input plan",
+           t_real * 1e6, t_uncached / t_real);
+    printf("  %-32s %10.2f us/frame  (%.2fx)\n", "real + kiss_fftr_batch segments",
+           t_batched * 1e6, t_uncached / t_batched);
+
+    int failures = bench_simd_kernels(iterations);
+    failures += bench_codelets(iterations);
+    failures += bench_autotune(iterations);
+    failures += bench_large_fft(iterations);
+    failures += bench_awkward_sizes(iterations);
+    failures += bench_welch_stream(iterations);
+    failures += bench_welch_iq(iterations);
+    failures += bench_windows(iterations);
+    failures += bench_spectrum_kernels(iterations);
+    failures += bench_bands(iterations);
+    failures += bench_peaks(iterations);
+    failures += bench_cfar(iterations);
+    failures += bench_noise(iterations);
+    failures += bench_features_iq();
+    failures += bench_fastfir(iterations);
+    failures += bench_ddc(iterations);
+    failures += bench_channelizer(iterations);
+    failures += bench_zoom(signal, iterations);
+    failures += bench_sliding_dft(iterations);
+    failures += bench_goertzel(signal, iterations);
+
+    kfc_cleanup();
+    return failures == 0 ? 0 : 1;
+}
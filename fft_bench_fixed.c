@@ -0,0 +1,361 @@
+/*
+ * fft_bench_fixed.c
+ *
+ * Report for the fixed-point build profile: measures the integer frame chain
+ * (fixed_dsp.c: Hann-windowed 512-pt magnitude spectrum and Welch PSD, 8
+ * band energies over whole bins) against the same chain evaluated in double
+ * precision on the same samples, for inputs from -6 to -60 dBFS, and times
+ * it against the float chain (fixed_float_chain.c) on the same frame.
+ *
+ * Build with -DFIXED_POINT=16 (int16 Q15) or -DFIXED_POINT=32 (int32 Q31);
+ * see the bench-fixed target in Makefile.windows.
+ *
+ * Usage:
+ *   ./fft_bench_q15 [iterations]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <time.h>
+#endif
+
+#include "fixed_dsp.h"
+#include "fixed_float_chain.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+/*===========================================================================
+ * Configuration (mirrors fft_analyzer_network.c)
+ *===========================================================================*/
+
+#define FFT_SIZE            512
+#define SAMPLE_RATE         8000
+#define NUM_BANDS           8
+#define WELCH_SEGMENT_SIZE  256
+#define WELCH_NUM_BINS      (WELCH_SEGMENT_SIZE / 2)
+#define DEFAULT_ITERATIONS  20000
+#define WINDOW              KISS_WINDOW_HANN
+
+static const float BAND_EDGES[NUM_BANDS + 1] = {
+    0, 200, 400, 600, 800, 1200, 1600, 2400, 4000
+};
+
+// Bins and bands further than this below the peak are left out of the
+// PSD and band error columns; their values are mostly rounding noise
+#define ERROR_RANGE_DB      40.0
+
+/*===========================================================================
+ * Timing Helpers
+ *===========================================================================*/
+
+static double now_seconds(void) {
+#ifdef _WIN32
+    LARGE_INTEGER freq, count;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&count);
+    return (double)count.QuadPart / (double)freq.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+#endif
+}
+
+// Keeps the optimizer from discarding results
+static volatile int32_t g_sink = 0;
+
+/*===========================================================================
+ * Frame Chains
+ *===========================================================================*/
+
+typedef struct {
+    double magnitude[FFT_SIZE / 2];
+    double psd[WELCH_NUM_BINS];
+    double bands[NUM_BANDS];
+} chain_result_t;
+
+// WINDOW of size n in double, from its cosine coefficients; returns sum(w^2)
+static double reference_window(double* w, int n) {
+    double kernel[KISS_WINDOW_MAX_TAPS];
+    int taps = kiss_window_kernel(WINDOW, kernel);
+    double sum2 = 0.0;
+    for (int i = 0; i < n; i++) {
+        w[i] = kernel[0];
+        for (int m = 1; m < taps; m++) {
+            w[i] += 2.0 * kernel[m] * cos(2.0 * M_PI * m * i / n);
+        }
+        sum2 += w[i] * w[i];
+    }
+    return sum2;
+}
+
+// The chain's values, with every sum taken by a direct DFT in double
+static void reference_chain(const double* x, chain_result_t* out) {
+    static double cos_table[FFT_SIZE];
+    static double sin_table[FFT_SIZE];
+    static double window[FFT_SIZE];
+    static double seg_window[WELCH_SEGMENT_SIZE];
+    for (int n = 0; n < FFT_SIZE; n++) {
+        cos_table[n] = cos(2.0 * M_PI * n / FFT_SIZE);
+        sin_table[n] = sin(2.0 * M_PI * n / FFT_SIZE);
+    }
+    reference_window(window, FFT_SIZE);
+    const double seg_sum2 = reference_window(seg_window, WELCH_SEGMENT_SIZE);
+    double kernel[KISS_WINDOW_MAX_TAPS];
+    kiss_window_kernel(WINDOW, kernel);
+    const double coherent_gain = kernel[0];
+
+    for (int k = 0; k < FFT_SIZE / 2; k++) {
+        double re = 0.0, im = 0.0;
+        for (int n = 0; n < FFT_SIZE; n++) {
+            int idx = (int)((long)k * n % FFT_SIZE);
+            re += x[n] * window[n] * cos_table[idx];
+            im -= x[n] * window[n] * sin_table[idx];
+        }
+        out->magnitude[k] = sqrt(re * re + im * im) / coherent_gain;
+    }
+
+    // A 256-pt segment's twiddles are every other entry of the 512-pt table
+    const int overlap = WELCH_SEGMENT_SIZE / 2;
+    const int num_segments = (FFT_SIZE - WELCH_SEGMENT_SIZE) / overlap + 1;
+    for (int k = 0; k < WELCH_NUM_BINS; k++) {
+        double power = 0.0;
+        for (int seg = 0; seg < num_segments; seg++) {
+            const double* s = x + seg * overlap;
+            double re = 0.0, im = 0.0;
+            for (int n = 0; n < WELCH_SEGMENT_SIZE; n++) {
+                int idx = 2 * (int)((long)k * n % WELCH_SEGMENT_SIZE);
+                re += s[n] * seg_window[n] * cos_table[idx];
+                im -= s[n] * seg_window[n] * sin_table[idx];
+            }
+            power += re * re + im * im;
+        }
+        power /= num_segments;
+        power /= WELCH_SEGMENT_SIZE * seg_sum2;
+        out->psd[k] = 10.0 * log10(power + 1e-10);
+    }
+
+    for (int band = 0; band < NUM_BANDS; band++) {
+        int bin_low = (int)((BAND_EDGES[band] * FFT_SIZE) / SAMPLE_RATE);
+        int bin_high = (int)((BAND_EDGES[band + 1] * FFT_SIZE) / SAMPLE_RATE);
+        if (bin_high >= FFT_SIZE / 2) bin_high = FFT_SIZE / 2 - 1;
+        double energy = 0.0;
+        for (int i = bin_low; i <= bin_high; i++) {
+            energy += out->magnitude[i] * out->magnitude[i];
+        }
+        out->bands[band] = sqrt(energy / (bin_high - bin_low + 1));
+    }
+}
+
+// One frame of the integer chain
+static int32_t g_magnitude[FFT_SIZE / 2];
+static float g_psd[WELCH_NUM_BINS];
+static int32_t g_bands[NUM_BANDS];
+
+static void fixed_chain(const kiss_fft_scalar* x) {
+    fixed_compute_fft(x, g_magnitude, FFT_SIZE, WINDOW);
+    fixed_compute_psd_welch(x, g_psd, FFT_SIZE, WELCH_SEGMENT_SIZE, WINDOW);
+    for (int band = 0; band < NUM_BANDS; band++) {
+        g_bands[band] = fixed_get_band_energy(g_magnitude, FFT_SIZE, SAMPLE_RATE,
+                                              BAND_EDGES[band], BAND_EDGES[band + 1]);
+    }
+}
+
+/*===========================================================================
+ * Report
+ *===========================================================================*/
+
+// Spectrum SNR in dB, the worst PSD error in dB, and how many of the bands
+// within ERROR_RANGE_DB of the loudest one read within 1 dB of the float chain
+static void chain_errors(const chain_result_t* ref, double* snr, double* psd_err,
+                         int* bands_ok, int* bands_checked) {
+    double signal = 0.0, noise = 0.0;
+    for (int k = 0; k < FFT_SIZE / 2; k++) {
+        double d = fixed_magnitude_to_float(g_magnitude[k], FFT_SIZE, WINDOW) - ref->magnitude[k];
+        signal += ref->magnitude[k] * ref->magnitude[k];
+        noise += d * d;
+    }
+    *snr = noise > 0.0 ? 10.0 * log10(signal / noise) : INFINITY;
+
+    double psd_peak = -INFINITY;
+    for (int k = 0; k < WELCH_NUM_BINS; k++) {
+        if (ref->psd[k] > psd_peak) psd_peak = ref->psd[k];
+    }
+    *psd_err = 0.0;
+    for (int k = 0; k < WELCH_NUM_BINS; k++) {
+        if (ref->psd[k] >= psd_peak - ERROR_RANGE_DB) {
+            double d = fabs(g_psd[k] - ref->psd[k]);
+            if (d > *psd_err) *psd_err = d;
+        }
+    }
+
+    double band_peak = 0.0;
+    for (int band = 0; band < NUM_BANDS; band++) {
+        if (ref->bands[band] > band_peak) band_peak = ref->bands[band];
+    }
+    *bands_ok = 0;
+    *bands_checked = 0;
+    for (int band = 0; band < NUM_BANDS; band++) {
+        if (ref->bands[band] >= band_peak * pow(10.0, -ERROR_RANGE_DB / 20.0)) {
+            // A band rounded down to 0 counts as wrong
+            double value = fixed_magnitude_to_float(g_bands[band], FFT_SIZE, WINDOW);
+            (*bands_checked)++;
+            if (value > 0.0 && fabs(20.0 * log10(value / ref->bands[band])) <= 1.0) {
+                (*bands_ok)++;
+            }
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    static const struct { const char* name; double level_db; bool noise; } cases[] = {
+        { "two tones", -6.0, false },
+        { "two tones", -20.0, false },
+        { "two tones", -40.0, false },
+        { "two tones", -60.0, false },
+        { "white noise", -10.0, true },
+        { "white noise", -40.0, true },
+    };
+    // At -6 dBFS anything below this means the scaling is broken, not rounding
+    const double min_snr = FIXED_DSP_FRACBITS == 15 ? 40.0 : 100.0;
+    int iterations = DEFAULT_ITERATIONS;
+    int failures = 0;
+
+    if (argc > 1) {
+        iterations = atoi(argv[1]);
+        if (iterations <= 0) {
+            fprintf(stderr, "Usage: %s [iterations]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    printf("===========================================\n");
+    printf("  FFT Analyzer - Fixed-Point Profile\n");
+    printf("===========================================\n");
+    printf("Samples: int%d Q%d, frame: %d-pt spectrum + %d-pt Welch + %d bands\n\n",
+           FIXED_DSP_FRACBITS + 1, FIXED_DSP_FRACBITS, FFT_SIZE, WELCH_SEGMENT_SIZE, NUM_BANDS);
+
+    static float input[FFT_SIZE];
+    static kiss_fft_scalar samples[FFT_SIZE];
+    static double dequantized[FFT_SIZE];
+    static chain_result_t ref;
+    static float float_input[FFT_SIZE];
+    static float float_magnitude[FFT_SIZE / 2];
+    static float float_psd[WELCH_NUM_BINS];
+    static float float_bands[NUM_BANDS];
+
+    bool have_float = float_chain_init(FFT_SIZE, WELCH_SEGMENT_SIZE, SAMPLE_RATE, BAND_EDGES, NUM_BANDS);
+    if (!have_float) {
+        printf("float frame chain: setup failed  FAIL\n\n");
+        failures++;
+    }
+
+    // The float chain's SNR is its own rounding; the difference is what the
+    // integer format loses
+    printf("Accuracy vs the chain in double (same samples)\n");
+    printf("  %-12s %8s %14s %14s %14s %14s\n", "signal", "level", "spectrum SNR", "PSD max err",
+           "bands +-1 dB", "float SNR");
+
+    for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+        // Two tones peak at 0.5 before scaling, noise has 0.5 RMS
+        double gain = pow(10.0, cases[c].level_db / 20.0) / 0.5;
+        srand(4321);
+        for (int i = 0; i < FFT_SIZE; i++) {
+            double v;
+            if (cases[c].noise) {
+                v = 0.5 * sqrt(3.0) * ((double)rand() / RAND_MAX * 2.0 - 1.0);
+            } else {
+                double t = (double)i / SAMPLE_RATE;
+                v = 0.3 * sin(2.0 * M_PI * 440.0 * t) + 0.2 * sin(2.0 * M_PI * 1320.0 * t);
+            }
+            input[i] = (float)(v * gain);
+        }
+
+        fixed_dsp_quantize(input, samples, FFT_SIZE);
+        for (int i = 0; i < FFT_SIZE; i++) {
+            dequantized[i] = ldexp((double)samples[i], -FIXED_DSP_FRACBITS);
+        }
+        reference_chain(dequantized, &ref);
+        fixed_chain(samples);
+
+        double snr, psd_err;
+        int bands_ok, bands_checked;
+        chain_errors(&ref, &snr, &psd_err, &bands_ok, &bands_checked);
+
+        double float_snr = 0.0;
+        if (have_float) {
+            double signal = 0.0, noise = 0.0;
+            for (int i = 0; i < FFT_SIZE; i++) {
+                float_input[i] = (float)dequantized[i];
+            }
+            float_chain(float_input, float_magnitude, float_psd, float_bands);
+            for (int k = 0; k < FFT_SIZE / 2; k++) {
+                double d = float_magnitude[k] - ref.magnitude[k];
+                signal += ref.magnitude[k] * ref.magnitude[k];
+                noise += d * d;
+            }
+            float_snr = noise > 0.0 ? 10.0 * log10(signal / noise) : INFINITY;
+        }
+
+        bool bad = c == 0 && (snr < min_snr || bands_ok < bands_checked);
+        printf("  %-12s %5.0f dBFS %11.1f dB %11.2f dB %10d/%d %11.1f dB%s\n", cases[c].name,
+               cases[c].level_db, snr, psd_err, bands_ok, bands_checked, float_snr,
+               bad ? "  FAIL" : "");
+        if (bad) {
+            failures++;
+        }
+    }
+
+    // Time per frame on the -6 dBFS two-tone input
+    for (int i = 0; i < FFT_SIZE; i++) {
+        double t = (double)i / SAMPLE_RATE;
+        input[i] = (float)(0.3 * sin(2.0 * M_PI * 440.0 * t) + 0.2 * sin(2.0 * M_PI * 1320.0 * t));
+    }
+    fixed_dsp_quantize(input, samples, FFT_SIZE);
+    for (int i = 0; i < iterations / 10 + 1; i++) {
+        fixed_chain(samples);
+    }
+    double start = now_seconds();
+    for (int i = 0; i < iterations; i++) {
+        fixed_chain(samples);
+        g_sink += g_bands[2];
+    }
+    double elapsed = (now_seconds() - start) / iterations;
+
+    // The float chain on the same frame, before quantization
+    double float_elapsed = 0.0;
+    if (have_float) {
+        for (int i = 0; i < iterations / 10 + 1; i++) {
+            float_chain(input, float_magnitude, float_psd, float_bands);
+        }
+        start = now_seconds();
+        for (int i = 0; i < iterations; i++) {
+            float_chain(input, float_magnitude, float_psd, float_bands);
+            g_sink += (int32_t)float_bands[2];
+        }
+        float_elapsed = (now_seconds() - start) / iterations;
+    }
+
+    printf("\nSpeed (%d iterations)\n", iterations);
+    if (have_float) {
+        printf("  %-32s %10.2f us/frame  (%.2fx the float chain)\n", "integer frame chain",
+               elapsed * 1e6, elapsed / float_elapsed);
+        printf("  %-32s %10.2f us/frame\n", "float frame chain", float_elapsed * 1e6);
+    } else {
+        printf("  %-32s %10.2f us/frame\n", "integer frame chain", elapsed * 1e6);
+    }
+
+    float_chain_cleanup();
+    fixed_dsp_cleanup();
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,172 @@
+/*
+ * fixed_dsp.c
+ *
+ * Integer version of the analyzer's frame chain for FIXED_POINT builds:
+ * the windowed transforms of compute_fft() and compute_psd_welch() in
+ * fft_analyzer_network.c, on Q15/Q31 samples with a quantized window, and
+ * bands summed over whole bins rather than kiss_bands' fractional edges.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+
+#include "fixed_dsp.h"
+#include "kiss_fftr.h"
+#include "kiss_window.h"
+#include "kfc.h"
+
+#define FIXED_DSP_MAX_SEGMENT_BINS  4097
+
+// Spectrum work buffer, grown on demand (one frame or one batch of segments)
+static kiss_fft_cpx* g_fixed_out = NULL;
+static int g_fixed_out_size = 0;
+
+static bool fixed_work_reserve(int bins) {
+    if (bins <= g_fixed_out_size) {
+        return true;
+    }
+    kiss_fft_cpx* out = (kiss_fft_cpx*)realloc(g_fixed_out, bins * sizeof(kiss_fft_cpx));
+    if (!out) {
+        return false;
+    }
+    g_fixed_out = out;
+    g_fixed_out_size = bins;
+    return true;
+}
+
+// |c|^2; at most 2^31 for Q15 and 2^63 for Q31, so it always fits
+static uint64_t fixed_power(const kiss_fft_cpx* c) {
+    return (uint64_t)((int64_t)c->r * c->r) + (uint64_t)((int64_t)c->i * c->i);
+}
+
+// Rounded integer square root
+static uint32_t fixed_isqrt(uint64_t x) {
+    uint64_t root = 0;
+    uint64_t bit = (uint64_t)1 << 62;
+
+    // Skip to the top set bit pair; most values here fit in 32 bits
+    if (x < ((uint64_t)1 << 32)) {
+        bit = (uint64_t)1 << (x < ((uint64_t)1 << 16) ? 14 : 30);
+    }
+    while (bit > x) {
+        bit >>= 2;
+    }
+    while (bit != 0) {
+        if (x >= root + bit) {
+            x -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    // x is now the remainder value - root^2
+    return (uint32_t)(x > root ? root + 1 : root);
+}
+
+void fixed_dsp_quantize(const float* input, kiss_fft_scalar* output, int count) {
+    const double full_scale = ldexp(1.0, FIXED_DSP_FRACBITS);
+    const double max_value = full_scale - 1.0;
+
+    for (int i = 0; i < count; i++) {
+        double v = floor(input[i] * full_scale + 0.5);
+        if (v > max_value) v = max_value;
+        if (v < -full_scale) v = -full_scale;
+        output[i] = (kiss_fft_scalar)v;
+    }
+}
+
+void fixed_compute_fft(const kiss_fft_scalar* input, int32_t* magnitude, int size,
+                       kiss_window_type window) {
+    kiss_fftr_cfg cfg = kfc_getcfgr(size, 0);
+    const kiss_window* win = kiss_window_get(window, size);
+    if (!cfg || !win || !fixed_work_reserve(size / 2 + 1)) {
+        fprintf(stderr, "[ERROR] Fixed-point FFT setup failed (size %d)\n", size);
+        memset(magnitude, 0, (size / 2) * sizeof(int32_t));
+        return;
+    }
+
+    kiss_fftr_windowed(cfg, input, win->w, g_fixed_out);
+
+    for (int i = 0; i < size / 2; i++) {
+        magnitude[i] = (int32_t)fixed_isqrt(fixed_power(&g_fixed_out[i]));
+    }
+}
+
+void fixed_compute_psd_welch(const kiss_fft_scalar* signal, float* psd, int fft_size,
+                             int segment_size, kiss_window_type window) {
+    const int overlap = segment_size / 2;
+    const int num_bins = segment_size / 2;
+    const int segment_bins = segment_size / 2 + 1;
+    const int num_segments = (fft_size - segment_size) / overlap + 1;
+
+    static uint64_t accumulated_psd[FIXED_DSP_MAX_SEGMENT_BINS];
+
+    kiss_fftr_cfg cfg = kfc_getcfgr(segment_size, 0);
+    const kiss_window* win = kiss_window_get(window, segment_size);
+    if (!cfg || !win || num_segments <= 0 || segment_bins > FIXED_DSP_MAX_SEGMENT_BINS ||
+        !fixed_work_reserve(num_segments * segment_bins)) {
+        fprintf(stderr, "[ERROR] Fixed-point Welch PSD setup failed (size %d)\n", fft_size);
+        memset(psd, 0, num_bins * sizeof(float));
+        return;
+    }
+
+    // The scaled FFT already divided by segment_size^2; remove the window's
+    // CG^2 * ENBW and the sample format
+    const double to_float = ldexp(1.0, -2 * FIXED_DSP_FRACBITS) /
+                            (win->coherent_gain * win->coherent_gain * win->enbw);
+
+    kiss_fftr_batch_windowed(cfg, num_segments, signal, overlap, win->w, g_fixed_out, segment_bins);
+
+    // Each term is divided before summing so that Q31 powers near 2^63
+    // cannot overflow, whatever the number of segments
+    memset(accumulated_psd, 0, num_bins * sizeof(uint64_t));
+    for (int seg = 0; seg < num_segments; seg++) {
+        const kiss_fft_cpx* spectrum = g_fixed_out + seg * segment_bins;
+        for (int i = 0; i < num_bins; i++) {
+            accumulated_psd[i] += fixed_power(&spectrum[i]) / (uint64_t)num_segments;
+        }
+    }
+
+    for (int i = 0; i < num_bins; i++) {
+        psd[i] = 10.0f * log10f((float)(accumulated_psd[i] * to_float) + 1e-10f);
+    }
+}
+
+int32_t fixed_get_band_energy(const int32_t* magnitude, int size, int sample_rate,
+                              float freq_low, float freq_high) {
+    int bin_low = (int)((freq_low * size) / sample_rate);
+    int bin_high = (int)((freq_high * size) / sample_rate);
+
+    if (bin_high >= size / 2) bin_high = size / 2 - 1;
+    if (bin_low < 0) bin_low = 0;
+    if (bin_high < bin_low) {
+        return 0;
+    }
+
+    // By Parseval the sum of squared scaled bins is at most the mean square
+    // sample, so it fits in 64 bits for either sample format
+    uint64_t energy = 0;
+    for (int i = bin_low; i <= bin_high; i++) {
+        energy += (uint64_t)((int64_t)magnitude[i] * magnitude[i]);
+    }
+
+    return (int32_t)fixed_isqrt(energy / (uint64_t)(bin_high - bin_low + 1));
+}
+
+float fixed_magnitude_to_float(int32_t magnitude, int size, kiss_window_type window) {
+    const kiss_window* win = kiss_window_get(window, size);
+    const double gain = win ? win->coherent_gain : 1.0;
+    return (float)(ldexp((double)magnitude * size, -FIXED_DSP_FRACBITS) / gain);
+}
+
+void fixed_dsp_cleanup(void) {
+    free(g_fixed_out);
+    g_fixed_out = NULL;
+    g_fixed_out_size = 0;
+    kiss_window_cleanup();
+    kfc_cleanup();
+}
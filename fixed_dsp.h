@@ -0,0 +1,85 @@
+/*
+ * fixed_dsp.h
+ *
+ * Integer version of the analyzer's frame chain (windowed FFT magnitude,
+ * windowed Welch PSD, band energies over whole bins) for FIXED_POINT builds
+ * of KISS FFT
+ */
+
+#ifndef FIXED_DSP_H
+#define FIXED_DSP_H
+
+#include <stdint.h>
+
+#include "kiss_fft.h"
+#include "kiss_window.h"
+
+#ifndef FIXED_POINT
+#error "fixed_dsp.h is for FIXED_POINT builds (-DFIXED_POINT=16 or -DFIXED_POINT=32)"
+#endif
+
+/*===========================================================================
+ * Scaling
+ *===========================================================================
+ *
+ * Samples are Q15 (int16) or Q31 (int32) fractions of full scale, so a
+ * float sample x in [-1, 1) is x * 2^FIXED_DSP_FRACBITS.  The fixed-point
+ * kiss_fftr divides by the transform size as it goes (one shift or divide
+ * per radix stage), so a spectrum can never overflow and
+ *
+ *   fixed |X[k]| = float |X[k]| / size * 2^FIXED_DSP_FRACBITS
+ *
+ * of the windowed frame.  The window table is kiss_window's, quantized to
+ * the sample format and applied while the input is packed, as in
+ * compute_fft().  Magnitudes and band energies stay in those units
+ * (fixed_magnitude_to_float divides out size and the coherent gain to give
+ * compute_fft()'s scale).  Powers are kept in 64 bits.  The Welch PSD comes
+ * out in the same dB as compute_psd_welch(): the float path divides the
+ * segment power by size^2 * CG^2 * ENBW, of which the scaled FFT already
+ * did size^2, so the window's CG^2 * ENBW and the 2^(2*FRACBITS) of the
+ * sample format are taken out in the final dB conversion.  That is the
+ * only floating-point step (128 log10 calls per frame), and it only feeds
+ * the display.
+ *
+ * Bands are summed over the whole bins their edges fall in, not the
+ * fractional edges of kiss_bands that the float chain uses.
+ *
+ * The price of dividing inside the FFT is that rounding noise is added
+ * after every stage, so quiet inputs lose SNR: a -40 dBFS tone in an int16
+ * build is far noisier than at -6 dBFS.  fft_bench_fixed reports how much.
+ */
+
+#if (FIXED_POINT == 32)
+#define FIXED_DSP_FRACBITS  31
+#else
+#define FIXED_DSP_FRACBITS  15
+#endif
+
+/*===========================================================================
+ * Frame Chain
+ *===========================================================================*/
+
+// Convert float samples in [-1, 1) to the sample format, saturating
+void fixed_dsp_quantize(const float* input, kiss_fft_scalar* output, int count);
+
+// magnitude[0 .. size/2-1] = |X[k]| of the windowed frame, in the fixed
+// units above
+void fixed_compute_fft(const kiss_fft_scalar* input, int32_t* magnitude, int size,
+                       kiss_window_type window);
+
+// Welch PSD with windowed 50%-overlap segments, segment_size/2 values in dB
+void fixed_compute_psd_welch(const kiss_fft_scalar* signal, float* psd, int fft_size,
+                             int segment_size, kiss_window_type window);
+
+// RMS magnitude of the whole bins from freq_low to freq_high Hz (the bins the
+// edges fall in, truncated), not the fractional edges of kiss_bands
+int32_t fixed_get_band_energy(const int32_t* magnitude, int size, int sample_rate,
+                              float freq_low, float freq_high);
+
+// A fixed magnitude of a size-point frame under window in compute_fft() units
+float fixed_magnitude_to_float(int32_t magnitude, int size, kiss_window_type window);
+
+// Free the cached plans, windows and work buffer
+void fixed_dsp_cleanup(void);
+
+#endif // FIXED_DSP_H
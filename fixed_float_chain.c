@@ -0,0 +1,146 @@
+/*
+ * fixed_float_chain.c
+ *
+ * The float frame chain of fft_analyzer_network.c (windowed kiss_fftr
+ * magnitudes, windowed Welch PSD, kiss_bands energies) for fft_bench_fixed.
+ *
+ * That report links the FIXED_POINT build of KISS FFT, so the float library
+ * is compiled here a second time, into this one translation unit, with its
+ * entry points renamed to float_* so they do not collide with the integer
+ * ones.  Nothing outside this file sees the float copy.
+ */
+
+#undef FIXED_POINT
+#undef USE_SIMD
+
+// Every external symbol the float sources share with the fixed-point build
+#define kf_alloc_plan               float_kf_alloc_plan
+#define kf_batch_interleaved        float_kf_batch_interleaved
+#define kf_batch_stride             float_kf_batch_stride
+#define kf_default_plan             float_kf_default_plan
+#define kf_factor                   float_kf_factor
+#define kf_wisdom_lookup            float_kf_wisdom_lookup
+#define kiss_fft                    float_kiss_fft
+#define kiss_fft_alloc              float_kiss_fft_alloc
+#define kiss_fft_batch              float_kiss_fft_batch
+#define kiss_fft_bluestein_size     float_kiss_fft_bluestein_size
+#define kiss_fft_cleanup            float_kiss_fft_cleanup
+#define kiss_fft_next_fast_size     float_kiss_fft_next_fast_size
+#define kiss_fft_set_codelets       float_kiss_fft_set_codelets
+#define kiss_fft_set_simd_level     float_kiss_fft_set_simd_level
+#define kiss_fft_simd_level         float_kiss_fft_simd_level
+#define kiss_fft_simd_name          float_kiss_fft_simd_name
+#define kiss_fft_stride             float_kiss_fft_stride
+#define kiss_fft_tune               float_kiss_fft_tune
+#define kiss_fft_wisdom_describe    float_kiss_fft_wisdom_describe
+#define kiss_fft_wisdom_forget      float_kiss_fft_wisdom_forget
+#define kiss_fft_wisdom_has         float_kiss_fft_wisdom_has
+#define kiss_fft_wisdom_load        float_kiss_fft_wisdom_load
+#define kiss_fft_wisdom_save        float_kiss_fft_wisdom_save
+#define kiss_fftr                   float_kiss_fftr
+#define kiss_fftr_alloc             float_kiss_fftr_alloc
+#define kiss_fftr_batch             float_kiss_fftr_batch
+#define kiss_fftr_batch_windowed    float_kiss_fftr_batch_windowed
+#define kiss_fftr_windowed          float_kiss_fftr_windowed
+#define kiss_fftri                  float_kiss_fftri
+#define kiss_window_cleanup         float_kiss_window_cleanup
+#define kiss_window_get             float_kiss_window_get
+#define kiss_window_kernel          float_kiss_window_kernel
+#define kiss_window_name            float_kiss_window_name
+#define kiss_window_parse           float_kiss_window_parse
+
+#include "kiss_fft.c"
+#include "kiss_fft_codelets.c"
+#include "kiss_fft_wisdom.c"
+#include "kiss_fftr.c"
+#include "kiss_window.c"
+#include "kiss_bands.c"
+
+#include "fixed_float_chain.h"
+
+#define FLOAT_CHAIN_MAX_BINS  4097
+
+static int g_size = 0;
+static int g_segment_size = 0;
+static kiss_fftr_cfg g_cfg = NULL;
+static kiss_fftr_cfg g_segment_cfg = NULL;
+static kiss_bands_cfg g_bands_cfg = NULL;
+static const kiss_window* g_window = NULL;
+static const kiss_window* g_segment_window = NULL;
+static kiss_fft_cpx* g_out = NULL;
+
+bool float_chain_init(int size, int segment_size, int sample_rate,
+                      const float* band_edges, int num_bands) {
+    const int num_segments = (size - segment_size) / (segment_size / 2) + 1;
+    double edges[FLOAT_CHAIN_MAX_BINS];
+
+    float_chain_cleanup();
+    if (segment_size < 2 || segment_size > size || size / 2 + 1 > FLOAT_CHAIN_MAX_BINS ||
+        num_bands < 1 || num_bands >= FLOAT_CHAIN_MAX_BINS) {
+        return false;
+    }
+    for (int band = 0; band <= num_bands; band++) {
+        edges[band] = (double)band_edges[band] * size / sample_rate;
+    }
+
+    g_size = size;
+    g_segment_size = segment_size;
+    g_cfg = kiss_fftr_alloc(size, 0, NULL, NULL);
+    g_segment_cfg = kiss_fftr_alloc(segment_size, 0, NULL, NULL);
+    g_bands_cfg = kiss_bands_alloc(num_bands, edges, size / 2, NULL, NULL);
+    g_window = kiss_window_get(KISS_WINDOW_HANN, size);
+    g_segment_window = kiss_window_get(KISS_WINDOW_HANN, segment_size);
+    g_out = (kiss_fft_cpx*)malloc((size / 2 + 1 + num_segments * (segment_size / 2 + 1)) *
+                                  sizeof(kiss_fft_cpx));
+    if (!g_cfg || !g_segment_cfg || !g_bands_cfg || !g_window || !g_segment_window || !g_out) {
+        float_chain_cleanup();
+        return false;
+    }
+    return true;
+}
+
+void float_chain(const float* input, float* magnitude, float* psd, float* bands) {
+    const int spectrum_bins = g_size / 2 + 1;
+    const int overlap = g_segment_size / 2;
+    const int segment_bins = g_segment_size / 2 + 1;
+    const int num_segments = (g_size - g_segment_size) / overlap + 1;
+    const float scale = (float)(1.0 / g_window->coherent_gain);
+    const double power_scale = (double)g_segment_size * g_segment_size *
+        g_segment_window->coherent_gain * g_segment_window->coherent_gain * g_segment_window->enbw;
+    float accumulated[FLOAT_CHAIN_MAX_BINS];
+
+    kiss_fftr_windowed(g_cfg, input, g_window->w, g_out);
+    for (int k = 0; k < g_size / 2; k++) {
+        magnitude[k] = sqrtf(g_out[k].r * g_out[k].r + g_out[k].i * g_out[k].i) * scale;
+    }
+
+    kiss_fftr_batch_windowed(g_segment_cfg, num_segments, input, overlap, g_segment_window->w,
+                             g_out + spectrum_bins, segment_bins);
+    memset(accumulated, 0, overlap * sizeof(float));
+    for (int seg = 0; seg < num_segments; seg++) {
+        const kiss_fft_cpx* spectrum = g_out + spectrum_bins + seg * segment_bins;
+        for (int k = 0; k < overlap; k++) {
+            accumulated[k] += spectrum[k].r * spectrum[k].r + spectrum[k].i * spectrum[k].i;
+        }
+    }
+    for (int k = 0; k < overlap; k++) {
+        psd[k] = 10.0f * log10f((float)(accumulated[k] / (num_segments * power_scale)) + 1e-10f);
+    }
+
+    kiss_bands_rms(g_bands_cfg, magnitude, bands);
+}
+
+void float_chain_cleanup(void) {
+    kiss_fftr_free(g_cfg);
+    g_cfg = NULL;
+    kiss_fftr_free(g_segment_cfg);
+    g_segment_cfg = NULL;
+    kiss_bands_free(g_bands_cfg);
+    g_bands_cfg = NULL;
+    free(g_out);
+    g_out = NULL;
+    g_window = NULL;
+    g_segment_window = NULL;
+    kiss_window_cleanup();
+    kiss_fft_cleanup();
+}
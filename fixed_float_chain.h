@@ -0,0 +1,25 @@
+/*
+ * fixed_float_chain.h
+ *
+ * The analyzer's float frame chain, built into the fixed-point report so
+ * both chains are timed on the same samples in one run
+ */
+
+#ifndef FIXED_FLOAT_CHAIN_H
+#define FIXED_FLOAT_CHAIN_H
+
+#include <stdbool.h>
+
+// Plans, Hann windows and bands (num_bands bands between the num_bands + 1
+// edges in Hz) for size-point frames and segment_size-point Welch segments
+bool float_chain_init(int size, int segment_size, int sample_rate,
+                      const float* band_edges, int num_bands);
+
+// One frame: windowed |X[k]| / coherent gain (size/2 values), Welch PSD in
+// dB (segment_size/2 values) and the RMS magnitude of each band
+void float_chain(const float* input, float* magnitude, float* psd, float* bands);
+
+// Free the plans, windows and bands
+void float_chain_cleanup(void);
+
+#endif // FIXED_FLOAT_CHAIN_H
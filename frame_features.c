@@ -0,0 +1,128 @@
+/*
+ * frame_features.c
+ *
+ * Per-frame spectrum summary shared by the trigger, web server and loggers
+ */
+
+#include "frame_features.h"
+#include "kiss_noise.h"
+#include <string.h>
+#include <math.h>
+
+// Mean over median of a Rayleigh magnitude: sqrt(pi/2) / sqrt(2 ln 2)
+#define RAYLEIGH_MEAN_PER_MEDIAN 1.0645f
+
+static const char* NOISE_NAMES[] = { "mean", "median", "hist" };
+
+int frame_noise_parse(const char* name) {
+    for (int i = 0; i < (int)(sizeof(NOISE_NAMES) / sizeof(NOISE_NAMES[0])); i++) {
+        if (strcmp(name, NOISE_NAMES[i]) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+const char* frame_noise_name(frame_noise_method_t method) {
+    return NOISE_NAMES[method];
+}
+
+void frame_features_compute(frame_features_t* features,
+                            const float* signal, int num_samples,
+                            const float* magnitude, int num_bins, int dc_bin,
+                            float bin_hz, const float* bin_freqs,
+                            const float* psd, int psd_size,
+                            const float* band_energies, int num_bands,
+                            frame_noise_method_t noise_method) {
+    memset(features, 0, sizeof(*features));
+    features->band_energies = band_energies;
+    features->num_bands = num_bands;
+
+    // Time domain: mean |x| and RMS together
+    if (signal && num_samples > 0) {
+        double sum_abs = 0.0, sum_sq = 0.0;
+        for (int i = 0; i < num_samples; i++) {
+            sum_abs += fabsf(signal[i]);
+            sum_sq += (double)signal[i] * signal[i];
+        }
+        features->mean_abs = (float)(sum_abs / num_samples);
+        features->rms = (float)sqrt(sum_sq / num_samples);
+    }
+
+    if (psd && psd_size > 0) {
+        double sum = 0.0;
+        for (int i = 0; i < psd_size; i++) {
+            sum += psd[i];
+        }
+        features->psd_mean = (float)(sum / psd_size);
+    }
+
+    if (!magnitude || num_bins < 2 || dc_bin < 0 || dc_bin >= num_bins) {
+        return;
+    }
+
+    // One pass over the spectrum: peak, total and frequency-weighted total.
+    // The noise floor is the total less the few bins around the peak,
+    // taken out afterwards instead of in a second pass.
+    double sum = 0.0, weighted = 0.0;
+    float peak = 0.0f;
+    int peak_bin = 0;
+    for (int i = 0; i < num_bins; i++) {
+        if (i == dc_bin) {
+            continue;
+        }
+        float m = magnitude[i];
+        float freq = bin_freqs ? bin_freqs[i] : i * bin_hz;
+        if (m > peak) {
+            peak = m;
+            peak_bin = i;
+        }
+        sum += m;
+        weighted += (double)freq * m;
+    }
+
+    float noise_floor;
+    if (noise_method == FRAME_NOISE_MEAN) {
+        double noise_sum = sum;
+        int noise_count = num_bins - 1;
+        int first = peak_bin - FRAME_FEATURES_PEAK_EXCLUSION;
+        int last = peak_bin + FRAME_FEATURES_PEAK_EXCLUSION;
+        if (first < 0) first = 0;
+        if (last > num_bins - 1) last = num_bins - 1;
+        for (int i = first; i <= last; i++) {
+            if (i != dc_bin) {
+                noise_sum -= magnitude[i];
+                noise_count--;
+            }
+        }
+        noise_floor = noise_count > 0 ? (float)(noise_sum / noise_count) : 1e-10f;
+    } else {
+        // The bins but DC as one run: just past it when DC is bin 0, else
+        // copied around it.  A spectrum too long to copy keeps DC in its
+        // histogram, where one bin moves the median by at most one rank.
+        float work[FRAME_FEATURES_MAX_SELECT];
+        const float* rest = magnitude + 1;
+        int count = num_bins - 1;
+        if (dc_bin > 0 && count <= FRAME_FEATURES_MAX_SELECT) {
+            memcpy(work, magnitude, dc_bin * sizeof(float));
+            memcpy(work + dc_bin, magnitude + dc_bin + 1, (count - dc_bin) * sizeof(float));
+            rest = work;
+        } else if (dc_bin > 0) {
+            rest = magnitude;
+            count = num_bins;
+        }
+        if (noise_method == FRAME_NOISE_MEDIAN && count <= FRAME_FEATURES_MAX_SELECT) {
+            noise_floor = RAYLEIGH_MEAN_PER_MEDIAN * kiss_noise_percentile(rest, count, 0.5, work);
+        } else {
+            noise_floor = RAYLEIGH_MEAN_PER_MEDIAN * kiss_noise_hist(rest, count, 0.5);
+        }
+    }
+
+    features->peak_bin = peak_bin;
+    features->peak_freq = bin_freqs ? bin_freqs[peak_bin] : peak_bin * bin_hz;
+    features->peak_value = peak;
+    features->magnitude_mean = (float)(sum / (num_bins - 1));
+    features->noise_floor = noise_floor > 1e-10f ? noise_floor : 1e-10f;
+    features->snr_db = 20.0f * log10f(peak / (features->noise_floor + 1e-10f) + 1e-10f);
+    features->centroid = sum > 0.0 ? (float)(weighted / sum) : 0.0f;
+}
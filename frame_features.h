@@ -0,0 +1,85 @@
+/*
+ * frame_features.h
+ *
+ * Per-frame summary of the analyzer's spectrum, computed once right after
+ * the FFT and shared by the auto-record trigger, the web server and every
+ * logger format
+ */
+
+#ifndef FRAME_FEATURES_H
+#define FRAME_FEATURES_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*===========================================================================
+ * Frame Features
+ *===========================================================================*/
+
+// Bins this close to the peak are left out of the mean noise floor
+#define FRAME_FEATURES_PEAK_EXCLUSION 5
+
+// Largest spectrum the median is selected from on the stack; longer ones
+// use the histogram
+#define FRAME_FEATURES_MAX_SELECT 4096
+
+// How the noise floor is estimated.  The median and histogram read the
+// middle of the spectrum, so tones (however many) do not move them; both
+// are scaled to read the same as the mean on a spectrum of pure noise.
+typedef enum {
+    FRAME_NOISE_MEAN = 0,   // Mean magnitude away from the peak
+    FRAME_NOISE_MEDIAN,     // Median magnitude by introselect (exact)
+    FRAME_NOISE_HISTOGRAM   // Median from a 16-slot-per-octave histogram
+} frame_noise_method_t;
+
+typedef struct {
+    int peak_bin;           // Strongest bin, DC excluded
+    float peak_freq;        // Its frequency in Hz
+    float peak_value;       // Its magnitude
+    float magnitude_mean;   // Mean magnitude of every bin but DC
+    float noise_floor;      // Noise magnitude, by the chosen estimator
+    float snr_db;           // 20*log10(peak_value / noise_floor)
+    float centroid;         // Spectral centroid in Hz (magnitude weighted)
+    float rms;              // RMS of the time-domain frame
+    float mean_abs;         // Mean |x| of the time-domain frame
+    float psd_mean;         // Mean of the PSD in dB
+    int num_bands;          // Band energies of the frame (owned by the caller)
+    const float* band_energies;
+} frame_features_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Compute the features of one frame in a single pass over each input.
+ * magnitude holds num_bins values; bin dc_bin is DC and is skipped (0 for a
+ * one-sided spectrum, num_bins/2 for an fftshifted two-sided one).  Bin i
+ * is at i * bin_hz Hz, or at bin_freqs[i] Hz when bin_freqs is given (for
+ * spectra that are not evenly spaced or start below 0 Hz).  signal and psd may
+ * be NULL; band_energies is only referenced.  The noise floor, and the SNR
+ * over it, come from noise_method; none of them allocate.
+ */
+void frame_features_compute(frame_features_t* features,
+                            const float* signal, int num_samples,
+                            const float* magnitude, int num_bins, int dc_bin,
+                            float bin_hz, const float* bin_freqs,
+                            const float* psd, int psd_size,
+                            const float* band_energies, int num_bands,
+                            frame_noise_method_t noise_method);
+
+/**
+ * Parse "mean", "median" or "hist"; returns -1 for anything else
+ */
+int frame_noise_parse(const char* name);
+
+/**
+ * Name of a noise floor method, as frame_noise_parse() takes it
+ */
+const char* frame_noise_name(frame_noise_method_t method);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FRAME_FEATURES_H
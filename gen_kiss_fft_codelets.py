@@ -0,0 +1,164 @@
+#!/usr/bin/env python3
+"""
+Codelet generator for kiss_fft_codelets.c
+
+Writes _kiss_fft_codelets.h: straight-line forward DFTs of size 8, 16, 32
+and 64 with hardcoded twiddles, built by radix-4 decimation in time.  The
+output is a template in the style of _kiss_fft_simd.h (vector primitives
+are supplied by the including file), so the same codelets serve the scalar,
+SSE2 and AVX2 builds.
+
+Usage:
+    python gen_kiss_fft_codelets.py > _kiss_fft_codelets.h
+"""
+
+import math
+import sys
+
+SIZES = (8, 16, 32, 64)
+
+HEADER = """\
+/*
+ *  Copyright (c) 2003-2010, Mark Borgerding. All rights reserved.
+ *  This file is part of KISS FFT - https://github.com/mborgerding/kissfft
+ *
+ *  SPDX-License-Identifier: BSD-3-Clause
+ *  See COPYING file for more information.
+ */
+
+/* _kiss_fft_codelets.h
+   GENERATED by gen_kiss_fft_codelets.py -- do not edit.
+
+   Straight-line forward DFTs of size %(sizes)s with hardcoded twiddles
+   (radix-4 decimation in time).  This file is a template: kiss_fft_codelets.c
+   includes it once per instruction set after defining
+
+     KF_V              vector type holding KF_VLEN complex values (lanes)
+     KF_TARGET         function attribute enabling the instruction set
+     VLD(p) VST(p,v)   load/store KF_VLEN consecutive complex values
+     VLDS(p,s)         load p[0], p[s], p[2s], ...
+     VADD VSUB VMUL    lane-wise arithmetic
+     VCMUL(a,b)        complex multiply
+     VCMULK(a,c,s)     complex multiply by the constant c + i*s
+     VMULNI(a)         multiply by -i
+     VSET1(x)          broadcast a scalar
+
+   and the names pick up the KF_SFX suffix.  Each lane runs an independent
+   transform; for size n:
+
+     kf_cl_col<n>  lane l reads in[j*is + l], writes out[k*os + l]
+     kf_cl_row<n>  lane l reads in[j*is + l*ls] * tw[j*is + l*ls]
+                   (j > 0), writes out[k*os + l]
+ */
+
+#define KF_CL_SQRT1_2 0.70710678118654752440f
+"""
+
+
+def fmt(x):
+    if abs(x) < 1e-300:
+        return "0.0f"
+    return "%.17gf" % x
+
+
+class Gen:
+    def __init__(self):
+        self.lines = []
+        self.ntmp = 0
+
+    def tmp(self, expr):
+        name = "t%d" % self.ntmp
+        self.ntmp += 1
+        self.lines.append("    KF_V %s = %s;" % (name, expr))
+        return name
+
+    def twiddle(self, v, e, n):
+        """v * exp(-2*pi*i*e/n)"""
+        e %= n
+        if e == 0:
+            return v
+        if 4 * e == n:
+            return self.tmp("VMULNI(%s)" % v)
+        if 8 * e == n:
+            # (1-i)/sqrt(2): (v - i*v) * sqrt(1/2)
+            return self.tmp("VMUL(VADD(%s,VMULNI(%s)),VSET1(KF_CL_SQRT1_2))" % (v, v))
+        if 8 * e == 3 * n:
+            # (-1-i)/sqrt(2): (-i*v - v) * sqrt(1/2)
+            return self.tmp("VMUL(VSUB(VMULNI(%s),%s),VSET1(KF_CL_SQRT1_2))" % (v, v))
+        phase = -2.0 * math.pi * e / n
+        return self.tmp("VCMULK(%s,%s,%s)" % (v, fmt(math.cos(phase)), fmt(math.sin(phase))))
+
+    def dft(self, ins):
+        n = len(ins)
+        if n == 1:
+            return list(ins)
+        if n == 2:
+            a, b = ins
+            return [self.tmp("VADD(%s,%s)" % (a, b)), self.tmp("VSUB(%s,%s)" % (a, b))]
+        assert n % 4 == 0
+        q = n // 4
+        subs = [self.dft(ins[r::4]) for r in range(4)]
+        outs = [None] * n
+        for k in range(q):
+            a = [self.twiddle(subs[r][k], r * k, n) for r in range(4)]
+            t0 = self.tmp("VADD(%s,%s)" % (a[0], a[2]))
+            t1 = self.tmp("VSUB(%s,%s)" % (a[0], a[2]))
+            t2 = self.tmp("VADD(%s,%s)" % (a[1], a[3]))
+            t3 = self.tmp("VMULNI(VSUB(%s,%s))" % (a[1], a[3]))
+            outs[k] = self.tmp("VADD(%s,%s)" % (t0, t2))
+            outs[k + q] = self.tmp("VADD(%s,%s)" % (t1, t3))
+            outs[k + 2 * q] = self.tmp("VSUB(%s,%s)" % (t0, t2))
+            outs[k + 3 * q] = self.tmp("VSUB(%s,%s)" % (t1, t3))
+        return outs
+
+
+def emit(n, out):
+    g = Gen()
+    outs = g.dft(["x[%d]" % j for j in range(n)])
+
+    out.append("/* DFT-%d in place on x[0..%d] */" % (n, n - 1))
+    out.append("static KF_CL_INLINE KF_TARGET void KF_NAME(kf_cl_dft%d_)(KF_V * x)" % n)
+    out.append("{")
+    out.extend(g.lines)
+    for k, v in enumerate(outs):
+        out.append("    x[%d] = %s;" % (k, v))
+    out.append("}")
+    out.append("")
+    out.append("static KF_TARGET void KF_NAME(kf_cl_col%d_)(" % n)
+    out.append("        const kiss_fft_cpx * in,size_t is,kiss_fft_cpx * out,size_t os)")
+    out.append("{")
+    out.append("    KF_V x[%d];" % n)
+    out.append("    int j;")
+    out.append("    for (j=0;j<%d;++j)" % n)
+    out.append("        x[j] = VLD(in + j*is);")
+    out.append("    KF_NAME(kf_cl_dft%d_)(x);" % n)
+    out.append("    for (j=0;j<%d;++j)" % n)
+    out.append("        VST(out + j*os, x[j]);")
+    out.append("}")
+    out.append("")
+    out.append("static KF_TARGET void KF_NAME(kf_cl_row%d_)(" % n)
+    out.append("        const kiss_fft_cpx * in,const kiss_fft_cpx * tw,size_t is,size_t ls,")
+    out.append("        kiss_fft_cpx * out,size_t os)")
+    out.append("{")
+    out.append("    KF_V x[%d];" % n)
+    out.append("    int j;")
+    out.append("    (void)ls;  /* lane stride; unused by the scalar VLDS */")
+    out.append("    x[0] = VLDS(in, ls);")
+    out.append("    for (j=1;j<%d;++j)" % n)
+    out.append("        x[j] = VCMUL(VLDS(in + j*is, ls), VLDS(tw + j*is, ls));")
+    out.append("    KF_NAME(kf_cl_dft%d_)(x);" % n)
+    out.append("    for (j=0;j<%d;++j)" % n)
+    out.append("        VST(out + j*os, x[j]);")
+    out.append("}")
+    out.append("")
+
+
+def main():
+    out = [HEADER % {"sizes": ", ".join(str(n) for n in SIZES)}]
+    for n in SIZES:
+        emit(n, out)
+    sys.stdout.write("\n".join(out))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,155 @@
+/*
+ *  Copyright (c) 2003-2010, Mark Borgerding. All rights reserved.
+ *  This file is part of KISS FFT - https://github.com/mborgerding/kissfft
+ *
+ *  SPDX-License-Identifier: BSD-3-Clause
+ *  See COPYING file for more information.
+ */
+
+#include "kfc.h"
+#include "_kiss_fft_guts.h"
+
+typedef struct cached_fft *kfc_cfg;
+
+struct cached_fft
+{
+    int nfft;
+    int inverse;
+    kiss_fft_cfg cfg;
+    kfc_cfg next;
+};
+
+struct cached_fftr
+{
+    int nfft;
+    int inverse;
+    kiss_fftr_cfg cfg;
+    struct cached_fftr * next;
+};
+
+static kfc_cfg cache_root=NULL;
+static struct cached_fftr * cache_root_r=NULL;
+static int ncached=0;
+
+static kiss_fft_cfg find_cached_fft(int nfft,int inverse)
+{
+    size_t len;
+    kfc_cfg  cur=cache_root;
+    kfc_cfg  prev=NULL;
+    while ( cur ) {
+        if ( cur->nfft == nfft && inverse == cur->inverse )
+            break;/*found the right node*/
+        prev = cur;
+        cur = prev->next;
+    }
+    if (cur== NULL) {
+        /* no cached node found, need to create a new one*/
+        kiss_fft_alloc(nfft,inverse,0,&len);
+#ifdef USE_SIMD
+        int padding = (16-sizeof(struct cached_fft)) & 15;
+        // make sure the cfg aligns on a 16 byte boundary
+        len += padding;
+#endif
+        cur = (kfc_cfg)KISS_FFT_MALLOC((sizeof(struct cached_fft) + len ));
+        if (cur == NULL)
+            return NULL;
+        cur->cfg = (kiss_fft_cfg)(cur+1);
+#ifdef USE_SIMD
+        cur->cfg = (kiss_fft_cfg) ((char*)(cur+1)+padding);
+#endif
+        kiss_fft_alloc(nfft,inverse,cur->cfg,&len);
+        cur->nfft=nfft;
+        cur->inverse=inverse;
+        cur->next = NULL;
+        if ( prev )
+            prev->next = cur;
+        else
+            cache_root = cur;
+        ++ncached;
+    }
+    return cur->cfg;
+}
+
+static kiss_fftr_cfg find_cached_fftr(int nfft,int inverse)
+{
+    struct cached_fftr * cur=cache_root_r;
+    struct cached_fftr * prev=NULL;
+    while ( cur ) {
+        if ( cur->nfft == nfft && inverse == cur->inverse )
+            break;/*found the right node*/
+        prev = cur;
+        cur = prev->next;
+    }
+    if (cur== NULL) {
+        /* no cached node found, need to create a new one*/
+        cur = (struct cached_fftr *)KISS_FFT_MALLOC(sizeof(struct cached_fftr));
+        if (cur == NULL)
+            return NULL;
+        cur->cfg = kiss_fftr_alloc(nfft,inverse,NULL,NULL);
+        if (cur->cfg == NULL) {
+            KISS_FFT_FREE(cur);
+            return NULL;
+        }
+        cur->nfft=nfft;
+        cur->inverse=inverse;
+        cur->next = NULL;
+        if ( prev )
+            prev->next = cur;
+        else
+            cache_root_r = cur;
+        ++ncached;
+    }
+    return cur->cfg;
+}
+
+kiss_fft_cfg kfc_getcfg(int nfft, int inverse)
+{
+    return find_cached_fft(nfft,inverse);
+}
+
+kiss_fftr_cfg kfc_getcfgr(int nfft, int inverse)
+{
+    return find_cached_fftr(nfft,inverse);
+}
+
+void kfc_cleanup(void)
+{
+    kfc_cfg  cur=cache_root;
+    kfc_cfg  next=NULL;
+    struct cached_fftr * cur_r=cache_root_r;
+    struct cached_fftr * next_r=NULL;
+    while (cur){
+        next = cur->next;
+        KISS_FFT_FREE(cur);
+        cur=next;
+    }
+    while (cur_r){
+        next_r = cur_r->next;
+        kiss_fftr_free(cur_r->cfg);
+        KISS_FFT_FREE(cur_r);
+        cur_r=next_r;
+    }
+    ncached=0;
+    cache_root = NULL;
+    cache_root_r = NULL;
+}
+
+void kfc_fft(int nfft, const kiss_fft_cpx * fin,kiss_fft_cpx * fout)
+{
+    kiss_fft( find_cached_fft(nfft,0),fin,fout );
+}
+
+void kfc_ifft(int nfft, const kiss_fft_cpx * fin,kiss_fft_cpx * fout)
+{
+    kiss_fft( find_cached_fft(nfft,1),fin,fout );
+}
+
+void kfc_fftr(int nfft, const kiss_fft_scalar * timedata,kiss_fft_cpx * freqdata)
+{
+    kiss_fftr( find_cached_fftr(nfft,0),timedata,freqdata );
+}
+
+void kfc_fftri(int nfft, const kiss_fft_cpx * freqdata,kiss_fft_scalar * timedata)
+{
+    kiss_fftri( find_cached_fftr(nfft,1),freqdata,timedata );
+}
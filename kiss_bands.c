@@ -0,0 +1,156 @@
+/*
+ *  Band energies from a running sum over the spectrum, for KISS FFT.
+ *
+ *  SPDX-License-Identifier: BSD-3-Clause
+ *  See COPYING file for more information.
+ */
+
+#include "kiss_bands.h"
+#include "_kiss_fft_guts.h"
+
+#ifdef USE_SIMD
+# error "kiss_bands needs a scalar kiss_fft_scalar (USE_SIMD packs four transforms per value)"
+#endif
+
+/*
+ An edge at u = e + 1/2 bins from the bottom of bin 0 is kept as the bin
+ it falls in and how far into it: C(e) = cum[pos] + frac * p[pos].
+ Edges are clamped to [0, nbins], so pos is always a valid bin.
+*/
+struct kiss_bands_state{
+    int nbands;
+    int nbins;
+    int * pos;                  /* nbands+1 values */
+    double * frac;              /* nbands+1 values in [0, 1] */
+    double * inv_width;         /* nbands values, 0 for bands past the last bin */
+    double * cum;               /* nbins+1 values: power below each bin boundary */
+};
+
+kiss_bands_cfg kiss_bands_alloc(int nbands,const double *edges,int nbins,void * mem,size_t * lenmem)
+{
+    kiss_bands_cfg st = NULL;
+    size_t memneeded;
+    double u, width;
+    int b;
+
+    if (nbands < 1 || nbins < 1) {
+        KISS_FFT_ERROR("Band set needs at least one band and one bin.");
+        return NULL;
+    }
+    for (b = 0; b < nbands; ++b) {
+        if (!(edges[b + 1] > edges[b])) {
+            KISS_FFT_ERROR("Band edges must be strictly increasing.");
+            return NULL;
+        }
+    }
+
+    memneeded = ((sizeof(struct kiss_bands_state) + 15) & ~(size_t)15)
+        + sizeof(double) * ((size_t)nbands + 1)          /* frac */
+        + sizeof(double) * (size_t)nbands                /* inv_width */
+        + sizeof(double) * ((size_t)nbins + 1)           /* cum */
+        + sizeof(int) * ((size_t)nbands + 1);            /* pos */
+
+    if (lenmem == NULL) {
+        st = (kiss_bands_cfg) KISS_FFT_MALLOC (memneeded);
+    } else {
+        if (mem != NULL && *lenmem >= memneeded)
+            st = (kiss_bands_cfg) mem;
+        *lenmem = memneeded;
+    }
+    if (!st)
+        return NULL;
+
+    st->nbands = nbands;
+    st->nbins = nbins;
+    st->frac = (double *) ((char *) st + ((sizeof(struct kiss_bands_state) + 15) & ~(size_t)15));
+    st->inv_width = st->frac + nbands + 1;
+    st->cum = st->inv_width + nbands;
+    st->pos = (int *) (st->cum + nbins + 1);
+
+    for (b = 0; b <= nbands; ++b) {
+        u = edges[b] + 0.5;
+        if (u < 0)
+            u = 0;
+        if (u > nbins)
+            u = nbins;
+        st->pos[b] = (int) floor(u);
+        if (st->pos[b] > nbins - 1)
+            st->pos[b] = nbins - 1;
+        st->frac[b] = u - st->pos[b];
+    }
+    for (b = 0; b < nbands; ++b) {
+        width = (st->pos[b + 1] + st->frac[b + 1]) - (st->pos[b] + st->frac[b]);
+        st->inv_width[b] = width > 0 ? 1.0 / width : 0;
+    }
+    return st;
+}
+
+static double kf_bands_edge(kiss_bands_cfg st,int b)
+{
+    const int k = st->pos[b];
+    return st->cum[k] + st->frac[b] * (st->cum[k + 1] - st->cum[k]);
+}
+
+void kiss_bands_mean(kiss_bands_cfg st,const kiss_fft_scalar *power,kiss_fft_scalar *mean)
+{
+    double sum = 0;
+    int k, b;
+
+    st->cum[0] = 0;
+    for (k = 0; k < st->nbins; ++k) {
+        sum += power[k];
+        st->cum[k + 1] = sum;
+    }
+    for (b = 0; b < st->nbands; ++b)
+        mean[b] = (kiss_fft_scalar) ((kf_bands_edge(st, b + 1) - kf_bands_edge(st, b)) * st->inv_width[b]);
+}
+
+void kiss_bands_rms(kiss_bands_cfg st,const kiss_fft_scalar *mag,kiss_fft_scalar *rms)
+{
+    double sum = 0, v;
+    int k, b;
+
+    st->cum[0] = 0;
+    for (k = 0; k < st->nbins; ++k) {
+        sum += (double) mag[k] * mag[k];
+        st->cum[k + 1] = sum;
+    }
+    for (b = 0; b < st->nbands; ++b) {
+        v = (kf_bands_edge(st, b + 1) - kf_bands_edge(st, b)) * st->inv_width[b];
+        rms[b] = (kiss_fft_scalar) sqrt(v > 0 ? v : 0);
+    }
+}
+
+int kiss_bands_bins(kiss_bands_cfg st,int band,int *first,int *last)
+{
+    if (band < 0 || band >= st->nbands || st->inv_width[band] == 0) {
+        *first = 0;
+        *last = -1;
+        return 0;
+    }
+    *first = st->pos[band];
+    /* an upper edge on a bin boundary takes nothing from the bin above it */
+    *last = st->frac[band + 1] > 0 ? st->pos[band + 1] : st->pos[band + 1] - 1;
+    return *last - *first + 1;
+}
+
+int kiss_bands_octave(int fraction,double f_low,double f_high,double *edges,int maxbands)
+{
+    int k, k_low, k_high, nbands;
+
+    if (fraction < 1 || f_low <= 0 || f_high < f_low || maxbands < 1)
+        return 0;
+
+    /* the tolerance keeps 1000 * 2^(k/fraction) == f_low from rounding out */
+    k_low = (int) ceil(fraction * log(f_low / 1000.0) / log(2.0) - 1e-9);
+    k_high = (int) floor(fraction * log(f_high / 1000.0) / log(2.0) + 1e-9);
+    nbands = k_high - k_low + 1;
+    if (nbands < 1)
+        return 0;
+    if (nbands > maxbands)
+        nbands = maxbands;
+
+    for (k = 0; k <= nbands; ++k)
+        edges[k] = 1000.0 * pow(2.0, (k_low + k - 0.5) / fraction);
+    return nbands;
+}
@@ -0,0 +1,76 @@
+/*
+ *  Band energies from a running sum over the spectrum, for KISS FFT.
+ *
+ *  SPDX-License-Identifier: BSD-3-Clause
+ *  See COPYING file for more information.
+ */
+
+#ifndef KISS_BANDS_H
+#define KISS_BANDS_H
+
+#include "kiss_fft.h"
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/*
+
+ Mean power per bin of every band in a set of contiguous bands
+
+   mean[b] = (C(e[b+1]) - C(e[b])) / (e[b+1] - e[b])
+
+ where C(x) is the power of the spectrum below x, taking bin k to spread
+ its power evenly over [k-1/2, k+1/2).  The edges e[] are in bins and need
+ not be whole: a band ending a third of the way into a bin takes a third
+ of that bin's power, and a band narrower than a bin reads the bin it is
+ in.  Each frame builds the running sum C at the bin boundaries once
+ (in double, so a quiet band next to a loud one keeps its digits), after
+ which every band costs two lookups whatever its width, so a set of
+ thousands of 1/12-octave or user-defined bands costs about as much as
+ one pass over the spectrum.  Edges past the last bin are clamped to it;
+ a band entirely past it reads 0.
+
+ */
+
+typedef struct kiss_bands_state *kiss_bands_cfg;
+
+
+kiss_bands_cfg KISS_FFT_API kiss_bands_alloc(int nbands,const double *edges,int nbins,void * mem,size_t * lenmem);
+/*
+ nbands bands with the nbands+1 strictly increasing edges (in bins, e.g.
+ freq * nfft / sample_rate) over spectra of nbins bins.
+ mem/lenmem work as for kiss_fft_alloc; the result is freed with kiss_bands_free.
+ The cfg holds the running sum, so it must not be shared between threads.
+*/
+
+void KISS_FFT_API kiss_bands_mean(kiss_bands_cfg cfg,const kiss_fft_scalar *power,kiss_fft_scalar *mean);
+/*
+ mean power per bin of each band, from the nbins values of power
+*/
+
+void KISS_FFT_API kiss_bands_rms(kiss_bands_cfg cfg,const kiss_fft_scalar *mag,kiss_fft_scalar *rms);
+/*
+ sqrt of kiss_bands_mean of mag^2: the RMS magnitude of each band
+*/
+
+int KISS_FFT_API kiss_bands_bins(kiss_bands_cfg cfg,int band,int *first,int *last);
+/*
+ the bins the band takes any power from, first..last inclusive; returns
+ how many there are (0 for a band past the last bin)
+*/
+
+int KISS_FFT_API kiss_bands_octave(int fraction,double f_low,double f_high,double *edges,int maxbands);
+/*
+ 1/fraction-octave bands (base 2, mid-band frequencies 1000 * 2^(k/fraction) Hz)
+ for every mid-band frequency in [f_low, f_high] Hz, at most maxbands of them.
+ Writes the band edges (in Hz, one more than the bands) and returns the
+ number of bands.
+*/
+
+#define kiss_bands_free KISS_FFT_FREE
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,263 @@
+/*
+ *  Constant false alarm rate (CFAR) detection across the bins of a power
+ *  spectrum, for KISS FFT spectra.
+ *
+ *  SPDX-License-Identifier: BSD-3-Clause
+ *  See COPYING file for more information.
+ */
+
+#include "kiss_cfar.h"
+#include "_kiss_fft_guts.h"
+
+#if defined(USE_SIMD) || defined(FIXED_POINT)
+# error "kiss_cfar needs a float kiss_fft_scalar"
+#endif
+
+/*
+ With n training cells (fewer than 2*train near the ends), the noise at a
+ bin is norm[n] times the window's statistic (its sum, or its rank[n]-th
+ smallest cell) and the threshold is scale[n] times the noise.
+*/
+struct kiss_cfar_state{
+    int nbins;
+    int guard;
+    int train;
+    kiss_cfar_method method;
+    double * scale;             /* 2*train+1 values */
+    double * norm;              /* 2*train+1 values */
+    double * cum;               /* nbins+1 values: power below each bin (CA) */
+    int * rank;                 /* 2*train+1 values (OS) */
+    kiss_fft_scalar * sorted;   /* 2*train values: the window in order (OS) */
+};
+
+/* log P(x > alpha * x_(k)) for x and the k-th smallest of n more unit exponentials */
+static double kf_cfar_os_logp(int n,int k,double alpha)
+{
+    double logp = 0;
+    int i;
+
+    for (i = 0; i < k; ++i)
+        logp += log((n - i) / (n - i + alpha));
+    return logp;
+}
+
+static double kf_cfar_os_alpha(int n,int k,double pfa)
+{
+    double lo = 0, hi = 1, mid;
+    int it;
+
+    while (kf_cfar_os_logp(n, k, hi) > log(pfa))
+        hi *= 2;
+    for (it = 0; it < 100; ++it) {
+        mid = 0.5 * (lo + hi);
+        if (kf_cfar_os_logp(n, k, mid) > log(pfa))
+            lo = mid;
+        else
+            hi = mid;
+    }
+    return 0.5 * (lo + hi);
+}
+
+kiss_cfar_cfg kiss_cfar_alloc(int nbins,int guard,int train,kiss_cfar_method method,
+        int rank,double pfa,void * mem,size_t * lenmem)
+{
+    kiss_cfar_cfg st = NULL;
+    size_t memneeded;
+    const int ncells = 2 * train;
+    double h;
+    int n, i;
+
+    if (nbins < 1 || guard < 0 || train < 1 || !(pfa > 0 && pfa < 1)
+            || rank < 0 || rank > ncells
+            || (method != KISS_CFAR_CA && method != KISS_CFAR_OS)) {
+        KISS_FFT_ERROR("CFAR needs bins, a training cell per side, 0 < pfa < 1 and a rank within the window.");
+        return NULL;
+    }
+    if (rank == 0)
+        rank = (3 * ncells + 3) / 4;
+
+    memneeded = ((sizeof(struct kiss_cfar_state) + 15) & ~(size_t)15)
+        + sizeof(double) * 2 * ((size_t)ncells + 1)      /* scale, norm */
+        + sizeof(double) * ((size_t)nbins + 1)           /* cum */
+        + sizeof(kiss_fft_scalar) * (size_t)ncells       /* sorted */
+        + sizeof(int) * ((size_t)ncells + 1);            /* rank */
+
+    if (lenmem == NULL) {
+        st = (kiss_cfar_cfg) KISS_FFT_MALLOC (memneeded);
+    } else {
+        if (mem != NULL && *lenmem >= memneeded)
+            st = (kiss_cfar_cfg) mem;
+        *lenmem = memneeded;
+    }
+    if (!st)
+        return NULL;
+
+    st->nbins = nbins;
+    st->guard = guard;
+    st->train = train;
+    st->method = method;
+    st->scale = (double *) ((char *) st + ((sizeof(struct kiss_cfar_state) + 15) & ~(size_t)15));
+    st->norm = st->scale + ncells + 1;
+    st->cum = st->norm + ncells + 1;
+    st->sorted = (kiss_fft_scalar *) (st->cum + nbins + 1);
+    st->rank = (int *) (st->sorted + ncells);
+
+    st->scale[0] = st->norm[0] = 0;
+    st->rank[0] = 0;
+    for (n = 1; n <= ncells; ++n) {
+        if (method == KISS_CFAR_CA) {
+            st->norm[n] = 1.0 / n;
+            st->scale[n] = n * (pow(pfa, -1.0 / n) - 1);
+        } else {
+            /* the same fraction of the way up a shorter window */
+            st->rank[n] = (int) floor((double) rank * n / ncells + 0.5);
+            if (st->rank[n] < 1)
+                st->rank[n] = 1;
+            /* x_(k) averages h times the noise power */
+            h = 0;
+            for (i = 0; i < st->rank[n]; ++i)
+                h += 1.0 / (n - i);
+            st->norm[n] = 1.0 / h;
+            st->scale[n] = kf_cfar_os_alpha(n, st->rank[n], pfa) * h;
+        }
+    }
+    return st;
+}
+
+double kiss_cfar_scale(kiss_cfar_cfg st)
+{
+    return st->scale[2 * st->train];
+}
+
+static int kf_cfar_test(kiss_cfar_cfg st,const kiss_fft_scalar *power,kiss_fft_scalar *noise,
+        int *hits,int nhits,int k,int n,double stat)
+{
+    const double est = st->norm[n] * stat;
+
+    if (noise)
+        noise[k] = (kiss_fft_scalar) est;
+    if (n > 0 && power[k] > st->scale[n] * est)
+        hits[nhits++] = k;
+    return nhits;
+}
+
+static int kf_cfar_ca(kiss_cfar_cfg st,const kiss_fft_scalar *power,kiss_fft_scalar *noise,int *hits)
+{
+    const int g = st->guard, t = st->train, nbins = st->nbins;
+    double sum = 0, stat;
+    int nhits = 0, k, lo, hi, n;
+
+    st->cum[0] = 0;
+    for (k = 0; k < nbins; ++k) {
+        sum += power[k];
+        st->cum[k + 1] = sum;
+    }
+    for (k = 0; k < nbins; ++k) {
+        stat = 0;
+        n = 0;
+        lo = k - g - t;
+        hi = k - g - 1;
+        if (lo < 0)
+            lo = 0;
+        if (hi >= lo) {
+            stat += st->cum[hi + 1] - st->cum[lo];
+            n += hi - lo + 1;
+        }
+        lo = k + g + 1;
+        hi = k + g + t;
+        if (hi > nbins - 1)
+            hi = nbins - 1;
+        if (hi >= lo) {
+            stat += st->cum[hi + 1] - st->cum[lo];
+            n += hi - lo + 1;
+        }
+        nhits = kf_cfar_test(st, power, noise, hits, nhits, k, n, stat);
+    }
+    return nhits;
+}
+
+/* The window is short, so plain shifting beats a binary search and
+   memmove.  A cell leaving and one entering on the same side are done in
+   one pass that moves only the values between the two.
+
+   A NaN power (one non-finite sample makes a whole spectrum of them)
+   compares false both ways, so cells are found by KF_CFAR_SAME, which
+   lets a NaN match a NaN, and every search is bounded by the window: a
+   cell still not found stands for the last one.  The window keeps its
+   size and stays in its buffer; the order, and so the threshold, is only
+   meaningless while non-finite cells are in or near it. */
+#define KF_CFAR_SAME(a,b) ((a) == (b) || ((a) != (a) && (b) != (b)))
+
+static void kf_cfar_insert(kiss_fft_scalar *s,int m,kiss_fft_scalar v)
+{
+    while (m > 0 && s[m - 1] > v) {
+        s[m] = s[m - 1];
+        --m;
+    }
+    s[m] = v;
+}
+
+static void kf_cfar_remove(kiss_fft_scalar *s,int m,kiss_fft_scalar v)
+{
+    int i = 0;
+
+    while (i < m && !KF_CFAR_SAME(s[i], v))
+        ++i;
+    for (; i < m - 1; ++i)
+        s[i] = s[i + 1];
+}
+
+static void kf_cfar_replace(kiss_fft_scalar *s,int m,kiss_fft_scalar old,kiss_fft_scalar v)
+{
+    int i = 0;
+
+    while (i < m && !KF_CFAR_SAME(s[i], old))
+        ++i;
+    if (i == m)
+        i = m - 1;
+    while (i < m - 1 && s[i + 1] < v) {
+        s[i] = s[i + 1];
+        ++i;
+    }
+    while (i > 0 && s[i - 1] > v) {
+        s[i] = s[i - 1];
+        --i;
+    }
+    s[i] = v;
+}
+
+static int kf_cfar_os(kiss_cfar_cfg st,const kiss_fft_scalar *power,kiss_fft_scalar *noise,int *hits)
+{
+    const int g = st->guard, t = st->train, nbins = st->nbins;
+    kiss_fft_scalar * s = st->sorted;
+    int nhits = 0, m = 0, k, j;
+
+    /* bin 0 has only leading cells */
+    for (j = g + 1; j <= g + t && j < nbins; ++j)
+        kf_cfar_insert(s, m++, power[j]);
+
+    for (k = 0; k < nbins; ++k) {
+        nhits = kf_cfar_test(st, power, noise, hits, nhits, k, m,
+                             m > 0 ? s[st->rank[m] - 1] : 0);
+
+        /* slide to k+1: the leading cells lose k+1+g and gain k+1+g+t,
+           the lagging cells lose k-g-t and gain k-g.  Past the ends a
+           side only loses (leading) or only gains (lagging) cells. */
+        if (k + 1 + g + t < nbins)
+            kf_cfar_replace(s, m, power[k + 1 + g], power[k + 1 + g + t]);
+        else if (k + 1 + g < nbins)
+            kf_cfar_remove(s, m--, power[k + 1 + g]);
+        if (k - g - t >= 0)
+            kf_cfar_replace(s, m, power[k - g - t], power[k - g]);
+        else if (k - g >= 0)
+            kf_cfar_insert(s, m++, power[k - g]);
+    }
+    return nhits;
+}
+
+int kiss_cfar_detect(kiss_cfar_cfg st,const kiss_fft_scalar *power,kiss_fft_scalar *noise,int *hits)
+{
+    if (st->method == KISS_CFAR_OS)
+        return kf_cfar_os(st, power, noise, hits);
+    return kf_cfar_ca(st, power, noise, hits);
+}
@@ -0,0 +1,78 @@
+/*
+ *  Constant false alarm rate (CFAR) detection across the bins of a power
+ *  spectrum, for KISS FFT spectra.
+ *
+ *  SPDX-License-Identifier: BSD-3-Clause
+ *  See COPYING file for more information.
+ */
+
+#ifndef KISS_CFAR_H
+#define KISS_CFAR_H
+
+#include "kiss_fft.h"
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/*
+
+ kiss_cfar_detect compares every bin of a power spectrum with the noise
+ around it: the train bins on either side, past guard bins that keep the
+ bin's own signal out of the estimate.
+
+                 train     guard  k  guard     train
+             [ . . . . . ][ . . ] X [ . . ][ . . . . . ]
+
+   KISS_CFAR_CA   cell averaging: the noise is the mean of the training
+                  cells, read from a running sum, so the cost per bin does
+                  not depend on train
+   KISS_CFAR_OS   ordered statistic: the noise comes from the rank-th
+                  smallest training cell, kept in a sliding sorted window
+                  (two insertion passes over at most 2*train values per
+                  bin).  A strong neighbour in the training cells raises
+                  it far less than it raises the mean.
+
+ The threshold is scaled for a false alarm probability pfa per bin on
+ noise whose power is exponentially distributed (the periodogram of
+ Gaussian noise).  Near the ends of the spectrum the window is cut short;
+ the scale is worked out again for the cells left.
+
+ */
+
+typedef struct kiss_cfar_state *kiss_cfar_cfg;
+
+typedef enum {
+    KISS_CFAR_CA = 0,
+    KISS_CFAR_OS
+} kiss_cfar_method;
+
+kiss_cfar_cfg KISS_FFT_API kiss_cfar_alloc(int nbins,int guard,int train,kiss_cfar_method method,
+        int rank,double pfa,void * mem,size_t * lenmem);
+/*
+ spectra of nbins bins; guard and train bins on each side of the bin under
+ test; rank (KISS_CFAR_OS only) is 1..2*train, or 0 for 3/4 of the way up.
+ mem/lenmem work as for kiss_fft_alloc; the result is freed with kiss_cfar_free.
+*/
+
+int KISS_FFT_API kiss_cfar_detect(kiss_cfar_cfg cfg,const kiss_fft_scalar *power,
+        kiss_fft_scalar *noise,int *hits);
+/*
+ Writes the bins whose power exceeds their threshold to hits (ascending, up
+ to nbins values) and returns how many.  noise, if not NULL, receives the
+ noise power estimated at every bin (the mean power of the noise; the
+ threshold is kiss_cfar_scale times it).  NaN or Inf powers are safe: they
+ yield no hits near them (CA: after them), never a read out of bounds.
+*/
+
+double KISS_FFT_API kiss_cfar_scale(kiss_cfar_cfg cfg);
+/*
+ threshold / noise for a full window
+*/
+
+#define kiss_cfar_free KISS_FFT_FREE
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,143 @@
+/*
+ *  Chirp-z transform built on KISS FFT.
+ *
+ *  SPDX-License-Identifier: BSD-3-Clause
+ *  See COPYING file for more information.
+ */
+
+#include "kiss_czt.h"
+#include "_kiss_fft_guts.h"
+
+#ifdef USE_SIMD
+# error "kiss_czt needs a scalar kiss_fft_scalar (USE_SIMD packs four transforms per value)"
+#endif
+
+/*
+ With w[j] = exp(-i*pi*df*j^2), j*k*df = df*(j^2 + k^2 - (k-j)^2)/2 gives
+
+   X[k] = w[k] * sum_j (x[j] * exp(-2*pi*i*f0*j) * w[j]) * conj(w[k-j])
+
+ a linear convolution of n and n+m-1 points, done as a circular one of
+ size L >= n+m-1.  The inverse FFT is conj(FFT(conj(.))), and 1/L is folded
+ into the stored filter spectrum.
+*/
+struct kiss_czt_state{
+    int n;
+    int m;
+    kiss_fft_cfg substate;      /* forward FFT of size L */
+    kiss_fft_cpx * pre;         /* n values: exp(-2*pi*i*f0*j) * w[j] */
+    kiss_fft_cpx * post;        /* m values: w[k] */
+    kiss_fft_cpx * filter;      /* L values: FFT(conj(w)) / L */
+    kiss_fft_cpx * tmpbuf;      /* 2*L values */
+};
+
+/* exp(-2*pi*i*cycles), reduced to one turn in double before the cexp */
+static void kf_czt_phasor(kiss_fft_cpx * x,double cycles)
+{
+    const double pi=3.14159265358979323846264338327;
+    cycles -= floor(cycles);
+    kf_cexp(x,-2*pi*cycles);
+}
+
+kiss_czt_cfg kiss_czt_alloc(int n,int m,double f0,double df,void * mem,size_t * lenmem)
+{
+    int j,L;
+    kiss_czt_cfg st = NULL;
+    size_t subsize = 0, memneeded;
+    kiss_fft_cpx * b;
+    kiss_fft_scalar scale;
+
+    if (n <= 0 || m <= 0) {
+        KISS_FFT_ERROR("CZT sizes must be positive.");
+        return NULL;
+    }
+    L = kiss_fft_next_fast_size(n + m - 1);
+
+    kiss_fft_alloc (L, 0, NULL, &subsize);
+    memneeded = sizeof(struct kiss_czt_state) + subsize
+        + sizeof(kiss_fft_cpx) * ((size_t)n + m + 3 * (size_t)L);
+
+    if (lenmem == NULL) {
+        st = (kiss_czt_cfg) KISS_FFT_MALLOC (memneeded);
+    } else {
+        if (*lenmem >= memneeded)
+            st = (kiss_czt_cfg) mem;
+        *lenmem = memneeded;
+    }
+    if (!st)
+        return NULL;
+
+    st->n = n;
+    st->m = m;
+    st->substate = (kiss_fft_cfg) (st + 1); /*just beyond kiss_czt_state struct */
+    st->pre = (kiss_fft_cpx *) (((char *) st->substate) + subsize);
+    st->post = st->pre + n;
+    st->filter = st->post + m;
+    st->tmpbuf = st->filter + L;
+    kiss_fft_alloc(L, 0, st->substate, &subsize);
+
+    for (j = 0; j < n; ++j)
+        kf_czt_phasor(st->pre + j, f0 * j + 0.5 * df * (double) j * j);
+    for (j = 0; j < m; ++j)
+        kf_czt_phasor(st->post + j, 0.5 * df * (double) j * j);
+
+    /* conj(w[d]) for lags d = 0..m-1 and, wrapped around, d = -(n-1)..-1 */
+    b = st->tmpbuf;
+    memset(b, 0, sizeof(kiss_fft_cpx) * L);
+    for (j = 0; j < m; ++j)
+        kf_czt_phasor(b + j, -0.5 * df * (double) j * j);
+    for (j = 1; j < n; ++j)
+        kf_czt_phasor(b + L - j, -0.5 * df * (double) j * j);
+
+    kiss_fft(st->substate, b, st->filter);
+    scale = (kiss_fft_scalar) (1.0 / L);
+    for (j = 0; j < L; ++j)
+        C_MULBYSCALAR(st->filter[j], scale);
+    return st;
+}
+
+/* a = FFT(premodulated input, zero padded to L), then fout = post * conv */
+static void kf_czt_finish(kiss_czt_cfg st,kiss_fft_cpx *fout)
+{
+    const int L = st->substate->nfft;
+    kiss_fft_cpx * a = st->tmpbuf;
+    kiss_fft_cpx * A = st->tmpbuf + L;
+    kiss_fft_cpx t;
+    int k;
+
+    memset(a + st->n, 0, sizeof(kiss_fft_cpx) * (L - st->n));
+
+    kiss_fft(st->substate, a, A);
+
+    for (k = 0; k < L; ++k) {
+        C_MUL(t, A[k], st->filter[k]);
+        a[k].r = t.r;
+        a[k].i = -t.i;
+    }
+
+    kiss_fft(st->substate, a, A);
+
+    for (k = 0; k < st->m; ++k) {
+        t.r = A[k].r;
+        t.i = -A[k].i;
+        C_MUL(fout[k], t, st->post[k]);
+    }
+}
+
+void kiss_czt(kiss_czt_cfg st,const kiss_fft_cpx *fin,kiss_fft_cpx *fout)
+{
+    int j;
+    for (j = 0; j < st->n; ++j)
+        C_MUL(st->tmpbuf[j], fin[j], st->pre[j]);
+    kf_czt_finish(st, fout);
+}
+
+void kiss_czt_real(kiss_czt_cfg st,const kiss_fft_scalar *timedata,kiss_fft_cpx *fout)
+{
+    int j;
+    for (j = 0; j < st->n; ++j) {
+        st->tmpbuf[j].r = S_MUL(timedata[j], st->pre[j].r);
+        st->tmpbuf[j].i = S_MUL(timedata[j], st->pre[j].i);
+    }
+    kf_czt_finish(st, fout);
+}
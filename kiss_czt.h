@@ -0,0 +1,54 @@
+/*
+ *  Chirp-z transform built on KISS FFT.
+ *
+ *  SPDX-License-Identifier: BSD-3-Clause
+ *  See COPYING file for more information.
+ */
+
+#ifndef KISS_CZT_H
+#define KISS_CZT_H
+
+#include "kiss_fft.h"
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/*
+
+ Zoom spectrum: m bins at arbitrary spacing over an arbitrary band,
+
+   X[k] = sum_{j=0}^{n-1} x[j] * exp(-2*pi*i * j * (f0 + k*df)),   k = 0..m-1
+
+ with f0 and df in cycles/sample (Hz / sample rate).  The sum is evaluated as
+ one convolution (Bluestein), i.e. two kiss_fft calls of the next fast size
+ >= n+m-1, however fine df is.  Meant for float builds.
+
+ */
+
+typedef struct kiss_czt_state *kiss_czt_cfg;
+
+
+kiss_czt_cfg KISS_FFT_API kiss_czt_alloc(int n,int m,double f0,double df,void * mem,size_t * lenmem);
+/*
+ n input points, m output bins.
+ mem/lenmem work as for kiss_fft_alloc; the result is freed with kiss_czt_free.
+ The cfg holds its own scratch space, so it must not be shared between threads.
+*/
+
+void KISS_FFT_API kiss_czt(kiss_czt_cfg cfg,const kiss_fft_cpx *fin,kiss_fft_cpx *fout);
+/*
+ input fin has n complex points, output fout has m complex points
+*/
+
+void KISS_FFT_API kiss_czt_real(kiss_czt_cfg cfg,const kiss_fft_scalar *timedata,kiss_fft_cpx *fout);
+/*
+ input timedata has n scalar points, output fout has m complex points
+*/
+
+#define kiss_czt_free KISS_FFT_FREE
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,518 @@
+/*
+ *  Digital downconverter: mix a slice of a real input stream to baseband
+ *  and decimate it through a CIC and halfband chain.
+ *
+ *  SPDX-License-Identifier: BSD-3-Clause
+ *  See COPYING file for more information.
+ */
+
+#include "kiss_ddc.h"
+#include "_kiss_fft_guts.h"
+
+#if defined(USE_SIMD) || defined(FIXED_POINT)
+# error "kiss_ddc needs a float kiss_fft_scalar"
+#endif
+
+#define KD_LANES        8       /* partial sums of every dot product, on every level */
+#define KD_BLOCK        64      /* CIC outputs per pass through the chain */
+#define KD_MAX_HALVES   3
+#define KD_HALFBAND     31      /* halfband taps (4k - 1) */
+#define KD_GRID         512     /* frequencies sampled by the compensator design */
+#define KD_RENORM       1024    /* oscillator steps between renormalizations */
+
+static const double kd_pi = 3.14159265358979323846264338327;
+
+/*
+ A stage by 2 keeps the even and odd samples of its input apart (I and Q
+ planar), so with taps split the same way an output is
+
+   y[m] = sum_j he[j] * e[m + oe + j]  +  sum_j ho[j] * o[m + oo + j]
+
+ oe and oo skip leading zero taps (a halfband's odd branch is a single tap).
+*/
+typedef struct {
+    int ne, no;                 /* taps per branch, padded to KD_LANES */
+    int oe, oo;
+    int ce, co;                 /* samples held in each branch */
+    kiss_fft_scalar * he;
+    kiss_fft_scalar * ho;
+    kiss_fft_scalar * er;       /* cap values each */
+    kiss_fft_scalar * ei;
+    kiss_fft_scalar * odr;
+    kiss_fft_scalar * odi;
+} kf_ddc_half;
+
+struct kiss_ddc_state{
+    int decim;
+    int cic;                    /* R */
+    int ntaps;                  /* CIC taps, padded to KD_LANES */
+    int nhalves;
+    int taps;                   /* nonzero taps of the whole chain */
+    int fill;                   /* inputs held in x */
+    int cap;                    /* room in x */
+    int half_cap;               /* room in each branch of a stage by 2 */
+    int quarter;                /* outputs so far mod 4 (kiss_ddc_real) */
+    int steps;                  /* oscillator steps since it was renormalized */
+    double step_r, step_i;      /* exp(-i w R) */
+    double rot_r, rot_i;        /* exp(-i w p), p the next CIC window's first input */
+    kiss_fft_scalar * gr;       /* CIC taps times exp(-i w k) */
+    kiss_fft_scalar * gi;
+    kiss_fft_scalar * x;        /* cap values */
+    kiss_fft_scalar * ar;       /* KD_BLOCK values each: the chain's ping-pong buffers */
+    kiss_fft_scalar * ai;
+    kiss_fft_scalar * br;
+    kiss_fft_scalar * bi;
+    kf_ddc_half half[KD_MAX_HALVES];
+};
+
+static int kf_ddc_pad(int n)
+{
+    return (n + KD_LANES - 1) / KD_LANES * KD_LANES;
+}
+
+/* the eight partial sums, added in the same order on every level */
+static kiss_fft_scalar kf_ddc_sum(const kiss_fft_scalar *a)
+{
+    return ((a[0] + a[4]) + (a[2] + a[6])) + ((a[1] + a[5]) + (a[3] + a[7]));
+}
+
+static void kf_ddc_dot_scalar(const kiss_fft_scalar *x0,const kiss_fft_scalar *h0,
+        const kiss_fft_scalar *x1,const kiss_fft_scalar *h1,int n,
+        kiss_fft_scalar *s0,kiss_fft_scalar *s1)
+{
+    kiss_fft_scalar a[KD_LANES] = {0}, b[KD_LANES] = {0};
+    int j, l;
+
+    for (j = 0; j < n; j += KD_LANES) {
+        for (l = 0; l < KD_LANES; ++l) {
+            a[l] += x0[j + l] * h0[j + l];
+            b[l] += x1[j + l] * h1[j + l];
+        }
+    }
+    *s0 = kf_ddc_sum(a);
+    *s1 = kf_ddc_sum(b);
+}
+
+#ifdef KISS_FFT_RUNTIME_SIMD
+#include <immintrin.h>
+
+static KF_ATTR_TARGET("sse2") void kf_ddc_dot_sse2(const kiss_fft_scalar *x0,const kiss_fft_scalar *h0,
+        const kiss_fft_scalar *x1,const kiss_fft_scalar *h1,int n,
+        kiss_fft_scalar *s0,kiss_fft_scalar *s1)
+{
+    __m128 a0 = _mm_setzero_ps(), a1 = _mm_setzero_ps();
+    __m128 b0 = _mm_setzero_ps(), b1 = _mm_setzero_ps();
+    kiss_fft_scalar a[KD_LANES], b[KD_LANES];
+    int j;
+
+    for (j = 0; j < n; j += KD_LANES) {
+        a0 = _mm_add_ps(a0, _mm_mul_ps(_mm_loadu_ps(x0 + j), _mm_loadu_ps(h0 + j)));
+        a1 = _mm_add_ps(a1, _mm_mul_ps(_mm_loadu_ps(x0 + j + 4), _mm_loadu_ps(h0 + j + 4)));
+        b0 = _mm_add_ps(b0, _mm_mul_ps(_mm_loadu_ps(x1 + j), _mm_loadu_ps(h1 + j)));
+        b1 = _mm_add_ps(b1, _mm_mul_ps(_mm_loadu_ps(x1 + j + 4), _mm_loadu_ps(h1 + j + 4)));
+    }
+    _mm_storeu_ps(a, a0);
+    _mm_storeu_ps(a + 4, a1);
+    _mm_storeu_ps(b, b0);
+    _mm_storeu_ps(b + 4, b1);
+    *s0 = kf_ddc_sum(a);
+    *s1 = kf_ddc_sum(b);
+}
+
+static KF_ATTR_TARGET("avx2") void kf_ddc_dot_avx2(const kiss_fft_scalar *x0,const kiss_fft_scalar *h0,
+        const kiss_fft_scalar *x1,const kiss_fft_scalar *h1,int n,
+        kiss_fft_scalar *s0,kiss_fft_scalar *s1)
+{
+    __m256 a0 = _mm256_setzero_ps(), b0 = _mm256_setzero_ps();
+    kiss_fft_scalar a[KD_LANES], b[KD_LANES];
+    int j;
+
+    for (j = 0; j < n; j += KD_LANES) {
+        a0 = _mm256_add_ps(a0, _mm256_mul_ps(_mm256_loadu_ps(x0 + j), _mm256_loadu_ps(h0 + j)));
+        b0 = _mm256_add_ps(b0, _mm256_mul_ps(_mm256_loadu_ps(x1 + j), _mm256_loadu_ps(h1 + j)));
+    }
+    _mm256_storeu_ps(a, a0);
+    _mm256_storeu_ps(b, b0);
+    *s0 = kf_ddc_sum(a);
+    *s1 = kf_ddc_sum(b);
+}
+#endif /* KISS_FFT_RUNTIME_SIMD */
+
+/* s0 = x0 . h0 and s1 = x1 . h1 over n values (a multiple of KD_LANES) */
+static void kf_ddc_dot(const kiss_fft_scalar *x0,const kiss_fft_scalar *h0,
+        const kiss_fft_scalar *x1,const kiss_fft_scalar *h1,int n,
+        kiss_fft_scalar *s0,kiss_fft_scalar *s1)
+{
+#ifdef KISS_FFT_RUNTIME_SIMD
+    const int level = kiss_fft_simd_level();
+    if (level >= KISS_FFT_SIMD_AVX2)
+        kf_ddc_dot_avx2(x0, h0, x1, h1, n, s0, s1);
+    else if (level >= KISS_FFT_SIMD_SSE2)
+        kf_ddc_dot_sse2(x0, h0, x1, h1, n, s0, s1);
+    else
+#endif
+        kf_ddc_dot_scalar(x0, h0, x1, h1, n, s0, s1);
+}
+
+static double kf_ddc_blackman(int k,int len)
+{
+    return len > 1 ? 0.42 - 0.5 * cos(2 * kd_pi * k / (len - 1))
+                     + 0.08 * cos(4 * kd_pi * k / (len - 1)) : 1;
+}
+
+/* (1 + z^-1 + ... + z^-(R-1))^order / R^order: order*(R-1)+1 taps */
+static int kf_ddc_cic_design(kiss_fft_scalar *h,int r,int order)
+{
+    int len = 1, i, k, s;
+    double sum;
+
+    h[0] = 1;
+    for (s = 0; s < order && r > 1; ++s) {
+        /* convolve with a boxcar of r ones, from the top so nothing is read
+           after it is overwritten */
+        len += r - 1;
+        for (k = len - 1; k >= 0; --k) {
+            sum = 0;
+            for (i = 0; i < r; ++i)
+                if (k - i >= 0 && k - i < len - r + 1)
+                    sum += h[k - i];
+            h[k] = (kiss_fft_scalar) (sum / r);
+        }
+    }
+    return len;
+}
+
+static double kf_ddc_halfband_tap(int k)
+{
+    const int t = k - (KD_HALFBAND - 1) / 2;
+    const double v = t == 0 ? 0.5 : sin(0.5 * kd_pi * t) / (kd_pi * t);
+    return v * kf_ddc_blackman(k, KD_HALFBAND);
+}
+
+/* |H(f)| of the halfband, f in cycles/sample at its input */
+static double kf_ddc_halfband_gain(double f,double norm)
+{
+    const int mid = (KD_HALFBAND - 1) / 2;
+    double g = 0;
+    int k;
+
+    for (k = 0; k < KD_HALFBAND; ++k)
+        g += kf_ddc_halfband_tap(k) * cos(2 * kd_pi * f * (k - mid));
+    return fabs(g) / norm;
+}
+
+/* Window-method lowpass with cutoff fc (cycles/sample at its input), shaped
+   by the inverse of the droop of everything before it (the CIC and
+   nhb halfbands), so the chain is flat up to the passband edge */
+static void kf_ddc_comp_design(double *h,int len,double fc,int r,int order,int nhb)
+{
+    const int mid = (len - 1) / 2;
+    double hb_norm = 0, f, fin, droop, target, sum = 0;
+    int g, k, s;
+
+    for (k = 0; k < KD_HALFBAND; ++k)
+        hb_norm += kf_ddc_halfband_tap(k);
+    for (k = 0; k < len; ++k)
+        h[k] = 0;
+
+    for (g = 0; g < KD_GRID; ++g) {
+        f = (g + 0.5) * fc / KD_GRID;
+        /* f at the CIC's input, then through each halfband at its own rate */
+        fin = f / ((double) r * (1 << nhb));
+        droop = r > 1 ? pow(fabs(sin(kd_pi * r * fin) / (r * sin(kd_pi * fin))), order) : 1;
+        for (s = 0; s < nhb; ++s)
+            droop *= kf_ddc_halfband_gain(f / (1 << (nhb - s)), hb_norm);
+        target = 1 / (droop > 0.25 ? droop : 0.25);
+        for (k = 0; k < len; ++k)
+            h[k] += target * cos(2 * kd_pi * f * (k - mid));
+    }
+    for (k = 0; k < len; ++k) {
+        h[k] *= kf_ddc_blackman(k, len);
+        sum += h[k];
+    }
+    for (k = 0; k < len; ++k)
+        h[k] /= sum;
+}
+
+/* split len taps into the stage's branches, dropping zero taps at either end */
+static int kf_ddc_half_taps(kf_ddc_half *hs,const double *h,int len)
+{
+    int lo, hi, j, used = 0, ph;
+
+    for (ph = 0; ph < 2; ++ph) {
+        kiss_fft_scalar * dst = ph ? hs->ho : hs->he;
+        const int nb = ph ? (len - 1) / 2 : (len + 1) / 2;
+
+        lo = 0;
+        hi = nb - 1;
+        while (lo < hi && h[2 * lo + ph] == 0)
+            ++lo;
+        while (hi > lo && h[2 * hi + ph] == 0)
+            --hi;
+        for (j = 0; j < kf_ddc_pad(hi - lo + 1); ++j)
+            dst[j] = lo + j <= hi ? (kiss_fft_scalar) h[2 * (lo + j) + ph] : 0;
+        if (ph) {
+            hs->oo = lo;
+            hs->no = kf_ddc_pad(hi - lo + 1);
+        } else {
+            hs->oe = lo;
+            hs->ne = kf_ddc_pad(hi - lo + 1);
+        }
+        used += hi - lo + 1;
+    }
+    return used;
+}
+
+kiss_ddc_cfg kiss_ddc_alloc(double center,int decim,int order,
+        double passband,double stopband,void * mem,size_t * lenmem)
+{
+    kiss_ddc_cfg st = NULL;
+    size_t memneeded;
+    int r, nhalves = 0, ncic, ntaps, clen, cap, half_cap, branch, s, k;
+    kiss_fft_scalar * p;
+    double * scratch;
+
+    if (order == 0)
+        order = 4;
+    if (passband == 0 && stopband == 0) {
+        passband = 0.4;
+        stopband = 0.6;
+    }
+    if (decim < 2 || (decim & 1) || !(fabs(center) <= 0.5) || order < 1 || order > 6
+            || !(passband > 0 && passband < stopband && stopband <= 1 - passband)) {
+        KISS_FFT_ERROR("DDC needs an even decimation, |centre| <= 0.5, CIC order 1..6 and 0 < passband < stopband <= 1 - passband.");
+        return NULL;
+    }
+
+    while (nhalves < KD_MAX_HALVES && (decim >> nhalves) % 2 == 0)
+        ++nhalves;
+    r = decim >> nhalves;
+
+    ncic = order * (r - 1) + 1;
+    ntaps = kf_ddc_pad(ncic);
+    cap = ntaps - 1 + r * KD_BLOCK;
+    /* about 6/len wide Blackman transition, over half the gap at this rate */
+    clen = (int) ceil(12 / (stopband - passband)) | 1;
+    branch = kf_ddc_pad((clen + 1) / 2);
+    if (branch < kf_ddc_pad((KD_HALFBAND + 1) / 2))
+        branch = kf_ddc_pad((KD_HALFBAND + 1) / 2);
+    half_cap = branch + KD_BLOCK;
+
+    memneeded = ((sizeof(struct kiss_ddc_state) + 15) & ~(size_t)15)
+        + sizeof(kiss_fft_scalar) * (2 * (size_t)ntaps + kf_ddc_pad(cap) + 4 * KD_BLOCK)
+        + sizeof(kiss_fft_scalar) * (size_t)nhalves * (2 * (size_t)branch + 4 * (size_t)half_cap);
+
+    if (lenmem == NULL) {
+        st = (kiss_ddc_cfg) KISS_FFT_MALLOC (memneeded);
+    } else {
+        if (mem != NULL && *lenmem >= memneeded)
+            st = (kiss_ddc_cfg) mem;
+        *lenmem = memneeded;
+    }
+    if (!st)
+        return NULL;
+
+    st->decim = decim;
+    st->cic = r;
+    st->ntaps = ntaps;
+    st->nhalves = nhalves;
+    st->cap = cap;
+    st->half_cap = half_cap;
+    st->step_r = cos(2 * kd_pi * center * r);
+    st->step_i = -sin(2 * kd_pi * center * r);
+
+    p = (kiss_fft_scalar *) ((char *) st + ((sizeof(struct kiss_ddc_state) + 15) & ~(size_t)15));
+    st->gr = p;             p += ntaps;
+    st->gi = p;             p += ntaps;
+    st->x = p;              p += kf_ddc_pad(cap);
+    st->ar = p;             p += KD_BLOCK;
+    st->ai = p;             p += KD_BLOCK;
+    st->br = p;             p += KD_BLOCK;
+    st->bi = p;             p += KD_BLOCK;
+    for (s = 0; s < nhalves; ++s) {
+        st->half[s].he = p;     p += branch;
+        st->half[s].ho = p;     p += branch;
+        st->half[s].er = p;     p += half_cap;
+        st->half[s].ei = p;     p += half_cap;
+        st->half[s].odr = p;    p += half_cap;
+        st->half[s].odi = p;    p += half_cap;
+    }
+
+    /* the CIC, designed in x and moved into the mixer taps */
+    memset(st->x, 0, sizeof(kiss_fft_scalar) * cap);
+    kf_ddc_cic_design(st->x, r, order);
+    for (k = 0; k < ntaps; ++k) {
+        st->gr[k] = (kiss_fft_scalar) (st->x[k] * cos(2 * kd_pi * center * k));
+        st->gi[k] = (kiss_fft_scalar) (-st->x[k] * sin(2 * kd_pi * center * k));
+    }
+    st->taps = ncic;
+
+    /* the stages by 2 design in double in their own sample buffers (4 *
+       half_cap floats, at least clen doubles), cleared by the reset below */
+    for (s = 0; s < nhalves; ++s) {
+        scratch = (double *) st->half[s].er;
+        if (s < nhalves - 1) {
+            for (k = 0; k < KD_HALFBAND; ++k)
+                scratch[k] = kf_ddc_halfband_tap(k);
+            st->taps += kf_ddc_half_taps(&st->half[s], scratch, KD_HALFBAND);
+        } else {
+            kf_ddc_comp_design(scratch, clen, 0.25 * (passband + stopband), r, order, nhalves - 1);
+            st->taps += kf_ddc_half_taps(&st->half[s], scratch, clen);
+        }
+    }
+    /* unit DC gain for the halfbands (the compensator is designed with it) */
+    for (s = 0; s < nhalves - 1; ++s) {
+        double sum = 0;
+        for (k = 0; k < st->half[s].ne; ++k)
+            sum += st->half[s].he[k];
+        for (k = 0; k < st->half[s].no; ++k)
+            sum += st->half[s].ho[k];
+        for (k = 0; k < st->half[s].ne; ++k)
+            st->half[s].he[k] = (kiss_fft_scalar) (st->half[s].he[k] / sum);
+        for (k = 0; k < st->half[s].no; ++k)
+            st->half[s].ho[k] = (kiss_fft_scalar) (st->half[s].ho[k] / sum);
+    }
+
+    kiss_ddc_reset(st);
+    return st;
+}
+
+void kiss_ddc_reset(kiss_ddc_cfg st)
+{
+    int s;
+
+    memset(st->x, 0, sizeof(kiss_fft_scalar) * st->cap);
+    st->fill = 0;
+    for (s = 0; s < st->nhalves; ++s) {
+        memset(st->half[s].er, 0, sizeof(kiss_fft_scalar) * 4 * (size_t)st->half_cap);
+        st->half[s].ce = 0;
+        st->half[s].co = 0;
+    }
+    st->quarter = 0;
+    st->steps = 0;
+    st->rot_r = 1;
+    st->rot_i = 0;
+}
+
+void kiss_ddc_info(kiss_ddc_cfg st,int *cic_decim,int *halves,int *taps)
+{
+    *cic_decim = st->cic;
+    *halves = st->nhalves;
+    *taps = st->taps;
+}
+
+/* CIC outputs for every window of ntaps inputs held, starting R apart */
+static int kf_ddc_cic(kiss_ddc_cfg st,kiss_fft_scalar *yr,kiss_fft_scalar *yi)
+{
+    kiss_fft_scalar sr, si;
+    double r;
+    int p, m = 0;
+
+    for (p = 0; p + st->ntaps <= st->fill; p += st->cic) {
+        kf_ddc_dot(st->x + p, st->gr, st->x + p, st->gi, st->ntaps, &sr, &si);
+        yr[m] = (kiss_fft_scalar) (sr * st->rot_r - si * st->rot_i);
+        yi[m] = (kiss_fft_scalar) (sr * st->rot_i + si * st->rot_r);
+        ++m;
+
+        r = st->rot_r * st->step_r - st->rot_i * st->step_i;
+        st->rot_i = st->rot_r * st->step_i + st->rot_i * st->step_r;
+        st->rot_r = r;
+        if (++st->steps == KD_RENORM) {
+            r = 1 / sqrt(st->rot_r * st->rot_r + st->rot_i * st->rot_i);
+            st->rot_r *= r;
+            st->rot_i *= r;
+            st->steps = 0;
+        }
+    }
+    st->fill -= p;
+    memmove(st->x, st->x + p, sizeof(kiss_fft_scalar) * st->fill);
+    return m;
+}
+
+/* feed n complex samples (planar) to a stage by 2; returns its outputs */
+static int kf_ddc_halve(kf_ddc_half *hs,const kiss_fft_scalar *xr,const kiss_fft_scalar *xi,int n,
+        kiss_fft_scalar *yr,kiss_fft_scalar *yi)
+{
+    kiss_fft_scalar er, ei, orr, oi;
+    int i, m;
+
+    for (i = 0; i < n; ++i) {
+        if (hs->ce == hs->co) {
+            hs->er[hs->ce] = xr[i];
+            hs->ei[hs->ce++] = xi[i];
+        } else {
+            hs->odr[hs->co] = xr[i];
+            hs->odi[hs->co++] = xi[i];
+        }
+    }
+
+    for (m = 0; m + hs->oe + hs->ne <= hs->ce && m + hs->oo + hs->no <= hs->co; ++m) {
+        kf_ddc_dot(hs->er + m + hs->oe, hs->he, hs->ei + m + hs->oe, hs->he, hs->ne, &er, &ei);
+        kf_ddc_dot(hs->odr + m + hs->oo, hs->ho, hs->odi + m + hs->oo, hs->ho, hs->no, &orr, &oi);
+        yr[m] = er + orr;
+        yi[m] = ei + oi;
+    }
+
+    hs->ce -= m;
+    hs->co -= m;
+    memmove(hs->er, hs->er + m, sizeof(kiss_fft_scalar) * hs->ce);
+    memmove(hs->ei, hs->ei + m, sizeof(kiss_fft_scalar) * hs->ce);
+    memmove(hs->odr, hs->odr + m, sizeof(kiss_fft_scalar) * hs->co);
+    memmove(hs->odi, hs->odi + m, sizeof(kiss_fft_scalar) * hs->co);
+    return m;
+}
+
+static int kf_ddc_run(kiss_ddc_cfg st,const kiss_fft_scalar *in,int n,
+        kiss_fft_cpx *out,kiss_fft_scalar *rout)
+{
+    kiss_fft_scalar *xr, *xi, *yr, *yi, *t;
+    int nout = 0, m, cnt, s, i;
+
+    while (n > 0) {
+        m = st->cap - st->fill;
+        if (m > n)
+            m = n;
+        memcpy(st->x + st->fill, in, sizeof(kiss_fft_scalar) * m);
+        st->fill += m;
+        in += m;
+        n -= m;
+
+        xr = st->ar;
+        xi = st->ai;
+        yr = st->br;
+        yi = st->bi;
+        cnt = kf_ddc_cic(st, xr, xi);
+        for (s = 0; s < st->nhalves; ++s) {
+            cnt = kf_ddc_halve(&st->half[s], xr, xi, cnt, yr, yi);
+            t = xr; xr = yr; yr = t;
+            t = xi; xi = yi; yi = t;
+        }
+
+        for (i = 0; i < cnt; ++i, ++nout) {
+            if (out) {
+                out[nout].r = xr[i];
+                out[nout].i = xi[i];
+            } else {
+                /* 2 Re(z * i^n) */
+                switch (st->quarter) {
+                    case 0: rout[nout] = 2 * xr[i]; break;
+                    case 1: rout[nout] = -2 * xi[i]; break;
+                    case 2: rout[nout] = -2 * xr[i]; break;
+                    default: rout[nout] = 2 * xi[i]; break;
+                }
+                st->quarter = (st->quarter + 1) & 3;
+            }
+        }
+    }
+    return nout;
+}
+
+int kiss_ddc(kiss_ddc_cfg st,const kiss_fft_scalar *in,int n,kiss_fft_cpx *out)
+{
+    return kf_ddc_run(st, in, n, out, NULL);
+}
+
+int kiss_ddc_real(kiss_ddc_cfg st,const kiss_fft_scalar *in,int n,kiss_fft_scalar *out)
+{
+    return kf_ddc_run(st, in, n, NULL, out);
+}
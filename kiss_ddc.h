@@ -0,0 +1,95 @@
+/*
+ *  Digital downconverter: mix a slice of a real input stream to baseband
+ *  and decimate it through a CIC and halfband chain.
+ *
+ *  SPDX-License-Identifier: BSD-3-Clause
+ *  See COPYING file for more information.
+ */
+
+#ifndef KISS_DDC_H
+#define KISS_DDC_H
+
+#include "kiss_fft.h"
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/*
+
+ Brings the band around centre (cycles/input sample) of a real stream
+ down to 0 Hz and decimates it by decim (even) in three kinds of stage:
+
+   CIC, decimating by R    the response of order comb/integrator pairs,
+                           (1 + z^-1 + ... + z^-(R-1))^order / R^order,
+                           run as a polyphase FIR.  Float integrators
+                           would drift; the FIR form does not, and the
+                           oscillator is folded into its taps (a
+                           frequency-translating FIR), so the mixer costs
+                           one complex rotation per CIC output instead of
+                           one per input sample.
+   halfbands, each by 2    Blackman windowed, every other tap zero
+   compensator, by 2       flattens the CIC droop over the passband and
+                           rejects everything that would alias into it
+
+ decim = R * 2^h with h (1 to 3 stages by 2, the last of them the
+ compensator) taken from the factors of 2 in decim, and R possibly 1.
+ Aliases are down about 75 dB when decim is a multiple of 8; with a
+ single factor of 2 the CIC guards most of them alone, at about 40 dB
+ for order 4.  Each stage splits its input into polyphase branches, so
+ every output is a few dot products over contiguous memory; they run 8
+ lanes wide in the SSE2/AVX2 code picked by kiss_fft_simd_level(), and
+ every level gives bit-identical results.
+
+ The passband is flat (within about 0.01 dB) to passband * output rate on
+ either side of 0 Hz, and nothing from beyond stopband * output rate
+ aliases into it.  A tone of amplitude A in the passband comes out as a
+ complex exponential of amplitude A/2 (its negative-frequency image is
+ filtered away).  Meant for float builds.
+
+ */
+
+typedef struct kiss_ddc_state *kiss_ddc_cfg;
+
+kiss_ddc_cfg KISS_FFT_API kiss_ddc_alloc(double center,int decim,int order,
+        double passband,double stopband,void * mem,size_t * lenmem);
+/*
+ centre in cycles/input sample (-0.5 to 0.5); decim even; order of the CIC
+ (1..6, or 0 for 4); passband < stopband <= 1 - passband, as fractions of
+ the output rate (both 0 for 0.4 and 0.6, the widest alias-free band).
+ mem/lenmem work as for kiss_fft_alloc; the result is freed with kiss_ddc_free.
+ The cfg holds the stream's history, so it must not be shared between threads.
+*/
+
+int KISS_FFT_API kiss_ddc(kiss_ddc_cfg cfg,const kiss_fft_scalar *in,int n,kiss_fft_cpx *out);
+/*
+ Feeds n input samples and returns the number of outputs written to out
+ (room for n/decim + 1).  Samples that do not complete an output are kept
+ for the next call.
+*/
+
+int KISS_FFT_API kiss_ddc_real(kiss_ddc_cfg cfg,const kiss_fft_scalar *in,int n,kiss_fft_scalar *out);
+/*
+ As kiss_ddc, but the baseband is shifted up by a quarter of the output
+ rate and its real part doubled: a real stream with centre at fs_out/4
+ and tones at their input amplitude.  Only the band within fs_out/4 of
+ centre fits; allocate with stopband <= 0.5 - passband (e.g. 0.2, 0.3).
+*/
+
+void KISS_FFT_API kiss_ddc_reset(kiss_ddc_cfg cfg);
+/*
+ clears the history and restarts the oscillator
+*/
+
+void KISS_FFT_API kiss_ddc_info(kiss_ddc_cfg cfg,int *cic_decim,int *halves,int *taps);
+/*
+ the chain: CIC decimation R, stages by 2 (including the compensator),
+ and the taps of all stages together
+*/
+
+#define kiss_ddc_free KISS_FFT_FREE
+
+#ifdef __cplusplus
+}
+#endif
+#endif
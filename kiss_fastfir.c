@@ -0,0 +1,129 @@
+/*
+ *  Overlap-save fast convolution built on KISS FFT.
+ *
+ *  SPDX-License-Identifier: BSD-3-Clause
+ *  See COPYING file for more information.
+ */
+
+#include "kiss_fastfir.h"
+#include "kiss_fftr.h"
+#include "_kiss_fft_guts.h"
+
+#ifdef USE_SIMD
+# error "kiss_fastfir needs a scalar kiss_fft_scalar (USE_SIMD packs four transforms per value)"
+#endif
+
+/*
+ The circular convolution of the nfft-sample history with the zero padded
+ taps equals the linear one from index ntaps-1 on, so a block can return
+ its last m <= nfft-ntaps+1 samples.  1/nfft of the inverse transform is
+ folded into the stored spectrum.
+*/
+struct kiss_fastfir_state{
+    int ntaps;
+    int nfft;
+    int hop;                    /* most outputs per block: nfft-ntaps+1 */
+    kiss_fftr_cfg fwd;
+    kiss_fftr_cfg inv;
+    kiss_fft_cpx * filter;      /* nfft/2+1 values: FFT(taps) / nfft */
+    kiss_fft_cpx * freq;        /* nfft/2+1 values of scratch */
+    kiss_fft_scalar * hist;     /* nfft values: the latest inputs, oldest first */
+    kiss_fft_scalar * time;     /* nfft values of scratch */
+};
+
+kiss_fastfir_cfg kiss_fastfir_alloc(const kiss_fft_scalar *taps,int ntaps,int nfft,void * mem,size_t * lenmem)
+{
+    kiss_fastfir_cfg st = NULL;
+    size_t fwdsize = 0, invsize = 0, memneeded;
+    const int nbins = nfft / 2 + 1;
+    kiss_fft_scalar scale;
+    int j;
+
+    if (ntaps <= 0) {
+        KISS_FFT_ERROR("FIR filter needs at least one tap.");
+        return NULL;
+    }
+    if (nfft == 0)
+        return kiss_fastfir_alloc(taps, ntaps,
+                kiss_fftr_next_fast_size_real(4 * ntaps > 64 ? 4 * ntaps : 64), mem, lenmem);
+    if ((nfft & 1) || nfft < ntaps) {
+        KISS_FFT_ERROR("FIR block size must be even and at least the number of taps.");
+        return NULL;
+    }
+
+    kiss_fftr_alloc(nfft, 0, NULL, &fwdsize);
+    kiss_fftr_alloc(nfft, 1, NULL, &invsize);
+    fwdsize = (fwdsize + 15) & ~(size_t)15;
+    invsize = (invsize + 15) & ~(size_t)15;
+    memneeded = ((sizeof(struct kiss_fastfir_state) + 15) & ~(size_t)15) + fwdsize + invsize
+        + sizeof(kiss_fft_cpx) * 2 * (size_t)nbins + sizeof(kiss_fft_scalar) * 2 * (size_t)nfft;
+
+    if (lenmem == NULL) {
+        st = (kiss_fastfir_cfg) KISS_FFT_MALLOC (memneeded);
+    } else {
+        if (mem != NULL && *lenmem >= memneeded)
+            st = (kiss_fastfir_cfg) mem;
+        *lenmem = memneeded;
+    }
+    if (!st)
+        return NULL;
+
+    st->ntaps = ntaps;
+    st->nfft = nfft;
+    st->hop = nfft - ntaps + 1;
+    st->fwd = (kiss_fftr_cfg) ((char *) st + ((sizeof(struct kiss_fastfir_state) + 15) & ~(size_t)15));
+    st->inv = (kiss_fftr_cfg) ((char *) st->fwd + fwdsize);
+    st->filter = (kiss_fft_cpx *) ((char *) st->inv + invsize);
+    st->freq = st->filter + nbins;
+    st->hist = (kiss_fft_scalar *) (st->freq + nbins);
+    st->time = st->hist + nfft;
+    kiss_fftr_alloc(nfft, 0, st->fwd, &fwdsize);
+    kiss_fftr_alloc(nfft, 1, st->inv, &invsize);
+
+    memset(st->time, 0, sizeof(kiss_fft_scalar) * nfft);
+    memcpy(st->time, taps, sizeof(kiss_fft_scalar) * ntaps);
+    kiss_fftr(st->fwd, st->time, st->filter);
+    scale = (kiss_fft_scalar) (1.0 / nfft);
+    for (j = 0; j < nbins; ++j)
+        C_MULBYSCALAR(st->filter[j], scale);
+
+    kiss_fastfir_reset(st);
+    return st;
+}
+
+void kiss_fastfir_reset(kiss_fastfir_cfg st)
+{
+    memset(st->hist, 0, sizeof(kiss_fft_scalar) * st->nfft);
+}
+
+int kiss_fastfir_nfft(kiss_fastfir_cfg st)
+{
+    return st->nfft;
+}
+
+void kiss_fastfir(kiss_fastfir_cfg st,const kiss_fft_scalar *in,kiss_fft_scalar *out,int n)
+{
+    const int nfft = st->nfft;
+    const int nbins = nfft / 2 + 1;
+    kiss_fft_cpx t;
+    int m, k;
+
+    while (n > 0) {
+        m = n < st->hop ? n : st->hop;
+
+        memmove(st->hist, st->hist + m, sizeof(kiss_fft_scalar) * (nfft - m));
+        memcpy(st->hist + nfft - m, in, sizeof(kiss_fft_scalar) * m);
+
+        kiss_fftr(st->fwd, st->hist, st->freq);
+        for (k = 0; k < nbins; ++k) {
+            C_MUL(t, st->freq[k], st->filter[k]);
+            st->freq[k] = t;
+        }
+        kiss_fftri(st->inv, st->freq, st->time);
+
+        memcpy(out, st->time + nfft - m, sizeof(kiss_fft_scalar) * m);
+        in += m;
+        out += m;
+        n -= m;
+    }
+}
@@ -0,0 +1,67 @@
+/*
+ *  Overlap-save fast convolution built on KISS FFT.
+ *
+ *  SPDX-License-Identifier: BSD-3-Clause
+ *  See COPYING file for more information.
+ */
+
+#ifndef KISS_FASTFIR_H
+#define KISS_FASTFIR_H
+
+#include "kiss_fft.h"
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/*
+
+ Streaming real FIR filter,
+
+   y[t] = sum_{j=0}^{ntaps-1} h[j] * x[t-j]
+
+ evaluated by overlap-save: each block keeps the last nfft inputs, takes
+ kiss_fftr of them, multiplies by the filter spectrum (computed once at
+ alloc) and returns the newest samples of kiss_fftri (inverse_fft=1).  A
+ block yields up to nfft-ntaps+1 outputs, so the cost per sample is
+ O(log nfft) whatever the number of taps.  Output sample t is available
+ as soon as input sample t is: calls of any length work and there is no
+ added latency beyond the filter's own.  Calls shorter than a block still
+ pay for a whole block, so pick nfft >= ntaps-1 plus the usual call
+ length.  Meant for float builds.
+
+ */
+
+typedef struct kiss_fastfir_state *kiss_fastfir_cfg;
+
+
+kiss_fastfir_cfg KISS_FFT_API kiss_fastfir_alloc(const kiss_fft_scalar *taps,int ntaps,int nfft,void * mem,size_t * lenmem);
+/*
+ ntaps filter coefficients taps[0..ntaps-1].
+ nfft is the block size: even and at least ntaps, or 0 to pick a fast
+ size of about four times ntaps.
+ mem/lenmem work as for kiss_fft_alloc; the result is freed with kiss_fastfir_free.
+ The cfg holds the input history, so it must not be shared between threads.
+*/
+
+void KISS_FFT_API kiss_fastfir(kiss_fastfir_cfg cfg,const kiss_fft_scalar *in,kiss_fft_scalar *out,int n);
+/*
+ filters the next n input samples into n output samples; out may equal in
+*/
+
+void KISS_FFT_API kiss_fastfir_reset(kiss_fastfir_cfg cfg);
+/*
+ clears the input history (as if all earlier input were zero)
+*/
+
+int KISS_FFT_API kiss_fastfir_nfft(kiss_fastfir_cfg cfg);
+/*
+ the block size in use
+*/
+
+#define kiss_fastfir_free KISS_FFT_FREE
+
+#ifdef __cplusplus
+}
+#endif
+#endif
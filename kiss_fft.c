@@ -188,6 +188,272 @@ static void kf_bfly5(
     }
 }
 
+#ifdef KISS_FFT_RUNTIME_SIMD
+/*
+ * Runtime-dispatched SIMD butterflies.
+ *
+ * The radix-2/3/4/5 kernels are instantiated from _kiss_fft_simd.h for
+ * SSE2, AVX2 and AVX-512F.  All of them work on the ordinary float
+ * kiss_fft_cpx layout, so the public API is unchanged, and the widest
+ * set the CPU and OS support is picked via cpuid the first time a cfg is
+ * allocated.  A stage whose m is not a multiple of the vector width
+ * falls back to the next narrower kernel, down to the scalar one.
+ */
+#include <immintrin.h>
+#ifdef _MSC_VER
+# include <intrin.h>
+#else
+# include <cpuid.h>
+#endif
+
+/* two complex values from p[0] and p[s] */
+#define KF_TW2(p,s) \
+    _mm_loadh_pi( _mm_loadl_pi(_mm_setzero_ps(),(const __m64*)(p)), (const __m64*)((p)+(s)) )
+/* four complex values from p[0], p[s], p[2s], p[3s] */
+#define KF_TW4(p,s) \
+    _mm256_insertf128_ps( _mm256_castps128_ps256(KF_TW2(p,s)), KF_TW2((p)+2*(s),s), 1 )
+
+/* ---- SSE2: 2 complex per vector ---- */
+#define KF_V            __m128
+#define KF_VLEN         2
+#define KF_SFX          sse2
+#define KF_TARGET       KF_ATTR_TARGET("sse2")
+#define VLD(p)          _mm_loadu_ps((const float*)(p))
+#define VST(p,v)        _mm_storeu_ps((float*)(p),(v))
+#define VTW(p,s)        KF_TW2(p,s)
+#define VADD(a,b)       _mm_add_ps((a),(b))
+#define VSUB(a,b)       _mm_sub_ps((a),(b))
+#define VMUL(a,b)       _mm_mul_ps((a),(b))
+#define VSET1(x)        _mm_set1_ps(x)
+#define VSWAP(v)        _mm_shuffle_ps((v),(v),_MM_SHUFFLE(2,3,0,1))
+#define VDUPRE(v)       _mm_shuffle_ps((v),(v),_MM_SHUFFLE(2,2,0,0))
+#define VDUPIM(v)       _mm_shuffle_ps((v),(v),_MM_SHUFFLE(3,3,1,1))
+#define VNEGRE(v)       _mm_xor_ps((v),_mm_setr_ps(-0.f,0.f,-0.f,0.f))
+#define VNEGIM(v)       _mm_xor_ps((v),_mm_setr_ps(0.f,-0.f,0.f,-0.f))
+#include "_kiss_fft_simd.h"
+#undef KF_V
+#undef KF_VLEN
+#undef KF_SFX
+#undef KF_TARGET
+#undef VLD
+#undef VST
+#undef VTW
+#undef VADD
+#undef VSUB
+#undef VMUL
+#undef VSET1
+#undef VSWAP
+#undef VDUPRE
+#undef VDUPIM
+#undef VNEGRE
+#undef VNEGIM
+
+/* ---- AVX2: 4 complex per vector ---- */
+#define KF_V            __m256
+#define KF_VLEN         4
+#define KF_SFX          avx2
+#define KF_TARGET       KF_ATTR_TARGET("avx2")
+#define VLD(p)          _mm256_loadu_ps((const float*)(p))
+#define VST(p,v)        _mm256_storeu_ps((float*)(p),(v))
+#define VTW(p,s)        KF_TW4(p,s)
+#define VADD(a,b)       _mm256_add_ps((a),(b))
+#define VSUB(a,b)       _mm256_sub_ps((a),(b))
+#define VMUL(a,b)       _mm256_mul_ps((a),(b))
+#define VSET1(x)        _mm256_set1_ps(x)
+#define VSWAP(v)        _mm256_permute_ps((v),0xB1)
+#define VDUPRE(v)       _mm256_moveldup_ps(v)
+#define VDUPIM(v)       _mm256_movehdup_ps(v)
+#define VNEGRE(v)       _mm256_xor_ps((v),_mm256_setr_ps(-0.f,0.f,-0.f,0.f,-0.f,0.f,-0.f,0.f))
+#define VNEGIM(v)       _mm256_xor_ps((v),_mm256_setr_ps(0.f,-0.f,0.f,-0.f,0.f,-0.f,0.f,-0.f))
+#include "_kiss_fft_simd.h"
+#undef KF_V
+#undef KF_VLEN
+#undef KF_SFX
+#undef KF_TARGET
+#undef VLD
+#undef VST
+#undef VTW
+#undef VADD
+#undef VSUB
+#undef VMUL
+#undef VSET1
+#undef VSWAP
+#undef VDUPRE
+#undef VDUPIM
+#undef VNEGRE
+#undef VNEGIM
+
+/* ---- AVX-512F: 8 complex per vector ---- */
+#define KF_XOR512(a,b) \
+    _mm512_castsi512_ps( _mm512_xor_si512(_mm512_castps_si512(a),_mm512_castps_si512(b)) )
+#define KF_V            __m512
+#define KF_VLEN         8
+#define KF_SFX          avx512
+#define KF_TARGET       KF_ATTR_TARGET("avx512f")
+#define VLD(p)          _mm512_loadu_ps((const float*)(p))
+#define VST(p,v)        _mm512_storeu_ps((float*)(p),(v))
+#define VTW(p,s)        _mm512_castpd_ps( _mm512_insertf64x4( \
+                            _mm512_castpd256_pd512(_mm256_castps_pd(KF_TW4(p,s))), \
+                            _mm256_castps_pd(KF_TW4((p)+4*(s),s)), 1) )
+#define VADD(a,b)       _mm512_add_ps((a),(b))
+#define VSUB(a,b)       _mm512_sub_ps((a),(b))
+#define VMUL(a,b)       _mm512_mul_ps((a),(b))
+#define VSET1(x)        _mm512_set1_ps(x)
+#define VSWAP(v)        _mm512_permute_ps((v),0xB1)
+#define VDUPRE(v)       _mm512_moveldup_ps(v)
+#define VDUPIM(v)       _mm512_movehdup_ps(v)
+#define VNEGRE(v)       KF_XOR512((v),_mm512_setr_ps(-0.f,0.f,-0.f,0.f,-0.f,0.f,-0.f,0.f, \
+                                                     -0.f,0.f,-0.f,0.f,-0.f,0.f,-0.f,0.f))
+#define VNEGIM(v)       KF_XOR512((v),_mm512_setr_ps(0.f,-0.f,0.f,-0.f,0.f,-0.f,0.f,-0.f, \
+                                                     0.f,-0.f,0.f,-0.f,0.f,-0.f,0.f,-0.f))
+#include "_kiss_fft_simd.h"
+#undef KF_V
+#undef KF_VLEN
+#undef KF_SFX
+#undef KF_TARGET
+#undef VLD
+#undef VST
+#undef VTW
+#undef VADD
+#undef VSUB
+#undef VMUL
+#undef VSET1
+#undef VSWAP
+#undef VDUPRE
+#undef VDUPIM
+#undef VNEGRE
+#undef VNEGIM
+
+static int kf_simd_detected = -1;   /* best level this host supports */
+static int kf_simd_active = -1;     /* level the butterflies dispatch on */
+
+static void kf_cpuid(unsigned int leaf, unsigned int sub, unsigned int * regs)
+{
+#ifdef _MSC_VER
+    int r[4];
+    __cpuidex(r,(int)leaf,(int)sub);
+    regs[0]=r[0]; regs[1]=r[1]; regs[2]=r[2]; regs[3]=r[3];
+#else
+    __cpuid_count(leaf,sub,regs[0],regs[1],regs[2],regs[3]);
+#endif
+}
+
+static unsigned long long kf_xgetbv0(void)
+{
+#ifdef _MSC_VER
+    return _xgetbv(0);
+#else
+    unsigned int eax,edx;
+    __asm__ __volatile__ ("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return ((unsigned long long)edx << 32) | eax;
+#endif
+}
+
+static int kf_detect_simd(void)
+{
+    unsigned int r[4];
+    unsigned int max_leaf;
+    unsigned long long xcr0 = 0;
+    int level = KISS_FFT_SIMD_SCALAR;
+
+    kf_cpuid(0,0,r);
+    max_leaf = r[0];
+    if (max_leaf < 1)
+        return level;
+
+    kf_cpuid(1,0,r);
+    if (r[3] & (1u<<26))                            /* SSE2 */
+        level = KISS_FFT_SIMD_SSE2;
+    if ( (r[2] & (1u<<27)) && (r[2] & (1u<<28)) )   /* OSXSAVE + AVX */
+        xcr0 = kf_xgetbv0();
+
+    if (max_leaf >= 7 && (xcr0 & 0x6) == 0x6) {     /* OS saves XMM/YMM */
+        kf_cpuid(7,0,r);
+        if (r[1] & (1u<<5))                         /* AVX2 */
+            level = KISS_FFT_SIMD_AVX2;
+        if ( (r[1] & (1u<<16)) && (xcr0 & 0xE6) == 0xE6 )  /* AVX-512F + ZMM state */
+            level = KISS_FFT_SIMD_AVX512;
+    }
+    return level;
+}
+
+static void kf_simd_init(void)
+{
+    if (kf_simd_detected < 0) {
+        kf_simd_detected = kf_detect_simd();
+        kf_simd_active = kf_simd_detected;
+    }
+}
+
+#define KF_SIMD_BFLY(sfx) \
+    switch (p) { \
+        case 2: kf_bfly2_##sfx(Fout,fstride,st,m); return 1; \
+        case 3: kf_bfly3_##sfx(Fout,fstride,st,m); return 1; \
+        case 4: kf_bfly4_##sfx(Fout,fstride,st,m); return 1; \
+        case 5: kf_bfly5_##sfx(Fout,fstride,st,m); return 1; \
+        default: return 0; \
+    }
+
+/* returns 0 if no vector kernel fits this stage */
+static int kf_bfly_simd(
+        kiss_fft_cpx * Fout,
+        const size_t fstride,
+        const kiss_fft_cfg st,
+        int m,
+        int p
+        )
+{
+    if (kf_simd_active >= KISS_FFT_SIMD_AVX512 && (m & 7) == 0) {
+        KF_SIMD_BFLY(avx512)
+    }
+    if (kf_simd_active >= KISS_FFT_SIMD_AVX2 && (m & 3) == 0) {
+        KF_SIMD_BFLY(avx2)
+    }
+    if (kf_simd_active >= KISS_FFT_SIMD_SSE2 && (m & 1) == 0) {
+        KF_SIMD_BFLY(sse2)
+    }
+    return 0;
+}
+
+#define KF_SIMD_BFLY_BATCH(sfx,width) \
+    n = (B - b) & ~(width-1); \
+    if (n) { \
+        switch (p) { \
+            case 2: kf_bfly2_batch_##sfx(Fout,fstride,st,m,B,b,b+n); break; \
+            case 3: kf_bfly3_batch_##sfx(Fout,fstride,st,m,B,b,b+n); break; \
+            case 4: kf_bfly4_batch_##sfx(Fout,fstride,st,m,B,b,b+n); break; \
+            default: kf_bfly5_batch_##sfx(Fout,fstride,st,m,B,b,b+n); break; \
+        } \
+        b += n; \
+    }
+
+/* vectorize the batch columns of one stage, widest kernel first;
+   returns the first column left for the scalar kernels */
+static int kf_bfly_batch_simd(
+        kiss_fft_cpx * Fout,
+        const size_t fstride,
+        const kiss_fft_cfg st,
+        int m,
+        int p,
+        int B
+        )
+{
+    int b = 0, n;
+    if (p < 2 || p > 5)
+        return 0;
+    if (kf_simd_active >= KISS_FFT_SIMD_AVX512) {
+        KF_SIMD_BFLY_BATCH(avx512,8)
+    }
+    if (kf_simd_active >= KISS_FFT_SIMD_AVX2) {
+        KF_SIMD_BFLY_BATCH(avx2,4)
+    }
+    if (kf_simd_active >= KISS_FFT_SIMD_SSE2) {
+        KF_SIMD_BFLY_BATCH(sse2,2)
+    }
+    return b;
+}
+#endif /* KISS_FFT_RUNTIME_SIMD */
+
 /* perform the butterfly for one stage of a mixed radix FFT */
 static void kf_bfly_generic(
         kiss_fft_cpx * Fout,
@@ -232,6 +498,28 @@ static void kf_bfly_generic(
     KISS_FFT_TMP_FREE(scratch);
 }
 
+/* recombine the p smaller DFTs of one stage */
+static void kf_bfly(
+        kiss_fft_cpx * Fout,
+        const size_t fstride,
+        const kiss_fft_cfg st,
+        int m,
+        int p
+        )
+{
+#ifdef KISS_FFT_RUNTIME_SIMD
+    if (kf_bfly_simd(Fout,fstride,st,m,p))
+        return;
+#endif
+    switch (p) {
+        case 2: kf_bfly2(Fout,fstride,st,m); break;
+        case 3: kf_bfly3(Fout,fstride,st,m); break;
+        case 4: kf_bfly4(Fout,fstride,st,m); break;
+        case 5: kf_bfly5(Fout,fstride,st,m); break;
+        default: kf_bfly_generic(Fout,fstride,st,m,p); break;
+    }
+}
+
 static
 void kf_work(
         kiss_fft_cpx * Fout,
@@ -260,13 +548,7 @@ void kf_work(
             kf_work( Fout +k*m, f+ fstride*in_stride*k,fstride*p,in_stride,factors,st);
         // all threads have joined by this point
 
-        switch (p) {
-            case 2: kf_bfly2(Fout,fstride,st,m); break;
-            case 3: kf_bfly3(Fout,fstride,st,m); break;
-            case 4: kf_bfly4(Fout,fstride,st,m); break;
-            case 5: kf_bfly5(Fout,fstride,st,m); break;
-            default: kf_bfly_generic(Fout,fstride,st,m,p); break;
-        }
+        kf_bfly(Fout,fstride,st,m,p);
         return;
     }
 #endif
@@ -290,20 +572,434 @@ void kf_work(
     Fout=Fout_beg;
 
     // recombine the p smaller DFTs
+    kf_bfly(Fout,fstride,st,m,p);
+}
+
+/*
+ * Batched transforms.
+ *
+ * A batch of B transforms is worked on element-interleaved: element k of
+ * transform b lives at Fout[k*B+b].  Each stage then walks its twiddles
+ * once and applies every twiddle to a whole row of B values, which is
+ * also where the SIMD kernels put their lanes.  The scalar kernels below
+ * handle the columns [b0,b1) the vector kernels leave over.
+ */
+static void kf_bfly2_batch(
+        kiss_fft_cpx * Fout,
+        const size_t fstride,
+        const kiss_fft_cfg st,
+        int m,
+        int B,
+        int b0,
+        int b1
+        )
+{
+    int k,b;
+    kiss_fft_cpx t;
+    for (k=0;k<m;++k) {
+        const kiss_fft_cpx tw1 = st->twiddles[k*fstride];
+        kiss_fft_cpx * F0 = Fout + (size_t)k*B;
+        kiss_fft_cpx * F1 = F0 + (size_t)m*B;
+        for (b=b0;b<b1;++b) {
+            C_FIXDIV(F0[b],2); C_FIXDIV(F1[b],2);
+            C_MUL (t, F1[b], tw1);
+            C_SUB( F1[b], F0[b], t );
+            C_ADDTO( F0[b], t );
+        }
+    }
+}
+
+static void kf_bfly4_batch(
+        kiss_fft_cpx * Fout,
+        const size_t fstride,
+        const kiss_fft_cfg st,
+        int m,
+        int B,
+        int b0,
+        int b1
+        )
+{
+    const size_t r1=(size_t)m*B, r2=2*r1, r3=3*r1;
+    kiss_fft_cpx scratch[6];
+    int k,b;
+    for (k=0;k<m;++k) {
+        const kiss_fft_cpx tw1 = st->twiddles[k*fstride];
+        const kiss_fft_cpx tw2 = st->twiddles[k*fstride*2];
+        const kiss_fft_cpx tw3 = st->twiddles[k*fstride*3];
+        kiss_fft_cpx * F = Fout + (size_t)k*B;
+        for (b=b0;b<b1;++b) {
+            kiss_fft_cpx * f = F + b;
+            C_FIXDIV(f[0],4); C_FIXDIV(f[r1],4); C_FIXDIV(f[r2],4); C_FIXDIV(f[r3],4);
+
+            C_MUL(scratch[0],f[r1] , tw1 );
+            C_MUL(scratch[1],f[r2] , tw2 );
+            C_MUL(scratch[2],f[r3] , tw3 );
+
+            C_SUB( scratch[5] , f[0], scratch[1] );
+            C_ADDTO(f[0], scratch[1]);
+            C_ADD( scratch[3] , scratch[0] , scratch[2] );
+            C_SUB( scratch[4] , scratch[0] , scratch[2] );
+            C_SUB( f[r2], f[0], scratch[3] );
+            C_ADDTO( f[0] , scratch[3] );
+
+            if(st->inverse) {
+                f[r1].r = scratch[5].r - scratch[4].i;
+                f[r1].i = scratch[5].i + scratch[4].r;
+                f[r3].r = scratch[5].r + scratch[4].i;
+                f[r3].i = scratch[5].i - scratch[4].r;
+            }else{
+                f[r1].r = scratch[5].r + scratch[4].i;
+                f[r1].i = scratch[5].i - scratch[4].r;
+                f[r3].r = scratch[5].r - scratch[4].i;
+                f[r3].i = scratch[5].i + scratch[4].r;
+            }
+        }
+    }
+}
+
+static void kf_bfly3_batch(
+        kiss_fft_cpx * Fout,
+        const size_t fstride,
+        const kiss_fft_cfg st,
+        int m,
+        int B,
+        int b0,
+        int b1
+        )
+{
+    const size_t r1=(size_t)m*B, r2=2*r1;
+    const kiss_fft_cpx epi3 = st->twiddles[fstride*m];
+    kiss_fft_cpx scratch[5];
+    int k,b;
+    for (k=0;k<m;++k) {
+        const kiss_fft_cpx tw1 = st->twiddles[k*fstride];
+        const kiss_fft_cpx tw2 = st->twiddles[k*fstride*2];
+        kiss_fft_cpx * F = Fout + (size_t)k*B;
+        for (b=b0;b<b1;++b) {
+            kiss_fft_cpx * f = F + b;
+            C_FIXDIV(f[0],3); C_FIXDIV(f[r1],3); C_FIXDIV(f[r2],3);
+
+            C_MUL(scratch[1],f[r1] , tw1);
+            C_MUL(scratch[2],f[r2] , tw2);
+
+            C_ADD(scratch[3],scratch[1],scratch[2]);
+            C_SUB(scratch[0],scratch[1],scratch[2]);
+
+            f[r1].r = f[0].r - HALF_OF(scratch[3].r);
+            f[r1].i = f[0].i - HALF_OF(scratch[3].i);
+
+            C_MULBYSCALAR( scratch[0] , epi3.i );
+
+            C_ADDTO(f[0],scratch[3]);
+
+            f[r2].r = f[r1].r + scratch[0].i;
+            f[r2].i = f[r1].i - scratch[0].r;
+
+            f[r1].r -= scratch[0].i;
+            f[r1].i += scratch[0].r;
+        }
+    }
+}
+
+static void kf_bfly5_batch(
+        kiss_fft_cpx * Fout,
+        const size_t fstride,
+        const kiss_fft_cfg st,
+        int m,
+        int B,
+        int b0,
+        int b1
+        )
+{
+    const size_t r1=(size_t)m*B;
+    const kiss_fft_cpx ya = st->twiddles[fstride*m];
+    const kiss_fft_cpx yb = st->twiddles[fstride*2*m];
+    kiss_fft_cpx scratch[13];
+    int u,b;
+    for (u=0;u<m;++u) {
+        const kiss_fft_cpx tw1 = st->twiddles[u*fstride];
+        const kiss_fft_cpx tw2 = st->twiddles[2*u*fstride];
+        const kiss_fft_cpx tw3 = st->twiddles[3*u*fstride];
+        const kiss_fft_cpx tw4 = st->twiddles[4*u*fstride];
+        kiss_fft_cpx * F = Fout + (size_t)u*B;
+        for (b=b0;b<b1;++b) {
+            kiss_fft_cpx *Fout0=F+b, *Fout1=Fout0+r1, *Fout2=Fout0+2*r1,
+                         *Fout3=Fout0+3*r1, *Fout4=Fout0+4*r1;
+            C_FIXDIV( *Fout0,5); C_FIXDIV( *Fout1,5); C_FIXDIV( *Fout2,5); C_FIXDIV( *Fout3,5); C_FIXDIV( *Fout4,5);
+            scratch[0] = *Fout0;
+
+            C_MUL(scratch[1] ,*Fout1, tw1);
+            C_MUL(scratch[2] ,*Fout2, tw2);
+            C_MUL(scratch[3] ,*Fout3, tw3);
+            C_MUL(scratch[4] ,*Fout4, tw4);
+
+            C_ADD( scratch[7],scratch[1],scratch[4]);
+            C_SUB( scratch[10],scratch[1],scratch[4]);
+            C_ADD( scratch[8],scratch[2],scratch[3]);
+            C_SUB( scratch[9],scratch[2],scratch[3]);
+
+            Fout0->r += scratch[7].r + scratch[8].r;
+            Fout0->i += scratch[7].i + scratch[8].i;
+
+            scratch[5].r = scratch[0].r + S_MUL(scratch[7].r,ya.r) + S_MUL(scratch[8].r,yb.r);
+            scratch[5].i = scratch[0].i + S_MUL(scratch[7].i,ya.r) + S_MUL(scratch[8].i,yb.r);
+
+            scratch[6].r =  S_MUL(scratch[10].i,ya.i) + S_MUL(scratch[9].i,yb.i);
+            scratch[6].i = -S_MUL(scratch[10].r,ya.i) - S_MUL(scratch[9].r,yb.i);
+
+            C_SUB(*Fout1,scratch[5],scratch[6]);
+            C_ADD(*Fout4,scratch[5],scratch[6]);
+
+            scratch[11].r = scratch[0].r + S_MUL(scratch[7].r,yb.r) + S_MUL(scratch[8].r,ya.r);
+            scratch[11].i = scratch[0].i + S_MUL(scratch[7].i,yb.r) + S_MUL(scratch[8].i,ya.r);
+            scratch[12].r = - S_MUL(scratch[10].i,yb.i) + S_MUL(scratch[9].i,ya.i);
+            scratch[12].i = S_MUL(scratch[10].r,yb.i) - S_MUL(scratch[9].r,ya.i);
+
+            C_ADD(*Fout2,scratch[11],scratch[12]);
+            C_SUB(*Fout3,scratch[11],scratch[12]);
+        }
+    }
+}
+
+static void kf_bfly_generic_batch(
+        kiss_fft_cpx * Fout,
+        const size_t fstride,
+        const kiss_fft_cfg st,
+        int m,
+        int p,
+        int B,
+        int b0,
+        int b1
+        )
+{
+    int u,k,q1,q,b;
+    kiss_fft_cpx * twiddles = st->twiddles;
+    kiss_fft_cpx t;
+    int Norig = st->nfft;
+
+    kiss_fft_cpx * scratch = (kiss_fft_cpx*)KISS_FFT_TMP_ALLOC(sizeof(kiss_fft_cpx)*p);
+    if (scratch == NULL){
+        KISS_FFT_ERROR("Memory allocation failed.");
+        return;
+    }
+
+    for ( b=b0; b<b1; ++b ) {
+        for ( u=0; u<m; ++u ) {
+            k=u;
+            for ( q1=0 ; q1<p ; ++q1 ) {
+                scratch[q1] = Fout[ (size_t)k*B+b ];
+                C_FIXDIV(scratch[q1],p);
+                k += m;
+            }
+
+            k=u;
+            for ( q1=0 ; q1<p ; ++q1 ) {
+                int twidx=0;
+                kiss_fft_cpx * f = Fout + (size_t)k*B+b;
+                *f = scratch[0];
+                for (q=1;q<p;++q ) {
+                    twidx += fstride * k;
+                    if (twidx>=Norig) twidx-=Norig;
+                    C_MUL(t,scratch[q] , twiddles[twidx] );
+                    C_ADDTO( *f ,t);
+                }
+                k += m;
+            }
+        }
+    }
+    KISS_FFT_TMP_FREE(scratch);
+}
+
+static void kf_bfly_batch(
+        kiss_fft_cpx * Fout,
+        const size_t fstride,
+        const kiss_fft_cfg st,
+        int m,
+        int p,
+        int B
+        )
+{
+    int b = 0;
+#ifdef KISS_FFT_RUNTIME_SIMD
+    b = kf_bfly_batch_simd(Fout,fstride,st,m,p,B);
+    if (b == B)
+        return;
+#endif
     switch (p) {
-        case 2: kf_bfly2(Fout,fstride,st,m); break;
-        case 3: kf_bfly3(Fout,fstride,st,m); break;
-        case 4: kf_bfly4(Fout,fstride,st,m); break;
-        case 5: kf_bfly5(Fout,fstride,st,m); break;
-        default: kf_bfly_generic(Fout,fstride,st,m,p); break;
+        case 2: kf_bfly2_batch(Fout,fstride,st,m,B,b,B); break;
+        case 3: kf_bfly3_batch(Fout,fstride,st,m,B,b,B); break;
+        case 4: kf_bfly4_batch(Fout,fstride,st,m,B,b,B); break;
+        case 5: kf_bfly5_batch(Fout,fstride,st,m,B,b,B); break;
+        default: kf_bfly_generic_batch(Fout,fstride,st,m,p,B,b,B); break;
+    }
+}
+
+/* kf_work for nb transforms at once; f points at transform 0, transform b
+   starts at f + b*in_dist, and Fout is element-interleaved with row length
+   B >= nb (the padding columns are zero-filled and transformed along) */
+static
+void kf_work_batch(
+        kiss_fft_cpx * Fout,
+        const kiss_fft_cpx * f,
+        const size_t fstride,
+        int in_dist,
+        int nb,
+        int B,
+        int * factors,
+        const kiss_fft_cfg st
+        )
+{
+    kiss_fft_cpx * Fout_beg=Fout;
+    const int p=*factors++; /* the radix  */
+    const int m=*factors++; /* stage's fft length/p */
+    const kiss_fft_cpx * Fout_end = Fout + (size_t)p*m*B;
+    int b;
+
+    if (m==1) {
+        do{
+            for (b=0;b<nb;++b)
+                Fout[b] = f[(size_t)b*in_dist];
+            if (b<B)
+                memset(Fout+b,0,sizeof(kiss_fft_cpx)*(B-b));
+            f += fstride;
+        }while( (Fout += B) != Fout_end );
+    }else{
+        do{
+            kf_work_batch( Fout , f, fstride*p, in_dist, nb, B, factors,st);
+            f += fstride;
+        }while( (Fout += (size_t)m*B) != Fout_end );
+    }
+
+    Fout=Fout_beg;
+
+    kf_bfly_batch(Fout,fstride,st,m,p,B);
+}
+
+#ifdef KISS_FFT_BLUESTEIN
+/* Bluestein's algorithm: with w[n] = exp(-+i*pi*n^2/N),
+   X[k] = w[k] * sum_n (x[n]*w[n]) * conj(w[k-n]),
+   a linear convolution done as a circular one of size M >= 2N-1.
+   The inverse sub-FFT is conj(FFT(conj(.))), and 1/M lives in chirp_fft.
+   The 2*M values of scratch are taken per call, as kf_work takes its own,
+   so the cfg stays read-only and can be shared between threads.
+   fin is fully read before fout is written, so fin may equal fout. */
+static
+void kf_bluestein(kiss_fft_cfg st,const kiss_fft_cpx *fin,int in_stride,
+        kiss_fft_cpx *fout,int out_stride)
+{
+    const kiss_fft_cfg sub = st->bluestein;
+    const int n = st->nfft;
+    const int M = sub->nfft;
+    kiss_fft_cpx * a;
+    kiss_fft_cpx * A;
+    kiss_fft_cpx t;
+    int k;
+
+    a = (kiss_fft_cpx*)KISS_FFT_TMP_ALLOC(sizeof(kiss_fft_cpx)*2*(size_t)M);
+    if (a == NULL){
+        KISS_FFT_ERROR("Memory allocation error.");
+        return;
+    }
+    A = a + M;
+
+    for (k=0;k<n;++k)
+        C_MUL(a[k],fin[(size_t)k*in_stride],st->chirp[k]);
+    for (;k<M;++k)
+        a[k].r = a[k].i = 0;
+
+    /* through kiss_fft_stride, so a power-of-two M runs its codelet */
+    kiss_fft_stride(sub,a,A,1);
+
+    for (k=0;k<M;++k) {
+        C_MUL(t,A[k],st->chirp_fft[k]);
+        a[k].r = t.r;
+        a[k].i = -t.i;
     }
+
+    kiss_fft_stride(sub,a,A,1);
+
+    for (k=0;k<n;++k) {
+        t.r = A[k].r;
+        t.i = -A[k].i;
+        C_MUL(fout[(size_t)k*out_stride],t,st->chirp[k]);
+    }
+    KISS_FFT_TMP_FREE(a);
+}
+
+/* fills the Bluestein tables of st; sub is already allocated */
+static
+void kf_bluestein_init(kiss_fft_cfg st)
+{
+    const double pi=3.141592653589793238462643383279502884197169399375105820974944;
+    const kiss_fft_cfg sub = st->bluestein;
+    const int n = st->nfft;
+    const int M = sub->nfft;
+    kiss_fft_cpx * b = st->chirp_fft;
+    const kiss_fft_scalar scale = (kiss_fft_scalar)(1.0/M);
+    int k;
+
+    for (k=0;k<n;++k) {
+        /* n^2 mod 2N keeps the phase exact for large k */
+        long long k2 = ((long long)k*k) % (2*(long long)n);
+        double phase = -pi*(double)k2 / n;
+        if (st->inverse)
+            phase *= -1;
+        kf_cexp(st->chirp+k, phase);
+    }
+
+    for (k=0;k<M;++k)
+        b[k].r = b[k].i = 0;
+    b[0].r = st->chirp[0].r;
+    b[0].i = -st->chirp[0].i;
+    for (k=1;k<n;++k) {
+        b[k].r = b[M-k].r = st->chirp[k].r;
+        b[k].i = b[M-k].i = -st->chirp[k].i;
+    }
+
+    /* in place: kiss_fft_stride copes with fin == fout */
+    kiss_fft_stride(sub,b,st->chirp_fft,1);
+    for (k=0;k<M;++k)
+        C_MULBYSCALAR(st->chirp_fft[k],scale);
+}
+#endif
+
+int kf_batch_stride(int howmany)
+{
+#ifdef KISS_FFT_RUNTIME_SIMD
+    /* pad the rows so whole vectors cover them: computing an idle
+       lane is cheaper than finishing the row with scalar code */
+    kf_simd_init();
+    if (kf_simd_active >= KISS_FFT_SIMD_AVX2)
+        return (howmany + 3) & ~3;
+    if (kf_simd_active >= KISS_FFT_SIMD_SSE2)
+        return (howmany + 1) & ~1;
+#endif
+    return howmany;
+}
+
+int kf_batch_interleaved(kiss_fft_cfg st,int howmany,
+        const kiss_fft_cpx *fin,int in_dist,kiss_fft_cpx *work)
+{
+    const int B = kf_batch_stride(howmany);
+#ifdef KISS_FFT_BLUESTEIN
+    if (st->bluestein) {
+        int b,k;
+        for (b=0;b<howmany;++b)
+            kf_bluestein(st,fin+(size_t)b*in_dist,1,work+b,B);
+        for (k=0;k<st->nfft;++k)
+            for (b=howmany;b<B;++b)
+                work[(size_t)k*B+b].r = work[(size_t)k*B+b].i = 0;
+        return B;
+    }
+#endif
+    kf_work_batch(work,fin,1,in_dist,howmany,B,st->factors,st);
+    return B;
 }
 
 /*  facbuf is populated by p1,m1,p2,m2, ...
     where
     p[i] * m[i] = m[i-1]
     m0 = n                  */
-static
 void kf_factor(int n,int * facbuf)
 {
     int p=4;
@@ -327,6 +1023,25 @@ void kf_factor(int n,int * facbuf)
     } while (n > 1);
 }
 
+static int kf_codelets_enabled = 1;
+
+int kiss_fft_set_codelets(int enable)
+{
+    int previous = kf_codelets_enabled;
+    kf_codelets_enabled = enable != 0;
+    return previous;
+}
+
+void kf_default_plan(int nfft,kf_plan * plan)
+{
+    kf_factor(nfft,plan->factors);
+#ifdef KISS_FFT_CODELETS
+    plan->codelet_n1 = kf_codelet_n1(nfft);
+#else
+    plan->codelet_n1 = 0;
+#endif
+}
+
 /*
  *
  * User-callable function to allocate all necessary storage space for the fft.
@@ -335,12 +1050,46 @@ void kf_factor(int n,int * facbuf)
  * It can be freed with free(), rather than a kiss_fft-specific function.
  * */
 kiss_fft_cfg kiss_fft_alloc(int nfft,int inverse_fft,void * mem,size_t * lenmem )
+{
+    kf_plan plan;
+    if (!kf_wisdom_lookup(nfft,&plan))
+        kf_default_plan(nfft,&plan);
+    if (!kf_codelets_enabled)
+        plan.codelet_n1 = 0;
+    return kf_alloc_plan(nfft,inverse_fft,&plan,mem,lenmem);
+}
+
+kiss_fft_cfg kf_alloc_plan(int nfft,int inverse_fft,const kf_plan * plan,void * mem,size_t * lenmem)
 {
     KISS_FFT_ALIGN_CHECK(mem)
 
     kiss_fft_cfg st=NULL;
     size_t memneeded = KISS_FFT_ALIGN_SIZE_UP(sizeof(struct kiss_fft_state)
         + sizeof(kiss_fft_cpx)*(nfft-1)); /* twiddle factors*/
+#ifdef KISS_FFT_BLUESTEIN
+    size_t submem = 0;
+    int M = 0;
+#endif
+#ifdef KISS_FFT_CODELETS
+    const int codelet_n1 = plan->codelet_n1;
+    const size_t codelet_offset = (memneeded + 15) & ~(size_t)15;
+    if (codelet_n1)
+        memneeded = codelet_offset + sizeof(kiss_fft_cpx)*nfft;
+#endif
+
+#ifdef KISS_FFT_RUNTIME_SIMD
+    kf_simd_init();
+#endif
+#ifdef KISS_FFT_BLUESTEIN
+    /* the sub-FFT is 2,3,5-smooth, so it never recurses into this branch */
+    M = kiss_fft_bluestein_size(nfft);
+    if (M) {
+        memneeded = (memneeded + 15) & ~(size_t)15;
+        kiss_fft_alloc(M,0,NULL,&submem);
+        memneeded += KISS_FFT_ALIGN_SIZE_UP(submem
+            + sizeof(kiss_fft_cpx)*((size_t)nfft + (size_t)M));
+    }
+#endif
 
     if ( lenmem==NULL ) {
         st = ( kiss_fft_cfg)KISS_FFT_MALLOC( memneeded );
@@ -362,7 +1111,32 @@ kiss_fft_cfg kiss_fft_alloc(int nfft,int inverse_fft,void * mem,size_t * lenmem
             kf_cexp(st->twiddles+i, phase );
         }
 
-        kf_factor(nfft,st->factors);
+        memcpy(st->factors,plan->factors,sizeof(st->factors));
+        st->bluestein = NULL;
+        st->chirp = st->chirp_fft = NULL;
+        st->codelet_tw = NULL;
+        st->codelet_n1 = 0;
+#ifdef KISS_FFT_CODELETS
+        if (codelet_n1) {
+            /* the twiddle grid follows the twiddles in the same block */
+            st->codelet_n1 = codelet_n1;
+            st->codelet_tw = (kiss_fft_cpx*)((char*)st + codelet_offset);
+            kf_codelet_init(st);
+        }
+#endif
+#ifdef KISS_FFT_BLUESTEIN
+        if (M) {
+            /* the sub-FFT and tables follow the twiddles in the same block,
+               so the cfg is still released with a single free() */
+            char * p = (char*)st + ((KISS_FFT_ALIGN_SIZE_UP(
+                sizeof(struct kiss_fft_state) + sizeof(kiss_fft_cpx)*(nfft-1))
+                + 15) & ~(size_t)15);
+            st->bluestein = kiss_fft_alloc(M,0,p,&submem);
+            st->chirp = (kiss_fft_cpx*)(p + submem);
+            st->chirp_fft = st->chirp + nfft;
+            kf_bluestein_init(st);
+        }
+#endif
     }
     return st;
 }
@@ -370,6 +1144,18 @@ kiss_fft_cfg kiss_fft_alloc(int nfft,int inverse_fft,void * mem,size_t * lenmem
 
 void kiss_fft_stride(kiss_fft_cfg st,const kiss_fft_cpx *fin,kiss_fft_cpx *fout,int in_stride)
 {
+#ifdef KISS_FFT_CODELETS
+    if (st->codelet_tw && in_stride == 1) {
+        kf_codelet(st,fin,fout);
+        return;
+    }
+#endif
+#ifdef KISS_FFT_BLUESTEIN
+    if (st->bluestein) {
+        kf_bluestein(st,fin,in_stride,fout,1);
+        return;
+    }
+#endif
     if (fin == fout) {
         //NOTE: this is not really an in-place FFT algorithm.
         //It just performs an out-of-place FFT into a temp buffer
@@ -399,6 +1185,55 @@ void kiss_fft(kiss_fft_cfg cfg,const kiss_fft_cpx *fin,kiss_fft_cpx *fout)
     kiss_fft_stride(cfg,fin,fout,1);
 }
 
+void kiss_fft_batch(kiss_fft_cfg st,int howmany,
+        const kiss_fft_cpx *fin,int in_dist,
+        kiss_fft_cpx *fout,int out_dist)
+{
+    kiss_fft_cpx stackbuf[KISS_FFT_BATCH_STACK];
+    kiss_fft_cpx * work;
+    const int nfft = st->nfft;
+    int done,stride,k,b;
+
+#ifdef KISS_FFT_CODELETS
+    /* codelets already keep the whole transform in registers/cache */
+    if (st->codelet_tw) {
+        for (b=0;b<howmany;++b)
+            kf_codelet(st,fin+(size_t)b*in_dist,fout+(size_t)b*out_dist);
+        return;
+    }
+#endif
+
+    while (howmany > 0) {
+        /* chunks of KISS_FFT_BATCH_MAX transforms keep the working set small */
+        done = howmany < KISS_FFT_BATCH_MAX ? howmany : KISS_FFT_BATCH_MAX;
+        stride = kf_batch_stride(done);
+
+        if ((size_t)nfft*stride <= KISS_FFT_BATCH_STACK) {
+            work = stackbuf;
+        }else{
+            work = (kiss_fft_cpx*)KISS_FFT_TMP_ALLOC(sizeof(kiss_fft_cpx)*nfft*stride);
+            if (work == NULL){
+                KISS_FFT_ERROR("Memory allocation error.");
+                return;
+            }
+        }
+
+        kf_batch_interleaved(st,done,fin,in_dist,work);
+
+        /* de-interleave (fin may alias fout: it has been fully read) */
+        for (k=0;k<nfft;++k)
+            for (b=0;b<done;++b)
+                fout[(size_t)b*out_dist+k] = work[(size_t)k*stride+b];
+
+        if (work != stackbuf)
+            KISS_FFT_TMP_FREE(work);
+
+        fin += (size_t)done*in_dist;
+        fout += (size_t)done*out_dist;
+        howmany -= done;
+    }
+}
+
 
 void kiss_fft_cleanup(void)
 {
@@ -418,3 +1253,71 @@ int kiss_fft_next_fast_size(int n)
     }
     return n;
 }
+
+int kiss_fft_bluestein_size(int nfft)
+{
+#ifdef KISS_FFT_BLUESTEIN
+    int factors[2*MAXFACTORS];
+    int i = 0, pmax = 1, M;
+
+    if (nfft <= 0)
+        return 0;
+    kf_factor(nfft,factors);
+    do {
+        if (factors[2*i] > pmax)
+            pmax = factors[2*i];
+    } while (factors[2*i++ + 1] > 1);
+    if (pmax <= KISS_FFT_BLUESTEIN_MIN_FACTOR)
+        return 0;
+
+    M = kiss_fft_next_fast_size(2*nfft-1);
+#ifdef KISS_FFT_CODELETS
+    {
+        /* a power of two with a codelet beats a smaller mixed-radix size */
+        int p2 = 1;
+        while (p2 < 2*nfft-1)
+            p2 <<= 1;
+        if (kf_codelets_enabled && kf_codelet_n1(p2))
+            M = p2;
+    }
+#endif
+    return M;
+#else
+    (void)nfft;
+    return 0;
+#endif
+}
+
+int kiss_fft_simd_level(void)
+{
+#ifdef KISS_FFT_RUNTIME_SIMD
+    kf_simd_init();
+    return kf_simd_active;
+#else
+    return KISS_FFT_SIMD_SCALAR;
+#endif
+}
+
+int kiss_fft_set_simd_level(int level)
+{
+#ifdef KISS_FFT_RUNTIME_SIMD
+    kf_simd_init();
+    if (level < KISS_FFT_SIMD_SCALAR || level > kf_simd_detected)
+        level = kf_simd_detected;
+    kf_simd_active = level;
+    return kf_simd_active;
+#else
+    (void)level;
+    return KISS_FFT_SIMD_SCALAR;
+#endif
+}
+
+const char * kiss_fft_simd_name(int level)
+{
+    switch (level) {
+        case KISS_FFT_SIMD_SSE2:   return "SSE2";
+        case KISS_FFT_SIMD_AVX2:   return "AVX2";
+        case KISS_FFT_SIMD_AVX512: return "AVX-512";
+        default:                   return "scalar";
+    }
+}
@@ -38,12 +38,19 @@ extern "C" {
  If you would like a :
  -- a utility that will handle the caching of fft objects
  -- real-only (no imaginary time component ) FFT
+
+ Then see kfc.h and kiss_fftr.h alongside this file.
+
+ If you would like a :
+ -- streaming fast-convolution (FIR) filtering
+
+ Then see kiss_fastfir.h and kiss_fastfir.c alongside this file.
+
+ If you would like a :
  -- a multi-dimensional FFT
  -- a command-line utility to perform ffts
- -- a command-line utility to perform fast-convolution filtering
 
- Then see kfc.h kiss_fftr.h kiss_fftnd.h fftutil.c kiss_fastfir.c
-  in the tools/ directory.
+ Then see kiss_fftnd.h and fftutil.c in the upstream tools/ directory.
 */
 
 /* User may override KISS_FFT_MALLOC and/or KISS_FFT_FREE. */
@@ -112,6 +119,12 @@ typedef struct kiss_fft_state* kiss_fft_cfg;
  *  If lenmem is not NULL and ( mem is NULL or *lenmem is not large enough),
  *      then the function returns NULL and places the minimum cfg 
  *      buffer size in *lenmem.
+ *
+ *  In float builds, sizes with a prime factor above
+ *  KISS_FFT_BLUESTEIN_MIN_FACTOR (default 31, at least 5) are computed with
+ *  Bluestein's algorithm, keeping prime and awkward sizes O(N log N).
+ *  Like every other cfg it is read-only once allocated and can be shared
+ *  between threads; each transform takes its scratch with KISS_FFT_TMP_ALLOC.
  * */
 
 kiss_fft_cfg KISS_FFT_API kiss_fft_alloc(int nfft,int inverse_fft,void * mem,size_t * lenmem);
@@ -133,6 +146,69 @@ void KISS_FFT_API kiss_fft(kiss_fft_cfg cfg,const kiss_fft_cpx *fin,kiss_fft_cpx
  * */
 void KISS_FFT_API kiss_fft_stride(kiss_fft_cfg cfg,const kiss_fft_cpx *fin,kiss_fft_cpx *fout,int fin_stride);
 
+/*
+ * kiss_fft_batch(cfg,howmany,fin,in_dist,fout,out_dist)
+ *
+ * Perform howmany independent FFTs of size nfft with one cfg.
+ * Transform b reads fin[b*in_dist + 0 .. nfft-1] and
+ * writes fout[b*out_dist + 0 .. nfft-1].
+ * Sizes run by kf_work go through every butterfly stage interleaved, so
+ * each twiddle is loaded once per stage for the whole batch and the SIMD
+ * lanes run across transforms.  Power-of-two sizes with a codelet (64 to
+ * 4096 in float builds) have no interleaved form, and a loop over the
+ * codelet is faster than the interleaved stages, so for them this is just
+ * that loop.  Either way the results are bit-identical to one kiss_fft
+ * per transform at every SIMD level.  Overlapping input (in_dist < nfft)
+ * is allowed; fout may equal fin when in_dist == out_dist >= nfft.
+ * */
+void KISS_FFT_API kiss_fft_batch(kiss_fft_cfg cfg,int howmany,
+        const kiss_fft_cpx *fin,int in_dist,
+        kiss_fft_cpx *fout,int out_dist);
+
+/*
+ * Runtime SIMD dispatch (float builds on x86/x86-64 only).
+ *
+ * The radix 2/3/4/5 butterflies have SSE2, AVX2 and AVX-512 versions that
+ * operate on the normal kiss_fft_cpx layout.  The best level supported by
+ * the CPU and OS is detected with cpuid on the first kiss_fft_alloc and
+ * results are bit-identical to the scalar path.
+ *
+ * kiss_fft_simd_level returns the level in use (KISS_FFT_SIMD_*).
+ * kiss_fft_set_simd_level forces a lower level (e.g. for testing); a level
+ *   above what the host supports, or a negative one, restores the detected
+ *   level.  Returns the level now in use.  Not thread-safe with respect to
+ *   transforms running concurrently.
+ * kiss_fft_simd_name returns a printable name for a level.
+ */
+#define KISS_FFT_SIMD_SCALAR    0
+#define KISS_FFT_SIMD_SSE2      1
+#define KISS_FFT_SIMD_AVX2      2
+#define KISS_FFT_SIMD_AVX512    3
+
+#if !defined(FIXED_POINT) && !defined(USE_SIMD) && !defined(KISS_FFT_NO_RUNTIME_SIMD) && \
+    (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86))
+# define KISS_FFT_RUNTIME_SIMD
+#endif
+
+int KISS_FFT_API kiss_fft_simd_level(void);
+int KISS_FFT_API kiss_fft_set_simd_level(int level);
+const char * KISS_FFT_API kiss_fft_simd_name(int level);
+
+/*
+ * Fixed-size codelets (float builds).
+ *
+ * Power-of-two sizes from 64 to 4096 are computed by generated straight-line
+ * DFT-8/16/32/64 codelets with hardcoded twiddles (N = N1*N2, two passes),
+ * vectorized with SSE2 or AVX2 (the AVX-512 level runs the AVX2 codelets).
+ * This applies to kiss_fft/kiss_fft_stride with unit stride, so also to
+ * kiss_fftr of twice those sizes.
+ *
+ * kiss_fft_set_codelets(0) makes later kiss_fft_alloc calls build the
+ * generic kf_work plan instead, (1) restores the default.  Returns the
+ * previous setting.  Plans already allocated are not affected.
+ */
+int KISS_FFT_API kiss_fft_set_codelets(int enable);
+
 /* If kiss_fft_alloc allocated a buffer, it is one contiguous 
    buffer and can be simply free()d when no longer needed*/
 #define kiss_fft_free KISS_FFT_FREE
@@ -149,6 +225,13 @@ void KISS_FFT_API kiss_fft_cleanup(void);
  */
 int KISS_FFT_API kiss_fft_next_fast_size(int n);
 
+/*
+ * Returns the size M of the sub-FFT that a plan of nfft points runs
+ * Bluestein's algorithm over (M >= 2*nfft-1), or 0 if nfft is computed
+ * directly.  kiss_fft_tune tunes this size for such nfft.
+ */
+int KISS_FFT_API kiss_fft_bluestein_size(int nfft);
+
 /* for real ffts, we need an even size */
 #define kiss_fftr_next_fast_size_real(n) \
         (kiss_fft_next_fast_size( ((n)+1)>>1)<<1)
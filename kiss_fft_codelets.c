@@ -0,0 +1,278 @@
+/*
+ *  Copyright (c) 2003-2010, Mark Borgerding. All rights reserved.
+ *  This file is part of KISS FFT - https://github.com/mborgerding/kissfft
+ *
+ *  SPDX-License-Identifier: BSD-3-Clause
+ *  See COPYING file for more information.
+ */
+
+#include "_kiss_fft_guts.h"
+
+#ifdef KISS_FFT_CODELETS
+/*
+ * Fixed-size plans for power-of-two nfft in [KF_CODELET_MIN, KF_CODELET_MAX].
+ *
+ * N = N1*N2 with N1, N2 in {8,16,32,64} (N1 >= N2) runs as two passes of
+ * the straight-line codelets generated into _kiss_fft_codelets.h:
+ *
+ *   Y[k1][n2] = DFT-N1 over n1 of x[n1*N2 + n2]                 (columns)
+ *   X[k1 + N1*k2] = DFT-N2 over n2 of Y[k1][n2] * W_N^(k1*n2)   (rows)
+ *
+ * Lanes run across n2 in the first pass and across k1 in the second, so
+ * every load and store of the first pass and every store of the second is
+ * contiguous.  The codelets are forward only; an inverse plan swaps real
+ * and imaginary parts on the way in and out, since
+ * IDFT(x) = swap(DFT(swap(x))).
+ */
+
+#if defined(_MSC_VER)
+# define KF_CL_INLINE __forceinline
+#elif defined(__GNUC__) || defined(__clang__)
+# define KF_CL_INLINE inline __attribute__((always_inline))
+#else
+# define KF_CL_INLINE inline
+#endif
+
+#define KF_CAT_(a,b) a##b
+#define KF_CAT(a,b) KF_CAT_(a,b)
+#define KF_NAME(base) KF_CAT(base,KF_SFX)
+
+/* ---- scalar: one complex per "vector" ---- */
+static KF_CL_INLINE kiss_fft_cpx kf_cl_add(kiss_fft_cpx a,kiss_fft_cpx b)
+{ kiss_fft_cpx r; r.r = a.r + b.r; r.i = a.i + b.i; return r; }
+static KF_CL_INLINE kiss_fft_cpx kf_cl_sub(kiss_fft_cpx a,kiss_fft_cpx b)
+{ kiss_fft_cpx r; r.r = a.r - b.r; r.i = a.i - b.i; return r; }
+static KF_CL_INLINE kiss_fft_cpx kf_cl_mul(kiss_fft_cpx a,kiss_fft_cpx b)
+{ kiss_fft_cpx r; r.r = a.r * b.r; r.i = a.i * b.i; return r; }
+static KF_CL_INLINE kiss_fft_cpx kf_cl_cmul(kiss_fft_cpx a,kiss_fft_cpx b)
+{ kiss_fft_cpx r; C_MUL(r,a,b); return r; }
+static KF_CL_INLINE kiss_fft_cpx kf_cl_cmulk(kiss_fft_cpx a,kiss_fft_scalar c,kiss_fft_scalar s)
+{ kiss_fft_cpx r; r.r = a.r*c - a.i*s; r.i = a.r*s + a.i*c; return r; }
+static KF_CL_INLINE kiss_fft_cpx kf_cl_mulni(kiss_fft_cpx a)
+{ kiss_fft_cpx r; r.r = a.i; r.i = -a.r; return r; }
+static KF_CL_INLINE kiss_fft_cpx kf_cl_set1(kiss_fft_scalar x)
+{ kiss_fft_cpx r; r.r = x; r.i = x; return r; }
+
+#define KF_V            kiss_fft_cpx
+#define KF_VLEN         1
+#define KF_SFX          scalar
+#define KF_TARGET
+#define VLD(p)          (*(p))
+#define VST(p,v)        (*(p) = (v))
+#define VLDS(p,s)       (*(p))
+#define VADD(a,b)       kf_cl_add((a),(b))
+#define VSUB(a,b)       kf_cl_sub((a),(b))
+#define VMUL(a,b)       kf_cl_mul((a),(b))
+#define VCMUL(a,b)      kf_cl_cmul((a),(b))
+#define VCMULK(a,c,s)   kf_cl_cmulk((a),(c),(s))
+#define VMULNI(a)       kf_cl_mulni(a)
+#define VSET1(x)        kf_cl_set1(x)
+#include "_kiss_fft_codelets.h"
+#undef KF_V
+#undef KF_VLEN
+#undef KF_SFX
+#undef KF_TARGET
+#undef VLD
+#undef VST
+#undef VLDS
+#undef VADD
+#undef VSUB
+#undef VMUL
+#undef VCMUL
+#undef VCMULK
+#undef VMULNI
+#undef VSET1
+#undef KF_CL_SQRT1_2
+
+#ifdef KISS_FFT_RUNTIME_SIMD
+#include <immintrin.h>
+
+/* two complex values from p[0] and p[s] */
+#define KF_TW2(p,s) \
+    _mm_loadh_pi( _mm_loadl_pi(_mm_setzero_ps(),(const __m64*)(p)), (const __m64*)((p)+(s)) )
+/* four complex values from p[0], p[s], p[2s], p[3s] */
+#define KF_TW4(p,s) \
+    _mm256_insertf128_ps( _mm256_castps128_ps256(KF_TW2(p,s)), KF_TW2((p)+2*(s),s), 1 )
+
+/* ---- SSE2: 2 complex per vector ---- */
+#define KF_V            __m128
+#define KF_VLEN         2
+#define KF_SFX          sse2
+#define KF_TARGET       KF_ATTR_TARGET("sse2")
+#define VLD(p)          _mm_loadu_ps((const float*)(p))
+#define VST(p,v)        _mm_storeu_ps((float*)(p),(v))
+#define VLDS(p,s)       KF_TW2(p,s)
+#define VADD(a,b)       _mm_add_ps((a),(b))
+#define VSUB(a,b)       _mm_sub_ps((a),(b))
+#define VMUL(a,b)       _mm_mul_ps((a),(b))
+#define VSET1(x)        _mm_set1_ps(x)
+#define VSWAP(v)        _mm_shuffle_ps((v),(v),_MM_SHUFFLE(2,3,0,1))
+#define VCMUL(a,b)      VADD( VMUL((a),_mm_shuffle_ps((b),(b),_MM_SHUFFLE(2,2,0,0))), \
+                              VMUL(VSWAP(a),_mm_xor_ps(_mm_shuffle_ps((b),(b),_MM_SHUFFLE(3,3,1,1)), \
+                                                       _mm_setr_ps(-0.f,0.f,-0.f,0.f))) )
+#define VCMULK(a,c,s)   VADD( VMUL((a),VSET1(c)), VMUL(VSWAP(a),_mm_setr_ps(-(s),(s),-(s),(s))) )
+#define VMULNI(a)       _mm_xor_ps(VSWAP(a),_mm_setr_ps(0.f,-0.f,0.f,-0.f))
+#include "_kiss_fft_codelets.h"
+#undef KF_V
+#undef KF_VLEN
+#undef KF_SFX
+#undef KF_TARGET
+#undef VLD
+#undef VST
+#undef VLDS
+#undef VADD
+#undef VSUB
+#undef VMUL
+#undef VSET1
+#undef VSWAP
+#undef VCMUL
+#undef VCMULK
+#undef VMULNI
+#undef KF_CL_SQRT1_2
+
+/* ---- AVX2: 4 complex per vector ---- */
+#define KF_V            __m256
+#define KF_VLEN         4
+#define KF_SFX          avx2
+#define KF_TARGET       KF_ATTR_TARGET("avx2")
+#define VLD(p)          _mm256_loadu_ps((const float*)(p))
+#define VST(p,v)        _mm256_storeu_ps((float*)(p),(v))
+#define VLDS(p,s)       KF_TW4(p,s)
+#define VADD(a,b)       _mm256_add_ps((a),(b))
+#define VSUB(a,b)       _mm256_sub_ps((a),(b))
+#define VMUL(a,b)       _mm256_mul_ps((a),(b))
+#define VSET1(x)        _mm256_set1_ps(x)
+#define VSWAP(v)        _mm256_permute_ps((v),0xB1)
+#define VCMUL(a,b)      VADD( VMUL((a),_mm256_moveldup_ps(b)), \
+                              VMUL(VSWAP(a),_mm256_xor_ps(_mm256_movehdup_ps(b), \
+                                   _mm256_setr_ps(-0.f,0.f,-0.f,0.f,-0.f,0.f,-0.f,0.f))) )
+#define VCMULK(a,c,s)   VADD( VMUL((a),VSET1(c)), \
+                              VMUL(VSWAP(a),_mm256_setr_ps(-(s),(s),-(s),(s),-(s),(s),-(s),(s))) )
+#define VMULNI(a)       _mm256_xor_ps(VSWAP(a),_mm256_setr_ps(0.f,-0.f,0.f,-0.f,0.f,-0.f,0.f,-0.f))
+#include "_kiss_fft_codelets.h"
+#undef KF_V
+#undef KF_VLEN
+#undef KF_SFX
+#undef KF_TARGET
+#undef VLD
+#undef VST
+#undef VLDS
+#undef VADD
+#undef VSUB
+#undef VMUL
+#undef VSET1
+#undef VSWAP
+#undef VCMUL
+#undef VCMULK
+#undef VMULNI
+#undef KF_CL_SQRT1_2
+#endif /* KISS_FFT_RUNTIME_SIMD */
+
+typedef void (*kf_cl_col_fn)(const kiss_fft_cpx *,size_t,kiss_fft_cpx *,size_t);
+typedef void (*kf_cl_row_fn)(const kiss_fft_cpx *,const kiss_fft_cpx *,size_t,size_t,
+        kiss_fft_cpx *,size_t);
+
+/* indexed by log2(n) - 3 */
+#define KF_CL_TABLE(sfx) \
+    static const kf_cl_col_fn kf_cl_col_##sfx[4] = { \
+        kf_cl_col8_##sfx, kf_cl_col16_##sfx, kf_cl_col32_##sfx, kf_cl_col64_##sfx }; \
+    static const kf_cl_row_fn kf_cl_row_##sfx[4] = { \
+        kf_cl_row8_##sfx, kf_cl_row16_##sfx, kf_cl_row32_##sfx, kf_cl_row64_##sfx };
+KF_CL_TABLE(scalar)
+#ifdef KISS_FFT_RUNTIME_SIMD
+KF_CL_TABLE(sse2)
+KF_CL_TABLE(avx2)
+#endif
+
+static int kf_cl_log2(int n)
+{
+    int l = 0;
+    while ((1 << l) < n)
+        ++l;
+    return l;
+}
+
+int kf_codelet_n1(int nfft)
+{
+    int l;
+    if (nfft < KF_CODELET_MIN || nfft > KF_CODELET_MAX || (nfft & (nfft - 1)))
+        return 0;
+    l = kf_cl_log2(nfft);
+    return 1 << ((l + 1) / 2);
+}
+
+int kf_codelet_split_ok(int nfft,int n1)
+{
+    return kf_codelet_n1(nfft) && n1 >= 8 && n1 <= 64 && (n1 & (n1 - 1)) == 0
+        && nfft / n1 >= 8 && nfft / n1 <= 64;
+}
+
+void kf_codelet_init(kiss_fft_cfg st)
+{
+    const double pi=3.141592653589793238462643383279502884197169399375105820974944;
+    const int n1 = st->codelet_n1;
+    const int n2 = st->nfft / n1;
+    int k1,j;
+
+    for (k1=0;k1<n1;++k1)
+        for (j=0;j<n2;++j)
+            kf_cexp(st->codelet_tw + (size_t)k1*n2 + j,
+                    -2*pi*(double)((k1*j) % st->nfft) / st->nfft);
+}
+
+static void kf_cl_swap(kiss_fft_cpx * out,const kiss_fft_cpx * in,int n)
+{
+    int k;
+    for (k=0;k<n;++k) {
+        kiss_fft_scalar t = in[k].r;
+        out[k].r = in[k].i;
+        out[k].i = t;
+    }
+}
+
+void kf_codelet(kiss_fft_cfg st,const kiss_fft_cpx *fin,kiss_fft_cpx *fout)
+{
+    kiss_fft_cpx work[KF_CODELET_MAX];
+    const int nfft = st->nfft;
+    const int n1 = st->codelet_n1;
+    const int n2 = nfft / n1;
+    const kf_cl_col_fn * col = kf_cl_col_scalar;
+    const kf_cl_row_fn * row = kf_cl_row_scalar;
+    int vlen = 1;
+    int i;
+
+#ifdef KISS_FFT_RUNTIME_SIMD
+    {
+        const int level = kiss_fft_simd_level();
+        if (level >= KISS_FFT_SIMD_AVX2) {
+            col = kf_cl_col_avx2;
+            row = kf_cl_row_avx2;
+            vlen = 4;
+        } else if (level >= KISS_FFT_SIMD_SSE2) {
+            col = kf_cl_col_sse2;
+            row = kf_cl_row_sse2;
+            vlen = 2;
+        }
+    }
+#endif
+
+    if (st->inverse) {
+        kf_cl_swap(fout,fin,nfft);
+        fin = fout;
+    }
+
+    {
+        const kf_cl_col_fn c = col[kf_cl_log2(n1) - 3];
+        for (i=0;i<n2;i+=vlen)
+            c(fin + i, n2, work + i, n2);
+    }
+    {
+        const kf_cl_row_fn r = row[kf_cl_log2(n2) - 3];
+        for (i=0;i<n1;i+=vlen)
+            r(work + (size_t)i*n2, st->codelet_tw + (size_t)i*n2, 1, n2, fout + i, n1);
+    }
+
+    if (st->inverse)
+        kf_cl_swap(fout,fout,nfft);
+}
+#endif /* KISS_FFT_CODELETS */
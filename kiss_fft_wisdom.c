@@ -0,0 +1,373 @@
+/*
+ *  Plan autotuning for KISS FFT.
+ *
+ *  SPDX-License-Identifier: BSD-3-Clause
+ *  See COPYING file for more information.
+ */
+
+#include "kiss_fft_wisdom.h"
+#include "_kiss_fft_guts.h"
+#include <time.h>
+
+#define KFW_MAGIC    "kissfft-wisdom"
+#define KFW_VERSION  1
+/* how many candidate plans one size can have */
+#define KFW_MAX_CANDIDATES 12
+/* one timed run of a candidate lasts at least this long; best of KFW_RUNS */
+#define KFW_MIN_CLOCKS ((clock_t)(CLOCKS_PER_SEC / 200 > 0 ? CLOCKS_PER_SEC / 200 : 1))
+#define KFW_RUNS 3
+
+struct wisdom_entry
+{
+    int nfft;
+    kf_plan plan;
+    struct wisdom_entry * next;
+};
+
+static struct wisdom_entry * wisdom_root = NULL;
+
+static struct wisdom_entry * find_wisdom(int nfft)
+{
+    struct wisdom_entry * cur = wisdom_root;
+    while (cur && cur->nfft != nfft)
+        cur = cur->next;
+    return cur;
+}
+
+static int remember(int nfft,const kf_plan * plan)
+{
+    struct wisdom_entry * e = find_wisdom(nfft);
+    if (e == NULL) {
+        e = (struct wisdom_entry *) malloc(sizeof(struct wisdom_entry));
+        if (e == NULL) {
+            KISS_FFT_ERROR("Memory allocation failed.");
+            return -1;
+        }
+        e->nfft = nfft;
+        e->next = wisdom_root;
+        wisdom_root = e;
+    }
+    e->plan = *plan;
+    return 0;
+}
+
+int kf_wisdom_lookup(int nfft,kf_plan * plan)
+{
+    const struct wisdom_entry * e = find_wisdom(nfft);
+    if (e == NULL)
+        return 0;
+    *plan = e->plan;
+    return 1;
+}
+
+/* radices of a plan in stage order; returns how many */
+static int get_radices(const int * factors,int * radix)
+{
+    int n = 0;
+    do {
+        radix[n] = factors[2*n];
+    } while (factors[2*n++ + 1] > 1);
+    return n;
+}
+
+/* the factors[] layout for the radices radix[0..n-1] of nfft;
+   returns 0 if they do not multiply to nfft */
+static int set_radices(int nfft,const int * radix,int n,int * factors)
+{
+    int i, m = nfft;
+    if (n < 1 || n > MAXFACTORS)
+        return 0;
+    for (i = 0; i < n; ++i) {
+        if (radix[i] < 2 || m % radix[i])
+            return 0;
+        m /= radix[i];
+        factors[2*i] = radix[i];
+        factors[2*i + 1] = m;
+    }
+    return m == 1;
+}
+
+/* both plans are for the same nfft, so equal radices end together */
+static int same_plan(const kf_plan * a,const kf_plan * b)
+{
+    int i = 0;
+    if (a->codelet_n1 || b->codelet_n1)
+        return a->codelet_n1 == b->codelet_n1;
+    do {
+        if (a->factors[2*i] != b->factors[2*i])
+            return 0;
+    } while (a->factors[2*i++ + 1] > 1);
+    return 1;
+}
+
+static int add_candidate(kf_plan * cand,int ncand,const kf_plan * plan)
+{
+    int i;
+    for (i = 0; i < ncand; ++i)
+        if (same_plan(cand + i,plan))
+            return ncand;
+    if (ncand < KFW_MAX_CANDIDATES)
+        cand[ncand++] = *plan;
+    return ncand;
+}
+
+static int add_radix_candidate(kf_plan * cand,int ncand,int nfft,const int * radix,int n)
+{
+    kf_plan plan;
+    plan.codelet_n1 = 0;
+    if (!set_radices(nfft,radix,n,plan.factors))
+        return ncand;
+    return add_candidate(cand,ncand,&plan);
+}
+
+static int get_candidates(int nfft,kf_plan * cand)
+{
+    int radix[MAXFACTORS], alt[MAXFACTORS];
+    int n, i, k, ncand = 0;
+    kf_plan def;
+
+    kf_factor(nfft,def.factors);
+    def.codelet_n1 = 0;
+    n = get_radices(def.factors,radix);
+    ncand = add_candidate(cand,ncand,&def);
+
+    /* the lone 2 (after the 4s) as the first stage instead */
+    for (i = 0; i < n && radix[i] != 2; ++i)
+        ;
+    if (i < n) {
+        alt[0] = 2;
+        for (k = 0; k < i; ++k)
+            alt[k + 1] = radix[k];
+        for (k = i + 1; k < n; ++k)
+            alt[k] = radix[k];
+        ncand = add_radix_candidate(cand,ncand,nfft,alt,n);
+    }
+
+    /* radix 2 stages instead of radix 4 */
+    for (i = k = 0; i < n && k + 2 <= MAXFACTORS; ++i) {
+        if (radix[i] == 4) {
+            alt[k++] = 2;
+            alt[k++] = 2;
+        } else {
+            alt[k++] = radix[i];
+        }
+    }
+    if (i == n)
+        ncand = add_radix_candidate(cand,ncand,nfft,alt,k);
+
+    /* largest radix first */
+    for (i = 0; i < n; ++i)
+        alt[i] = radix[n - 1 - i];
+    ncand = add_radix_candidate(cand,ncand,nfft,alt,n);
+
+#ifdef KISS_FFT_CODELETS
+    for (k = 8; k <= 64; k *= 2) {
+        if (kf_codelet_split_ok(nfft,k)) {
+            kf_plan plan = def;
+            plan.codelet_n1 = k;
+            ncand = add_candidate(cand,ncand,&plan);
+        }
+    }
+#endif
+    return ncand;
+}
+
+/* seconds per forward transform, best of KFW_RUNS */
+static double time_plan(kiss_fft_cfg cfg,const kiss_fft_cpx * in,kiss_fft_cpx * out)
+{
+    long reps = 1, r;
+    clock_t elapsed, t0;
+    double best;
+    int run;
+
+    kiss_fft(cfg,in,out);
+    for (;;) {
+        t0 = clock();
+        for (r = 0; r < reps; ++r)
+            kiss_fft(cfg,in,out);
+        elapsed = clock() - t0;
+        if (elapsed >= KFW_MIN_CLOCKS || reps >= (1L << 24))
+            break;
+        reps *= 2;
+    }
+    best = (double)elapsed / reps;
+    for (run = 1; run < KFW_RUNS; ++run) {
+        t0 = clock();
+        for (r = 0; r < reps; ++r)
+            kiss_fft(cfg,in,out);
+        elapsed = clock() - t0;
+        if ((double)elapsed / reps < best)
+            best = (double)elapsed / reps;
+    }
+    return best / CLOCKS_PER_SEC;
+}
+
+int kiss_fft_tune(int nfft)
+{
+    kf_plan cand[KFW_MAX_CANDIDATES];
+    kiss_fft_cpx * in;
+    kiss_fft_cpx * out;
+    double best_time = 0;
+    int ncand, best = -1, i;
+
+    if (nfft <= 0) {
+        KISS_FFT_ERROR("Cannot tune a non-positive FFT size.");
+        return -1;
+    }
+    /* the plan for nfft would only wrap this sub-FFT */
+    if (kiss_fft_bluestein_size(nfft))
+        return kiss_fft_tune(kiss_fft_bluestein_size(nfft));
+
+    ncand = get_candidates(nfft,cand);
+    if (ncand == 1)
+        return remember(nfft,cand);
+
+    in = (kiss_fft_cpx *) KISS_FFT_MALLOC(sizeof(kiss_fft_cpx) * 2 * (size_t)nfft);
+    if (in == NULL) {
+        KISS_FFT_ERROR("Memory allocation failed.");
+        return -1;
+    }
+    out = in + nfft;
+    for (i = 0; i < nfft; ++i) {
+        in[i].r = (kiss_fft_scalar) ((i * 37 % 101) / 50.0 - 1.0);
+        in[i].i = (kiss_fft_scalar) ((i * 61 % 103) / 51.0 - 1.0);
+    }
+
+    for (i = 0; i < ncand; ++i) {
+        kiss_fft_cfg cfg = kf_alloc_plan(nfft,0,cand + i,NULL,NULL);
+        double t;
+        if (cfg == NULL)
+            continue;
+        t = time_plan(cfg,in,out);
+        if (best < 0 || t < best_time) {
+            best = i;
+            best_time = t;
+        }
+        kiss_fft_free(cfg);
+    }
+    KISS_FFT_FREE(in);
+
+    if (best < 0) {
+        KISS_FFT_ERROR("No candidate plan could be allocated.");
+        return -1;
+    }
+    return remember(nfft,cand + best);
+}
+
+int kiss_fft_wisdom_has(int nfft)
+{
+    return find_wisdom(nfft) != NULL;
+}
+
+int kiss_fft_wisdom_describe(int nfft,char * buf,size_t buflen)
+{
+    const struct wisdom_entry * e = find_wisdom(nfft);
+    int radix[MAXFACTORS], n, i;
+    size_t len;
+
+    if (e == NULL || buflen == 0)
+        return 0;
+    if (e->plan.codelet_n1) {
+        snprintf(buf,buflen,"codelets %dx%d",e->plan.codelet_n1,nfft / e->plan.codelet_n1);
+        return 1;
+    }
+    n = get_radices(e->plan.factors,radix);
+    snprintf(buf,buflen,"radix %d",radix[0]);
+    for (i = 1; i < n; ++i) {
+        len = strlen(buf);
+        snprintf(buf + len,buflen - len,"x%d",radix[i]);
+    }
+    return 1;
+}
+
+/* reads the plan text of one line (after the size); returns 0 if it is
+   not a plan this build can use for nfft */
+static int parse_plan(int nfft,const char * kind,const char * spec,kf_plan * plan)
+{
+    int radix[MAXFACTORS], n = 0;
+    const char * p = spec;
+    char * end;
+
+    kf_factor(nfft,plan->factors);
+    plan->codelet_n1 = 0;
+    if (strcmp(kind,"codelets") == 0) {
+#ifdef KISS_FFT_CODELETS
+        int n1 = (int)strtol(spec,&end,10);
+        if (*end != 'x' || n1 <= 0 || strtol(end + 1,NULL,10) != nfft / n1
+                || !kf_codelet_split_ok(nfft,n1))
+            return 0;
+        plan->codelet_n1 = n1;
+        return 1;
+#else
+        return 0;
+#endif
+    }
+    if (strcmp(kind,"radix") != 0)
+        return 0;
+    for (;;) {
+        if (n == MAXFACTORS)
+            return 0;
+        radix[n++] = (int)strtol(p,&end,10);
+        if (end == p)
+            return 0;
+        if (*end != 'x')
+            break;
+        p = end + 1;
+    }
+    return *end == '\0' && set_radices(nfft,radix,n,plan->factors);
+}
+
+int kiss_fft_wisdom_load(const char * path)
+{
+    char magic[32], level[32], kind[16], spec[256];
+    int version, nfft, count = 0;
+    kf_plan plan;
+    FILE * f = fopen(path,"r");
+
+    if (f == NULL)
+        return -1;
+    if (fscanf(f,"%31s %d %31s",magic,&version,level) != 3
+            || strcmp(magic,KFW_MAGIC) != 0 || version != KFW_VERSION
+            || strcmp(level,kiss_fft_simd_name(kiss_fft_simd_level())) != 0) {
+        fclose(f);
+        return -1;
+    }
+    while (fscanf(f,"%d %15s %255s",&nfft,kind,spec) == 3) {
+        if (nfft > 0 && parse_plan(nfft,kind,spec,&plan)) {
+            if (remember(nfft,&plan) < 0)
+                break;
+            ++count;
+        }
+    }
+    fclose(f);
+    return count;
+}
+
+int kiss_fft_wisdom_save(const char * path)
+{
+    const struct wisdom_entry * e;
+    char spec[16 + 4*MAXFACTORS];
+    int count = 0;
+    FILE * f = fopen(path,"w");
+
+    if (f == NULL)
+        return -1;
+    fprintf(f,"%s %d %s\n",KFW_MAGIC,KFW_VERSION,kiss_fft_simd_name(kiss_fft_simd_level()));
+    for (e = wisdom_root; e; e = e->next) {
+        kiss_fft_wisdom_describe(e->nfft,spec,sizeof(spec));
+        fprintf(f,"%d %s\n",e->nfft,spec);
+        ++count;
+    }
+    if (fclose(f) != 0)
+        return -1;
+    return count;
+}
+
+void kiss_fft_wisdom_forget(void)
+{
+    while (wisdom_root) {
+        struct wisdom_entry * next = wisdom_root->next;
+        free(wisdom_root);
+        wisdom_root = next;
+    }
+}
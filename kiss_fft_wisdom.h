@@ -0,0 +1,69 @@
+/*
+ *  Plan autotuning for KISS FFT.
+ *
+ *  SPDX-License-Identifier: BSD-3-Clause
+ *  See COPYING file for more information.
+ */
+
+#ifndef KISS_FFT_WISDOM_H
+#define KISS_FFT_WISDOM_H
+
+#include "kiss_fft.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+
+ kiss_fft_alloc normally uses one fixed plan per size: the radices in
+ kf_factor's order (4s first, then 2, then the odd primes), or the default
+ codelet split for power-of-two sizes.  Which plan is fastest depends on
+ the CPU and the size, so kiss_fft_tune times the candidates on this host
+ and remembers the winner ("wisdom").  Every later kiss_fft_alloc of that
+ size, including the sub-FFTs of kiss_fftr and of Bluestein plans, then
+ builds the tuned plan.  Plans that already exist are not changed.
+
+ Candidates are the default radix order, the 2 moved to the first stage,
+ radix 2 instead of 4, the reversed order, and every codelet split
+ N1 x N2 with both passes within the generated codelets.
+
+ Wisdom is saved as a small text file, one size per line, and is only
+ valid for the SIMD level it was tuned at: loading a file written at
+ another level fails, so the caller retunes.  None of these functions may
+ run while other threads allocate plans.
+
+ */
+
+/* Times the candidate plans for nfft (forward, out of place) and keeps the
+   fastest.  Sizes computed with Bluestein's algorithm tune the sub-FFT
+   size instead (kiss_fft_bluestein_size).  Takes a few tens of
+   milliseconds per size.
+   Returns 0 on success, -1 on failure. */
+int KISS_FFT_API kiss_fft_tune(int nfft);
+
+/* nonzero if there is wisdom for nfft */
+int KISS_FFT_API kiss_fft_wisdom_has(int nfft);
+
+/* writes the tuned plan for nfft as text (e.g. "radix 4x4x2x4" or
+   "codelets 16x32") into buf; returns 0 if there is no wisdom for nfft */
+int KISS_FFT_API kiss_fft_wisdom_describe(int nfft,char * buf,size_t buflen);
+
+/* Merges the wisdom in a file written by kiss_fft_wisdom_save into the
+   current wisdom.  Returns the number of sizes read, or -1 if the file
+   cannot be opened, is not a wisdom file, or was tuned at another SIMD
+   level. */
+int KISS_FFT_API kiss_fft_wisdom_load(const char * path);
+
+/* Writes all current wisdom to path; returns the number of sizes written
+   or -1 on failure. */
+int KISS_FFT_API kiss_fft_wisdom_save(const char * path);
+
+/* forgets all wisdom: later plans use the default order again */
+void KISS_FFT_API kiss_fft_wisdom_forget(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,420 @@
+/*
+ *  Multithreaded large FFT built on KISS FFT.
+ *
+ *  SPDX-License-Identifier: BSD-3-Clause
+ *  See COPYING file for more information.
+ */
+
+#ifdef _WIN32
+# if !defined(_WIN32_WINNT) || _WIN32_WINNT < 0x0600
+#  undef _WIN32_WINNT
+#  define _WIN32_WINNT 0x0600   /* SRW locks and condition variables */
+# endif
+#elif !defined(_POSIX_C_SOURCE)
+# define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "kiss_fftmt.h"
+#include "_kiss_fft_guts.h"
+
+#ifdef USE_SIMD
+# error "kiss_fftmt needs a scalar kiss_fft_scalar (USE_SIMD packs four transforms per value)"
+#endif
+
+#ifdef _WIN32
+# include <windows.h>
+#else
+# include <stdint.h>
+# include <pthread.h>
+# include <unistd.h>
+#endif
+
+/* columns (pass 1) or rows (pass 2) moved per cache-blocked transpose */
+#ifndef KISS_FFTMT_BLOCK
+#define KISS_FFTMT_BLOCK 16
+#endif
+
+/*
+ With n = N2*n1 + n2 and k = k1 + N1*k2,
+
+   X[k1 + N1*k2] = sum_n2 W_N2^(n2*k2) * W_N^(n2*k1) * sum_n1 x[N2*n1 + n2] * W_N1^(n1*k1)
+
+ Pass 1 gathers a block of input columns n2, runs their size-N1 FFTs,
+ applies W_N^(n2*k1) and stores them as scratch[k1*N2 + n2].  Pass 2 runs
+ the size-N2 FFT of each scratch row k1 and stores bin k2 at
+ fout[k2*N1 + k1].  The twiddle exponent n2*k1 is below N, so it is
+ split as lo + N1*hi and built from two short tables.
+*/
+struct kiss_fftmt_state{
+    int nfft;
+    int inverse;
+    int nthreads;
+    int n1;
+    int n2;
+    kiss_fft_cfg sub1;          /* plan of size n1, shared by the threads */
+    kiss_fft_cfg sub2;          /* plan of size n2 */
+    kiss_fft_cpx * tw_lo;       /* n1 values: W_N^j */
+    kiss_fft_cpx * tw_hi;       /* n2 values: W_N^(n1*j) */
+    kiss_fft_cpx * scratch;     /* nfft values between the passes */
+    kiss_fft_cpx * blocks;      /* nthreads * blocklen values of transpose buffers */
+    size_t blocklen;
+};
+
+/*
+ * Worker pool
+ *
+ * kmt_run(fn,arg,nparts) calls fn(arg,part) for part = 0..nparts-1, part 0
+ * on the calling thread and the others on pool threads, and returns when
+ * all of them are done.  Threads are started on demand and kept until
+ * kiss_fftmt_cleanup.
+ */
+typedef void (*kmt_task_fn)(void * arg,int part);
+
+#ifdef _WIN32
+typedef HANDLE kmt_thread;
+typedef SRWLOCK kmt_mutex;
+typedef CONDITION_VARIABLE kmt_cond;
+# define KMT_MUTEX_INIT SRWLOCK_INIT
+# define KMT_COND_INIT CONDITION_VARIABLE_INIT
+# define kmt_lock(m) AcquireSRWLockExclusive(m)
+# define kmt_unlock(m) ReleaseSRWLockExclusive(m)
+# define kmt_wait(c,m) SleepConditionVariableSRW(c,m,INFINITE,0)
+# define kmt_broadcast(c) WakeAllConditionVariable(c)
+#else
+typedef pthread_t kmt_thread;
+typedef pthread_mutex_t kmt_mutex;
+typedef pthread_cond_t kmt_cond;
+# define KMT_MUTEX_INIT PTHREAD_MUTEX_INITIALIZER
+# define KMT_COND_INIT PTHREAD_COND_INITIALIZER
+# define kmt_lock(m) pthread_mutex_lock(m)
+# define kmt_unlock(m) pthread_mutex_unlock(m)
+# define kmt_wait(c,m) pthread_cond_wait(c,m)
+# define kmt_broadcast(c) pthread_cond_broadcast(c)
+#endif
+
+static kmt_mutex kmt_busy = KMT_MUTEX_INIT;     /* one kmt_run at a time */
+static kmt_mutex kmt_lock_ = KMT_MUTEX_INIT;    /* guards the fields below */
+static kmt_cond kmt_wake = KMT_COND_INIT;
+static kmt_cond kmt_done = KMT_COND_INIT;
+static kmt_thread kmt_threads[KISS_FFTMT_MAX_THREADS];
+static unsigned kmt_born[KISS_FFTMT_MAX_THREADS]; /* kmt_generation when started */
+static int kmt_nworkers = 0;        /* pool threads, numbered 1..kmt_nworkers */
+static unsigned kmt_generation = 0; /* bumped for every job */
+static int kmt_stop = 0;
+static kmt_task_fn kmt_fn;
+static void * kmt_arg;
+static int kmt_nparts;
+static int kmt_remaining;
+
+static void kmt_worker(int part)
+{
+    unsigned seen;
+    kmt_lock(&kmt_lock_);
+    seen = kmt_born[part];
+    for (;;) {
+        while (kmt_generation == seen && !kmt_stop)
+            kmt_wait(&kmt_wake,&kmt_lock_);
+        if (kmt_stop)
+            break;
+        seen = kmt_generation;
+        if (part < kmt_nparts) {
+            kmt_task_fn fn = kmt_fn;
+            void * arg = kmt_arg;
+            kmt_unlock(&kmt_lock_);
+            fn(arg,part);
+            kmt_lock(&kmt_lock_);
+            if (--kmt_remaining == 0)
+                kmt_broadcast(&kmt_done);
+        }
+    }
+    kmt_unlock(&kmt_lock_);
+}
+
+#ifdef _WIN32
+static DWORD WINAPI kmt_thread_main(LPVOID part)
+{
+    kmt_worker((int)(INT_PTR)part);
+    return 0;
+}
+#else
+static void * kmt_thread_main(void * part)
+{
+    kmt_worker((int)(intptr_t)part);
+    return NULL;
+}
+#endif
+
+/* starts pool threads up to n; returns how many are running */
+static int kmt_grow(int n)
+{
+    if (n > KISS_FFTMT_MAX_THREADS - 1)
+        n = KISS_FFTMT_MAX_THREADS - 1;
+    while (kmt_nworkers < n) {
+        int part = kmt_nworkers + 1;
+        kmt_born[part] = kmt_generation;
+#ifdef _WIN32
+        kmt_thread t = CreateThread(NULL,0,kmt_thread_main,(LPVOID)(INT_PTR)part,0,NULL);
+        if (t == NULL)
+            break;
+#else
+        kmt_thread t;
+        if (pthread_create(&t,NULL,kmt_thread_main,(void *)(intptr_t)part) != 0)
+            break;
+#endif
+        kmt_threads[kmt_nworkers++] = t;
+    }
+    return kmt_nworkers;
+}
+
+static void kmt_run(kmt_task_fn fn,void * arg,int nparts)
+{
+    int part;
+
+    kmt_lock(&kmt_busy);
+    kmt_lock(&kmt_lock_);
+    if (nparts > 1 + kmt_grow(nparts - 1)) {
+        /* too few threads could be started: run the rest here */
+        const int running = 1 + kmt_nworkers;
+        kmt_unlock(&kmt_lock_);
+        for (part = running; part < nparts; ++part)
+            fn(arg,part);
+        kmt_lock(&kmt_lock_);
+        nparts = running;
+    }
+    kmt_fn = fn;
+    kmt_arg = arg;
+    kmt_nparts = nparts;
+    kmt_remaining = nparts - 1;
+    ++kmt_generation;
+    kmt_broadcast(&kmt_wake);
+    kmt_unlock(&kmt_lock_);
+
+    fn(arg,0);
+
+    kmt_lock(&kmt_lock_);
+    while (kmt_remaining > 0)
+        kmt_wait(&kmt_done,&kmt_lock_);
+    kmt_unlock(&kmt_lock_);
+    kmt_unlock(&kmt_busy);
+}
+
+void kiss_fftmt_cleanup(void)
+{
+    int i;
+    kmt_lock(&kmt_busy);
+    kmt_lock(&kmt_lock_);
+    kmt_stop = 1;
+    kmt_broadcast(&kmt_wake);
+    kmt_unlock(&kmt_lock_);
+    for (i = 0; i < kmt_nworkers; ++i) {
+#ifdef _WIN32
+        WaitForSingleObject(kmt_threads[i],INFINITE);
+        CloseHandle(kmt_threads[i]);
+#else
+        pthread_join(kmt_threads[i],NULL);
+#endif
+    }
+    kmt_nworkers = 0;
+    kmt_stop = 0;
+    kmt_unlock(&kmt_busy);
+}
+
+int kiss_fftmt_cpu_count(void)
+{
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return (int)info.dwNumberOfProcessors;
+#else
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (int)n : 1;
+#endif
+}
+
+/*
+ * Four-step transform
+ */
+
+kiss_fftmt_cfg kiss_fftmt_alloc(int nfft,int inverse_fft,int nthreads,void * mem,size_t * lenmem)
+{
+    const double pi=3.14159265358979323846264338327;
+    kiss_fftmt_cfg st = NULL;
+    size_t sub1size = 0, sub2size = 0, memneeded;
+    char * p;
+    int n1, n2, j;
+
+    if (nfft <= 0) {
+        KISS_FFT_ERROR("FFT size must be positive.");
+        return NULL;
+    }
+    if (nthreads <= 0)
+        nthreads = kiss_fftmt_cpu_count();
+    if (nthreads > KISS_FFTMT_MAX_THREADS)
+        nthreads = KISS_FFTMT_MAX_THREADS;
+
+    /* largest divisor up to sqrt(nfft) */
+    for (n1 = (int) floor(sqrt((double) nfft)); nfft % n1; --n1)
+        ;
+    n2 = nfft / n1;
+    if (n1 == 1)
+        nthreads = 1;
+
+    if (n1 > 1)
+        kiss_fft_alloc(n1, inverse_fft, NULL, &sub1size);
+    kiss_fft_alloc(n2, inverse_fft, NULL, &sub2size);
+    sub1size = (sub1size + 15) & ~(size_t)15;
+    sub2size = (sub2size + 15) & ~(size_t)15;
+
+    memneeded = ((sizeof(struct kiss_fftmt_state) + 15) & ~(size_t)15) + sub1size + sub2size;
+    if (n1 > 1) {
+        const size_t blocklen = KISS_FFTMT_BLOCK * (size_t)(2 * n1 > n2 ? 2 * n1 : n2);
+        memneeded += sizeof(kiss_fft_cpx) * ((size_t)n1 + n2 + nfft + blocklen * nthreads);
+    }
+
+    if (lenmem == NULL) {
+        st = (kiss_fftmt_cfg) KISS_FFT_MALLOC (memneeded);
+    } else {
+        if (mem != NULL && *lenmem >= memneeded)
+            st = (kiss_fftmt_cfg) mem;
+        *lenmem = memneeded;
+    }
+    if (!st)
+        return NULL;
+
+    st->nfft = nfft;
+    st->inverse = inverse_fft;
+    st->nthreads = nthreads;
+    st->n1 = n1;
+    st->n2 = n2;
+    /* the sub-plans just beyond the kiss_fftmt_state struct; kiss_fft cfgs
+       are read-only, so every thread runs the same two */
+    p = (char *) st + ((sizeof(struct kiss_fftmt_state) + 15) & ~(size_t)15);
+    st->sub1 = NULL;
+    if (n1 > 1) {
+        size_t len = sub1size;
+        st->sub1 = kiss_fft_alloc(n1, inverse_fft, p, &len);
+        p += sub1size;
+    }
+    {
+        size_t len = sub2size;
+        st->sub2 = kiss_fft_alloc(n2, inverse_fft, p, &len);
+        p += sub2size;
+    }
+
+    st->tw_lo = st->tw_hi = st->scratch = st->blocks = NULL;
+    st->blocklen = 0;
+    if (n1 > 1) {
+        st->blocklen = KISS_FFTMT_BLOCK * (size_t)(2 * n1 > n2 ? 2 * n1 : n2);
+        st->tw_lo = (kiss_fft_cpx *) p;
+        st->tw_hi = st->tw_lo + n1;
+        st->scratch = st->tw_hi + n2;
+        st->blocks = st->scratch + nfft;
+        for (j = 0; j < n1; ++j)
+            kf_cexp(st->tw_lo + j, (inverse_fft ? 2 : -2) * pi * j / nfft);
+        for (j = 0; j < n2; ++j)
+            kf_cexp(st->tw_hi + j, (inverse_fft ? 2 : -2) * pi * j / n2);
+    }
+    return st;
+}
+
+typedef struct {
+    kiss_fftmt_cfg st;
+    const kiss_fft_cpx * fin;
+    kiss_fft_cpx * fout;
+} kmt_job;
+
+/* first and one-past-last block of part out of nblocks */
+static void kmt_part_range(int nblocks,int nparts,int part,int * b0,int * b1)
+{
+    *b0 = (int) ((long long) nblocks * part / nparts);
+    *b1 = (int) ((long long) nblocks * (part + 1) / nparts);
+}
+
+/* columns c0..c0+w-1: fin -> size-n1 FFTs -> twiddles -> scratch */
+static void kmt_pass1(void * arg,int part)
+{
+    const kmt_job * job = (const kmt_job *) arg;
+    const kiss_fftmt_cfg st = job->st;
+    const int n1 = st->n1, n2 = st->n2;
+    kiss_fft_cpx * in = st->blocks + st->blocklen * part;
+    kiss_fft_cpx * out = in + (size_t)KISS_FFTMT_BLOCK * n1;
+    int blk, b0, b1, b, j;
+
+    kmt_part_range((n2 + KISS_FFTMT_BLOCK - 1) / KISS_FFTMT_BLOCK, st->nthreads, part, &b0, &b1);
+    for (blk = b0; blk < b1; ++blk) {
+        const int c0 = blk * KISS_FFTMT_BLOCK;
+        const int w = n2 - c0 < KISS_FFTMT_BLOCK ? n2 - c0 : KISS_FFTMT_BLOCK;
+
+        for (j = 0; j < n1; ++j) {
+            const kiss_fft_cpx * src = job->fin + (size_t)j * n2 + c0;
+            for (b = 0; b < w; ++b)
+                in[(size_t)b * n1 + j] = src[b];
+        }
+
+        for (b = 0; b < w; ++b) {
+            kiss_fft_cpx * row = out + (size_t)b * n1;
+            const int col = c0 + b;
+            const int dlo = col % n1, dhi = col / n1;
+            int lo = 0, hi = 0;
+            kiss_fft(st->sub1, in + (size_t)b * n1, row);
+            for (j = 1; j < n1; ++j) {
+                kiss_fft_cpx tw, t;
+                lo += dlo;
+                hi += dhi;
+                if (lo >= n1) {
+                    lo -= n1;
+                    ++hi;
+                }
+                C_MUL(tw, st->tw_hi[hi], st->tw_lo[lo]);
+                C_MUL(t, row[j], tw);
+                row[j] = t;
+            }
+        }
+
+        for (j = 0; j < n1; ++j) {
+            kiss_fft_cpx * dst = st->scratch + (size_t)j * n2 + c0;
+            for (b = 0; b < w; ++b)
+                dst[b] = out[(size_t)b * n1 + j];
+        }
+    }
+}
+
+/* rows r0..r0+w-1: scratch -> size-n2 FFTs -> fout */
+static void kmt_pass2(void * arg,int part)
+{
+    const kmt_job * job = (const kmt_job *) arg;
+    const kiss_fftmt_cfg st = job->st;
+    const int n1 = st->n1, n2 = st->n2;
+    kiss_fft_cpx * out = st->blocks + st->blocklen * part;
+    int blk, b0, b1, b, k;
+
+    kmt_part_range((n1 + KISS_FFTMT_BLOCK - 1) / KISS_FFTMT_BLOCK, st->nthreads, part, &b0, &b1);
+    for (blk = b0; blk < b1; ++blk) {
+        const int r0 = blk * KISS_FFTMT_BLOCK;
+        const int w = n1 - r0 < KISS_FFTMT_BLOCK ? n1 - r0 : KISS_FFTMT_BLOCK;
+
+        for (b = 0; b < w; ++b)
+            kiss_fft(st->sub2, st->scratch + (size_t)(r0 + b) * n2, out + (size_t)b * n2);
+
+        for (k = 0; k < n2; ++k) {
+            kiss_fft_cpx * dst = job->fout + (size_t)k * n1 + r0;
+            for (b = 0; b < w; ++b)
+                dst[b] = out[(size_t)b * n2 + k];
+        }
+    }
+}
+
+void kiss_fftmt(kiss_fftmt_cfg st,const kiss_fft_cpx *fin,kiss_fft_cpx *fout)
+{
+    kmt_job job;
+
+    if (st->n1 == 1) {
+        kiss_fft(st->sub2, fin, fout);
+        return;
+    }
+    job.st = st;
+    job.fin = fin;
+    job.fout = fout;
+    kmt_run(kmt_pass1, &job, st->nthreads);
+    kmt_run(kmt_pass2, &job, st->nthreads);
+}
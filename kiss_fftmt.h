@@ -0,0 +1,69 @@
+/*
+ *  Multithreaded large FFT built on KISS FFT.
+ *
+ *  SPDX-License-Identifier: BSD-3-Clause
+ *  See COPYING file for more information.
+ */
+
+#ifndef KISS_FFTMT_H
+#define KISS_FFTMT_H
+
+#include "kiss_fft.h"
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/*
+
+ Complex FFT for very long transforms (2^20 points and up), split as
+ N = N1 * N2 with N1 <= N2 as close to sqrt(N) as the factors allow
+ (four-step / six-step FFT):
+
+   pass 1: N2 FFTs of size N1 over the columns of the N1 x N2 input,
+           times the twiddles exp(-2*pi*i * n2*k1 / N)
+   pass 2: N1 FFTs of size N2 over the rows of the result
+
+ Each pass reads and writes through cache-blocked transposes
+ (KISS_FFTMT_BLOCK columns at a time), so every sub-FFT runs on
+ contiguous data that fits in cache, and the passes are split across a
+ pool of worker threads shared by all cfgs.  The calling thread does one
+ share of the work.  Results match kiss_fft to float rounding, not bit
+ for bit.  Sizes without a divisor other than 1 run as one kiss_fft.
+ Meant for float builds.
+
+ */
+
+#ifndef KISS_FFTMT_MAX_THREADS
+#define KISS_FFTMT_MAX_THREADS 64
+#endif
+
+typedef struct kiss_fftmt_state *kiss_fftmt_cfg;
+
+
+kiss_fftmt_cfg KISS_FFT_API kiss_fftmt_alloc(int nfft,int inverse_fft,int nthreads,void * mem,size_t * lenmem);
+/*
+ nthreads threads share each transform (0 or less: one per CPU, at most
+ KISS_FFTMT_MAX_THREADS).
+ mem/lenmem work as for kiss_fft_alloc; the result is freed with kiss_fftmt_free.
+ The cfg holds an nfft-point scratch buffer, so it must not be shared between threads.
+*/
+
+void KISS_FFT_API kiss_fftmt(kiss_fftmt_cfg cfg,const kiss_fft_cpx *fin,kiss_fft_cpx *fout);
+/*
+ nfft complex points in and out; fin may equal fout.
+ Transforms from different threads take turns on the worker pool.
+*/
+
+/* number of CPUs the OS reports */
+int KISS_FFT_API kiss_fftmt_cpu_count(void);
+
+/* stops the worker threads; they are started again on the next transform */
+void KISS_FFT_API kiss_fftmt_cleanup(void);
+
+#define kiss_fftmt_free KISS_FFT_FREE
+
+#ifdef __cplusplus
+}
+#endif
+#endif
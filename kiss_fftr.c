@@ -0,0 +1,324 @@
+/*
+ *  Copyright (c) 2003-2004, Mark Borgerding. All rights reserved.
+ *  This file is part of KISS FFT - https://github.com/mborgerding/kissfft
+ *
+ *  SPDX-License-Identifier: BSD-3-Clause
+ *  See COPYING file for more information.
+ */
+
+#include "kiss_fftr.h"
+#include "_kiss_fft_guts.h"
+
+struct kiss_fftr_state{
+    kiss_fft_cfg substate;
+    kiss_fft_cpx * tmpbuf;
+    kiss_fft_cpx * super_twiddles;
+#ifdef USE_SIMD
+    void * pad;
+#endif
+};
+
+kiss_fftr_cfg kiss_fftr_alloc(int nfft,int inverse_fft,void * mem,size_t * lenmem)
+{
+    int i;
+    kiss_fftr_cfg st = NULL;
+    size_t subsize = 0, memneeded;
+
+    if (nfft & 1) {
+        KISS_FFT_ERROR("Real FFT optimization must be even.");
+        return NULL;
+    }
+    nfft >>= 1;
+
+    kiss_fft_alloc (nfft, inverse_fft, NULL, &subsize);
+    memneeded = sizeof(struct kiss_fftr_state) + subsize + sizeof(kiss_fft_cpx) * ( nfft * 3 / 2);
+
+    if (lenmem == NULL) {
+        st = (kiss_fftr_cfg) KISS_FFT_MALLOC (memneeded);
+    } else {
+        if (*lenmem >= memneeded)
+            st = (kiss_fftr_cfg) mem;
+        *lenmem = memneeded;
+    }
+    if (!st)
+        return NULL;
+
+    st->substate = (kiss_fft_cfg) (st + 1); /*just beyond kiss_fftr_state struct */
+    st->tmpbuf = (kiss_fft_cpx *) (((char *) st->substate) + subsize);
+    st->super_twiddles = st->tmpbuf + nfft;
+    kiss_fft_alloc(nfft, inverse_fft, st->substate, &subsize);
+
+    for (i = 0; i < nfft/2; ++i) {
+        double phase =
+            -3.14159265358979323846264338327 * ((double) (i+1) / nfft + .5);
+        if (inverse_fft)
+            phase *= -1;
+        kf_cexp (st->super_twiddles+i,phase);
+    }
+    return st;
+}
+
+/* freqdata[0..ncfft] from the ncfft-point complex FFT of the packed input
+   in packed (which may be freqdata itself: each pair of bins is read
+   before it is written) */
+static void kf_fftr_split(kiss_fftr_cfg st,const kiss_fft_cpx *packed,kiss_fft_cpx *freqdata)
+{
+    int k,ncfft;
+    kiss_fft_cpx fpnk,fpk,f1k,f2k,tw,tdc;
+
+    ncfft = st->substate->nfft;
+
+    /* The real part of the DC element of the frequency spectrum in packed
+     * contains the sum of the even-numbered elements of the input time sequence
+     * The imag part is the sum of the odd-numbered elements
+     *
+     * The sum of tdc.r and tdc.i is the sum of the input time sequence.
+     *      yielding DC of input time sequence
+     * The difference of tdc.r - tdc.i is the sum of the input (dot product) [1,-1,1,-1...
+     *      yielding Nyquist bin of input time sequence
+     */
+
+    tdc.r = packed[0].r;
+    tdc.i = packed[0].i;
+    C_FIXDIV(tdc,2);
+    CHECK_OVERFLOW_OP(tdc.r ,+, tdc.i);
+    CHECK_OVERFLOW_OP(tdc.r ,-, tdc.i);
+    freqdata[0].r = tdc.r + tdc.i;
+    freqdata[ncfft].r = tdc.r - tdc.i;
+#ifdef USE_SIMD
+    freqdata[ncfft].i = freqdata[0].i = _mm_set1_ps(0);
+#else
+    freqdata[ncfft].i = freqdata[0].i = 0;
+#endif
+
+    for ( k=1;k <= ncfft/2 ; ++k ) {
+        fpk    = packed[k];
+        fpnk.r =   packed[ncfft-k].r;
+        fpnk.i = - packed[ncfft-k].i;
+        C_FIXDIV(fpk,2);
+        C_FIXDIV(fpnk,2);
+
+        C_ADD( f1k, fpk , fpnk );
+        C_SUB( f2k, fpk , fpnk );
+        C_MUL( tw , f2k , st->super_twiddles[k-1]);
+
+        freqdata[k].r = HALF_OF(f1k.r + tw.r);
+        freqdata[k].i = HALF_OF(f1k.i + tw.i);
+        freqdata[ncfft-k].r = HALF_OF(f1k.r - tw.r);
+        freqdata[ncfft-k].i = HALF_OF(tw.i - f1k.i);
+    }
+}
+
+/* the real input as ncfft complex values (even samples real, odd imaginary),
+   each sample multiplied by its window value on the way */
+static void kf_fftr_pack(kiss_fft_cpx *packed,const kiss_fft_scalar *timedata,
+        const kiss_fft_scalar *window,int ncfft)
+{
+    int k;
+
+    for (k = 0; k < ncfft; ++k) {
+        packed[k].r = S_MUL(timedata[2*k], window[2*k]);
+        packed[k].i = S_MUL(timedata[2*k+1], window[2*k+1]);
+    }
+}
+
+void kiss_fftr(kiss_fftr_cfg st,const kiss_fft_scalar *timedata,kiss_fft_cpx *freqdata)
+{
+    /* input buffer timedata is stored row-wise */
+    if ( st->substate->inverse) {
+        KISS_FFT_ERROR("kiss fft usage error: improper alloc");
+        return;/* The caller did not call the correct function */
+    }
+
+    /*perform the parallel fft of two real signals packed in real,imag*/
+    kiss_fft( st->substate , (const kiss_fft_cpx*)timedata, st->tmpbuf );
+    kf_fftr_split(st, st->tmpbuf, freqdata);
+}
+
+void kiss_fftr_windowed(kiss_fftr_cfg st,const kiss_fft_scalar *timedata,
+        const kiss_fft_scalar *window,kiss_fft_cpx *freqdata)
+{
+    if (window == NULL) {
+        kiss_fftr(st, timedata, freqdata);
+        return;
+    }
+    if ( st->substate->inverse) {
+        KISS_FFT_ERROR("kiss fft usage error: improper alloc");
+        return;/* The caller did not call the correct function */
+    }
+
+    /* freqdata has room for the ncfft packed values and is not needed
+       until the split, so the windowed copy costs no scratch */
+    kf_fftr_pack(freqdata, timedata, window, st->substate->nfft);
+    kiss_fft( st->substate , freqdata, st->tmpbuf );
+    kf_fftr_split(st, st->tmpbuf, freqdata);
+}
+
+void kiss_fftri(kiss_fftr_cfg st,const kiss_fft_cpx *freqdata,kiss_fft_scalar *timedata)
+{
+    /* input buffer timedata is stored row-wise */
+    int k, ncfft;
+
+    if (st->substate->inverse == 0) {
+        KISS_FFT_ERROR("kiss fft usage error: improper alloc");
+        return;/* The caller did not call the correct function */
+    }
+
+    ncfft = st->substate->nfft;
+
+    st->tmpbuf[0].r = freqdata[0].r + freqdata[ncfft].r;
+    st->tmpbuf[0].i = freqdata[0].r - freqdata[ncfft].r;
+    C_FIXDIV(st->tmpbuf[0],2);
+
+    for (k = 1; k <= ncfft / 2; ++k) {
+        kiss_fft_cpx fk, fnkc, fek, fok, tmp;
+        fk = freqdata[k];
+        fnkc.r = freqdata[ncfft - k].r;
+        fnkc.i = -freqdata[ncfft - k].i;
+        C_FIXDIV( fk , 2 );
+        C_FIXDIV( fnkc , 2 );
+
+        C_ADD (fek, fk, fnkc);
+        C_SUB (tmp, fk, fnkc);
+        C_MUL (fok, tmp, st->super_twiddles[k-1]);
+        C_ADD (st->tmpbuf[k],     fek, fok);
+        C_SUB (st->tmpbuf[ncfft - k], fek, fok);
+#ifdef USE_SIMD
+        st->tmpbuf[ncfft - k].i *= _mm_set1_ps(-1.0);
+#else
+        st->tmpbuf[ncfft - k].i *= -1;
+#endif
+    }
+    kiss_fft (st->substate, st->tmpbuf, (kiss_fft_cpx *) timedata);
+}
+
+static void kf_fftr_batch(kiss_fftr_cfg st,int howmany,
+        const kiss_fft_scalar *timedata,int in_dist,const kiss_fft_scalar *window,
+        kiss_fft_cpx *freqdata,int out_dist)
+{
+    kiss_fft_cpx stackbuf[KISS_FFT_BATCH_STACK];
+    kiss_fft_cpx * work;
+    int k,b,ncfft,done,stride;
+    kiss_fft_cpx fpnk,fpk,f1k,f2k,tw,tdc;
+
+    if ( st->substate->inverse) {
+        KISS_FFT_ERROR("kiss fft usage error: improper alloc");
+        return;/* The caller did not call the correct function */
+    }
+
+    ncfft = st->substate->nfft;
+
+#ifdef KISS_FFT_CODELETS
+    /* the codelets have no interleaved form and beat the interleaved
+       stages one transform at a time: each runs in its own output slot
+       (a codelet reads all of its input before writing) and is split there */
+    if (st->substate->codelet_tw) {
+        for (b=0;b<howmany;++b) {
+            kiss_fft_cpx * out = freqdata + (size_t)b*out_dist;
+            if (window) {
+                kf_fftr_pack(out, timedata + (size_t)b*in_dist, window, ncfft);
+                kf_codelet(st->substate, out, out);
+            } else {
+                kf_codelet(st->substate, (const kiss_fft_cpx*)(timedata + (size_t)b*in_dist), out);
+            }
+            kf_fftr_split(st, out, out);
+        }
+        return;
+    }
+#endif
+
+    while (howmany > 0) {
+        done = howmany < KISS_FFT_BATCH_MAX ? howmany : KISS_FFT_BATCH_MAX;
+        stride = kf_batch_stride(done);
+
+        if ((size_t)ncfft*stride <= KISS_FFT_BATCH_STACK) {
+            work = stackbuf;
+        }else{
+            work = (kiss_fft_cpx*)KISS_FFT_TMP_ALLOC(sizeof(kiss_fft_cpx)*ncfft*stride);
+            if (work == NULL){
+                KISS_FFT_ERROR("Memory allocation error.");
+                return;
+            }
+        }
+
+        /* the parallel ffts of the even/odd halves of every input,
+           left element-interleaved in work; windowed inputs are packed
+           into their own output slots first */
+        if (window) {
+            for (b=0;b<done;++b)
+                kf_fftr_pack(freqdata + (size_t)b*out_dist, timedata + (size_t)b*in_dist,
+                             window, ncfft);
+            kf_batch_interleaved(st->substate,done,freqdata,out_dist,work);
+        } else {
+            kf_batch_interleaved(st->substate,done,(const kiss_fft_cpx*)timedata,in_dist/2,work);
+        }
+
+        /* same split as kiss_fftr, with each super twiddle reused across the batch */
+        for (b=0;b<done;++b) {
+            kiss_fft_cpx * out = freqdata + (size_t)b*out_dist;
+            tdc = work[b];
+            C_FIXDIV(tdc,2);
+            CHECK_OVERFLOW_OP(tdc.r ,+, tdc.i);
+            CHECK_OVERFLOW_OP(tdc.r ,-, tdc.i);
+            out[0].r = tdc.r + tdc.i;
+            out[ncfft].r = tdc.r - tdc.i;
+#ifdef USE_SIMD
+            out[ncfft].i = out[0].i = _mm_set1_ps(0);
+#else
+            out[ncfft].i = out[0].i = 0;
+#endif
+        }
+
+        for ( k=1;k <= ncfft/2 ; ++k ) {
+            const kiss_fft_cpx stw = st->super_twiddles[k-1];
+            const kiss_fft_cpx * rowk = work + (size_t)k*stride;
+            const kiss_fft_cpx * rownk = work + (size_t)(ncfft-k)*stride;
+            for (b=0;b<done;++b) {
+                kiss_fft_cpx * out = freqdata + (size_t)b*out_dist;
+                fpk    = rowk[b];
+                fpnk.r =   rownk[b].r;
+                fpnk.i = - rownk[b].i;
+                C_FIXDIV(fpk,2);
+                C_FIXDIV(fpnk,2);
+
+                C_ADD( f1k, fpk , fpnk );
+                C_SUB( f2k, fpk , fpnk );
+                C_MUL( tw , f2k , stw);
+
+                out[k].r = HALF_OF(f1k.r + tw.r);
+                out[k].i = HALF_OF(f1k.i + tw.i);
+                out[ncfft-k].r = HALF_OF(f1k.r - tw.r);
+                out[ncfft-k].i = HALF_OF(tw.i - f1k.i);
+            }
+        }
+
+        if (work != stackbuf)
+            KISS_FFT_TMP_FREE(work);
+
+        timedata += (size_t)done*in_dist;
+        freqdata += (size_t)done*out_dist;
+        howmany -= done;
+    }
+}
+
+void kiss_fftr_batch(kiss_fftr_cfg st,int howmany,
+        const kiss_fft_scalar *timedata,int in_dist,
+        kiss_fft_cpx *freqdata,int out_dist)
+{
+    if (in_dist & 1) {
+        KISS_FFT_ERROR("kiss_fftr_batch: in_dist must be even.");
+        return;
+    }
+    kf_fftr_batch(st, howmany, timedata, in_dist, NULL, freqdata, out_dist);
+}
+
+void kiss_fftr_batch_windowed(kiss_fftr_cfg st,int howmany,
+        const kiss_fft_scalar *timedata,int in_dist,const kiss_fft_scalar *window,
+        kiss_fft_cpx *freqdata,int out_dist)
+{
+    if (window == NULL && (in_dist & 1)) {
+        KISS_FFT_ERROR("kiss_fftr_batch: in_dist must be even.");
+        return;
+    }
+    kf_fftr_batch(st, howmany, timedata, in_dist, window, freqdata, out_dist);
+}
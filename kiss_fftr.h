@@ -0,0 +1,81 @@
+/*
+ *  Copyright (c) 2003-2004, Mark Borgerding. All rights reserved.
+ *  This file is part of KISS FFT - https://github.com/mborgerding/kissfft
+ *
+ *  SPDX-License-Identifier: BSD-3-Clause
+ *  See COPYING file for more information.
+ */
+
+#ifndef KISS_FTR_H
+#define KISS_FTR_H
+
+#include "kiss_fft.h"
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/*
+
+ Real optimized version can save about 45% cpu time vs. complex fft of a real seq.
+
+
+
+ */
+
+typedef struct kiss_fftr_state *kiss_fftr_cfg;
+
+
+kiss_fftr_cfg KISS_FFT_API kiss_fftr_alloc(int nfft,int inverse_fft,void * mem, size_t * lenmem);
+/*
+ nfft must be even
+
+ If you don't care to allocate space, use mem = lenmem = NULL
+*/
+
+
+void KISS_FFT_API kiss_fftr(kiss_fftr_cfg cfg,const kiss_fft_scalar *timedata,kiss_fft_cpx *freqdata);
+/*
+ input timedata has nfft scalar points
+ output freqdata has nfft/2+1 complex points
+*/
+
+void KISS_FFT_API kiss_fftri(kiss_fftr_cfg cfg,const kiss_fft_cpx *freqdata,kiss_fft_scalar *timedata);
+/*
+ input freqdata has  nfft/2+1 complex points
+ output timedata has nfft scalar points
+*/
+
+void KISS_FFT_API kiss_fftr_batch(kiss_fftr_cfg cfg,int howmany,
+        const kiss_fft_scalar *timedata,int in_dist,
+        kiss_fft_cpx *freqdata,int out_dist);
+/*
+ howmany independent real ffts with one cfg, run interleaved like kiss_fft_batch
+ (and, like it, one after another when nfft/2 has a codelet).
+ transform b reads timedata[b*in_dist + 0 .. nfft-1] (in_dist must be even,
+ overlapping segments are fine) and writes nfft/2+1 bins to freqdata[b*out_dist ...]
+*/
+
+void KISS_FFT_API kiss_fftr_windowed(kiss_fftr_cfg cfg,const kiss_fft_scalar *timedata,
+        const kiss_fft_scalar *window,kiss_fft_cpx *freqdata);
+/*
+ kiss_fftr of timedata[n] * window[n] (nfft window values, e.g. from
+ kiss_window_get; NULL is kiss_fftr).  The product is formed while the
+ input is packed into complex pairs, written to freqdata ahead of the
+ transform, so it takes no separate pass and no scratch buffer.
+*/
+
+void KISS_FFT_API kiss_fftr_batch_windowed(kiss_fftr_cfg cfg,int howmany,
+        const kiss_fft_scalar *timedata,int in_dist,const kiss_fft_scalar *window,
+        kiss_fft_cpx *freqdata,int out_dist);
+/*
+ kiss_fftr_batch with every transform windowed as in kiss_fftr_windowed.
+ out_dist must be at least nfft/2+1; in_dist may be odd when window is not NULL.
+*/
+
+#define kiss_fftr_free KISS_FFT_FREE
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,243 @@
+/*
+ *  Goertzel filter bank built on KISS FFT types.
+ *
+ *  SPDX-License-Identifier: BSD-3-Clause
+ *  See COPYING file for more information.
+ */
+
+#include "kiss_goertzel.h"
+#include "_kiss_fft_guts.h"
+
+#if defined(USE_SIMD) || defined(FIXED_POINT)
+# error "kiss_goertzel needs a float kiss_fft_scalar"
+#endif
+
+/*
+ Per frequency, with c = 2*cos(w) and w = 2*pi*f:
+
+   s[j] = (x[j] - s[j-2]) + c*s[j-1]
+
+ One recurrence over the whole block is a single dependency chain, so a
+ vector of frequencies waits a multiply and an add per sample whatever its
+ width.  The block is therefore cut into KG_SEGS segments, each run from a
+ zero state as its own chain, all chains interleaved in one loop.  If a
+ segment ends at sample e with end states s1 = s[e], s2 = s[e-1], its part
+ of the transform is
+
+   X_seg = exp(-i*w*e) * (s1 - exp(-i*w)*s2)
+         = exp(-i*w*e) * ((s1 - cos(w)*s2) + i*sin(w)*s2)
+
+ so the segments combine with one phase rotation each.  Segment m has
+ length L or L+1 (the first n % KG_SEGS get the extra sample) and starts
+ at m*L + min(m, n % KG_SEGS).
+
+ The coefficients are stored padded with zeros to a multiple of KG_PAD
+ (one SSE vector) so the vector kernels never need a tail loop.  Every
+ kernel does the same IEEE operations in the same order (no FMA) and the
+ combination is shared, which is what makes the levels bit-identical.
+ x[j] - s[j-2] is formed first so only the multiply and one add sit on
+ each chain.
+*/
+#define KG_PAD 4
+#define KG_SEGS 4
+
+struct kiss_goertzel_state{
+    int nfreqs;
+    int npad;                   /* nfreqs rounded up to KG_PAD */
+    int rot_n;                  /* block size the rotations are for, 0: none */
+    kiss_fft_scalar * coeff;    /* npad values: 2*cos(w) */
+    kiss_fft_scalar * s1;       /* KG_SEGS*npad segment end states s[e] */
+    kiss_fft_scalar * s2;       /* KG_SEGS*npad segment end states s[e-1] */
+    double * freq;              /* nfreqs frequencies, cycles/sample */
+    double * cw;                /* nfreqs values: cos(w), sin(w) */
+    double * sw;
+    double * rot_r;             /* KG_SEGS*nfreqs values: exp(-i*w*e) */
+    double * rot_i;
+};
+
+kiss_goertzel_cfg kiss_goertzel_alloc(int nfreqs,const double *freqs,void * mem,size_t * lenmem)
+{
+    int b;
+    kiss_goertzel_cfg st = NULL;
+    size_t memneeded;
+    int npad;
+    const double pi=3.14159265358979323846264338327;
+
+    if (nfreqs <= 0) {
+        KISS_FFT_ERROR("Goertzel bank needs at least one frequency.");
+        return NULL;
+    }
+    npad = (nfreqs + KG_PAD - 1) / KG_PAD * KG_PAD;
+
+    memneeded = sizeof(struct kiss_goertzel_state)
+        + sizeof(double) * (3 + 2 * KG_SEGS) * (size_t)nfreqs
+        + sizeof(kiss_fft_scalar) * (1 + 2 * KG_SEGS) * (size_t)npad;
+
+    if (lenmem == NULL) {
+        st = (kiss_goertzel_cfg) KISS_FFT_MALLOC (memneeded);
+    } else {
+        if (*lenmem >= memneeded)
+            st = (kiss_goertzel_cfg) mem;
+        *lenmem = memneeded;
+    }
+    if (!st)
+        return NULL;
+
+    st->nfreqs = nfreqs;
+    st->npad = npad;
+    st->rot_n = 0;
+    st->freq = (double *) (st + 1); /*just beyond kiss_goertzel_state struct */
+    st->cw = st->freq + nfreqs;
+    st->sw = st->cw + nfreqs;
+    st->rot_r = st->sw + nfreqs;
+    st->rot_i = st->rot_r + KG_SEGS * nfreqs;
+    st->coeff = (kiss_fft_scalar *) (st->rot_i + KG_SEGS * nfreqs);
+    st->s1 = st->coeff + npad;
+    st->s2 = st->s1 + KG_SEGS * npad;
+
+    for (b = 0; b < npad; ++b)
+        st->coeff[b] = b < nfreqs ? (kiss_fft_scalar) (2 * cos(2 * pi * freqs[b])) : 0;
+    for (b = 0; b < nfreqs; ++b) {
+        st->freq[b] = freqs[b];
+        st->cw[b] = cos(2 * pi * freqs[b]);
+        st->sw[b] = sin(2 * pi * freqs[b]);
+    }
+    return st;
+}
+
+/* exp(-i*w*e) for the end sample e of every segment of an n-point block */
+static void kg_rotations(kiss_goertzel_cfg st,int n)
+{
+    const double pi=3.14159265358979323846264338327;
+    const int len = n / KG_SEGS, extra = n % KG_SEGS;
+    int b, m;
+    for (m = 0; m < KG_SEGS; ++m) {
+        const int end = (m + 1) * len + (m + 1 < extra ? m + 1 : extra) - 1;
+        for (b = 0; b < st->nfreqs; ++b) {
+            /* reduce f*e to a fraction of a turn before scaling by 2*pi */
+            double turns = st->freq[b] * end;
+            turns -= floor(turns);
+            st->rot_r[m * st->nfreqs + b] = cos(2 * pi * turns);
+            st->rot_i[m * st->nfreqs + b] = -sin(2 * pi * turns);
+        }
+    }
+    st->rot_n = n;
+}
+
+static void kg_bank_scalar(const kiss_fft_scalar *coeff,const kiss_fft_scalar *x,int n,
+        kiss_fft_scalar *s1out,kiss_fft_scalar *s2out,int npad,int nb)
+{
+    const int len = n / KG_SEGS, extra = n % KG_SEGS;
+    int b, j, m;
+    for (m = 0; m < KG_SEGS; ++m) {
+        const kiss_fft_scalar *xm = x + m * len + (m < extra ? m : extra);
+        const int mlen = len + (m < extra);
+        for (b = 0; b < nb; ++b) {
+            const kiss_fft_scalar c = coeff[b];
+            kiss_fft_scalar s0, s1 = 0, s2 = 0;
+            for (j = 0; j < mlen; ++j) {
+                s0 = (xm[j] - s2) + c * s1;
+                s2 = s1;
+                s1 = s0;
+            }
+            s1out[m * npad + b] = s1;
+            s2out[m * npad + b] = s2;
+        }
+    }
+}
+
+#ifdef KISS_FFT_RUNTIME_SIMD
+#include <immintrin.h>
+
+/* One vector of frequencies over the KG_SEGS = 4 segments (x0..x3, len
+   samples each, the first 'extra' of them one more).  The four chains are
+   kept in named registers and stepped side by side; being independent,
+   they overlap each other's multiply-add latency. */
+#define KG_STEP(T, add, sub, mul, set1, c, s1, s2, xj) do { \
+        const T s0_ = add(sub(set1(xj), s2), mul(c, s1)); \
+        s2 = s1; s1 = s0_; } while (0)
+
+#define KG_GROUP(T, load, store, zero, add, sub, mul, set1) do { \
+        const T c = load(coeff + b); \
+        T s1a = zero(), s2a = zero(), s1b = zero(), s2b = zero(); \
+        T s1c = zero(), s2c = zero(), s1d = zero(), s2d = zero(); \
+        for (j = 0; j < len; ++j) { \
+            KG_STEP(T, add, sub, mul, set1, c, s1a, s2a, x0[j]); \
+            KG_STEP(T, add, sub, mul, set1, c, s1b, s2b, x1[j]); \
+            KG_STEP(T, add, sub, mul, set1, c, s1c, s2c, x2[j]); \
+            KG_STEP(T, add, sub, mul, set1, c, s1d, s2d, x3[j]); \
+        } \
+        if (extra > 0) KG_STEP(T, add, sub, mul, set1, c, s1a, s2a, x0[len]); \
+        if (extra > 1) KG_STEP(T, add, sub, mul, set1, c, s1b, s2b, x1[len]); \
+        if (extra > 2) KG_STEP(T, add, sub, mul, set1, c, s1c, s2c, x2[len]); \
+        store(s1out + b, s1a); store(s2out + b, s2a); \
+        store(s1out + npad + b, s1b); store(s2out + npad + b, s2b); \
+        store(s1out + 2 * npad + b, s1c); store(s2out + 2 * npad + b, s2c); \
+        store(s1out + 3 * npad + b, s1d); store(s2out + 3 * npad + b, s2d); \
+    } while (0)
+
+#define KG_SEGMENTS \
+    const int len = n / KG_SEGS, extra = n % KG_SEGS; \
+    const kiss_fft_scalar *x0 = x; \
+    const kiss_fft_scalar *x1 = x0 + len + (extra > 0); \
+    const kiss_fft_scalar *x2 = x1 + len + (extra > 1); \
+    const kiss_fft_scalar *x3 = x2 + len + (extra > 2)
+
+/* 4 frequencies per vector */
+static KF_ATTR_TARGET("sse2") void kg_bank_sse2(const kiss_fft_scalar *coeff,
+        const kiss_fft_scalar *x,int n,kiss_fft_scalar *s1out,kiss_fft_scalar *s2out,int npad)
+{
+    KG_SEGMENTS;
+    int b, j;
+    for (b = 0; b < npad; b += 4)
+        KG_GROUP(__m128, _mm_loadu_ps, _mm_storeu_ps, _mm_setzero_ps,
+                 _mm_add_ps, _mm_sub_ps, _mm_mul_ps, _mm_set1_ps);
+}
+
+/* 8 frequencies per vector; a last group of 4 runs in SSE width rather
+   than padded to 8 */
+static KF_ATTR_TARGET("avx2") void kg_bank_avx2(const kiss_fft_scalar *coeff,
+        const kiss_fft_scalar *x,int n,kiss_fft_scalar *s1out,kiss_fft_scalar *s2out,int npad)
+{
+    KG_SEGMENTS;
+    int b, j;
+    for (b = 0; b + 8 <= npad; b += 8)
+        KG_GROUP(__m256, _mm256_loadu_ps, _mm256_storeu_ps, _mm256_setzero_ps,
+                 _mm256_add_ps, _mm256_sub_ps, _mm256_mul_ps, _mm256_set1_ps);
+    if (b < npad)
+        KG_GROUP(__m128, _mm_loadu_ps, _mm_storeu_ps, _mm_setzero_ps,
+                 _mm_add_ps, _mm_sub_ps, _mm_mul_ps, _mm_set1_ps);
+}
+#endif /* KISS_FFT_RUNTIME_SIMD */
+
+void kiss_goertzel_power(kiss_goertzel_cfg st,const kiss_fft_scalar *timedata,int n,kiss_fft_scalar *power)
+{
+    int b, m;
+#ifdef KISS_FFT_RUNTIME_SIMD
+    const int level = kiss_fft_simd_level();
+    if (level >= KISS_FFT_SIMD_AVX2)
+        kg_bank_avx2(st->coeff, timedata, n, st->s1, st->s2, st->npad);
+    else if (level >= KISS_FFT_SIMD_SSE2)
+        kg_bank_sse2(st->coeff, timedata, n, st->s1, st->s2, st->npad);
+    else
+#endif
+        kg_bank_scalar(st->coeff, timedata, n, st->s1, st->s2, st->npad, st->nfreqs);
+
+    if (st->rot_n != n)
+        kg_rotations(st, n);
+
+    for (b = 0; b < st->nfreqs; ++b) {
+        double xr = 0, xi = 0;
+        for (m = 0; m < KG_SEGS; ++m) {
+            const double s1 = st->s1[m * st->npad + b];
+            const double s2 = st->s2[m * st->npad + b];
+            const double ar = s1 - st->cw[b] * s2;
+            const double ai = st->sw[b] * s2;
+            const double rr = st->rot_r[m * st->nfreqs + b];
+            const double ri = st->rot_i[m * st->nfreqs + b];
+            xr += ar * rr - ai * ri;
+            xi += ar * ri + ai * rr;
+        }
+        power[b] = (kiss_fft_scalar) (xr * xr + xi * xi);
+    }
+}
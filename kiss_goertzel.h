@@ -0,0 +1,56 @@
+/*
+ *  Goertzel filter bank built on KISS FFT types.
+ *
+ *  SPDX-License-Identifier: BSD-3-Clause
+ *  See COPYING file for more information.
+ */
+
+#ifndef KISS_GOERTZEL_H
+#define KISS_GOERTZEL_H
+
+#include "kiss_fft.h"
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/*
+
+ Power of a block of n real samples at a few chosen frequencies,
+
+   P[b] = | sum_{j=0}^{n-1} x[j] * exp(-2*pi*i * j * f[b]) |^2
+
+ with f[b] in cycles/sample (Hz / sample rate), not restricted to FFT bins.
+ For f = k/n this is |X[k]|^2 of kiss_fftr.  Each frequency costs one
+ multiply and two adds per sample.  The block is cut into 4 segments run
+ as independent recurrences, so the frequencies in a SIMD vector do not
+ wait on one multiply-add chain.  At n = 512 with AVX2, 4 frequencies
+ take about half a kiss_fftr and 13 about the same; against a windowed
+ spectrum plus Welch PSD the bank costs 0.14x at 4 and 0.6x at 32 (see
+ fft_bench).  The frequencies are run side by side in the SSE2/AVX2 lanes
+ picked by kiss_fft_simd_level(); every level gives bit-identical
+ results.  Meant for float builds.
+
+ */
+
+typedef struct kiss_goertzel_state *kiss_goertzel_cfg;
+
+
+kiss_goertzel_cfg KISS_FFT_API kiss_goertzel_alloc(int nfreqs,const double *freqs,void * mem,size_t * lenmem);
+/*
+ nfreqs frequencies freqs[0..nfreqs-1], in cycles/sample.
+ mem/lenmem work as for kiss_fft_alloc; the result is freed with kiss_goertzel_free.
+ The cfg holds its own state, so it must not be shared between threads.
+*/
+
+void KISS_FFT_API kiss_goertzel_power(kiss_goertzel_cfg cfg,const kiss_fft_scalar *timedata,int n,kiss_fft_scalar *power);
+/*
+ input timedata has n scalar points, output power has nfreqs values
+*/
+
+#define kiss_goertzel_free KISS_FFT_FREE
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,162 @@
+/*
+ *  Noise floor estimates (order statistics of a spectrum) in linear time,
+ *  for KISS FFT spectra.
+ *
+ *  SPDX-License-Identifier: BSD-3-Clause
+ *  See COPYING file for more information.
+ */
+
+#include "kiss_noise.h"
+#include "_kiss_fft_guts.h"
+#include <stdint.h>
+
+#if defined(USE_SIMD) || defined(FIXED_POINT)
+# error "kiss_noise needs a float kiss_fft_scalar"
+#endif
+
+/* histogram slots: bits 30..19 of a positive float are its exponent and
+   the top 4 bits of its mantissa, 16 slots per octave */
+#define KN_SLOT_SHIFT   19
+#define KN_SLOT_FIRST   ((127 - 40) << 4)       /* 2^-40 */
+#define KN_SLOTS        (64 << 4)               /* up to 2^24 */
+
+static void kf_noise_swap(kiss_fft_scalar *x,int i,int j)
+{
+    kiss_fft_scalar t = x[i];
+    x[i] = x[j];
+    x[j] = t;
+}
+
+/* the median of the medians of groups of five, gathered at the front of x */
+static kiss_fft_scalar kf_noise_mom(kiss_fft_scalar *x,int n)
+{
+    int g, i, j, len, ng = 0;
+    kiss_fft_scalar t;
+
+    for (g = 0; g < n; g += 5) {
+        len = n - g < 5 ? n - g : 5;
+        for (i = g + 1; i < g + len; ++i) {
+            t = x[i];
+            for (j = i; j > g && x[j - 1] > t; --j)
+                x[j] = x[j - 1];
+            x[j] = t;
+        }
+        kf_noise_swap(x, ng++, g + len / 2);
+    }
+    return kiss_noise_select(x, ng, ng / 2);
+}
+
+kiss_fft_scalar kiss_noise_select(kiss_fft_scalar *x,int n,int k)
+{
+    int lo = 0, hi = n - 1, lt, gt, i, span = n, misses = 0;
+    kiss_fft_scalar p, a, b, c;
+
+    if (n < 1)
+        return 0;
+    if (k < 0)
+        k = 0;
+    if (k > n - 1)
+        k = n - 1;
+
+    /* median-of-3 pivots until two rounds in a row fail to halve the range;
+       median-of-medians pivots then cut it to 7/10 a round until it has */
+    while (hi > lo) {
+        if (misses < 2) {
+            a = x[lo];
+            b = x[lo + (hi - lo) / 2];
+            c = x[hi];
+            p = a < b ? (b < c ? b : (a < c ? c : a)) : (a < c ? a : (b < c ? c : b));
+        } else {
+            p = kf_noise_mom(x + lo, hi - lo + 1);
+        }
+
+        /* three ways, so runs of equal values (zeroed bins) end it at once:
+           [lo, lt) < p, [lt, gt] == p, (gt, hi] > p */
+        lt = lo;
+        gt = hi;
+        i = lo;
+        while (i <= gt) {
+            if (x[i] < p)
+                kf_noise_swap(x, lt++, i++);
+            else if (x[i] > p)
+                kf_noise_swap(x, i, gt--);
+            else
+                ++i;
+        }
+
+        if (k < lt)
+            hi = lt - 1;
+        else if (k > gt)
+            lo = gt + 1;
+        else
+            return p;
+
+        if (hi - lo + 1 <= span / 2) {
+            span = hi - lo + 1;
+            misses = 0;
+        } else {
+            ++misses;
+        }
+    }
+    return x[k];
+}
+
+static int kf_noise_rank(int n,double fraction)
+{
+    if (fraction < 0)
+        fraction = 0;
+    if (fraction > 1)
+        fraction = 1;
+    return (int) floor(fraction * (n - 1) + 0.5);
+}
+
+kiss_fft_scalar kiss_noise_percentile(const kiss_fft_scalar *x,int n,double fraction,
+        kiss_fft_scalar *work)
+{
+    if (n < 1)
+        return 0;
+    if (work != x)
+        memcpy(work, x, sizeof(kiss_fft_scalar) * (size_t)n);
+    return kiss_noise_select(work, n, kf_noise_rank(n, fraction));
+}
+
+static kiss_fft_scalar kf_noise_slot_value(int slot)
+{
+    uint32_t bits = (uint32_t) (slot + KN_SLOT_FIRST) << KN_SLOT_SHIFT;
+    kiss_fft_scalar v;
+
+    memcpy(&v, &bits, sizeof(v));
+    return v;
+}
+
+kiss_fft_scalar kiss_noise_hist(const kiss_fft_scalar *x,int n,double fraction)
+{
+    unsigned hist[KN_SLOTS];
+    int32_t bits;
+    int i, slot, rank, below = 0;
+    kiss_fft_scalar lo, hi;
+
+    if (n < 1)
+        return 0;
+
+    memset(hist, 0, sizeof(hist));
+    for (i = 0; i < n; ++i) {
+        memcpy(&bits, &x[i], sizeof(bits));
+        /* negative values have the sign bit set and go to the first slot */
+        slot = bits < 0 ? 0 : (int) (bits >> KN_SLOT_SHIFT) - KN_SLOT_FIRST;
+        if (slot < 0)
+            slot = 0;
+        if (slot > KN_SLOTS - 1)
+            slot = KN_SLOTS - 1;
+        hist[slot]++;
+    }
+
+    rank = kf_noise_rank(n, fraction);
+    for (slot = 0; slot < KN_SLOTS - 1 && below + (int) hist[slot] <= rank; ++slot)
+        below += hist[slot];
+
+    /* spread the slot's values evenly across it */
+    lo = kf_noise_slot_value(slot);
+    hi = kf_noise_slot_value(slot + 1);
+    return lo + (hi - lo) * (kiss_fft_scalar) ((rank - below + 0.5) / (hist[slot] ? hist[slot] : 1));
+}
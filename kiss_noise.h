@@ -0,0 +1,61 @@
+/*
+ *  Noise floor estimates (order statistics of a spectrum) in linear time,
+ *  for KISS FFT spectra.
+ *
+ *  SPDX-License-Identifier: BSD-3-Clause
+ *  See COPYING file for more information.
+ */
+
+#ifndef KISS_NOISE_H
+#define KISS_NOISE_H
+
+#include "kiss_fft.h"
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/*
+
+ A median or low percentile of the bins reads the noise under a spectrum
+ with tones in it; the mean is pulled up by every tone.  Two ways to get
+ one without sorting, neither allocating (the histogram takes 4 KB of
+ stack):
+
+   kiss_noise_select      introselect: quickselect with median-of-3
+                          pivots, switching to median-of-medians pivots
+                          when two rounds in a row fail to halve the
+                          range, so O(n) even on adversarial input.
+                          Exact; reorders its input.
+   kiss_noise_hist        a histogram of 16 slots per octave (0.27 to
+                          0.53 dB wide) indexed by the top bits of each
+                          float, so there is no log per bin.  Within a
+                          slot of the exact value; leaves its input
+                          alone.  Positive values between 2^-40 and 2^24
+                          are resolved; smaller ones land in the first
+                          slot, larger ones in the last.
+
+ */
+
+kiss_fft_scalar KISS_FFT_API kiss_noise_select(kiss_fft_scalar *x,int n,int k);
+/*
+ the k-th smallest of x[0..n) (k from 0); x is reordered so that x[k]
+ holds it, smaller values come before and larger ones after
+*/
+
+kiss_fft_scalar KISS_FFT_API kiss_noise_percentile(const kiss_fft_scalar *x,int n,double fraction,
+        kiss_fft_scalar *work);
+/*
+ The fraction quantile of x (0.5 for the median), from kiss_noise_select
+ on a copy in work (n values; work may be x to reorder x itself).
+*/
+
+kiss_fft_scalar KISS_FFT_API kiss_noise_hist(const kiss_fft_scalar *x,int n,double fraction);
+/*
+ the fraction quantile of x from the histogram, interpolated within its slot
+*/
+
+#ifdef __cplusplus
+}
+#endif
+#endif
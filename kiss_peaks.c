@@ -0,0 +1,232 @@
+/*
+ *  Spectral peak picking with sub-bin interpolation, and peak tracks
+ *  followed from frame to frame, for KISS FFT spectra.
+ *
+ *  SPDX-License-Identifier: BSD-3-Clause
+ *  See COPYING file for more information.
+ */
+
+#include "kiss_peaks.h"
+#include "_kiss_fft_guts.h"
+
+#if defined(USE_SIMD) || defined(FIXED_POINT)
+# error "kiss_peaks needs a float kiss_fft_scalar"
+#endif
+
+struct kiss_peaks_state{
+    int nbins;
+    int max_peaks;
+    int max_tracks;
+    float max_jump;
+    int max_missed;
+    int ntracks;
+    int next_id;
+    kiss_peak * cand;           /* max_peaks values */
+    int * match;                /* max_peaks values: track taken by each peak, or -1 */
+    kiss_peak_track * tracks;   /* max_tracks values in frequency order */
+    kiss_peak_track * next;     /* max_tracks values: the tracks being rebuilt */
+    int * taken;                /* max_tracks values */
+};
+
+kiss_peaks_cfg kiss_peaks_alloc(int nbins,int max_peaks,int max_tracks,
+        float max_jump,int max_missed,void * mem,size_t * lenmem)
+{
+    kiss_peaks_cfg st = NULL;
+    size_t memneeded;
+
+    if (nbins < 3 || max_peaks < 1 || max_tracks < 1 || max_jump < 0 || max_missed < 0) {
+        KISS_FFT_ERROR("Peak tracker needs 3+ bins, room for a peak and a track, and no negative limits.");
+        return NULL;
+    }
+
+    memneeded = ((sizeof(struct kiss_peaks_state) + 15) & ~(size_t)15)
+        + sizeof(kiss_peak) * (size_t)max_peaks
+        + sizeof(kiss_peak_track) * 2 * (size_t)max_tracks
+        + sizeof(int) * ((size_t)max_peaks + max_tracks);
+
+    if (lenmem == NULL) {
+        st = (kiss_peaks_cfg) KISS_FFT_MALLOC (memneeded);
+    } else {
+        if (mem != NULL && *lenmem >= memneeded)
+            st = (kiss_peaks_cfg) mem;
+        *lenmem = memneeded;
+    }
+    if (!st)
+        return NULL;
+
+    st->nbins = nbins;
+    st->max_peaks = max_peaks;
+    st->max_tracks = max_tracks;
+    st->max_jump = max_jump;
+    st->max_missed = max_missed;
+    st->next_id = 0;
+    st->cand = (kiss_peak *) ((char *) st + ((sizeof(struct kiss_peaks_state) + 15) & ~(size_t)15));
+    st->tracks = (kiss_peak_track *) (st->cand + max_peaks);
+    st->next = st->tracks + max_tracks;
+    st->match = (int *) (st->next + max_tracks);
+    st->taken = st->match + max_peaks;
+
+    kiss_peaks_reset(st);
+    return st;
+}
+
+void kiss_peaks_reset(kiss_peaks_cfg st)
+{
+    st->ntracks = 0;
+}
+
+/* Quinn's tau(x) for the second estimator */
+static double kf_quinn_tau(double x)
+{
+    const double r = 0.816496580927726;     /* sqrt(2/3) */
+    return 0.25 * log(3 * x * x + 6 * x + 1)
+        - 0.102062072615966 * log((x + 1 - r) / (x + 1 + r));   /* sqrt(6)/24 */
+}
+
+static void kf_peak_place(const kiss_fft_scalar *mag,const kiss_fft_cpx *spec,
+        kiss_peaks_method method,kiss_peak *p)
+{
+    const int k = p->bin;
+    const double a = log(mag[k - 1] > 1e-30f ? mag[k - 1] : 1e-30f);
+    const double b = log(mag[k] > 1e-30f ? mag[k] : 1e-30f);
+    const double c = log(mag[k + 1] > 1e-30f ? mag[k + 1] : 1e-30f);
+    const double curve = a - 2 * b + c;
+    double d = curve < 0 ? 0.5 * (a - c) / curve : 0;
+    double pw, ap, am, dp, dm;
+
+    if (method == KISS_PEAKS_QUINN && spec) {
+        pw = (double) spec[k].r * spec[k].r + (double) spec[k].i * spec[k].i;
+        if (pw > 0) {
+            ap = ((double) spec[k + 1].r * spec[k].r + (double) spec[k + 1].i * spec[k].i) / pw;
+            am = ((double) spec[k - 1].r * spec[k].r + (double) spec[k - 1].i * spec[k].i) / pw;
+            dp = -ap / (1 - ap);
+            dm = am / (1 - am);
+            d = (dp + dm) / 2 + kf_quinn_tau(dp * dp) - kf_quinn_tau(dm * dm);
+        }
+    }
+    if (d > 1)
+        d = 1;
+    if (d < -1)
+        d = -1;
+
+    p->pos = (float) (k + d);
+    /* the log parabola, evaluated at the estimate */
+    p->mag = (float) exp(b + 0.5 * (c - a) * d + 0.5 * curve * d * d);
+}
+
+int kiss_peaks_find(kiss_peaks_cfg st,const kiss_fft_scalar *mag,const kiss_fft_cpx *spec,
+        kiss_fft_scalar threshold,kiss_peaks_method method,kiss_peak *peaks)
+{
+    int n = 0, weakest = 0, i, j, k;
+    kiss_peak t;
+
+    for (k = 1; k < st->nbins - 1; ++k) {
+        if (mag[k] <= threshold || mag[k] <= mag[k - 1] || mag[k] < mag[k + 1])
+            continue;
+
+        /* keep the strongest max_peaks, replacing the weakest when full */
+        if (n < st->max_peaks) {
+            i = n++;
+        } else if (mag[k] > st->cand[weakest].mag) {
+            i = weakest;
+        } else {
+            continue;
+        }
+        st->cand[i].bin = k;
+        st->cand[i].mag = mag[k];
+        if (n == st->max_peaks) {
+            weakest = 0;
+            for (j = 1; j < n; ++j)
+                if (st->cand[j].mag < st->cand[weakest].mag)
+                    weakest = j;
+        }
+    }
+
+    /* back into frequency order; replacements leave it nearly sorted */
+    for (i = 1; i < n; ++i) {
+        t = st->cand[i];
+        for (j = i; j > 0 && st->cand[j - 1].bin > t.bin; --j)
+            st->cand[j] = st->cand[j - 1];
+        st->cand[j] = t;
+    }
+    for (i = 0; i < n; ++i) {
+        peaks[i] = st->cand[i];
+        kf_peak_place(mag, spec, method, &peaks[i]);
+    }
+    return n;
+}
+
+int kiss_peaks_track(kiss_peaks_cfg st,const kiss_peak *peaks,int npeaks)
+{
+    kiss_peak_track * tr = st->tracks;
+    kiss_peak_track t;
+    int j0 = 0, best, nnext = 0, i, j;
+    float dist, best_dist;
+
+    if (npeaks > st->max_peaks)
+        npeaks = st->max_peaks;
+    for (j = 0; j < st->ntracks; ++j)
+        st->taken[j] = 0;
+
+    /* both lists ascend, so the tracks within reach of a peak are a window
+       that only moves up */
+    for (i = 0; i < npeaks; ++i) {
+        while (j0 < st->ntracks && tr[j0].pos < peaks[i].pos - st->max_jump)
+            ++j0;
+        best = -1;
+        best_dist = 0;
+        for (j = j0; j < st->ntracks && tr[j].pos <= peaks[i].pos + st->max_jump; ++j) {
+            dist = (float) fabs(tr[j].pos - peaks[i].pos);
+            if (!st->taken[j] && (best < 0 || dist < best_dist)) {
+                best = j;
+                best_dist = dist;
+            }
+        }
+        st->match[i] = best;
+        if (best >= 0)
+            st->taken[best] = 1;
+    }
+
+    /* surviving tracks carry over; taken[] becomes the slot + 1 of a matched one */
+    for (j = 0; j < st->ntracks; ++j) {
+        if (st->taken[j] || tr[j].missed < st->max_missed) {
+            st->next[nnext] = tr[j];
+            st->next[nnext].age++;
+            st->next[nnext].missed = st->taken[j] ? 0 : tr[j].missed + 1;
+            if (st->taken[j])
+                st->taken[j] = nnext + 1;
+            nnext++;
+        }
+    }
+    for (i = 0; i < npeaks; ++i) {
+        if (st->match[i] >= 0) {
+            j = st->taken[st->match[i]] - 1;
+            st->next[j].pos = peaks[i].pos;
+            st->next[j].mag = peaks[i].mag;
+        } else if (nnext < st->max_tracks) {
+            st->next[nnext].id = st->next_id++;
+            st->next[nnext].pos = peaks[i].pos;
+            st->next[nnext].mag = peaks[i].mag;
+            st->next[nnext].age = 0;
+            st->next[nnext].missed = 0;
+            nnext++;
+        }
+    }
+
+    /* moved tracks and new ones go back into frequency order */
+    for (i = 1; i < nnext; ++i) {
+        t = st->next[i];
+        for (j = i; j > 0 && st->next[j - 1].pos > t.pos; --j)
+            st->next[j] = st->next[j - 1];
+        st->next[j] = t;
+    }
+    memcpy(st->tracks, st->next, sizeof(kiss_peak_track) * (size_t)nnext);
+    st->ntracks = nnext;
+    return nnext;
+}
+
+const kiss_peak_track * kiss_peaks_tracks(kiss_peaks_cfg st,int *ntracks)
+{
+    *ntracks = st->ntracks;
+    return st->tracks;
+}
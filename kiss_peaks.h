@@ -0,0 +1,100 @@
+/*
+ *  Spectral peak picking with sub-bin interpolation, and peak tracks
+ *  followed from frame to frame, for KISS FFT spectra.
+ *
+ *  SPDX-License-Identifier: BSD-3-Clause
+ *  See COPYING file for more information.
+ */
+
+#ifndef KISS_PEAKS_H
+#define KISS_PEAKS_H
+
+#include "kiss_fft.h"
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/*
+
+ kiss_peaks_find picks the local maxima of a magnitude spectrum that lie
+ above a threshold (mag[k-1] < mag[k] >= mag[k+1]), keeps the strongest
+ max_peaks of them and places each between bins:
+
+   KISS_PEAKS_PARABOLIC   a parabola through the log magnitudes of bins
+                          k-1, k, k+1 (works for any window; the error
+                          is about 0.05 bin with Hann, more with no window)
+   KISS_PEAKS_QUINN       Quinn's second estimator on the complex bins
+                          k-1, k, k+1 (unbiased for an unwindowed tone;
+                          needs the complex spectrum)
+
+ The scan does one comparison per bin below the threshold; everything
+ else costs per peak.
+
+ kiss_peaks_track then matches the frame's peaks to the tracks of earlier
+ frames.  Peaks and tracks are both kept in frequency order and walked
+ together, each peak taking the nearest free track within max_jump bins,
+ so association is linear in peaks + tracks.  A peak left over starts a
+ new track with a new id; a track left over coasts, and is dropped after
+ max_missed frames in a row without a peak.
+
+ */
+
+typedef struct kiss_peaks_state *kiss_peaks_cfg;
+
+typedef enum {
+    KISS_PEAKS_PARABOLIC = 0,
+    KISS_PEAKS_QUINN
+} kiss_peaks_method;
+
+typedef struct {
+    int bin;                    /* local maximum */
+    float pos;                  /* interpolated position, in bins */
+    float mag;                  /* interpolated magnitude */
+} kiss_peak;
+
+typedef struct {
+    int id;                     /* unique over the life of the cfg */
+    float pos;                  /* position in bins of the last matched peak */
+    float mag;                  /* its magnitude */
+    int age;                    /* frames since the track started */
+    int missed;                 /* frames since it last matched a peak */
+} kiss_peak_track;
+
+kiss_peaks_cfg KISS_FFT_API kiss_peaks_alloc(int nbins,int max_peaks,int max_tracks,
+        float max_jump,int max_missed,void * mem,size_t * lenmem);
+/*
+ spectra of nbins bins, at most max_peaks peaks per frame and max_tracks tracks.
+ mem/lenmem work as for kiss_fft_alloc; the result is freed with kiss_peaks_free.
+*/
+
+int KISS_FFT_API kiss_peaks_find(kiss_peaks_cfg cfg,const kiss_fft_scalar *mag,const kiss_fft_cpx *spec,
+        kiss_fft_scalar threshold,kiss_peaks_method method,kiss_peak *peaks);
+/*
+ Writes the peaks above threshold (bins 1..nbins-2) in frequency order
+ and returns how many.  spec is only read by KISS_PEAKS_QUINN (NULL
+ otherwise falls back to KISS_PEAKS_PARABOLIC).
+*/
+
+int KISS_FFT_API kiss_peaks_track(kiss_peaks_cfg cfg,const kiss_peak *peaks,int npeaks);
+/*
+ Feeds one frame's peaks (in frequency order, as kiss_peaks_find gives
+ them) and returns the number of live tracks.
+*/
+
+const kiss_peak_track * KISS_FFT_API kiss_peaks_tracks(kiss_peaks_cfg cfg,int *ntracks);
+/*
+ the live tracks in frequency order; valid until the next kiss_peaks_track
+*/
+
+void KISS_FFT_API kiss_peaks_reset(kiss_peaks_cfg cfg);
+/*
+ drops every track (ids keep counting up)
+*/
+
+#define kiss_peaks_free KISS_FFT_FREE
+
+#ifdef __cplusplus
+}
+#endif
+#endif
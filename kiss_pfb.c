@@ -0,0 +1,175 @@
+/*
+ *  Polyphase filter bank channelizer built on KISS FFT.
+ *
+ *  SPDX-License-Identifier: BSD-3-Clause
+ *  See COPYING file for more information.
+ */
+
+#include "kiss_pfb.h"
+#include "kiss_fftr.h"
+#include "_kiss_fft_guts.h"
+
+#ifdef USE_SIMD
+# error "kiss_pfb needs a scalar kiss_fft_scalar (USE_SIMD packs four transforms per value)"
+#endif
+
+/*
+ With the prototype zero padded to L = P*nchan taps and stored reversed
+ (hr[i] = h[L-1-i]) next to a history of the last L inputs (oldest first),
+ the tap pairing with hist[i] is l = L-1-i, and the channel phase
+ exp(-2*pi*i*k*(n-l)/nchan) only depends on (i + n + 1) mod nchan.  So a
+ hop sums the P products of each branch j, rotates the nchan sums by
+ c = (n+1) mod nchan and takes one real FFT of them.
+*/
+struct kiss_pfb_state{
+    int nchan;
+    int decim;
+    int ntaps;                  /* L: prototype length rounded up to a multiple of nchan */
+    int fill;                   /* samples waiting in pend */
+    int phase;                  /* number of inputs consumed, mod nchan */
+    kiss_fftr_cfg fft;
+    kiss_fft_scalar * taps;     /* L values: the prototype, reversed */
+    kiss_fft_scalar * hist;     /* L values: the latest inputs, oldest first */
+    kiss_fft_scalar * pend;     /* decim values: inputs of the hop in progress */
+    kiss_fft_scalar * branch;   /* nchan values of scratch */
+    kiss_fft_scalar * rot;      /* nchan values of scratch */
+};
+
+/* Blackman windowed sinc with cutoff 1/(2*nchan) cycles/sample and unit DC gain */
+static void kf_pfb_design(kiss_fft_scalar *h,int ntaps,int nchan)
+{
+    const double pi=3.14159265358979323846264338327;
+    const double fc = 0.5 / nchan;
+    const double mid = 0.5 * (ntaps - 1);
+    double sum = 0, t, w, v;
+    int j;
+
+    for (j = 0; j < ntaps; ++j) {
+        t = j - mid;
+        v = t == 0 ? 2 * fc : sin(2 * pi * fc * t) / (pi * t);
+        w = ntaps > 1 ? 0.42 - 0.5 * cos(2 * pi * j / (ntaps - 1))
+                        + 0.08 * cos(4 * pi * j / (ntaps - 1)) : 1;
+        h[j] = (kiss_fft_scalar) (v * w);
+        sum += v * w;
+    }
+    for (j = 0; j < ntaps; ++j)
+        h[j] = (kiss_fft_scalar) (h[j] / sum);
+}
+
+kiss_pfb_cfg kiss_pfb_alloc(int nchan,int decim,const kiss_fft_scalar *proto,int ntaps,void * mem,size_t * lenmem)
+{
+    kiss_pfb_cfg st = NULL;
+    size_t fftsize = 0, memneeded;
+    int len, j;
+
+    if (nchan < 2 || (nchan & 1)) {
+        KISS_FFT_ERROR("Channelizer needs an even number of channels.");
+        return NULL;
+    }
+    if (decim < 1 || decim > nchan) {
+        KISS_FFT_ERROR("Channelizer decimation must be between 1 and the number of channels.");
+        return NULL;
+    }
+    if (ntaps <= 0) {
+        if (proto) {
+            KISS_FFT_ERROR("Channelizer prototype needs at least one tap.");
+            return NULL;
+        }
+        ntaps = 8 * nchan;
+    }
+    len = (ntaps + nchan - 1) / nchan * nchan;
+
+    kiss_fftr_alloc(nchan, 0, NULL, &fftsize);
+    fftsize = (fftsize + 15) & ~(size_t)15;
+    memneeded = ((sizeof(struct kiss_pfb_state) + 15) & ~(size_t)15) + fftsize
+        + sizeof(kiss_fft_scalar) * (2 * (size_t)len + (size_t)decim + 2 * (size_t)nchan);
+
+    if (lenmem == NULL) {
+        st = (kiss_pfb_cfg) KISS_FFT_MALLOC (memneeded);
+    } else {
+        if (mem != NULL && *lenmem >= memneeded)
+            st = (kiss_pfb_cfg) mem;
+        *lenmem = memneeded;
+    }
+    if (!st)
+        return NULL;
+
+    st->nchan = nchan;
+    st->decim = decim;
+    st->ntaps = len;
+    st->fft = (kiss_fftr_cfg) ((char *) st + ((sizeof(struct kiss_pfb_state) + 15) & ~(size_t)15));
+    st->taps = (kiss_fft_scalar *) ((char *) st->fft + fftsize);
+    st->hist = st->taps + len;
+    st->pend = st->hist + len;
+    st->branch = st->pend + decim;
+    st->rot = st->branch + nchan;
+    kiss_fftr_alloc(nchan, 0, st->fft, &fftsize);
+
+    /* design into hist, which is cleared below anyway */
+    memset(st->hist, 0, sizeof(kiss_fft_scalar) * len);
+    if (proto)
+        memcpy(st->hist, proto, sizeof(kiss_fft_scalar) * ntaps);
+    else
+        kf_pfb_design(st->hist, ntaps, nchan);
+    for (j = 0; j < len; ++j)
+        st->taps[j] = st->hist[len - 1 - j];
+
+    kiss_pfb_reset(st);
+    return st;
+}
+
+void kiss_pfb_reset(kiss_pfb_cfg st)
+{
+    memset(st->hist, 0, sizeof(kiss_fft_scalar) * st->ntaps);
+    st->fill = 0;
+    st->phase = 0;
+}
+
+static void kf_pfb_hop(kiss_pfb_cfg st,kiss_fft_cpx *out)
+{
+    const int nchan = st->nchan;
+    const int len = st->ntaps;
+    const kiss_fft_scalar *h = st->taps;
+    const kiss_fft_scalar *x = st->hist;
+    kiss_fft_scalar *u = st->branch;
+    int c, j, p;
+
+    memmove(st->hist, st->hist + st->decim, sizeof(kiss_fft_scalar) * (len - st->decim));
+    memcpy(st->hist + len - st->decim, st->pend, sizeof(kiss_fft_scalar) * st->decim);
+    st->phase = (st->phase + st->decim) % nchan;
+
+    for (j = 0; j < nchan; ++j)
+        u[j] = h[j] * x[j];
+    for (p = nchan; p < len; p += nchan)
+        for (j = 0; j < nchan; ++j)
+            u[j] += h[p + j] * x[p + j];
+
+    /* the newest input has index phase-1, so branch j lands at (j + phase) mod nchan */
+    c = st->phase;
+    memcpy(st->rot + c, u, sizeof(kiss_fft_scalar) * (nchan - c));
+    memcpy(st->rot, u + nchan - c, sizeof(kiss_fft_scalar) * c);
+
+    kiss_fftr(st->fft, st->rot, out);
+}
+
+int kiss_pfb(kiss_pfb_cfg st,const kiss_fft_scalar *in,int n,kiss_fft_cpx *out)
+{
+    const int nout = st->nchan / 2 + 1;
+    int hops = 0, m;
+
+    while (n > 0) {
+        m = st->decim - st->fill;
+        if (m > n)
+            m = n;
+        memcpy(st->pend + st->fill, in, sizeof(kiss_fft_scalar) * m);
+        st->fill += m;
+        in += m;
+        n -= m;
+        if (st->fill == st->decim) {
+            kf_pfb_hop(st, out + (size_t)hops * nout);
+            st->fill = 0;
+            ++hops;
+        }
+    }
+    return hops;
+}
@@ -0,0 +1,66 @@
+/*
+ *  Polyphase filter bank channelizer built on KISS FFT.
+ *
+ *  SPDX-License-Identifier: BSD-3-Clause
+ *  See COPYING file for more information.
+ */
+
+#ifndef KISS_PFB_H
+#define KISS_PFB_H
+
+#include "kiss_fft.h"
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/*
+
+ Splits a real input stream into nchan channels centred on k/nchan
+ cycles/sample, each mixed down to baseband, lowpass filtered by the
+ prototype h and decimated by decim:
+
+   y_k[m] = sum_{l=0}^{L-1} h[l] * x[n-l] * exp(-2*pi*i * k*(n-l) / nchan),   n = m*decim + decim-1
+
+ For real input only channels 0..nchan/2 are distinct, so those are the
+ ones returned.  Every hop of decim input samples costs one pass over the
+ L prototype taps (folded into nchan polyphase branches) and one
+ kiss_fftr of size nchan, instead of L multiplies per channel.
+ decim == nchan is critically sampled; decim == nchan/2 is 2x
+ oversampled, which keeps band edges between channels usable.  A tone at
+ a channel centre with amplitude A comes out as A/2 times the prototype's
+ DC gain.  Meant for float builds.
+
+ */
+
+typedef struct kiss_pfb_state *kiss_pfb_cfg;
+
+
+kiss_pfb_cfg KISS_FFT_API kiss_pfb_alloc(int nchan,int decim,const kiss_fft_scalar *proto,int ntaps,void * mem,size_t * lenmem);
+/*
+ nchan channels (even), one output per decim input samples (1 <= decim <= nchan).
+ proto holds ntaps prototype coefficients; if proto is NULL a windowed-sinc
+ lowpass of ntaps taps (8*nchan if ntaps <= 0) with cutoff 1/(2*nchan) and
+ unit DC gain is designed.
+ mem/lenmem work as for kiss_fft_alloc; the result is freed with kiss_pfb_free.
+ The cfg holds the input history, so it must not be shared between threads.
+*/
+
+int KISS_FFT_API kiss_pfb(kiss_pfb_cfg cfg,const kiss_fft_scalar *in,int n,kiss_fft_cpx *out);
+/*
+ Feeds n input samples and returns the number of hops completed, at most
+ n/decim + 1.  Hop h writes channels 0..nchan/2 to out[h*(nchan/2+1) ...].
+ Samples that do not complete a hop are kept for the next call.
+*/
+
+void KISS_FFT_API kiss_pfb_reset(kiss_pfb_cfg cfg);
+/*
+ clears the input history (as if all earlier input were zero)
+*/
+
+#define kiss_pfb_free KISS_FFT_FREE
+
+#ifdef __cplusplus
+}
+#endif
+#endif
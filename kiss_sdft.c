@@ -0,0 +1,145 @@
+/*
+ *  Sliding DFT built on KISS FFT.
+ *
+ *  SPDX-License-Identifier: BSD-3-Clause
+ *  See COPYING file for more information.
+ */
+
+#include "kiss_sdft.h"
+#include "_kiss_fft_guts.h"
+
+#if defined(USE_SIMD) || defined(FIXED_POINT)
+# error "kiss_sdft needs a float kiss_fft_scalar"
+#endif
+
+/*
+ Dropping the oldest sample w[0] and appending x shifts every index down
+ by one, so
+
+   S'[k] = exp(2*pi*i*k/n) * (S[k] - w[0] + x)
+
+ The window is a ring buffer whose write position is also the oldest
+ sample; when it wraps to 0 the ring is in time order and the bins are
+ resynchronized with a direct DFT.
+*/
+struct kiss_sdft_state{
+    int n;
+    int nbins;
+    int pos;                    /* ring index of the oldest sample */
+    int * bins;                 /* nbins bin indices */
+    kiss_fft_cpx * rot;         /* nbins values: exp(2*pi*i*k/n) */
+    kiss_fft_cpx * value;       /* nbins current bin values */
+    kiss_fft_cpx * twiddles;    /* n values: exp(-2*pi*i*j/n), for resync */
+    kiss_fft_scalar * ring;     /* n samples */
+};
+
+kiss_sdft_cfg kiss_sdft_alloc(int n,int nbins,const int *bins,void * mem,size_t * lenmem)
+{
+    int j;
+    kiss_sdft_cfg st = NULL;
+    size_t memneeded;
+    const double pi=3.14159265358979323846264338327;
+
+    if (n <= 0 || nbins <= 0) {
+        KISS_FFT_ERROR("SDFT sizes must be positive.");
+        return NULL;
+    }
+    for (j = 0; j < nbins; ++j) {
+        if (bins[j] < 0 || bins[j] >= n) {
+            KISS_FFT_ERROR("SDFT bin index out of range.");
+            return NULL;
+        }
+    }
+
+    memneeded = sizeof(struct kiss_sdft_state)
+        + sizeof(kiss_fft_cpx) * (2 * (size_t)nbins + n)
+        + sizeof(kiss_fft_scalar) * (size_t)n
+        + sizeof(int) * (size_t)nbins;
+
+    if (lenmem == NULL) {
+        st = (kiss_sdft_cfg) KISS_FFT_MALLOC (memneeded);
+    } else {
+        if (*lenmem >= memneeded)
+            st = (kiss_sdft_cfg) mem;
+        *lenmem = memneeded;
+    }
+    if (!st)
+        return NULL;
+
+    st->n = n;
+    st->nbins = nbins;
+    st->rot = (kiss_fft_cpx *) (st + 1); /*just beyond kiss_sdft_state struct */
+    st->value = st->rot + nbins;
+    st->twiddles = st->value + nbins;
+    st->ring = (kiss_fft_scalar *) (st->twiddles + n);
+    st->bins = (int *) (st->ring + n);
+
+    for (j = 0; j < n; ++j)
+        kf_cexp(st->twiddles + j, -2 * pi * j / n);
+    for (j = 0; j < nbins; ++j) {
+        st->bins[j] = bins[j];
+        kf_cexp(st->rot + j, 2 * pi * bins[j] / n);
+    }
+
+    kiss_sdft_reset(st);
+    return st;
+}
+
+void kiss_sdft_reset(kiss_sdft_cfg st)
+{
+    st->pos = 0;
+    memset(st->value, 0, sizeof(kiss_fft_cpx) * st->nbins);
+    memset(st->ring, 0, sizeof(kiss_fft_scalar) * st->n);
+}
+
+/* direct DFT of the (time-ordered) ring, accumulated in double */
+static void kf_sdft_resync(kiss_sdft_cfg st)
+{
+    int b, j;
+    for (b = 0; b < st->nbins; ++b) {
+        const int k = st->bins[b];
+        double sr = 0, si = 0;
+        int idx = 0;
+        for (j = 0; j < st->n; ++j) {
+            sr += (double) st->ring[j] * st->twiddles[idx].r;
+            si += (double) st->ring[j] * st->twiddles[idx].i;
+            idx += k;
+            if (idx >= st->n)
+                idx -= st->n;
+        }
+        st->value[b].r = (kiss_fft_scalar) sr;
+        st->value[b].i = (kiss_fft_scalar) si;
+    }
+}
+
+void kiss_sdft_push(kiss_sdft_cfg st,kiss_fft_scalar x)
+{
+    const kiss_fft_scalar delta = x - st->ring[st->pos];
+    kiss_fft_cpx t;
+    int b;
+
+    st->ring[st->pos] = x;
+    if (++st->pos == st->n) {
+        st->pos = 0;
+        kf_sdft_resync(st);
+        return;
+    }
+
+    for (b = 0; b < st->nbins; ++b) {
+        t.r = st->value[b].r + delta;
+        t.i = st->value[b].i;
+        C_MUL(st->value[b], t, st->rot[b]);
+    }
+}
+
+void kiss_sdft_update(kiss_sdft_cfg st,const kiss_fft_scalar *x,int count)
+{
+    int j;
+    for (j = 0; j < count; ++j)
+        kiss_sdft_push(st, x[j]);
+}
+
+const kiss_fft_cpx * kiss_sdft_bins(kiss_sdft_cfg st)
+{
+    return st->value;
+}
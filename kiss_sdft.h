@@ -0,0 +1,70 @@
+/*
+ *  Sliding DFT built on KISS FFT.
+ *
+ *  SPDX-License-Identifier: BSD-3-Clause
+ *  See COPYING file for more information.
+ */
+
+#ifndef KISS_SDFT_H
+#define KISS_SDFT_H
+
+#include "kiss_fft.h"
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/*
+
+ Per-sample spectrum of a sliding n-point window, on a chosen set of bins.
+
+ After every pushed sample, bin k holds
+
+   S[k] = sum_{j=0}^{n-1} w[j] * exp(-2*pi*i * j * k / n)
+
+ where w is the last n samples, oldest first: the same value kiss_fftr
+ gives for bin k of that window.  Each sample costs O(nbins), independent
+ of n.  The recursion is exact in theory but drifts in floating point, so
+ every n samples the bins are recomputed directly from the window
+ (O(n*nbins) once per window, i.e. still O(nbins) per sample on average).
+ Meant for float builds.
+
+ */
+
+typedef struct kiss_sdft_state *kiss_sdft_cfg;
+
+
+kiss_sdft_cfg KISS_FFT_API kiss_sdft_alloc(int n,int nbins,const int *bins,void * mem,size_t * lenmem);
+/*
+ n-point window, nbins bins with indices bins[0..nbins-1] in 0..n-1.
+ mem/lenmem work as for kiss_fft_alloc; the result is freed with kiss_sdft_free.
+ The window starts out all zeros.
+*/
+
+void KISS_FFT_API kiss_sdft_push(kiss_sdft_cfg cfg,kiss_fft_scalar x);
+/*
+ slide the window by one sample and update every bin
+*/
+
+void KISS_FFT_API kiss_sdft_update(kiss_sdft_cfg cfg,const kiss_fft_scalar *x,int count);
+/*
+ kiss_sdft_push for count samples in order
+*/
+
+const kiss_fft_cpx * KISS_FFT_API kiss_sdft_bins(kiss_sdft_cfg cfg);
+/*
+ current value of every bin, in the order given to kiss_sdft_alloc.
+ The pointer stays valid for the life of the cfg.
+*/
+
+void KISS_FFT_API kiss_sdft_reset(kiss_sdft_cfg cfg);
+/*
+ clear the window and all bins back to zero
+*/
+
+#define kiss_sdft_free KISS_FFT_FREE
+
+#ifdef __cplusplus
+}
+#endif
+#endif
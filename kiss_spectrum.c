@@ -0,0 +1,224 @@
+/*
+ *  Magnitude, power and dB kernels for KISS FFT spectra.
+ *
+ *  SPDX-License-Identifier: BSD-3-Clause
+ *  See COPYING file for more information.
+ */
+
+#include "kiss_spectrum.h"
+#include "_kiss_fft_guts.h"
+#include <float.h>
+#include <stdint.h>
+
+#if defined(USE_SIMD) || defined(FIXED_POINT)
+# error "kiss_spectrum needs a float kiss_fft_scalar"
+#endif
+
+/*
+ Every kernel is one loop over the bins: a value v (scale*|X|,
+ scale*|X|^2 or scale*x) is stored to out if out is given, and
+ mult*log10(v + offset) to db if db is given.  The vector kernels do the
+ same IEEE operations in the same order as ks_kernel_scalar (no FMA),
+ then finish the last few bins with the scalar kernel, which keeps every
+ level bit-identical.
+*/
+enum { KS_MAG, KS_POWER, KS_SCALAR };
+
+#define KS_SQRT2    1.41421356237f
+#define KS_LOG10_2  0.301029995664f
+/* 2/ln(2) * 1/(2j+1) */
+#define KS_C1       2.88539008178f
+#define KS_C3       0.961796693926f
+#define KS_C5       0.577078016356f
+#define KS_C7       0.412198583111f
+
+static float ks_log2(float y)
+{
+    union { float f; int32_t i; } u;
+    int32_t e;
+    float m, z, z2, p;
+
+    u.f = y > FLT_MIN ? y : FLT_MIN;
+    e = (u.i >> 23) - 127;
+    u.i = (u.i & 0x7fffff) | 0x3f800000;
+    m = u.f;
+    if (m > KS_SQRT2) {
+        m = m * 0.5f;
+        e = e + 1;
+    }
+    z = (m - 1.0f) / (m + 1.0f);
+    z2 = z * z;
+    p = ((KS_C7 * z2 + KS_C5) * z2 + KS_C3) * z2 + KS_C1;
+    return (float) e + z * p;
+}
+
+static void ks_kernel_scalar(int kind,const void *in,int k0,int n,float scale,float offset,
+        float dbmult,float *out,float *db)
+{
+    const kiss_fft_cpx *c = (const kiss_fft_cpx *) in;
+    const float *x = (const float *) in;
+    float v;
+    int k;
+
+    for (k = k0; k < n; ++k) {
+        if (kind == KS_MAG)
+            v = scale * sqrtf(c[k].r * c[k].r + c[k].i * c[k].i);
+        else if (kind == KS_POWER)
+            v = scale * (c[k].r * c[k].r + c[k].i * c[k].i);
+        else
+            v = scale * x[k];
+        if (out)
+            out[k] = v;
+        if (db)
+            db[k] = ks_log2(v + offset) * dbmult;
+    }
+}
+
+#ifdef KISS_FFT_RUNTIME_SIMD
+#include <immintrin.h>
+
+static KF_ATTR_TARGET("sse2") __m128 ks_log2_sse2(__m128 y)
+{
+    const __m128i mant = _mm_set1_epi32(0x7fffff);
+    const __m128i one = _mm_set1_epi32(0x3f800000);
+    __m128i bits, e;
+    __m128 m, big, z, z2, p;
+
+    bits = _mm_castps_si128(_mm_max_ps(y, _mm_set1_ps(FLT_MIN)));
+    e = _mm_sub_epi32(_mm_srli_epi32(bits, 23), _mm_set1_epi32(127));
+    m = _mm_castsi128_ps(_mm_or_si128(_mm_and_si128(bits, mant), one));
+    big = _mm_cmpgt_ps(m, _mm_set1_ps(KS_SQRT2));
+    m = _mm_mul_ps(m, _mm_or_ps(_mm_and_ps(big, _mm_set1_ps(0.5f)),
+                                _mm_andnot_ps(big, _mm_set1_ps(1.0f))));
+    e = _mm_sub_epi32(e, _mm_castps_si128(big));
+    z = _mm_div_ps(_mm_sub_ps(m, _mm_set1_ps(1.0f)), _mm_add_ps(m, _mm_set1_ps(1.0f)));
+    z2 = _mm_mul_ps(z, z);
+    p = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(KS_C7), z2), _mm_set1_ps(KS_C5));
+    p = _mm_add_ps(_mm_mul_ps(p, z2), _mm_set1_ps(KS_C3));
+    p = _mm_add_ps(_mm_mul_ps(p, z2), _mm_set1_ps(KS_C1));
+    return _mm_add_ps(_mm_cvtepi32_ps(e), _mm_mul_ps(z, p));
+}
+
+static KF_ATTR_TARGET("sse2") void ks_kernel_sse2(int kind,const void *in,int n,float scale,
+        float offset,float dbmult,float *out,float *db)
+{
+    const kiss_fft_cpx *c = (const kiss_fft_cpx *) in;
+    const float *x = (const float *) in;
+    const __m128 vs = _mm_set1_ps(scale), vf = _mm_set1_ps(offset), vm = _mm_set1_ps(dbmult);
+    __m128 a, b, re, im, v;
+    int k;
+
+    for (k = 0; k + 4 <= n; k += 4) {
+        if (kind == KS_SCALAR) {
+            v = _mm_mul_ps(vs, _mm_loadu_ps(x + k));
+        } else {
+            a = _mm_loadu_ps((const float *) (c + k));
+            b = _mm_loadu_ps((const float *) (c + k + 2));
+            re = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+            im = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+            v = _mm_add_ps(_mm_mul_ps(re, re), _mm_mul_ps(im, im));
+            v = _mm_mul_ps(vs, kind == KS_MAG ? _mm_sqrt_ps(v) : v);
+        }
+        if (out)
+            _mm_storeu_ps(out + k, v);
+        if (db)
+            _mm_storeu_ps(db + k, _mm_mul_ps(ks_log2_sse2(_mm_add_ps(v, vf)), vm));
+    }
+    ks_kernel_scalar(kind, in, k, n, scale, offset, dbmult, out, db);
+}
+
+static KF_ATTR_TARGET("avx2") __m256 ks_log2_avx2(__m256 y)
+{
+    const __m256i mant = _mm256_set1_epi32(0x7fffff);
+    const __m256i one = _mm256_set1_epi32(0x3f800000);
+    __m256i bits, e;
+    __m256 m, big, z, z2, p;
+
+    bits = _mm256_castps_si256(_mm256_max_ps(y, _mm256_set1_ps(FLT_MIN)));
+    e = _mm256_sub_epi32(_mm256_srli_epi32(bits, 23), _mm256_set1_epi32(127));
+    m = _mm256_castsi256_ps(_mm256_or_si256(_mm256_and_si256(bits, mant), one));
+    big = _mm256_cmp_ps(m, _mm256_set1_ps(KS_SQRT2), _CMP_GT_OQ);
+    m = _mm256_mul_ps(m, _mm256_blendv_ps(_mm256_set1_ps(1.0f), _mm256_set1_ps(0.5f), big));
+    e = _mm256_sub_epi32(e, _mm256_castps_si256(big));
+    z = _mm256_div_ps(_mm256_sub_ps(m, _mm256_set1_ps(1.0f)), _mm256_add_ps(m, _mm256_set1_ps(1.0f)));
+    z2 = _mm256_mul_ps(z, z);
+    p = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(KS_C7), z2), _mm256_set1_ps(KS_C5));
+    p = _mm256_add_ps(_mm256_mul_ps(p, z2), _mm256_set1_ps(KS_C3));
+    p = _mm256_add_ps(_mm256_mul_ps(p, z2), _mm256_set1_ps(KS_C1));
+    return _mm256_add_ps(_mm256_cvtepi32_ps(e), _mm256_mul_ps(z, p));
+}
+
+static KF_ATTR_TARGET("avx2") void ks_kernel_avx2(int kind,const void *in,int n,float scale,
+        float offset,float dbmult,float *out,float *db)
+{
+    const kiss_fft_cpx *c = (const kiss_fft_cpx *) in;
+    const float *x = (const float *) in;
+    const __m256 vs = _mm256_set1_ps(scale), vf = _mm256_set1_ps(offset), vm = _mm256_set1_ps(dbmult);
+    __m256 a, b, re, im, v;
+    int k;
+
+    for (k = 0; k + 8 <= n; k += 8) {
+        if (kind == KS_SCALAR) {
+            v = _mm256_mul_ps(vs, _mm256_loadu_ps(x + k));
+        } else {
+            /* in-lane shuffles leave the pairs as (0,1,4,5 | 2,3,6,7) */
+            a = _mm256_loadu_ps((const float *) (c + k));
+            b = _mm256_loadu_ps((const float *) (c + k + 4));
+            re = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+            im = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+            re = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(re), _MM_SHUFFLE(3, 1, 2, 0)));
+            im = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(im), _MM_SHUFFLE(3, 1, 2, 0)));
+            v = _mm256_add_ps(_mm256_mul_ps(re, re), _mm256_mul_ps(im, im));
+            v = _mm256_mul_ps(vs, kind == KS_MAG ? _mm256_sqrt_ps(v) : v);
+        }
+        if (out)
+            _mm256_storeu_ps(out + k, v);
+        if (db)
+            _mm256_storeu_ps(db + k, _mm256_mul_ps(ks_log2_avx2(_mm256_add_ps(v, vf)), vm));
+    }
+    ks_kernel_scalar(kind, in, k, n, scale, offset, dbmult, out, db);
+}
+#endif /* KISS_FFT_RUNTIME_SIMD */
+
+static void ks_run(int kind,const void *in,int n,float scale,float offset,float mult,
+        float *out,float *db)
+{
+    const float dbmult = mult * KS_LOG10_2;
+#ifdef KISS_FFT_RUNTIME_SIMD
+    const int level = kiss_fft_simd_level();
+    if (level >= KISS_FFT_SIMD_AVX2)
+        ks_kernel_avx2(kind, in, n, scale, offset, dbmult, out, db);
+    else if (level >= KISS_FFT_SIMD_SSE2)
+        ks_kernel_sse2(kind, in, n, scale, offset, dbmult, out, db);
+    else
+#endif
+        ks_kernel_scalar(kind, in, 0, n, scale, offset, dbmult, out, db);
+}
+
+void kiss_spectrum_mag(const kiss_fft_cpx *in,int n,kiss_fft_scalar scale,kiss_fft_scalar *mag)
+{
+    ks_run(KS_MAG, in, n, scale, 0, 0, mag, NULL);
+}
+
+void kiss_spectrum_power(const kiss_fft_cpx *in,int n,kiss_fft_scalar scale,kiss_fft_scalar *power)
+{
+    ks_run(KS_POWER, in, n, scale, 0, 0, power, NULL);
+}
+
+void kiss_spectrum_db(const kiss_fft_scalar *x,int n,kiss_fft_scalar scale,
+        kiss_fft_scalar offset,kiss_fft_scalar mult,kiss_fft_scalar *db)
+{
+    ks_run(KS_SCALAR, x, n, scale, offset, mult, NULL, db);
+}
+
+void kiss_spectrum_mag_db(const kiss_fft_cpx *in,int n,kiss_fft_scalar scale,
+        kiss_fft_scalar offset,kiss_fft_scalar *mag,kiss_fft_scalar *db)
+{
+    ks_run(KS_MAG, in, n, scale, offset, 20, mag, db);
+}
+
+void kiss_spectrum_power_db(const kiss_fft_cpx *in,int n,kiss_fft_scalar scale,
+        kiss_fft_scalar offset,kiss_fft_scalar *power,kiss_fft_scalar *db)
+{
+    ks_run(KS_POWER, in, n, scale, offset, 10, power, db);
+}
@@ -0,0 +1,62 @@
+/*
+ *  Magnitude, power and dB kernels for KISS FFT spectra.
+ *
+ *  SPDX-License-Identifier: BSD-3-Clause
+ *  See COPYING file for more information.
+ */
+
+#ifndef KISS_SPECTRUM_H
+#define KISS_SPECTRUM_H
+
+#include "kiss_fft.h"
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/*
+
+ The per-bin loops that follow a transform:
+
+   mag[k]   = scale * |X[k]|
+   power[k] = scale * |X[k]|^2
+   db[k]    = mult * log10(scale * x[k] + offset)
+
+ and the fused forms that write a linear array and its dB in one pass.
+ The log is not log10f: the exponent is split off and the mantissa,
+ reduced to [sqrt(1/2), sqrt(2)), goes through z = (m-1)/(m+1) and
+ log2(m) = 2/ln2 * (z + z^3/3 + z^5/5 + z^7/7).  The series error is
+ below 5e-8 in log2, so results are within 1e-4 dB of the exact value
+ (fft_bench checks it).  Arguments below FLT_MIN are taken as FLT_MIN.
+ Bins run side by side in the SSE2/AVX2 lanes picked by
+ kiss_fft_simd_level(), and every level gives bit-identical results.
+ Meant for float builds.
+
+ */
+
+void KISS_FFT_API kiss_spectrum_mag(const kiss_fft_cpx *in,int n,kiss_fft_scalar scale,kiss_fft_scalar *mag);
+
+void KISS_FFT_API kiss_spectrum_power(const kiss_fft_cpx *in,int n,kiss_fft_scalar scale,kiss_fft_scalar *power);
+
+void KISS_FFT_API kiss_spectrum_db(const kiss_fft_scalar *x,int n,kiss_fft_scalar scale,
+        kiss_fft_scalar offset,kiss_fft_scalar mult,kiss_fft_scalar *db);
+/*
+ mult is 10 for powers and 20 for magnitudes; db may be x
+*/
+
+void KISS_FFT_API kiss_spectrum_mag_db(const kiss_fft_cpx *in,int n,kiss_fft_scalar scale,
+        kiss_fft_scalar offset,kiss_fft_scalar *mag,kiss_fft_scalar *db);
+/*
+ mag as kiss_spectrum_mag and db[k] = 20 * log10(mag[k] + offset)
+*/
+
+void KISS_FFT_API kiss_spectrum_power_db(const kiss_fft_cpx *in,int n,kiss_fft_scalar scale,
+        kiss_fft_scalar offset,kiss_fft_scalar *power,kiss_fft_scalar *db);
+/*
+ power as kiss_spectrum_power and db[k] = 10 * log10(power[k] + offset)
+*/
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,237 @@
+/*
+ *  Streaming Welch power spectrum estimate built on KISS FFT.
+ *
+ *  SPDX-License-Identifier: BSD-3-Clause
+ *  See COPYING file for more information.
+ */
+
+#include "kiss_welch.h"
+#include "kiss_fftr.h"
+#include "kiss_fft.h"
+#include "_kiss_fft_guts.h"
+
+#ifdef USE_SIMD
+# error "kiss_welch needs a scalar kiss_fft_scalar (USE_SIMD packs four transforms per value)"
+#endif
+
+/* segments transformed per kiss_fftr_batch call */
+#define KW_BATCH KISS_FFT_BATCH_MAX
+
+/*
+ buf holds the unconsumed stream, oldest first: every complete segment in
+ it is transformed before more input is copied in, so at most
+ nfft + KW_BATCH*hop samples are ever pending.  A complex cfg (cfft set)
+ keeps them as I/Q pairs and has nfft bins; a real one nfft/2+1.
+*/
+struct kiss_welch_state{
+    int nfft;
+    int hop;
+    int tau;
+    int fill;                   /* samples in buf */
+    int count;                  /* segments averaged since the last reset */
+    int nbins;
+    kiss_fftr_cfg fft;          /* real input */
+    kiss_fft_cfg cfft;          /* complex input, or NULL */
+    const kiss_fft_scalar * window;   /* nfft values owned by the caller, or NULL */
+    double * avg;               /* nbins values: running sum (tau 0) or average */
+    kiss_fft_scalar * buf;      /* nfft + KW_BATCH*hop samples */
+    kiss_fft_cpx * spec;        /* KW_BATCH spectra of nbins bins */
+};
+
+static kiss_welch_cfg kf_welch_alloc(int nfft,int hop,int tau,int cpx,void * mem,size_t * lenmem)
+{
+    kiss_welch_cfg st = NULL;
+    size_t fftsize = 0, memneeded;
+    char * plan;
+    const int nbins = cpx ? nfft : nfft / 2 + 1;
+    const int width = cpx ? 2 : 1;  /* scalars per sample */
+
+    if (nfft < 2 || (!cpx && (nfft & 1))) {
+        KISS_FFT_ERROR("Welch segment length must be even.");
+        return NULL;
+    }
+    if (hop < 1 || hop > nfft || tau < 0) {
+        KISS_FFT_ERROR("Welch hop must be between 1 and the segment length.");
+        return NULL;
+    }
+
+    if (cpx)
+        kiss_fft_alloc(nfft, 0, NULL, &fftsize);
+    else
+        kiss_fftr_alloc(nfft, 0, NULL, &fftsize);
+    fftsize = (fftsize + 15) & ~(size_t)15;
+    memneeded = ((sizeof(struct kiss_welch_state) + 15) & ~(size_t)15) + fftsize
+        + sizeof(double) * (size_t)nbins
+        + sizeof(kiss_fft_scalar) * width * ((size_t)nfft + (size_t)KW_BATCH * hop)
+        + sizeof(kiss_fft_cpx) * (size_t)KW_BATCH * nbins;
+
+    if (lenmem == NULL) {
+        st = (kiss_welch_cfg) KISS_FFT_MALLOC (memneeded);
+    } else {
+        if (mem != NULL && *lenmem >= memneeded)
+            st = (kiss_welch_cfg) mem;
+        *lenmem = memneeded;
+    }
+    if (!st)
+        return NULL;
+
+    st->nfft = nfft;
+    st->hop = hop;
+    st->tau = tau;
+    st->nbins = nbins;
+    st->window = NULL;
+    st->fft = NULL;
+    st->cfft = NULL;
+    plan = (char *) st + ((sizeof(struct kiss_welch_state) + 15) & ~(size_t)15);
+    st->avg = (double *) (plan + fftsize);
+    st->buf = (kiss_fft_scalar *) (st->avg + nbins);
+    st->spec = (kiss_fft_cpx *) (st->buf + width * (nfft + KW_BATCH * hop));
+    if (cpx)
+        st->cfft = kiss_fft_alloc(nfft, 0, plan, &fftsize);
+    else
+        st->fft = kiss_fftr_alloc(nfft, 0, plan, &fftsize);
+
+    kiss_welch_reset(st);
+    return st;
+}
+
+kiss_welch_cfg kiss_welch_alloc(int nfft,int hop,int tau,void * mem,size_t * lenmem)
+{
+    return kf_welch_alloc(nfft, hop, tau, 0, mem, lenmem);
+}
+
+kiss_welch_cfg kiss_welch_alloc_cpx(int nfft,int hop,int tau,void * mem,size_t * lenmem)
+{
+    return kf_welch_alloc(nfft, hop, tau, 1, mem, lenmem);
+}
+
+void kiss_welch_reset(kiss_welch_cfg st)
+{
+    memset(st->avg, 0, sizeof(double) * st->nbins);
+    st->fill = 0;
+    st->count = 0;
+}
+
+void kiss_welch_set_window(kiss_welch_cfg st,const kiss_fft_scalar *window)
+{
+    st->window = window;
+    kiss_welch_reset(st);
+}
+
+static void kf_welch_add(kiss_welch_cfg st,const kiss_fft_cpx *x)
+{
+    const int nbins = st->nbins;
+    double p, alpha;
+    int k;
+
+    if (st->tau == 0 || st->count == 0) {
+        for (k = 0; k < nbins; ++k)
+            st->avg[k] += (double) x[k].r * x[k].r + (double) x[k].i * x[k].i;
+    } else {
+        alpha = 1.0 / st->tau;
+        for (k = 0; k < nbins; ++k) {
+            p = (double) x[k].r * x[k].r + (double) x[k].i * x[k].i;
+            st->avg[k] += alpha * (p - st->avg[k]);
+        }
+    }
+    ++st->count;
+}
+
+/* windows b complex segments hop apart into spec and transforms them there */
+static void kf_welch_cpx_batch(kiss_welch_cfg st,const kiss_fft_cpx *x,int b)
+{
+    kiss_fft_cpx * seg;
+    int j, n;
+
+    for (j = 0; j < b; ++j) {
+        seg = st->spec + j * st->nfft;
+        if (st->window) {
+            for (n = 0; n < st->nfft; ++n) {
+                seg[n].r = x[j * st->hop + n].r * st->window[n];
+                seg[n].i = x[j * st->hop + n].i * st->window[n];
+            }
+        } else {
+            memcpy(seg, x + j * st->hop, sizeof(kiss_fft_cpx) * st->nfft);
+        }
+    }
+    kiss_fft_batch(st->cfft, b, st->spec, st->nfft, st->spec, st->nfft);
+}
+
+/* transforms every complete segment in buf and drops the samples no later segment needs */
+static int kf_welch_flush(kiss_welch_cfg st)
+{
+    const int nbins = st->nbins;
+    const int width = st->cfft ? 2 : 1;
+    int nseg, done = 0, pos = 0, b, j;
+
+    if (st->fill < st->nfft)
+        return 0;
+    nseg = (st->fill - st->nfft) / st->hop + 1;
+
+    while (done < nseg) {
+        b = nseg - done < KW_BATCH ? nseg - done : KW_BATCH;
+        if (st->cfft) {
+            kf_welch_cpx_batch(st, (const kiss_fft_cpx *) st->buf + pos, b);
+        } else if ((st->hop & 1) == 0 || st->window) {
+            kiss_fftr_batch_windowed(st->fft, b, st->buf + pos, st->hop, st->window,
+                                     st->spec, nbins);
+        } else {
+            for (j = 0; j < b; ++j)
+                kiss_fftr(st->fft, st->buf + pos + j * st->hop, st->spec + j * nbins);
+        }
+        for (j = 0; j < b; ++j)
+            kf_welch_add(st, st->spec + j * nbins);
+        pos += b * st->hop;
+        done += b;
+    }
+
+    st->fill -= pos;
+    memmove(st->buf, st->buf + width * pos, sizeof(kiss_fft_scalar) * width * st->fill);
+    return nseg;
+}
+
+/* in holds n samples of width scalars each */
+static int kf_welch_feed(kiss_welch_cfg st,const kiss_fft_scalar *in,int n,int width)
+{
+    const int cap = st->nfft + KW_BATCH * st->hop;
+    int segments = 0, m;
+
+    while (n > 0) {
+        m = cap - st->fill < n ? cap - st->fill : n;
+        memcpy(st->buf + width * st->fill, in, sizeof(kiss_fft_scalar) * width * m);
+        st->fill += m;
+        in += width * m;
+        n -= m;
+        segments += kf_welch_flush(st);
+    }
+    return segments;
+}
+
+int kiss_welch(kiss_welch_cfg st,const kiss_fft_scalar *in,int n)
+{
+    if (st->cfft) {
+        KISS_FFT_ERROR("kiss_welch on a complex cfg; use kiss_welch_cpx.");
+        return 0;
+    }
+    return kf_welch_feed(st, in, n, 1);
+}
+
+int kiss_welch_cpx(kiss_welch_cfg st,const kiss_fft_cpx *in,int n)
+{
+    if (!st->cfft) {
+        KISS_FFT_ERROR("kiss_welch_cpx on a real cfg; use kiss_welch.");
+        return 0;
+    }
+    return kf_welch_feed(st, (const kiss_fft_scalar *) in, n, 2);
+}
+
+int kiss_welch_psd(kiss_welch_cfg st,kiss_fft_scalar *power)
+{
+    const int nbins = st->nbins;
+    const double scale = st->tau == 0 && st->count > 0 ? 1.0 / st->count : 1.0;
+    int k;
+
+    for (k = 0; k < nbins; ++k)
+        power[k] = (kiss_fft_scalar) (st->avg[k] * scale);
+    return st->count;
+}
@@ -0,0 +1,94 @@
+/*
+ *  Streaming Welch power spectrum estimate built on KISS FFT.
+ *
+ *  SPDX-License-Identifier: BSD-3-Clause
+ *  See COPYING file for more information.
+ */
+
+#ifndef KISS_WELCH_H
+#define KISS_WELCH_H
+
+#include "kiss_fft.h"
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/*
+
+ Averaged periodogram of a sample stream:
+
+   P[k] = average over segments s of |sum_{n=0}^{nfft-1} x[s*hop + n] * exp(-2*pi*i * k*n / nfft)|^2
+
+ Input arrives in blocks of any length.  The cfg keeps the samples of
+ segments not yet complete, so a segment straddling two blocks is
+ transformed once, when its last sample arrives, and no segment is ever
+ transformed twice.  Complete segments are run through kiss_fftr_batch
+ (or kiss_fftr when hop is odd).  The average runs across blocks until
+ kiss_welch_reset: either the plain mean of every segment (tau = 0) or an
+ exponential average P += (|X|^2 - P) / tau, which follows a changing
+ signal with a memory of about tau segments.  Sums are kept in double.
+ Segments are unwindowed unless kiss_welch_set_window gives a window,
+ which is applied while each segment is packed for its FFT.  Meant for
+ float builds.
+
+ A cfg from kiss_welch_alloc_cpx takes complex (I/Q) samples instead,
+ runs its segments through kiss_fft_batch and averages all nfft bins, the
+ negative frequencies included.
+
+ */
+
+typedef struct kiss_welch_state *kiss_welch_cfg;
+
+
+kiss_welch_cfg KISS_FFT_API kiss_welch_alloc(int nfft,int hop,int tau,void * mem,size_t * lenmem);
+/*
+ nfft-point (even) segments starting every hop samples (1 <= hop <= nfft;
+ nfft/2 is the usual 50% overlap).
+ tau is 0 for the mean of all segments, or the exponential time constant in segments.
+ mem/lenmem work as for kiss_fft_alloc; the result is freed with kiss_welch_free.
+ The cfg holds the pending samples, so it must not be shared between threads.
+*/
+
+kiss_welch_cfg KISS_FFT_API kiss_welch_alloc_cpx(int nfft,int hop,int tau,void * mem,size_t * lenmem);
+/*
+ as kiss_welch_alloc, for complex input (nfft need not be even)
+*/
+
+int KISS_FFT_API kiss_welch(kiss_welch_cfg cfg,const kiss_fft_scalar *in,int n);
+/*
+ Feeds n samples and returns the number of segments they completed.
+*/
+
+int KISS_FFT_API kiss_welch_cpx(kiss_welch_cfg cfg,const kiss_fft_cpx *in,int n);
+/*
+ Feeds n complex samples to a kiss_welch_alloc_cpx cfg, as kiss_welch.
+*/
+
+int KISS_FFT_API kiss_welch_psd(kiss_welch_cfg cfg,kiss_fft_scalar *power);
+/*
+ Writes the nfft/2+1 averaged |X[k]|^2 (nfft for a complex cfg, in FFT
+ order: k >= nfft/2 are the negative frequencies), not normalized (divide
+ by nfft^2 for the mean square per bin), and returns the number of
+ segments averaged since the last reset (0: none yet, power is all zero).
+*/
+
+void KISS_FFT_API kiss_welch_set_window(kiss_welch_cfg cfg,const kiss_fft_scalar *window);
+/*
+ Windows every later segment with the nfft values of window (NULL: none),
+ e.g. a kiss_window_get table; the pointer is kept, not copied.  Resets
+ the average, which must not mix windows.  Divide power by nfft*sum(w^2)
+ instead of nfft^2 for the mean square per bin.
+*/
+
+void KISS_FFT_API kiss_welch_reset(kiss_welch_cfg cfg);
+/*
+ drops the pending samples and the average
+*/
+
+#define kiss_welch_free KISS_FFT_FREE
+
+#ifdef __cplusplus
+}
+#endif
+#endif
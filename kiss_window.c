@@ -0,0 +1,154 @@
+/*
+ *  Cached spectral analysis windows for KISS FFT.
+ *
+ *  SPDX-License-Identifier: BSD-3-Clause
+ *  See COPYING file for more information.
+ */
+
+#include "kiss_window.h"
+#include "_kiss_fft_guts.h"
+
+#ifdef USE_SIMD
+# error "kiss_window needs a scalar kiss_fft_scalar (USE_SIMD packs four transforms per value)"
+#endif
+
+/* the node header rounded up so the table after it stays 16-byte aligned */
+#define KW_HEADER ((sizeof(struct cached_window) + 15) & ~(size_t)15)
+
+struct cached_window
+{
+    kiss_window win;
+    struct cached_window * next;
+};
+
+static struct cached_window * cache_root = NULL;
+
+static const char * const window_names[KISS_WINDOW_COUNT] = {
+    "rect", "hann", "blackman-harris", "flattop"
+};
+
+/* cosine-sum coefficients a0 - a1 cos(x) + a2 cos(2x) - ... */
+static const double window_coefs[KISS_WINDOW_COUNT][5] = {
+    { 1, 0, 0, 0, 0 },
+    { 0.5, 0.5, 0, 0, 0 },
+    { 0.35875, 0.48829, 0.14128, 0.01168, 0 },
+    { 0.21557895, 0.41663158, 0.277263158, 0.083578947, 0.006947368 }
+};
+
+static struct cached_window * kf_window_build(kiss_window_type type,int size)
+{
+    const double pi=3.14159265358979323846264338327;
+    const double * a = window_coefs[type];
+    struct cached_window * cur;
+    kiss_fft_scalar * w = NULL;
+    double sum = 0, sum2 = 0, v;
+    int n, j;
+
+    if (type == KISS_WINDOW_RECT) {
+        cur = (struct cached_window *) KISS_FFT_MALLOC(sizeof(struct cached_window));
+    } else {
+        cur = (struct cached_window *) KISS_FFT_MALLOC(KW_HEADER + sizeof(kiss_fft_scalar) * (size_t)size);
+        if (cur)
+            w = (kiss_fft_scalar *) ((char *) cur + KW_HEADER);
+    }
+    if (cur == NULL)
+        return NULL;
+
+    for (n = 0; n < size; ++n) {
+        v = a[0];
+        for (j = 1; j < 5; ++j)
+            v += (j & 1 ? -a[j] : a[j]) * cos(2 * pi * j * n / size);
+        if (w) {
+#ifdef FIXED_POINT
+            w[n] = (kiss_fft_scalar) floor(.5 + v * SAMP_MAX);
+#else
+            w[n] = (kiss_fft_scalar) v;
+#endif
+        }
+        sum += v;
+        sum2 += v * v;
+    }
+
+    cur->win.type = type;
+    cur->win.size = size;
+    cur->win.coherent_gain = sum / size;
+    cur->win.enbw = size * sum2 / (sum * sum);
+    cur->win.w = w;
+    cur->next = NULL;
+    return cur;
+}
+
+const kiss_window * kiss_window_get(kiss_window_type type,int size)
+{
+    struct cached_window * cur = cache_root;
+    struct cached_window * prev = NULL;
+
+    if (size < 1 || (int) type < 0 || type >= KISS_WINDOW_COUNT)
+        return NULL;
+
+    while (cur) {
+        if (cur->win.type == type && cur->win.size == size)
+            return &cur->win;
+        prev = cur;
+        cur = cur->next;
+    }
+
+    cur = kf_window_build(type, size);
+    if (cur == NULL)
+        return NULL;
+    if (prev)
+        prev->next = cur;
+    else
+        cache_root = cur;
+    return &cur->win;
+}
+
+int kiss_window_kernel(kiss_window_type type,double *kernel)
+{
+    const double * a;
+    int taps = 1, m;
+
+    if ((int) type < 0 || type >= KISS_WINDOW_COUNT)
+        return 0;
+    a = window_coefs[type];
+    /* (-1)^m a_m cos(2 pi m n / size) puts (-1)^m a_m / 2 on bins k-m and k+m */
+    kernel[0] = a[0];
+    for (m = 1; m < KISS_WINDOW_MAX_TAPS; ++m) {
+        kernel[m] = (m & 1 ? -a[m] : a[m]) / 2;
+        if (a[m] != 0)
+            taps = m + 1;
+    }
+    return taps;
+}
+
+const char * kiss_window_name(kiss_window_type type)
+{
+    if ((int) type < 0 || type >= KISS_WINDOW_COUNT)
+        return "unknown";
+    return window_names[type];
+}
+
+int kiss_window_parse(const char *name)
+{
+    int t;
+
+    if (strcmp(name, "none") == 0 || strcmp(name, "rectangular") == 0)
+        return KISS_WINDOW_RECT;
+    for (t = 0; t < KISS_WINDOW_COUNT; ++t)
+        if (strcmp(name, window_names[t]) == 0)
+            return t;
+    return -1;
+}
+
+void kiss_window_cleanup(void)
+{
+    struct cached_window * cur = cache_root;
+    struct cached_window * next;
+
+    while (cur) {
+        next = cur->next;
+        KISS_FFT_FREE(cur);
+        cur = next;
+    }
+    cache_root = NULL;
+}
@@ -0,0 +1,85 @@
+/*
+ *  Cached spectral analysis windows for KISS FFT.
+ *
+ *  SPDX-License-Identifier: BSD-3-Clause
+ *  See COPYING file for more information.
+ */
+
+#ifndef KISS_WINDOW_H
+#define KISS_WINDOW_H
+
+#include "kiss_fft.h"
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/*
+
+ Periodic (DFT-even) window tables w[n], n = 0..size-1, built once per
+ (type, size) and kept until kiss_window_cleanup, so a frame loop only
+ looks them up.  Each comes with the two numbers needed to read a
+ windowed spectrum on the scale of the unwindowed one:
+
+   coherent_gain = sum(w) / size            divide |X[k]| by it for tone amplitudes
+   enbw          = size * sum(w^2) / sum(w)^2   equivalent noise bandwidth in bins
+
+ sum(w^2) = size * coherent_gain^2 * enbw, so dividing |X[k]|^2 by
+ size * sum(w^2) instead of size^2 keeps a noise density where it was.
+ The table is 16-byte aligned and meant for kiss_fftr_windowed /
+ kiss_fftr_batch_windowed, which apply it while packing the real input.
+ In FIXED_POINT builds the values are in the sample format (1.0 just
+ below full scale).  The cache is not thread safe.
+
+ */
+
+typedef enum {
+    KISS_WINDOW_RECT = 0,           /* no window: w is NULL */
+    KISS_WINDOW_HANN,               /* 0.5 - 0.5 cos: -31 dB sidelobes, ENBW 1.5 */
+    KISS_WINDOW_BLACKMAN_HARRIS,    /* 4-term, -92 dB sidelobes, ENBW 2.0 */
+    KISS_WINDOW_FLATTOP,            /* 5-term, < 0.02 dB scalloping, ENBW 3.8 */
+    KISS_WINDOW_COUNT
+} kiss_window_type;
+
+typedef struct {
+    kiss_window_type type;
+    int size;
+    double coherent_gain;
+    double enbw;
+    const kiss_fft_scalar * w;      /* size values, or NULL for KISS_WINDOW_RECT */
+} kiss_window;
+
+const kiss_window * KISS_FFT_API kiss_window_get(kiss_window_type type,int size);
+/*
+ returns the cached window, building it on first use (NULL if size < 1,
+ the type is unknown or memory runs out).  The window is owned by the cache.
+*/
+
+/* most taps kiss_window_kernel returns */
+#define KISS_WINDOW_MAX_TAPS 5
+
+int KISS_FFT_API kiss_window_kernel(kiss_window_type type,double *kernel);
+/*
+ Every window here is a sum of cosines, so windowing a block is a short
+ convolution over the bins of its unwindowed DFT X:
+
+   Xw[k] = sum_{|m| < taps} kernel[|m|] * X[k+m]      (k+m mod size)
+
+ Fills kernel[0..KISS_WINDOW_MAX_TAPS) (zero past taps) and returns taps
+ (1 for rect, 2 for hann; 0 if the type is unknown).  kernel[0] is the coherent gain.  Meant for
+ spectra that are only known unwindowed, like a sliding DFT's bins.
+*/
+
+const char * KISS_FFT_API kiss_window_name(kiss_window_type type);
+/* "rect", "hann", "blackman-harris" or "flattop" */
+
+int KISS_FFT_API kiss_window_parse(const char *name);
+/* the type named by kiss_window_name (or "none"/"rectangular"), -1 if unknown */
+
+void KISS_FFT_API kiss_window_cleanup(void);
+/* frees every cached window */
+
+#ifdef __cplusplus
+}
+#endif
+#endif
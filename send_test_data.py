@@ -6,6 +6,7 @@ Sends test signals over TCP or UDP to fft_analyzer_network
 Usage:
     python send_test_data.py --port 5000 --protocol tcp --signal sine
     python send_test_data.py --port 5000 --protocol udp --signal chirp
+    python send_test_data.py --port 5000 --iq --freq -1000   (for --iq)
 """
 
 import socket
@@ -33,6 +34,11 @@ class SignalGenerator:
         t = np.arange(samples) / self.sample_rate
         return amplitude * np.sin(2 * np.pi * freq * t)
 
+    def complex_sine(self, samples, freq=1000.0, amplitude=0.5):
+        """Generate complex exponential (one tone, at +freq or -freq)"""
+        t = np.arange(samples) / self.sample_rate
+        return amplitude * np.exp(2j * np.pi * freq * t)
+
     def multi_tone(self, samples):
         """Generate multiple sine waves"""
         t = np.arange(samples) / self.sample_rate
@@ -160,6 +166,8 @@ def main():
     ], default='sine', help='Signal type to generate')
     parser.add_argument('--freq', type=float, default=1000.0, help='Frequency in Hz (for sine)')
     parser.add_argument('--rate', type=float, default=0.1, help='Update rate in seconds (default: 0.1)')
+    parser.add_argument('--iq', action='store_true',
+                        help='Send interleaved I/Q pairs (sine becomes a complex tone; others have Q = 0)')
 
     args = parser.parse_args()
 
@@ -169,6 +177,8 @@ def main():
     print(f"Signal:   {args.signal}")
     print(f"Protocol: {args.protocol.upper()}")
     print(f"Port:     {args.port}")
+    if args.iq:
+        print("Format:   I/Q pairs")
     print()
 
     # Create signal generator and network sender
@@ -211,6 +221,14 @@ def main():
             else:
                 samples = gen.sine(FFT_SIZE, 1000.0)
 
+            if args.iq:
+                if args.signal == 'sine':
+                    samples = gen.complex_sine(FFT_SIZE, args.freq)
+                iq = np.empty(2 * FFT_SIZE)
+                iq[0::2] = np.real(samples)
+                iq[1::2] = np.imag(samples)
+                samples = iq
+
             # Send to analyzer
             sender.send(samples)
 
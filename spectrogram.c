@@ -0,0 +1,113 @@
+/*
+ * spectrogram.c
+ *
+ * Ring of the analyzer's latest spectra, read back decimated for the
+ * waterfall endpoint
+ */
+
+#include "spectrogram.h"
+#include <stdlib.h>
+#include <string.h>
+
+bool spectrogram_init(spectrogram_t* sg, int capacity, int bins) {
+    memset(sg, 0, sizeof(*sg));
+    if (capacity <= 0 || bins <= 0) {
+        return false;
+    }
+
+    const int per_line = SPECTROGRAM_ALIGN / (int)sizeof(float);
+    int stride = (bins + per_line - 1) / per_line * per_line;
+    size_t row_bytes = (size_t)capacity * stride * sizeof(float);
+
+    // One block: the rows on a cache line, then the timestamps (row_bytes
+    // is a whole number of lines, so they stay 8-byte aligned)
+    sg->block = malloc(row_bytes + (size_t)capacity * sizeof(uint64_t) + SPECTROGRAM_ALIGN - 1);
+    if (!sg->block) {
+        return false;
+    }
+    uintptr_t base = ((uintptr_t)sg->block + SPECTROGRAM_ALIGN - 1) & ~(uintptr_t)(SPECTROGRAM_ALIGN - 1);
+    sg->rows = (float*)base;
+    sg->timestamps = (uint64_t*)(base + row_bytes);
+    sg->capacity = capacity;
+    sg->bins = bins;
+    sg->stride = stride;
+    memset(sg->rows, 0, row_bytes);
+    return true;
+}
+
+void spectrogram_cleanup(spectrogram_t* sg) {
+    free(sg->block);
+    memset(sg, 0, sizeof(*sg));
+}
+
+void spectrogram_clear(spectrogram_t* sg) {
+    sg->head = 0;
+    sg->count = 0;
+    sg->total = 0;
+}
+
+void spectrogram_push(spectrogram_t* sg, const float* frame, uint64_t timestamp) {
+    if (!sg->rows) {
+        return;
+    }
+    memcpy(sg->rows + (size_t)sg->head * sg->stride, frame, sg->bins * sizeof(float));
+    sg->timestamps[sg->head] = timestamp;
+    sg->head = (sg->head + 1) % sg->capacity;
+    if (sg->count < sg->capacity) {
+        sg->count++;
+    }
+    sg->total++;
+}
+
+bool spectrogram_read(const spectrogram_t* sg, int frames, int* rows, int* cols,
+                      float* out, uint64_t* first_ts, uint64_t* last_ts) {
+    if (!sg->rows || sg->count == 0 || *rows <= 0 || *cols <= 0) {
+        return false;
+    }
+    if (frames <= 0 || frames > sg->count) {
+        frames = sg->count;
+    }
+    if (*rows > frames) {
+        *rows = frames;
+    }
+    if (*cols > sg->bins) {
+        *cols = sg->bins;
+    }
+
+    const int num_rows = *rows;
+    const int num_cols = *cols;
+    const int oldest = (sg->head - frames + sg->capacity) % sg->capacity;
+
+    // Output row r is the maximum over frames [r*F/R, (r+1)*F/R), column c
+    // over bins [c*B/C, (c+1)*B/C); each stored row is read once, in order
+    for (int r = 0; r < num_rows; r++) {
+        float* dst = out + (size_t)r * num_cols;
+        int f_lo = (int)((int64_t)r * frames / num_rows);
+        int f_hi = (int)((int64_t)(r + 1) * frames / num_rows);
+
+        for (int f = f_lo; f < f_hi; f++) {
+            const float* src = sg->rows + (size_t)((oldest + f) % sg->capacity) * sg->stride;
+            for (int c = 0; c < num_cols; c++) {
+                int b_lo = (int)((int64_t)c * sg->bins / num_cols);
+                int b_hi = (int)((int64_t)(c + 1) * sg->bins / num_cols);
+                float peak = src[b_lo];
+                for (int b = b_lo + 1; b < b_hi; b++) {
+                    if (src[b] > peak) {
+                        peak = src[b];
+                    }
+                }
+                if (f == f_lo || peak > dst[c]) {
+                    dst[c] = peak;
+                }
+            }
+        }
+    }
+
+    if (first_ts) {
+        *first_ts = sg->timestamps[oldest];
+    }
+    if (last_ts) {
+        *last_ts = sg->timestamps[(sg->head - 1 + sg->capacity) % sg->capacity];
+    }
+    return true;
+}
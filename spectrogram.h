@@ -0,0 +1,75 @@
+/*
+ * spectrogram.h
+ *
+ * Fixed-capacity history of the analyzer's spectra (one row per frame),
+ * kept for waterfall displays and read back decimated in one block
+ */
+
+#ifndef SPECTROGRAM_H
+#define SPECTROGRAM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*===========================================================================
+ * Spectrogram Ring
+ *===========================================================================*/
+
+// Rows start on a cache line: the row stride is rounded up to a multiple
+// of this many bytes, and the first row is aligned to it
+#define SPECTROGRAM_ALIGN 64
+
+typedef struct {
+    float* rows;            // capacity rows of stride values, oldest at (head - count)
+    uint64_t* timestamps;   // Timestamp in milliseconds of each row
+    int capacity;           // Rows held at most; the oldest is overwritten after that
+    int bins;               // Values per row
+    int stride;             // Floats from one row to the next (bins rounded up)
+    int head;               // Row the next frame goes to
+    int count;              // Rows held so far
+    uint64_t total;         // Frames pushed since init or the last clear
+    void* block;            // The one allocation behind rows and timestamps
+} spectrogram_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Allocate a ring of capacity rows of bins values, all in one block;
+ * nothing is allocated after this.  Returns: true on success
+ */
+bool spectrogram_init(spectrogram_t* sg, int capacity, int bins);
+
+/**
+ * Free the ring (safe on a ring that failed to initialize or was freed)
+ */
+void spectrogram_cleanup(spectrogram_t* sg);
+
+/**
+ * Forget every row
+ */
+void spectrogram_clear(spectrogram_t* sg);
+
+/**
+ * Append one frame of bins values, overwriting the oldest row when full
+ */
+void spectrogram_push(spectrogram_t* sg, const float* frame, uint64_t timestamp);
+
+/**
+ * Read the latest frames rows (all of them if frames <= 0) as a block of
+ * *rows x *cols values, oldest row first, into out.  Each value is the
+ * maximum over its block of frames and bins, so short events and narrow
+ * tones survive the decimation.  *rows and *cols are cut down to the
+ * frames and bins available; first_ts and last_ts (either may be NULL)
+ * get the timestamps of the oldest and newest frame read.
+ * Returns: false if the ring is empty or rows/cols are not positive
+ */
+bool spectrogram_read(const spectrogram_t* sg, int frames, int* rows, int* cols,
+                      float* out, uint64_t* first_ts, uint64_t* last_ts);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SPECTROGRAM_H */
@@ -6,9 +6,11 @@
  */
 
 #include "web_server.h"
+#include "kiss_spectrum.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdarg.h>
 #include <math.h>
 #include <errno.h>
 #include <time.h>
@@ -35,6 +37,10 @@
 static fft_data_t g_current_data = {0};
 static bool g_data_available = false;
 
+// Scratch for arrays converted to dB before they are written out
+static float* g_db_scratch = NULL;
+static int g_db_scratch_len = 0;
+
 /*===========================================================================
  * Embedded HTML Content
  *===========================================================================*/
@@ -155,6 +161,10 @@ static const char* HTML_CONTENT =
 "        <div class='status-label'>Update Rate</div>\n"
 "        <div class='status-value' id='updateRate'>--</div>\n"
 "      </div>\n"
+"      <div class='status-item'>\n"
+"        <div class='status-label'>Detections</div>\n"
+"        <div class='status-value' id='detections'>--</div>\n"
+"      </div>\n"
 "    </div>\n"
 "    \n"
 "    <!-- Charts -->\n"
@@ -185,6 +195,13 @@ static const char* HTML_CONTENT =
 "          <option value='10'>10: IQ LFM Chirp</option>\n"
 "          <option value='11'>11: Signal + Noise</option>\n"
 "        </select>\n"
+"        <label for='windowSelect' style='color:#fff; margin-right:10px; font-size:14px;'>Window:</label>\n"
+"        <select id='windowSelect' onchange='changeWindow()' style='margin-right:15px;'>\n"
+"          <option value='rect'>Rectangular</option>\n"
+"          <option value='hann'>Hann</option>\n"
+"          <option value='blackman-harris'>Blackman-Harris</option>\n"
+"          <option value='flattop'>Flat-top</option>\n"
+"        </select>\n"
 "        <button class='btn btn-secondary' onclick='togglePause()'>Pause/Resume</button>\n"
 "        <button class='btn btn-secondary' onclick='resetView()'>Reset View</button>\n"
 "      </div>\n"
@@ -345,8 +362,11 @@ static const char* HTML_CONTENT =
 "    // Spectrogram setup\n"
 "    const spectrogramCanvas = document.getElementById('spectrogramCanvas');\n"
 "    const spectrogramCtx = spectrogramCanvas.getContext('2d');\n"
-"    const spectrogramHistory = [];  // Rolling buffer of PSD frames\n"
-"    const maxHistory = 100;          // Keep last 100 frames (10 seconds at 10 Hz)\n"
+"    let spectrogramHistory = [];    // PSD rows from /api/waterfall, oldest first\n"
+"    let spectrogramRange = [0, 4000];  // Hz of the rows' first and last edge\n"
+"    const maxHistory = 100;          // Rows requested (the server's whole history, decimated)\n"
+"    let waterfallTotal = 0;          // Frames the server had pushed at the last reply\n"
+"    let resetTotal = -1;             // waterfallTotal when the view was reset, or -1\n"
 "    \n"
 "    // Hot colormap (black -> red -> yellow -> white)\n"
 "    function getHotColor(value) {\n"
@@ -414,9 +434,9 @@ static const char* HTML_CONTENT =
 "      spectrogramCtx.font = '12px monospace';\n"
 "      spectrogramCtx.textAlign = 'right';\n"
 "      const freqStep = 1000;  // Label every 1000 Hz\n"
-"      const maxFreq = 4000;   // Max frequency\n"
-"      for (let freq = 0; freq <= maxFreq; freq += freqStep) {\n"
-"        const y = height - (freq / maxFreq) * height;\n"
+"      const [minFreq, maxFreq] = spectrogramRange;\n"
+"      for (let freq = Math.ceil(minFreq / freqStep) * freqStep; freq <= maxFreq; freq += freqStep) {\n"
+"        const y = height - ((freq - minFreq) / (maxFreq - minFreq)) * height;\n"
 "        spectrogramCtx.fillText(freq + ' Hz', width - 5, y + 4);\n"
 "      }\n"
 "      \n"
@@ -467,6 +487,12 @@ static const char* HTML_CONTENT =
 "        }\n"
 "        lastUpdate = now;\n"
 "        \n"
+"        // CFAR detections: the strongest few, in Hz\n"
+"        const detections = (data.detections || []).slice().sort((a, b) => b.snr_db - a.snr_db);\n"
+"        document.getElementById('detections').textContent = detections.length === 0 ? 'None' :\n"
+"          detections.slice(0, 3).map(d => d.freq.toFixed(0)).join(', ') + ' Hz' +\n"
+"          (detections.length > 3 ? ` (+${detections.length - 3})` : '');\n"
+"        \n"
 "        // Update PSD chart\n"
 "        const freqs = data.frequencies || [];\n"
 "        const psd = data.psd || [];\n"
@@ -474,12 +500,15 @@ static const char* HTML_CONTENT =
 "        psdChart.data.datasets[0].data = psd;\n"
 "        psdChart.update();\n"
 "        \n"
-"        // Update spectrogram history\n"
-"        if (psd.length > 0) {\n"
-"          spectrogramHistory.push([...psd]);  // Clone the array\n"
-"          if (spectrogramHistory.length > maxHistory) {\n"
-"            spectrogramHistory.shift();  // Remove oldest frame\n"
-"          }\n"
+"        // Update spectrogram from the server's history (every frame, not just the polled ones)\n"
+"        // (after a reset, only the frames pushed since)\n"
+"        const since = resetTotal >= 0 ? `&frames=${Math.max(1, waterfallTotal - resetTotal)}` : '';\n"
+"        const waterfall = await fetch(`/api/waterfall?source=psd&rows=${maxHistory}&cols=64${since}`);\n"
+"        if (waterfall.ok) {\n"
+"          const block = await waterfall.json();\n"
+"          waterfallTotal = block.total;\n"
+"          spectrogramRange = [block.f0, block.f1];\n"
+"          spectrogramHistory = resetTotal >= 0 && block.total <= resetTotal ? [] : (block.data || []);\n"
 "          renderSpectrogram();\n"
 "        }\n"
 "        \n"
@@ -492,6 +521,10 @@ static const char* HTML_CONTENT =
 "        if (currentModeIndex >= 0 && modeSelect.selectedIndex !== currentModeIndex) {\n"
 "          modeSelect.selectedIndex = currentModeIndex;\n"
 "        }\n"
+"        const windowSelect = document.getElementById('windowSelect');\n"
+"        if (data.window && windowSelect.value !== data.window) {\n"
+"          windowSelect.value = data.window;\n"
+"        }\n"
 "      } catch (error) {\n"
 "        console.error('Error fetching data:', error);\n"
 "        document.getElementById('error').style.display = 'block';\n"
@@ -516,6 +549,20 @@ static const char* HTML_CONTENT =
 "        });\n"
 "    }\n"
 "    \n"
+"    function changeWindow() {\n"
+"      const type = document.getElementById('windowSelect').value;\n"
+"      fetch('/api/window?type=' + type, { method: 'POST' })\n"
+"        .then(response => response.json())\n"
+"        .then(data => {\n"
+"          console.log('Window changed to:', data.window);\n"
+"          showToast('Window changed', 'success');\n"
+"        })\n"
+"        .catch(error => {\n"
+"          console.error('Error changing window:', error);\n"
+"          showToast('Error changing window', 'error');\n"
+"        });\n"
+"    }\n"
+"    \n"
 "    function togglePause() {\n"
 "      fetch('/api/pause', { method: 'POST' })\n"
 "        .then(response => response.json())\n"
@@ -531,6 +578,7 @@ static const char* HTML_CONTENT =
 "    \n"
 "    function resetView() {\n"
 "      spectrogramHistory.length = 0;\n"
+"      resetTotal = waterfallTotal;\n"
 "      console.log('View reset');\n"
 "      showToast('Spectrogram view reset', 'info');\n"
 "    }\n"
@@ -615,6 +663,10 @@ static const char* (*g_log_format_callback)(void) = NULL;
 static void (*g_auto_record_callback)(bool enabled, float threshold) = NULL;
 static void (*g_log_directory_callback)(const char* directory) = NULL;
 static const char* (*g_get_log_directory_callback)(void) = NULL;
+static bool (*g_zoom_callback)(const float* signal, int size, float f0, float f1,
+                               int bins, float* magnitude) = NULL;
+static bool (*g_window_callback)(const char* name) = NULL;
+static int (*g_bands_callback)(const char* spec) = NULL;
 
 void web_server_set_mode_callback(void (*callback)(int mode)) {
     g_mode_callback = callback;
@@ -656,6 +708,20 @@ void web_server_set_get_log_directory_callback(const char* (*callback)(void)) {
     g_get_log_directory_callback = callback;
 }
 
+void web_server_set_zoom_callback(bool (*callback)(const float* signal, int size,
+                                                   float f0, float f1, int bins,
+                                                   float* magnitude)) {
+    g_zoom_callback = callback;
+}
+
+void web_server_set_window_callback(bool (*callback)(const char* name)) {
+    g_window_callback = callback;
+}
+
+void web_server_set_bands_callback(int (*callback)(const char* spec)) {
+    g_bands_callback = callback;
+}
+
 /*===========================================================================
  * Helper Functions
  *===========================================================================*/
@@ -670,6 +736,46 @@ uint64_t get_timestamp_ms(void) {
 #endif
 }
 
+// Magnitude bins of the current frame and the frequency of the first
+// (0 Hz one-sided; -Nyquist for IQ input, whose spectrum is two-sided)
+static int spectrum_bins(void) {
+    return g_current_data.iq ? g_current_data.fft_size : g_current_data.fft_size / 2;
+}
+
+static float spectrum_f0(void) {
+    return g_current_data.iq ? -g_current_data.sample_rate / 2.0f : 0.0f;
+}
+
+// snprintf onto the end of a reply being built in json[size].  If the text
+// does not fit, *len becomes -1 and nothing more is appended, so an
+// undersized buffer is reported by send_json() instead of overrunning it or
+// going out as truncated JSON
+static void json_append(char* json, size_t size, int* len, const char* fmt, ...) {
+    if (*len < 0) {
+        return;
+    }
+    va_list args;
+    va_start(args, fmt);
+    int written = vsnprintf(json + *len, size - *len, fmt, args);
+    va_end(args);
+    *len = written >= 0 && (size_t)written < size - *len ? *len + written : -1;
+}
+
+// mult * log10(x + offset) of n values through the shared vectorized
+// kernel; valid until the next call, NULL if the scratch cannot grow
+static const float* to_db(const float* x, int n, float offset, float mult) {
+    if (n > g_db_scratch_len) {
+        float* grown = (float*)realloc(g_db_scratch, n * sizeof(float));
+        if (!grown) {
+            return NULL;
+        }
+        g_db_scratch = grown;
+        g_db_scratch_len = n;
+    }
+    kiss_spectrum_db(x, n, 1.0f, offset, mult, g_db_scratch);
+    return g_db_scratch;
+}
+
 static void send_response(int client_fd, const char* status, const char* content_type,
                          const char* body, int body_len) {
     char header[512];
@@ -688,6 +794,16 @@ static void send_response(int client_fd, const char* status, const char* content
     }
 }
 
+// Send a reply built with json_append(), or a 500 if it overflowed its buffer
+static void send_json(int client_fd, const char* json, int json_len) {
+    if (json_len < 0) {
+        const char* msg = "{\"status\":\"error\",\"message\":\"Reply too large\"}";
+        send_response(client_fd, "500 Internal Server Error", "application/json", msg, strlen(msg));
+        return;
+    }
+    send_response(client_fd, "200 OK", "application/json", json, json_len);
+}
+
 /*===========================================================================
  * Web Server Implementation
  *===========================================================================*/
@@ -771,7 +887,7 @@ int web_server_handle_requests(int server_fd) {
 
             // Parse HTTP request
             char method[16], path[256];
-            sscanf(buffer, "%s %s", method, path);
+            sscanf(buffer, "%15s %255s", method, path);
 
             // Route requests
             if (strcmp(path, "/") == 0 || strcmp(path, "/index.html") == 0) {
@@ -780,70 +896,361 @@ int web_server_handle_requests(int server_fd) {
                             HTML_CONTENT, strlen(HTML_CONTENT));
             }
             else if (strcmp(path, "/api/fft") == 0 && g_data_available) {
-                // Serve FFT data as JSON
-                char json[8192];
+                // Serve FFT data as JSON (room for 4096 bands with their edges,
+                // plus every tone and channel)
+                static char json[131072];
                 int json_len = 0;
 
-                json_len += snprintf(json + json_len, sizeof(json) - json_len,
+                const int num_bins = spectrum_bins();
+                const float bin_hz = (float)g_current_data.sample_rate / g_current_data.fft_size;
+                const int td_stride = g_current_data.iq ? 2 : 1;
+
+                json_append(json, sizeof(json), &json_len,
                     "{\"fft_size\":%d,\"sample_rate\":%d,\"num_bands\":%d,"
-                    "\"mode\":\"%s\",\"paused\":%s,\"web_control_active\":%s,\"led_pattern\":%d,\"timestamp\":%llu,",
+                    "\"iq\":%s,\"bins\":%d,\"f_min\":%.1f,"
+                    "\"mode\":\"%s\",\"window\":\"%s\",\"coherent_gain\":%.4f,\"enbw\":%.3f,"
+                    "\"paused\":%s,\"web_control_active\":%s,\"led_pattern\":%d,\"timestamp\":%llu,",
                     g_current_data.fft_size, g_current_data.sample_rate,
-                    g_current_data.num_bands, g_current_data.mode_name,
+                    g_current_data.num_bands, g_current_data.iq ? "true" : "false",
+                    num_bins, spectrum_f0(), g_current_data.mode_name,
+                    g_current_data.window_name ? g_current_data.window_name : "rect",
+                    g_current_data.window_coherent_gain, g_current_data.window_enbw,
                     g_current_data.paused ? "true" : "false",
                     g_current_data.web_control_active ? "true" : "false",
                     g_current_data.led_pattern,
                     (unsigned long long)g_current_data.timestamp);
 
-                // Add time-domain samples (downsampled)
-                json_len += snprintf(json + json_len, sizeof(json) - json_len,
+                // Add time-domain samples (downsampled; I, then Q for IQ input)
+                json_append(json, sizeof(json), &json_len,
                     "\"time_domain\":[");
                 for (int i = 0; i < g_current_data.fft_size; i += 4) { // Downsample by 4
-                    json_len += snprintf(json + json_len, sizeof(json) - json_len,
-                        "%.3f%s", g_current_data.time_domain[i], (i < g_current_data.fft_size - 4) ? "," : "");
+                    json_append(json, sizeof(json), &json_len,
+                        "%.3f%s", g_current_data.time_domain[i * td_stride],
+                        (i < g_current_data.fft_size - 4) ? "," : "");
+                }
+                json_append(json, sizeof(json), &json_len, "],");
+                if (g_current_data.iq) {
+                    json_append(json, sizeof(json), &json_len,
+                        "\"time_domain_q\":[");
+                    for (int i = 0; i < g_current_data.fft_size; i += 4) {
+                        json_append(json, sizeof(json), &json_len,
+                            "%.3f%s", g_current_data.time_domain[2 * i + 1],
+                            (i < g_current_data.fft_size - 4) ? "," : "");
+                    }
+                    json_append(json, sizeof(json), &json_len, "],");
                 }
-                json_len += snprintf(json + json_len, sizeof(json) - json_len, "],");
 
-                // Add frequencies array
-                json_len += snprintf(json + json_len, sizeof(json) - json_len,
+                // Add frequencies array (from f_min; negative first for IQ input)
+                json_append(json, sizeof(json), &json_len,
                     "\"frequencies\":[");
-                for (int i = 0; i < g_current_data.fft_size / 2; i += 4) { // Downsample for web
-                    float freq = (float)i * g_current_data.sample_rate / g_current_data.fft_size;
-                    json_len += snprintf(json + json_len, sizeof(json) - json_len,
-                        "%.1f%s", freq, (i < g_current_data.fft_size / 2 - 4) ? "," : "");
+                for (int i = 0; i < num_bins; i += 4) { // Downsample for web
+                    float freq = spectrum_f0() + i * bin_hz;
+                    json_append(json, sizeof(json), &json_len,
+                        "%.1f%s", freq, (i < num_bins - 4) ? "," : "");
                 }
-                json_len += snprintf(json + json_len, sizeof(json) - json_len, "],");
+                json_append(json, sizeof(json), &json_len, "],");
 
-                // Add magnitudes array (in dB)
-                json_len += snprintf(json + json_len, sizeof(json) - json_len,
+                // Add magnitudes array (in dB; the analyzer usually converted them already)
+                const float* magnitude_db = g_current_data.magnitude_db ? g_current_data.magnitude_db :
+                    to_db(g_current_data.magnitude, num_bins, 1e-6f, 20.0f);
+                json_append(json, sizeof(json), &json_len,
                     "\"magnitudes\":[");
-                for (int i = 0; i < g_current_data.fft_size / 2; i += 4) { // Downsample
-                    float db = 20.0f * log10f(g_current_data.magnitude[i] + 1e-6f);
-                    json_len += snprintf(json + json_len, sizeof(json) - json_len,
-                        "%.1f%s", db, (i < g_current_data.fft_size / 2 - 4) ? "," : "");
+                for (int i = 0; magnitude_db && i < num_bins; i += 4) { // Downsample
+                    json_append(json, sizeof(json), &json_len,
+                        "%.1f%s", magnitude_db[i], (i < num_bins - 4) ? "," : "");
                 }
-                json_len += snprintf(json + json_len, sizeof(json) - json_len, "],");
+                json_append(json, sizeof(json), &json_len, "],");
 
                 // Add PSD array (in dB)
-                // PSD uses Welch's method with 256-pt segments, so 128 bins
-                json_len += snprintf(json + json_len, sizeof(json) - json_len,
+                // PSD uses Welch's method with 256-pt segments, so 128 bins (256 for IQ)
+                json_append(json, sizeof(json), &json_len,
                     "\"psd\":[");
-                for (int i = 0; i < g_current_data.psd_size; i += 2) { // Downsample by 2 (128 -> 64 points)
-                    json_len += snprintf(json + json_len, sizeof(json) - json_len,
+                for (int i = 0; i < g_current_data.psd_size; i += 2) { // Downsample by 2, as the frequencies
+                    json_append(json, sizeof(json), &json_len,
                         "%.1f%s", g_current_data.psd[i], (i < g_current_data.psd_size - 2) ? "," : "");
                 }
-                json_len += snprintf(json + json_len, sizeof(json) - json_len, "],");
+                json_append(json, sizeof(json), &json_len, "],");
 
                 // Add band energies (in dB)
-                json_len += snprintf(json + json_len, sizeof(json) - json_len,
+                const float* band_db = to_db(g_current_data.band_energies, g_current_data.num_bands,
+                                             1e-6f, 20.0f);
+                json_append(json, sizeof(json), &json_len,
                     "\"band_energies\":[");
-                for (int i = 0; i < g_current_data.num_bands; i++) {
-                    float db = 20.0f * log10f(g_current_data.band_energies[i] + 1e-6f);
-                    json_len += snprintf(json + json_len, sizeof(json) - json_len,
-                        "%.1f%s", db, (i < g_current_data.num_bands - 1) ? "," : "");
+                for (int i = 0; band_db && i < g_current_data.num_bands; i++) {
+                    json_append(json, sizeof(json), &json_len,
+                        "%.1f%s", band_db[i], (i < g_current_data.num_bands - 1) ? "," : "");
+                }
+                json_append(json, sizeof(json), &json_len, "],");
+
+                // Band edges in Hz (num_bands + 1 values)
+                json_append(json, sizeof(json), &json_len,
+                    "\"band_edges\":[");
+                for (int i = 0; g_current_data.band_edges && i <= g_current_data.num_bands; i++) {
+                    json_append(json, sizeof(json), &json_len,
+                        "%.1f%s", g_current_data.band_edges[i], (i < g_current_data.num_bands) ? "," : "");
+                }
+                json_append(json, sizeof(json), &json_len, "]");
+
+                // Frame features, as the analyzer computed them for the trigger and loggers
+                const frame_features_t* features = g_current_data.features;
+                if (features) {
+                    json_append(json, sizeof(json), &json_len,
+                        ",\"features\":{\"peak_freq\":%.1f,\"peak_db\":%.1f,\"noise_floor_db\":%.1f,"
+                        "\"snr_db\":%.1f,\"centroid\":%.1f,\"rms\":%.4f}",
+                        features->peak_freq, 20.0f * log10f(features->peak_value + 1e-6f),
+                        20.0f * log10f(features->noise_floor + 1e-6f), features->snr_db,
+                        features->centroid, features->rms);
                 }
-                json_len += snprintf(json + json_len, sizeof(json) - json_len, "]}");
 
-                send_response(client_fd, "200 OK", "application/json", json, json_len);
+                // CFAR detections, empty when the detector is off
+                json_append(json, sizeof(json), &json_len, ",\"detections\":[");
+                for (int i = 0; g_current_data.detections && i < g_current_data.num_detections; i++) {
+                    const cfar_detection_t* d = &g_current_data.detections[i];
+                    json_append(json, sizeof(json), &json_len,
+                        "{\"freq\":%.1f,\"db\":%.1f,\"snr_db\":%.1f,\"bins\":%d}%s",
+                        d->freq, 20.0f * log10f(d->magnitude + 1e-6f), d->snr_db, d->bins,
+                        (i < g_current_data.num_detections - 1) ? "," : "");
+                }
+                json_append(json, sizeof(json), &json_len, "]");
+
+                // Add Goertzel tones (in dB), if any are monitored
+                if (g_current_data.num_tones > 0) {
+                    const float* tone_db = to_db(g_current_data.tone_magnitudes,
+                                                 g_current_data.num_tones, 1e-6f, 20.0f);
+                    json_append(json, sizeof(json), &json_len,
+                        ",\"tones\":[");
+                    for (int i = 0; tone_db && i < g_current_data.num_tones; i++) {
+                        json_append(json, sizeof(json), &json_len,
+                            "{\"freq\":%.1f,\"db\":%.1f}%s", g_current_data.tone_freqs[i], tone_db[i],
+                            (i < g_current_data.num_tones - 1) ? "," : "");
+                    }
+                    json_append(json, sizeof(json), &json_len, "]");
+                }
+
+                // Add channelizer outputs (in dB), if the channelizer is on
+                if (g_current_data.num_channels > 0) {
+                    const float* channel_db = to_db(g_current_data.channel_power,
+                                                    g_current_data.num_channels, 1e-12f, 10.0f);
+                    json_append(json, sizeof(json), &json_len,
+                        ",\"channels\":[");
+                    for (int i = 0; channel_db && i < g_current_data.num_channels; i++) {
+                        json_append(json, sizeof(json), &json_len,
+                            "{\"freq\":%.1f,\"db\":%.1f}%s", g_current_data.channel_freqs[i], channel_db[i],
+                            (i < g_current_data.num_channels - 1) ? "," : "");
+                    }
+                    json_append(json, sizeof(json), &json_len, "]");
+                }
+                json_append(json, sizeof(json), &json_len, "}");
+
+                send_json(client_fd, json, json_len);
+            }
+            else if (strcmp(path, "/api/peaks") == 0 && g_data_available) {
+                // Peak tracks of the current frame, in frequency order
+                static char json[8192];
+                int json_len = 0;
+
+                json_append(json, sizeof(json), &json_len,
+                    "{\"timestamp\":%llu,\"resolution\":%.4f,\"peaks\":[",
+                    (unsigned long long)g_current_data.timestamp,
+                    (float)g_current_data.sample_rate / g_current_data.fft_size);
+                for (int i = 0; g_current_data.peaks && i < g_current_data.num_peaks; i++) {
+                    const peak_track_t* peak = &g_current_data.peaks[i];
+                    json_append(json, sizeof(json), &json_len,
+                        "{\"id\":%d,\"freq\":%.2f,\"db\":%.1f,\"age\":%d,\"coasting\":%s}%s",
+                        peak->id, peak->freq, 20.0f * log10f(peak->magnitude + 1e-6f), peak->age,
+                        peak->coasting ? "true" : "false",
+                        (i < g_current_data.num_peaks - 1) ? "," : "");
+                }
+                json_append(json, sizeof(json), &json_len, "]}");
+
+                send_json(client_fd, json, json_len);
+            }
+            else if (strncmp(path, "/api/waterfall", 14) == 0 && g_data_available) {
+                // Recent spectra as one decimated block, oldest row first
+                int rows = 128;
+                int cols = 128;
+                int frames = 0;
+                bool use_psd = false;
+
+                char* query = strchr(path, '?');
+                if (query) {
+                    char* rows_param = strstr(query, "rows=");
+                    if (rows_param) {
+                        rows = atoi(rows_param + 5);
+                    }
+                    char* cols_param = strstr(query, "cols=");
+                    if (cols_param) {
+                        cols = atoi(cols_param + 5);
+                    }
+                    char* frames_param = strstr(query, "frames=");
+                    if (frames_param) {
+                        frames = atoi(frames_param + 7);
+                    }
+                    use_psd = strstr(query, "source=psd") != NULL;
+                }
+
+                const spectrogram_t* history = use_psd ? g_current_data.psd_history :
+                                                         g_current_data.spectrogram;
+                // Bin width of the history's rows (the PSD has psd_size bins over the
+                // same span as the spectrum: up to Nyquist, or both sides of DC for IQ)
+                float span = g_current_data.iq ? (float)g_current_data.sample_rate :
+                                                 g_current_data.sample_rate / 2.0f;
+                float bin_hz = use_psd ? span / g_current_data.psd_size :
+                                         (float)g_current_data.sample_rate / g_current_data.fft_size;
+                static float cells[WEB_SERVER_WATERFALL_MAX_CELLS];
+                uint64_t first_ts = 0;
+                uint64_t last_ts = 0;
+
+                if (rows <= 0 || cols <= 0 || rows > WEB_SERVER_WATERFALL_MAX_CELLS / cols) {
+                    const char* msg = "{\"status\":\"error\",\"message\":\"Invalid waterfall size\"}";
+                    send_response(client_fd, "400 Bad Request", "application/json", msg, strlen(msg));
+                } else if (!history ||
+                           !spectrogram_read(history, frames, &rows, &cols, cells, &first_ts, &last_ts)) {
+                    const char* msg = "{\"status\":\"error\",\"message\":\"No spectrogram history\"}";
+                    send_response(client_fd, "500 Internal Server Error", "application/json", msg, strlen(msg));
+                } else {
+                    // Cells are clamped to +-999.9 dB, so each takes at most 8
+                    // characters ("-999.9,") and each row 3 more ("[", "],");
+                    // rows * cols <= MAX_CELLS bounds rows * (cols * 8 + 3) by this
+                    static char json[WEB_SERVER_WATERFALL_MAX_CELLS * (8 + 3) + 512];
+                    int json_len = 0;
+                    int frames_read = frames > 0 && frames < history->count ? frames : history->count;
+
+                    json_append(json, sizeof(json), &json_len,
+                        "{\"status\":\"ok\",\"source\":\"%s\",\"rows\":%d,\"cols\":%d,\"frames\":%d,"
+                        "\"total\":%llu,\"t0\":%llu,\"t1\":%llu,\"f0\":%.1f,\"f1\":%.1f,\"data\":[",
+                        use_psd ? "psd" : "magnitude", rows, cols, frames_read,
+                        (unsigned long long)history->total,
+                        (unsigned long long)first_ts, (unsigned long long)last_ts,
+                        spectrum_f0(), spectrum_f0() + history->bins * bin_hz);
+                    for (int r = 0; r < rows; r++) {
+                        json_append(json, sizeof(json), &json_len, "[");
+                        for (int c = 0; c < cols; c++) {
+                            float cell = cells[r * cols + c];
+                            cell = cell < -999.9f ? -999.9f : (cell > 999.9f ? 999.9f : cell);
+                            json_append(json, sizeof(json), &json_len,
+                                "%.1f%s", cell, (c < cols - 1) ? "," : "");
+                        }
+                        json_append(json, sizeof(json), &json_len,
+                            "]%s", (r < rows - 1) ? "," : "");
+                    }
+                    json_append(json, sizeof(json), &json_len, "]}");
+
+                    send_json(client_fd, json, json_len);
+                }
+            }
+            else if (strncmp(path, "/api/zoom", 9) == 0) {
+                // Zoomed spectrum of the current frame over [f0, f1] Hz (f0 may be
+                // negative for IQ input)
+                if (g_zoom_callback && g_data_available) {
+                    float nyquist = g_current_data.sample_rate / 2.0f;
+                    float f0 = 0.0f;
+                    float f1 = nyquist;
+                    int bins = 256;
+
+                    // Parse query parameters
+                    char* query = strchr(path, '?');
+                    if (query) {
+                        char* f0_param = strstr(query, "f0=");
+                        if (f0_param) {
+                            f0 = atof(f0_param + 3);
+                        }
+                        char* f1_param = strstr(query, "f1=");
+                        if (f1_param) {
+                            f1 = atof(f1_param + 3);
+                        }
+                        char* bins_param = strstr(query, "bins=");
+                        if (bins_param) {
+                            bins = atoi(bins_param + 5);
+                        }
+                    }
+
+                    static float zoom_magnitude[WEB_SERVER_ZOOM_MAX_BINS];
+                    if (f0 < spectrum_f0() || f1 > nyquist || f0 >= f1 ||
+                        bins < 2 || bins > WEB_SERVER_ZOOM_MAX_BINS) {
+                        const char* msg = "{\"status\":\"error\",\"message\":\"Invalid zoom range\"}";
+                        send_response(client_fd, "400 Bad Request", "application/json", msg, strlen(msg));
+                    } else if (!g_zoom_callback(g_current_data.time_domain, g_current_data.fft_size,
+                                                f0, f1, bins, zoom_magnitude)) {
+                        const char* msg = "{\"status\":\"error\",\"message\":\"Zoom failed\"}";
+                        send_response(client_fd, "500 Internal Server Error", "application/json", msg, strlen(msg));
+                    } else {
+                        static char json[16384];
+                        int json_len = 0;
+                        float step = (f1 - f0) / (bins - 1);
+
+                        json_append(json, sizeof(json), &json_len,
+                            "{\"status\":\"ok\",\"f0\":%.3f,\"f1\":%.3f,\"bins\":%d,\"resolution\":%.4f,",
+                            f0, f1, bins, step);
+
+                        json_append(json, sizeof(json), &json_len,
+                            "\"frequencies\":[");
+                        for (int i = 0; i < bins; i++) {
+                            json_append(json, sizeof(json), &json_len,
+                                "%.2f%s", f0 + i * step, (i < bins - 1) ? "," : "");
+                        }
+                        json_append(json, sizeof(json), &json_len, "],");
+
+                        // Magnitudes in dB, same reference as /api/fft
+                        const float* zoom_db = to_db(zoom_magnitude, bins, 1e-6f, 20.0f);
+                        json_append(json, sizeof(json), &json_len,
+                            "\"magnitudes\":[");
+                        for (int i = 0; zoom_db && i < bins; i++) {
+                            json_append(json, sizeof(json), &json_len,
+                                "%.1f%s", zoom_db[i], (i < bins - 1) ? "," : "");
+                        }
+                        json_append(json, sizeof(json), &json_len, "]}");
+
+                        send_json(client_fd, json, json_len);
+                    }
+                } else {
+                    const char* msg = "{\"status\":\"error\",\"message\":\"Zoom not available\"}";
+                    send_response(client_fd, "500 Internal Server Error", "application/json", msg, strlen(msg));
+                }
+            }
+            else if (strncmp(path, "/api/window", 11) == 0) {
+                // Handle window change - parse query parameter
+                char name[32] = "";
+                char* query = strchr(path, '?');
+                if (query) {
+                    char* type_param = strstr(query, "type=");
+                    if (type_param) {
+                        sscanf(type_param + 5, "%31[^&]", name);
+                    }
+                }
+
+                if (g_window_callback && name[0] && g_window_callback(name)) {
+                    char response[96];
+                    int len = snprintf(response, sizeof(response),
+                        "{\"status\":\"ok\",\"window\":\"%s\"}", name);
+                    send_response(client_fd, "200 OK", "application/json", response, len);
+                } else {
+                    const char* msg = "{\"status\":\"error\",\"message\":\"Invalid window\"}";
+                    send_response(client_fd, "400 Bad Request", "application/json", msg, strlen(msg));
+                }
+            }
+            else if (strncmp(path, "/api/bands", 10) == 0) {
+                // Handle band set change, e.g. set=octave:3 or set=0,500,1000,4000
+                char spec[224] = "";
+                char* query = strchr(path, '?');
+                if (query) {
+                    char* set_param = strstr(query, "set=");
+                    if (set_param) {
+                        sscanf(set_param + 4, "%223[^&]", spec);
+                    }
+                }
+
+                // The reply carries the parsed band count, never the raw spec
+                int num_bands = g_bands_callback && spec[0] ? g_bands_callback(spec) : 0;
+                if (num_bands > 0) {
+                    char response[64];
+                    int len = snprintf(response, sizeof(response),
+                        "{\"status\":\"ok\",\"bands\":%d}", num_bands);
+                    send_response(client_fd, "200 OK", "application/json", response, len);
+                } else {
+                    const char* msg = "{\"status\":\"error\",\"message\":\"Invalid band set\"}";
+                    send_response(client_fd, "400 Bad Request", "application/json", msg, strlen(msg));
+                }
             }
             else if (strcmp(path, "/api/pause") == 0) {
                 // Handle pause toggle
@@ -1060,4 +1467,7 @@ void web_server_cleanup(int server_fd) {
         close(server_fd);
         printf("[*] Web server closed\n");
     }
+    free(g_db_scratch);
+    g_db_scratch = NULL;
+    g_db_scratch_len = 0;
 }
@@ -17,6 +17,9 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+#include "frame_features.h"
+#include "spectrogram.h"
+
 /*===========================================================================
  * Configuration
  *===========================================================================*/
@@ -25,22 +28,60 @@
 #define WEB_SERVER_MAX_CLIENTS  4
 #define WEB_SERVER_TIMEOUT_SEC  5
 #define WEB_SERVER_BUFFER_SIZE  4096
+#define WEB_SERVER_ZOOM_MAX_BINS 512
+#define WEB_SERVER_WATERFALL_MAX_CELLS 65536  // rows x cols per /api/waterfall reply
 
 /*===========================================================================
  * FFT Data Structure for Web Interface
  *===========================================================================*/
 
+// One track of the analyzer's spectral peak tracker
+typedef struct {
+    int id;                 // Stable from frame to frame while the track lives
+    float freq;             // Interpolated frequency in Hz
+    float magnitude;        // Interpolated magnitude, same scale as magnitude
+    int age;                // Frames since the track started
+    bool coasting;          // No peak matched it this frame (last values held)
+} peak_track_t;
+
+// One detection of the analyzer's CFAR detector (a run of adjacent bins)
+typedef struct {
+    float freq;             // Frequency of the strongest bin in Hz
+    float magnitude;        // Its magnitude, same scale as magnitude
+    float snr_db;           // Its power over the local noise estimate
+    int bins;               // Adjacent bins over the threshold
+} cfar_detection_t;
+
 typedef struct {
     int fft_size;           // FFT size (e.g., 512)
     int sample_rate;        // Sample rate in Hz (e.g., 8000)
-    int num_bands;          // Number of frequency bands (e.g., 8)
-    int psd_size;           // PSD array size (128 for Welch with 256-pt segments)
-    float* time_domain;     // Time-domain signal (fft_size values)
-    float* magnitude;       // Magnitude spectrum (fft_size/2 values)
+    int num_bands;          // Number of frequency bands (8 by default, up to thousands)
+    int psd_size;           // PSD array size (128 for Welch with 256-pt segments, 256 for IQ)
+    bool iq;                // IQ input: two-sided spectrum and PSD from -sample_rate/2, fftshifted
+    float* time_domain;     // Time-domain signal (fft_size values, or fft_size I/Q pairs for IQ)
+    float* magnitude;       // Magnitude spectrum (fft_size/2 values, fft_size for IQ)
+    const float* magnitude_db;    // 20*log10(magnitude + 1e-6), or NULL to convert here
     float* psd;             // Power Spectral Density in dB/Hz (psd_size values)
     float* band_energies;   // Energy per band (num_bands values)
+    const float* band_edges;      // Band edges in Hz (num_bands + 1 values)
+    const frame_features_t* features;  // Peak, noise floor, SNR, ... of the frame, or NULL
+    int num_tones;          // Goertzel tones (0 unless tones are monitored)
+    const float* tone_freqs;      // Tone frequencies in Hz (num_tones values)
+    const float* tone_magnitudes; // Tone magnitudes, same scale as magnitude (num_tones values)
+    int num_channels;       // Channelizer outputs (0 unless the channelizer is on)
+    const float* channel_freqs;   // Channel centre frequencies in Hz (num_channels values)
+    const float* channel_power;   // Mean channel power over the frame (num_channels values)
+    int num_peaks;          // Peak tracks (0 unless the peak tracker runs)
+    const peak_track_t* peaks;    // Peak tracks in frequency order (num_peaks values)
+    int num_detections;     // CFAR detections (0 unless the detector runs)
+    const cfar_detection_t* detections;  // In frequency order (num_detections values)
+    const spectrogram_t* spectrogram;    // Magnitude history in dB, or NULL
+    const spectrogram_t* psd_history;    // PSD history in dB/Hz, or NULL
     uint8_t led_pattern;    // Current LED pattern
     const char* mode_name;  // Current waveform mode name
+    const char* window_name;      // Analysis window of the spectrum and PSD
+    float window_coherent_gain;   // sum(w)/N, already divided out of magnitude
+    float window_enbw;            // Equivalent noise bandwidth in bins
     bool paused;            // Pause state
     bool web_control_active; // True when switches=1111 (web control mode enabled)
     uint64_t timestamp;     // Timestamp in milliseconds
@@ -138,6 +179,29 @@ void web_server_set_log_directory_callback(void (*callback)(const char* director
  */
 void web_server_set_get_log_directory_callback(const char* (*callback)(void));
 
+/**
+ * Set callback for zoomed spectrum requests (/api/zoom?f0=&f1=&bins=)
+ * Fills magnitude with 'bins' linear magnitudes of the given frame, evenly
+ * spaced over [f0, f1] Hz
+ * Returns: true on success
+ */
+void web_server_set_zoom_callback(bool (*callback)(const float* signal, int size,
+                                                   float f0, float f1, int bins,
+                                                   float* magnitude));
+
+/**
+ * Set callback for window change requests (/api/window?type=NAME)
+ * Returns: true if NAME is a known window
+ */
+void web_server_set_window_callback(bool (*callback)(const char* name));
+
+/**
+ * Set callback for band set changes (/api/bands?set=SPEC, SPEC as for --bands)
+ * Returns: the number of bands if SPEC is a valid band set and can be
+ * applied now, 0 otherwise
+ */
+void web_server_set_bands_callback(int (*callback)(const char* spec));
+
 #ifdef __cplusplus
 }
 #endif